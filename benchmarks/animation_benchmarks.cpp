@@ -0,0 +1,76 @@
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "benchmark.h"
+
+import engine.animation;
+import glm;
+
+using namespace engine::animation;
+
+namespace citrus::benchmarks {
+
+namespace {
+constexpr uint32_t EVALUATIONS = 4096;
+
+// One track sampled at EVALUATIONS sorted times across its duration, as a playing clip would
+template<typename ValueType>
+class TrackEvaluate final : public Fixture {
+public:
+	TrackEvaluate(const uint32_t keyframe_count, const InterpolationMode mode) {
+		Rng rng;
+		track_.interpolation = mode;
+		for (uint32_t i = 0; i < keyframe_count; ++i) {
+			const float time = static_cast<float>(i) * 0.1F;
+			if constexpr (std::is_same_v<ValueType, glm::quat>) {
+				const glm::vec3 axis{rng.Float(-1.0F, 1.0F), rng.Float(0.1F, 1.0F), rng.Float(-1.0F, 1.0F)};
+				track_.AddKeyframe(time, glm::angleAxis(rng.Float(0.0F, 3.0F), glm::normalize(axis)));
+			}
+			else {
+				track_.AddKeyframe(
+					time,
+					glm::vec3(rng.Float(-10.0F, 10.0F), rng.Float(-10.0F, 10.0F), rng.Float(-10.0F, 10.0F))
+				);
+			}
+		}
+		step_ = track_.GetDuration() / static_cast<float>(EVALUATIONS);
+	}
+
+	void Run() override {
+		float sum = 0.0F;
+		for (uint32_t i = 0; i < EVALUATIONS; ++i) {
+			sum += std::get<ValueType>(track_.Evaluate(static_cast<float>(i) * step_)).x;
+		}
+		Consume(static_cast<uint64_t>(sum));
+	}
+
+private:
+	AnimationTrack track_;
+	float step_ = 0.0F;
+};
+} // namespace
+
+void RegisterAnimationBenchmarks(Registry& registry) {
+	for (const uint32_t keyframes : {4U, 32U, 256U}) {
+		const std::string suffix = "/" + std::to_string(keyframes);
+		registry.Add<TrackEvaluate<glm::vec3>>(
+			"animation_track_evaluate_vec3_linear" + suffix,
+			{{"keyframes", keyframes}, {"evaluations", EVALUATIONS}},
+			EVALUATIONS,
+			keyframes,
+			InterpolationMode::Linear
+		);
+		registry.Add<TrackEvaluate<glm::quat>>(
+			"animation_track_evaluate_quat_linear" + suffix,
+			{{"keyframes", keyframes}, {"evaluations", EVALUATIONS}},
+			EVALUATIONS,
+			keyframes,
+			InterpolationMode::Linear
+		);
+	}
+}
+
+} // namespace citrus::benchmarks
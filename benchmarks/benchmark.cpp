@@ -0,0 +1,116 @@
+#include "benchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <thread>
+
+namespace citrus::benchmarks {
+
+namespace {
+std::atomic<uint64_t> g_sink{0};
+
+int64_t ElapsedNs(const std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+const char* BuildType() {
+#ifdef NDEBUG
+	return "release";
+#else
+	return "debug";
+#endif
+}
+
+std::string Compiler() {
+#if defined(__clang__)
+	return "clang " __clang_version__;
+#elif defined(__GNUC__)
+	return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+	return "msvc " + std::to_string(_MSC_FULL_VER);
+#else
+	return "unknown";
+#endif
+}
+} // namespace
+
+void Consume(const uint64_t value) { g_sink.fetch_add(value, std::memory_order_relaxed); }
+
+Result RunCase(const Case& benchmark_case, const Options& options) {
+	Result result;
+	result.name = benchmark_case.name;
+	result.params = benchmark_case.params;
+	result.items_per_run = benchmark_case.items_per_run;
+
+	const auto fixture = benchmark_case.make();
+	for (uint32_t i = 0; i < options.warmup; ++i) {
+		fixture->Reset();
+		fixture->Run();
+	}
+
+	result.samples_ns.reserve(options.samples);
+	for (uint32_t i = 0; i < options.samples; ++i) {
+		fixture->Reset();
+		const auto start = std::chrono::steady_clock::now();
+		fixture->Run();
+		result.samples_ns.push_back(ElapsedNs(start));
+	}
+	if (result.samples_ns.empty()) {
+		return result;
+	}
+
+	auto sorted = result.samples_ns;
+	std::ranges::sort(sorted);
+	result.min_ns = sorted.front();
+	result.max_ns = sorted.back();
+	result.median_ns = sorted[sorted.size() / 2];
+
+	const double count = static_cast<double>(sorted.size());
+	result.mean_ns = static_cast<double>(std::accumulate(sorted.begin(), sorted.end(), int64_t{0})) / count;
+	double variance = 0.0;
+	for (const int64_t sample : sorted) {
+		const double delta = static_cast<double>(sample) - result.mean_ns;
+		variance += delta * delta;
+	}
+	result.stddev_ns = std::sqrt(variance / count);
+	return result;
+}
+
+nlohmann::json ToJson(const std::vector<Result>& results, const Options& options) {
+	nlohmann::json report;
+	report["context"] = {
+		{"build_type", BuildType()},
+		{"compiler", Compiler()},
+		{"hardware_threads", std::thread::hardware_concurrency()},
+		{"seed", SEED},
+		{"warmup", options.warmup},
+		{"samples", options.samples}
+	};
+
+	auto& benchmarks = report["benchmarks"];
+	benchmarks = nlohmann::json::array();
+	for (const auto& result : results) {
+		// Throughput from the median keeps one descheduled sample from skewing comparisons
+		const double items_per_second = result.median_ns > 0
+			? static_cast<double>(result.items_per_run) * 1e9 / static_cast<double>(result.median_ns)
+			: 0.0;
+		benchmarks.push_back({
+			{"name", result.name},
+			{"params", result.params},
+			{"items_per_run", result.items_per_run},
+			{"min_ns", result.min_ns},
+			{"median_ns", result.median_ns},
+			{"max_ns", result.max_ns},
+			{"mean_ns", result.mean_ns},
+			{"stddev_ns", result.stddev_ns},
+			{"items_per_second", items_per_second},
+			{"samples_ns", result.samples_ns}
+		});
+	}
+	return report;
+}
+
+} // namespace citrus::benchmarks
@@ -0,0 +1,111 @@
+#pragma once
+
+// Minimal microbenchmark harness for citrus-benchmarks.
+//
+// Each benchmark is a fixture: the constructor builds its data set (untimed), Reset() restores state between
+// samples (untimed) and Run() is the measured body. Data sets come from a fixed-seed generator so every run
+// measures the same work.
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace citrus::benchmarks {
+
+// Seed for every generated data set; change it only together with the stored baselines
+constexpr uint32_t SEED = 0xC17505U;
+
+// Deterministic random source. std::mt19937's output sequence is fixed by the standard, unlike the
+// <random> distributions, so values are derived from it directly to stay identical across toolchains.
+class Rng {
+public:
+	explicit Rng(const uint32_t seed = SEED) : engine_(seed) {}
+
+	float Float(const float min, const float max) {
+		return min + (max - min) * (static_cast<float>(engine_() >> 8) / static_cast<float>(1U << 24));
+	}
+
+	uint32_t Int(const uint32_t max_exclusive) { return engine_() % max_exclusive; }
+
+private:
+	std::mt19937 engine_;
+};
+
+class Fixture {
+public:
+	virtual ~Fixture() = default;
+
+	// Untimed; called before every sample
+	virtual void Reset() {}
+
+	// Timed body
+	virtual void Run() = 0;
+};
+
+struct Case {
+	std::string name;                               // Stable identifier, e.g. "transform_propagation/10000x8"
+	nlohmann::json params;                          // Problem size, recorded in the JSON report
+	uint64_t items_per_run = 1;                     // Work units processed by one Run() (entities, quads, ...)
+	std::function<std::unique_ptr<Fixture>()> make; // Builds the fixture; only called if the case is selected
+};
+
+struct Options {
+	uint32_t warmup = 3;     // Unrecorded runs before sampling
+	uint32_t samples = 25;   // Recorded runs; statistics are taken over these
+	std::string filter;      // Substring a case name must contain to run
+	std::string output_path; // JSON report destination; empty prints a summary only
+};
+
+struct Result {
+	std::string name;
+	nlohmann::json params;
+	uint64_t items_per_run = 1;
+	std::vector<int64_t> samples_ns;
+	int64_t min_ns = 0;
+	int64_t median_ns = 0;
+	int64_t max_ns = 0;
+	double mean_ns = 0.0;
+	double stddev_ns = 0.0;
+};
+
+class Registry {
+public:
+	void Add(Case benchmark_case) { cases_.push_back(std::move(benchmark_case)); }
+
+	template<typename T, typename... Args>
+	void Add(std::string name, nlohmann::json params, const uint64_t items_per_run, Args... args) {
+		Add(Case{
+			.name = std::move(name),
+			.params = std::move(params),
+			.items_per_run = items_per_run,
+			.make = [args...] { return std::unique_ptr<Fixture>(std::make_unique<T>(args...)); }
+		});
+	}
+
+	[[nodiscard]] const std::vector<Case>& Cases() const { return cases_; }
+
+private:
+	std::vector<Case> cases_;
+};
+
+// Keeps a computed value alive so the optimizer cannot drop the work that produced it
+void Consume(uint64_t value);
+
+Result RunCase(const Case& benchmark_case, const Options& options);
+
+nlohmann::json ToJson(const std::vector<Result>& results, const Options& options);
+
+// Per-subsystem registration, one per benchmarks/*_benchmarks.cpp
+void RegisterEcsBenchmarks(Registry& registry);
+void RegisterAnimationBenchmarks(Registry& registry);
+void RegisterGraphBenchmarks(Registry& registry);
+void RegisterUiBenchmarks(Registry& registry);
+void RegisterSceneBenchmarks(Registry& registry);
+void RegisterTilemapBenchmarks(Registry& registry);
+void RegisterRenderBenchmarks(Registry& registry);
+
+} // namespace citrus::benchmarks
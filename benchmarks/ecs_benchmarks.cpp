@@ -0,0 +1,166 @@
+#include <cstdint>
+#include <flecs.h>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+
+import engine.ecs;
+import engine.components;
+import engine.spatial;
+import glm;
+
+using namespace engine::components;
+using namespace engine::ecs;
+using namespace engine::spatial;
+
+namespace citrus::benchmarks {
+
+namespace {
+constexpr float DT = 1.0F / 60.0F;
+
+// entity_count entities in chains of `depth`; every root moves each sample, so the whole forest is recomputed
+class TransformPropagation final : public Fixture {
+public:
+	TransformPropagation(const uint32_t entity_count, const uint32_t depth) {
+		Rng rng;
+		flecs::entity previous;
+		for (uint32_t i = 0; i < entity_count; ++i) {
+			auto entity = ecs_.CreateEntity();
+			if (i % depth == 0) {
+				roots_.push_back(entity);
+			}
+			else {
+				ECSWorld::SetParent(entity, previous);
+			}
+			entity.set<Transform>({
+				.position = {rng.Float(-1.0F, 1.0F), rng.Float(-1.0F, 1.0F), rng.Float(-1.0F, 1.0F)},
+				.rotation = glm::angleAxis(rng.Float(0.0F, glm::two_pi<float>()), glm::vec3(0.0F, 1.0F, 0.0F))
+			});
+			previous = entity;
+		}
+		ecs_.ProgressPostSimulation(DT);
+	}
+
+	void Reset() override {
+		step_ += 1.0F;
+		for (auto root : roots_) {
+			root.set<Transform>({.position = {step_, 0.0F, 0.0F}});
+		}
+	}
+
+	void Run() override {
+		ecs_.ProgressPostSimulation(DT);
+		Consume(static_cast<uint64_t>(roots_.back().get<WorldTransform>().position.x));
+	}
+
+private:
+	ECSWorld ecs_;
+	std::vector<flecs::entity> roots_;
+	float step_ = 0.0F;
+};
+
+// Boxes scattered through a cube; queries are pre-generated so every sample asks the same questions
+class SpatialQueries : public Fixture {
+public:
+	SpatialQueries(const uint32_t object_count, const uint32_t query_count) {
+		Rng rng;
+		const float extent = static_cast<float>(object_count) * 0.05F;
+		for (uint32_t i = 0; i < object_count; ++i) {
+			const glm::vec3 center{
+				rng.Float(-extent, extent), rng.Float(-extent, extent), rng.Float(-extent, extent)
+			};
+			const glm::vec3 half_size{rng.Float(0.25F, 2.0F), rng.Float(0.25F, 2.0F), rng.Float(0.25F, 2.0F)};
+			tree_.Update(i, Aabb::FromCenterExtents(center, half_size), 1U << rng.Int(4));
+		}
+		for (uint32_t i = 0; i < query_count; ++i) {
+			const glm::vec3 origin{
+				rng.Float(-extent, extent), rng.Float(-extent, extent), rng.Float(-extent, extent)
+			};
+			boxes_.push_back(Aabb::FromCenterExtents(origin, glm::vec3(rng.Float(2.0F, 8.0F))));
+			const glm::vec3 direction{rng.Float(-1.0F, 1.0F), rng.Float(-1.0F, 1.0F), rng.Float(-1.0F, 1.0F)};
+			rays_.push_back({
+				.origin = origin,
+				.direction = glm::normalize(direction + glm::vec3(0.0F, 0.0F, 1e-3F)),
+				.max_distance = extent
+			});
+		}
+	}
+
+protected:
+	DynamicAabbTree tree_;
+	std::vector<Aabb> boxes_;
+	std::vector<Ray> rays_;
+};
+
+class SpatialAabbQueries final : public SpatialQueries {
+public:
+	using SpatialQueries::SpatialQueries;
+
+	void Run() override {
+		uint64_t hits = 0;
+		for (const auto& box : boxes_) {
+			ids_.clear();
+			tree_.QueryAabb(box, ALL_LAYERS, ids_);
+			hits += ids_.size();
+		}
+		Consume(hits);
+	}
+
+private:
+	std::vector<DynamicAabbTree::Id> ids_;
+};
+
+class SpatialRayQueries final : public SpatialQueries {
+public:
+	using SpatialQueries::SpatialQueries;
+
+	void Run() override {
+		uint64_t hits = 0;
+		for (const auto& ray : rays_) {
+			hits_.clear();
+			tree_.QueryRay(ray, ALL_LAYERS, hits_);
+			hits += hits_.size();
+		}
+		Consume(hits);
+	}
+
+private:
+	std::vector<DynamicAabbTree::RayHit> hits_;
+};
+} // namespace
+
+void RegisterEcsBenchmarks(Registry& registry) {
+	for (const uint32_t entities : {1000U, 10000U, 50000U}) {
+		for (const uint32_t depth : {1U, 8U}) {
+			registry.Add<TransformPropagation>(
+				"transform_propagation/" + std::to_string(entities) + "x" + std::to_string(depth),
+				{{"entities", entities}, {"depth", depth}},
+				entities,
+				entities,
+				depth
+			);
+		}
+	}
+
+	constexpr uint32_t QUERIES = 1000;
+	for (const uint32_t objects : {1000U, 10000U, 100000U}) {
+		const nlohmann::json params = {{"objects", objects}, {"queries", QUERIES}};
+		registry.Add<SpatialAabbQueries>(
+			"spatial_query_aabb/" + std::to_string(objects),
+			params,
+			QUERIES,
+			objects,
+			QUERIES
+		);
+		registry.Add<SpatialRayQueries>(
+			"spatial_query_ray/" + std::to_string(objects),
+			params,
+			QUERIES,
+			objects,
+			QUERIES
+		);
+	}
+}
+
+} // namespace citrus::benchmarks
@@ -0,0 +1,88 @@
+#include <any>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "benchmark.h"
+
+import engine.graph;
+import glm;
+
+using namespace engine::graph;
+
+namespace citrus::benchmarks {
+
+namespace {
+class AddEvaluator final : public INodeEvaluator {
+public:
+	std::map<int, std::any> Evaluate(const Node& /*node*/, const std::map<int, std::any>& inputs) override {
+		float sum = 0.0F;
+		for (const auto& [pin, value] : inputs) {
+			if (const auto* number = std::any_cast<float>(&value)) {
+				sum += *number;
+			}
+			else if (const auto* pin_value = std::any_cast<PinValue>(&value)) {
+				if (const auto* default_number = std::get_if<float>(pin_value)) {
+					sum += *default_number;
+				}
+			}
+		}
+		return {{0, sum}};
+	}
+};
+
+// Layers of `width` two-input add nodes, each fed by two random nodes of the previous layer
+class GraphEvaluate final : public Fixture {
+public:
+	GraphEvaluate(const uint32_t node_count, const uint32_t width) {
+		Rng rng;
+		std::vector<int> previous_layer;
+		std::vector<int> layer;
+		for (uint32_t i = 0; i < node_count; ++i) {
+			const int id = graph_.AddNode("Add", glm::vec2(0.0F));
+			Node* node = graph_.GetNode(id);
+			node->inputs.emplace_back(0, "A", PinType::Float, PinDirection::Input, 1.0F);
+			node->inputs.emplace_back(1, "B", PinType::Float, PinDirection::Input, 1.0F);
+			node->outputs.emplace_back(2, "Out", PinType::Float, PinDirection::Output);
+			if (!previous_layer.empty()) {
+				graph_.AddLink(previous_layer[rng.Int(static_cast<uint32_t>(previous_layer.size()))], 0, id, 0);
+				graph_.AddLink(previous_layer[rng.Int(static_cast<uint32_t>(previous_layer.size()))], 0, id, 1);
+			}
+			layer.push_back(id);
+			if (layer.size() == width) {
+				previous_layer.swap(layer);
+				layer.clear();
+			}
+		}
+		evaluators_["Add"] = &add_;
+	}
+
+	void Run() override {
+		const auto results = evaluator_.Evaluate(graph_, evaluators_);
+		Consume(results.size());
+	}
+
+private:
+	NodeGraph graph_;
+	GraphEvaluator evaluator_;
+	AddEvaluator add_;
+	std::map<std::string, INodeEvaluator*> evaluators_;
+};
+} // namespace
+
+void RegisterGraphBenchmarks(Registry& registry) {
+	constexpr uint32_t WIDTH = 16;
+	for (const uint32_t nodes : {64U, 256U, 1024U}) {
+		registry.Add<GraphEvaluate>(
+			"graph_evaluate/" + std::to_string(nodes),
+			{{"nodes", nodes}, {"layer_width", WIDTH}},
+			nodes,
+			nodes,
+			WIDTH
+		);
+	}
+}
+
+} // namespace citrus::benchmarks
@@ -0,0 +1,108 @@
+// citrus-benchmarks: reproducible microbenchmarks for engine hot paths
+//
+// Usage: citrus-benchmarks [--filter=<substring>] [--samples=<n>] [--warmup=<n>] [--out=<report.json>] [--list]
+
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "benchmark.h"
+
+import engine.rendering;
+
+using namespace citrus::benchmarks;
+
+namespace {
+bool ParseUint(const std::string_view text, uint32_t& out) {
+	try {
+		out = static_cast<uint32_t>(std::stoul(std::string(text)));
+		return true;
+	}
+	catch (const std::exception&) {
+		return false;
+	}
+}
+} // namespace
+
+int main(const int argc, char** argv) {
+	Options options;
+	bool list_only = false;
+	for (int i = 1; i < argc; ++i) {
+		const std::string_view arg = argv[i];
+		bool valid = true;
+		if (arg.starts_with("--filter=")) {
+			options.filter = arg.substr(9);
+		}
+		else if (arg.starts_with("--samples=")) {
+			valid = ParseUint(arg.substr(10), options.samples);
+		}
+		else if (arg.starts_with("--warmup=")) {
+			valid = ParseUint(arg.substr(9), options.warmup);
+		}
+		else if (arg.starts_with("--out=")) {
+			options.output_path = arg.substr(6);
+		}
+		else if (arg == "--list") {
+			list_only = true;
+		}
+		else {
+			valid = false;
+		}
+		if (!valid) {
+			std::cerr << "Unknown or malformed argument: " << arg << '\n'
+					  << "Usage: citrus-benchmarks [--filter=<substring>] [--samples=<n>] [--warmup=<n>] "
+						 "[--out=<report.json>] [--list]\n";
+			return 2;
+		}
+	}
+
+	// Everything here is CPU-side work; resource managers keep their bookkeeping without touching GL. Render
+	// benchmarks switch headless off for their lifetime and draw into the null device instead.
+	engine::rendering::SetHeadless(true);
+
+	Registry registry;
+	RegisterEcsBenchmarks(registry);
+	RegisterAnimationBenchmarks(registry);
+	RegisterGraphBenchmarks(registry);
+	RegisterUiBenchmarks(registry);
+	RegisterSceneBenchmarks(registry);
+	RegisterTilemapBenchmarks(registry);
+	RegisterRenderBenchmarks(registry);
+
+	std::vector<Result> results;
+	for (const auto& benchmark_case : registry.Cases()) {
+		if (!options.filter.empty() && !benchmark_case.name.contains(options.filter)) {
+			continue;
+		}
+		if (list_only) {
+			std::cout << benchmark_case.name << '\n';
+			continue;
+		}
+
+		const auto& result = results.emplace_back(RunCase(benchmark_case, options));
+		std::printf(
+			"%-48s median %12.3f us   min %12.3f us   stddev %10.3f us\n",
+			result.name.c_str(),
+			static_cast<double>(result.median_ns) / 1000.0,
+			static_cast<double>(result.min_ns) / 1000.0,
+			result.stddev_ns / 1000.0
+		);
+		std::fflush(stdout);
+	}
+
+	if (!options.output_path.empty() && !list_only) {
+		std::ofstream file(options.output_path, std::ios::trunc);
+		if (!file) {
+			std::cerr << "Failed to open " << options.output_path << " for writing\n";
+			return 1;
+		}
+		file << ToJson(results, options).dump(2) << '\n';
+		std::cout << "Wrote " << results.size() << " results to " << options.output_path << '\n';
+	}
+	return 0;
+}
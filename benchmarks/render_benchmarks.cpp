@@ -0,0 +1,124 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+
+import engine.rendering;
+import glm;
+
+using namespace engine::rendering;
+
+namespace citrus::benchmarks {
+
+namespace {
+constexpr auto VERTEX_SOURCE = R"(#version 300 es
+layout(location = 0) in vec3 a_Position;
+uniform mat4 u_MVP;
+void main() { gl_Position = u_MVP * vec4(a_Position, 1.0); }
+)";
+
+constexpr auto FRAGMENT_SOURCE = R"(#version 300 es
+precision mediump float;
+out vec4 FragColor;
+void main() { FragColor = vec4(1.0); }
+)";
+
+// Drives the renderer's real GL paths against the null device, so the timing covers the CPU side of submission
+// (uniforms, state cache, instance uploads) with no driver underneath
+class RenderSubmitCubes final : public Fixture {
+public:
+	RenderSubmitCubes(const uint32_t count, const bool instanced) : instanced_(instanced) {
+		InstallNullDevice();
+		SetHeadless(false);
+		command_.shader =
+			renderer_.GetShaderManager().LoadShaderFromString("benchmark", VERTEX_SOURCE, FRAGMENT_SOURCE);
+		command_.mesh = renderer_.GetMeshManager().CreateCube();
+		command_.material = INVALID_MATERIAL;
+		command_.camera_view = glm::lookAt(glm::vec3(0.0F, 0.0F, 50.0F), glm::vec3(0.0F), glm::vec3(0.0F, 1.0F, 0.0F));
+
+		Rng rng;
+		instances_.reserve(count);
+		for (uint32_t i = 0; i < count; ++i) {
+			const glm::mat4 model = glm::translate(glm::mat4(1.0F), glm::vec3(rng.Float(-20.0F, 20.0F), 0.0F, 0.0F));
+			instances_.push_back({.model = model, .normal_matrix = glm::transpose(glm::inverse(model))});
+		}
+	}
+
+	~RenderSubmitCubes() override { SetHeadless(true); }
+
+	void Reset() override { ResetNullDeviceStats(); }
+
+	void Run() override {
+		renderer_.BeginFrame();
+		if (instanced_) {
+			renderer_.SubmitInstancedRenderCommand(command_, instances_);
+		}
+		else {
+			for (const auto& instance : instances_) {
+				command_.transform = instance.model;
+				renderer_.SubmitRenderCommand(command_);
+			}
+		}
+		Consume(GetNullDeviceStats().draw_calls);
+	}
+
+private:
+	Renderer renderer_;
+	RenderCommand command_;
+	std::vector<InstanceData> instances_;
+	bool instanced_;
+};
+
+// count small point lights scattered through the first 100 units in front of the camera, binned into the view
+// clusters each run
+class LightClusterAssign final : public Fixture {
+public:
+	explicit LightClusterAssign(const uint32_t count) {
+		clusters_.SetProjection(glm::perspective(glm::radians(60.0F), 16.0F / 9.0F, 0.1F, 1000.0F), 0.1F, 1000.0F);
+		Rng rng;
+		lights_.reserve(count);
+		for (uint32_t i = 0; i < count; ++i) {
+			const float distance = rng.Float(1.0F, 100.0F);
+			lights_.push_back({
+				.position = {rng.Float(-0.5F, 0.5F) * distance, rng.Float(-0.3F, 0.3F) * distance, -distance},
+				.range = rng.Float(1.0F, 8.0F),
+				.index = i
+			});
+		}
+	}
+
+	void Run() override {
+		clusters_.Assign(lights_, glm::mat4(1.0F));
+		Consume(clusters_.GetLightIndices().size());
+	}
+
+private:
+	LightClusters clusters_;
+	std::vector<ClusterLight> lights_;
+};
+} // namespace
+
+void RegisterRenderBenchmarks(Registry& registry) {
+	for (const uint32_t count : {64U, 256U}) {
+		registry.Add<LightClusterAssign>(
+			"light_cluster_assign/" + std::to_string(count),
+			{{"lights", count}},
+			count,
+			count
+		);
+	}
+	for (const uint32_t count : {1000U, 10000U}) {
+		for (const bool instanced : {false, true}) {
+			registry.Add<RenderSubmitCubes>(
+				std::string(instanced ? "render_submit_instanced/" : "render_submit/") + std::to_string(count),
+				{{"objects", count}, {"instanced", instanced}},
+				count,
+				count,
+				instanced
+			);
+		}
+	}
+}
+
+} // namespace citrus::benchmarks
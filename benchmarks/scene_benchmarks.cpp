@@ -0,0 +1,89 @@
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include "benchmark.h"
+
+import engine.ecs;
+import engine.components;
+import engine.platform;
+import engine.scene;
+import glm;
+
+using namespace engine;
+using namespace engine::components;
+using namespace engine::scene;
+
+namespace citrus::benchmarks {
+
+namespace {
+// A scene of entity_count named entities, grouped under parents four at a time, saved once to a temp file
+class SceneFixture : public Fixture {
+public:
+	explicit SceneFixture(const uint32_t entity_count) :
+			manager_(std::make_unique<SceneManager>(ecs_)),
+			path_(std::filesystem::temp_directory_path() / "citrus_benchmark_scene.json") {
+		Rng rng;
+		scene_id_ = manager_->CreateScene("BenchmarkScene");
+		const auto& scene = manager_->GetScene(scene_id_);
+		ecs::Entity parent;
+		for (uint32_t i = 0; i < entity_count; ++i) {
+			const std::string name = "Entity" + std::to_string(i);
+			const auto entity = i % 4 == 0 ? scene.CreateEntity(name) : scene.CreateEntity(name, parent);
+			entity.set<Transform>({
+				.position = {rng.Float(-50.0F, 50.0F), rng.Float(-50.0F, 50.0F), rng.Float(-50.0F, 50.0F)},
+				.scale = glm::vec3(rng.Float(0.5F, 2.0F))
+			});
+			if (i % 4 == 0) {
+				parent = entity;
+			}
+		}
+		SceneSerializer::Save(scene, ecs_, path_);
+	}
+
+	~SceneFixture() override { std::filesystem::remove(path_); }
+
+protected:
+	ecs::ECSWorld ecs_;
+	std::unique_ptr<SceneManager> manager_;
+	platform::fs::Path path_;
+	SceneId scene_id_ = INVALID_SCENE;
+};
+
+class SceneSave final : public SceneFixture {
+public:
+	using SceneFixture::SceneFixture;
+
+	void Run() override { Consume(SceneSerializer::Save(manager_->GetScene(scene_id_), ecs_, path_) ? 1 : 0); }
+};
+
+class SceneLoad final : public SceneFixture {
+public:
+	using SceneFixture::SceneFixture;
+
+	void Reset() override {
+		if (loaded_id_ != INVALID_SCENE) {
+			manager_->DestroyScene(loaded_id_);
+			loaded_id_ = INVALID_SCENE;
+		}
+	}
+
+	void Run() override {
+		loaded_id_ = SceneSerializer::Load(path_, *manager_, ecs_);
+		Consume(loaded_id_);
+	}
+
+private:
+	SceneId loaded_id_ = INVALID_SCENE;
+};
+} // namespace
+
+void RegisterSceneBenchmarks(Registry& registry) {
+	for (const uint32_t entities : {100U, 1000U, 5000U}) {
+		registry.Add<SceneSave>("scene_save/" + std::to_string(entities), {{"entities", entities}}, entities, entities);
+		registry.Add<SceneLoad>("scene_load/" + std::to_string(entities), {{"entities", entities}}, entities, entities);
+	}
+}
+
+} // namespace citrus::benchmarks
@@ -0,0 +1,95 @@
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "benchmark.h"
+
+import engine.assets;
+import engine.components;
+import engine.rendering;
+import glm;
+
+using namespace engine;
+using namespace engine::rendering;
+
+namespace citrus::benchmarks {
+
+namespace {
+constexpr uint32_t TILESET_COLUMNS = 8;
+
+// A layers-deep map of size x size cells drawing from an 8x8 tileset; roughly a third of upper-layer cells are
+// empty, as decoration layers usually are
+class TilemapBuildBatches final : public Fixture {
+public:
+	TilemapBuildBatches(const uint32_t size, const uint32_t layers) {
+		auto tileset = std::make_shared<assets::Tileset>();
+		tileset->SetImagePath(CITRUS_BENCHMARK_ASSETS_DIR "/images/tiles.png");
+		constexpr float uv_step = 1.0F / static_cast<float>(TILESET_COLUMNS);
+		for (uint32_t id = 0; id < TILESET_COLUMNS * TILESET_COLUMNS; ++id) {
+			const glm::vec2 uv{
+				static_cast<float>(id % TILESET_COLUMNS) * uv_step, static_cast<float>(id / TILESET_COLUMNS) * uv_step
+			};
+			tileset->AddTile(id, glm::vec4(uv, uv_step, uv_step));
+		}
+
+		Rng rng;
+		for (uint32_t layer_index = 0; layer_index < layers; ++layer_index) {
+			auto& layer = *tilemap_.GetLayer(tilemap_.AddLayer());
+			layer.SetTileset(tileset);
+			for (uint32_t y = 0; y < size; ++y) {
+				for (uint32_t x = 0; x < size; ++x) {
+					if (layer_index > 0 && rng.Int(3) == 0) {
+						continue;
+					}
+					layer.SetTile(
+						static_cast<int32_t>(x),
+						static_cast<int32_t>(y),
+						rng.Int(TILESET_COLUMNS * TILESET_COLUMNS)
+					);
+				}
+			}
+		}
+		renderer_.SetMaxBatchSize(static_cast<size_t>(size) * size);
+	}
+
+	void Run() override {
+		const auto& texture_manager = GetRenderer().GetTextureManager();
+		size_t vertices = 0;
+		int layer_index = 0;
+		for (const auto& layer : tilemap_.layers) {
+			batch_.Clear();
+			renderer_.BuildLayerBatch(
+				layer,
+				tilemap_.tile_size,
+				tilemap_.grid_offset,
+				batch_,
+				texture_manager,
+				layer_index++,
+				0.01F
+			);
+			vertices += batch_.vertices.size();
+		}
+		Consume(vertices);
+	}
+
+private:
+	components::Tilemap tilemap_;
+	TilemapRenderer renderer_;
+	TileBatch batch_;
+};
+} // namespace
+
+void RegisterTilemapBenchmarks(Registry& registry) {
+	constexpr uint32_t LAYERS = 3;
+	for (const uint32_t size : {32U, 128U}) {
+		registry.Add<TilemapBuildBatches>(
+			"tilemap_build_batches/" + std::to_string(size) + "x" + std::to_string(size),
+			{{"width", size}, {"height", size}, {"layers", LAYERS}},
+			static_cast<uint64_t>(size) * size * LAYERS,
+			size,
+			LAYERS
+		);
+	}
+}
+
+} // namespace citrus::benchmarks
@@ -0,0 +1,119 @@
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+
+import engine.ui;
+import engine.ui.batch_renderer;
+
+using namespace engine::ui::batch_renderer;
+using namespace engine::ui::text_renderer;
+
+namespace citrus::benchmarks {
+
+namespace {
+// Quad rects and colors are generated up front so only SubmitQuad's vertex/index generation is timed
+class BatchSubmitQuads final : public Fixture {
+public:
+	BatchSubmitQuads(const uint32_t quad_count, const uint32_t texture_count) {
+		Rng rng;
+		for (uint32_t i = 0; i < quad_count; ++i) {
+			quads_.push_back({
+				.rect = Rectangle(rng.Float(0.0F, 1900.0F), rng.Float(0.0F, 1060.0F), 20.0F, 20.0F),
+				.color = Color(rng.Float(0.0F, 1.0F), rng.Float(0.0F, 1.0F), rng.Float(0.0F, 1.0F)),
+				// Headless textures are bookkeeping only, so any nonzero ID stands in for a real one
+				.texture_id = texture_count > 0 ? 1000 + rng.Int(texture_count) : 0
+			});
+		}
+	}
+
+	~BatchSubmitQuads() override { BatchRenderer::EndFrame(); }
+
+	void Reset() override {
+		BatchRenderer::EndFrame();
+		BatchRenderer::BeginFrame();
+	}
+
+	void Run() override {
+		for (const auto& quad : quads_) {
+			BatchRenderer::SubmitQuad(quad.rect, quad.color, std::nullopt, quad.texture_id);
+		}
+		Consume(BatchRenderer::GetPendingVertexCount());
+	}
+
+private:
+	struct Quad {
+		Rectangle rect;
+		Color color;
+		uint32_t texture_id = 0;
+	};
+	std::vector<Quad> quads_;
+};
+
+// Pseudo-random words with a hard line break every 40 words
+std::string MakeParagraph(const uint32_t word_count) {
+	constexpr std::array<const char*, 12> words{
+		"citrus", "engine", "layout", "glyph", "wrap", "the", "of", "benchmark", "text", "a", "renderer", "UI"
+	};
+	Rng rng;
+	std::string text;
+	for (uint32_t i = 0; i < word_count; ++i) {
+		if (i > 0) {
+			text += (i % 40 == 0) ? '\n' : ' ';
+		}
+		text += words[rng.Int(static_cast<uint32_t>(words.size()))];
+	}
+	return text;
+}
+
+// Word-wrapped, centered paragraph laid out with the bundled font
+class TextLayoutParagraph final : public Fixture {
+public:
+	TextLayoutParagraph(const uint32_t word_count, const float max_width) :
+			font_(std::make_unique<FontAtlas>(CITRUS_BENCHMARK_ASSETS_DIR "/fonts/Kenney Future.ttf", 16)),
+			text_(MakeParagraph(word_count)) {
+		options_.h_align = HorizontalAlign::Center;
+		options_.max_width = max_width;
+	}
+
+	void Run() override {
+		const auto glyphs = TextLayout::Layout(text_, *font_, options_);
+		Consume(glyphs.size());
+	}
+
+private:
+	std::unique_ptr<FontAtlas> font_;
+	std::string text_;
+	LayoutOptions options_;
+};
+} // namespace
+
+void RegisterUiBenchmarks(Registry& registry) {
+	for (const uint32_t quads : {1000U, 10000U}) {
+		for (const uint32_t textures : {0U, 4U, 16U}) {
+			registry.Add<BatchSubmitQuads>(
+				"batch_submit_quad/" + std::to_string(quads) + "/textures:" + std::to_string(textures),
+				{{"quads", quads}, {"textures", textures}},
+				quads,
+				quads,
+				textures
+			);
+		}
+	}
+
+	for (const uint32_t words : {50U, 500U}) {
+		registry.Add<TextLayoutParagraph>(
+			"text_layout/" + std::to_string(words) + "_words",
+			{{"words", words}, {"font_size", 16}, {"max_width", 400.0F}},
+			MakeParagraph(words).size(),
+			words,
+			400.0F
+		);
+	}
+}
+
+} // namespace citrus::benchmarks
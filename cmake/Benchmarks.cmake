@@ -0,0 +1,16 @@
+# Microbenchmark suite (citrus-benchmarks)
+
+option(BUILD_BENCHMARKS "Build the citrus-benchmarks microbenchmark suite" OFF)
+
+# Only set up benchmarks if this is the main project
+if (CMAKE_PROJECT_NAME STREQUAL PROJECT_NAME)
+    if (BUILD_BENCHMARKS AND NOT EMSCRIPTEN)
+        message(STATUS "Benchmarks enabled - citrus-benchmarks will be built")
+        if (NOT CMAKE_BUILD_TYPE STREQUAL "Release" AND NOT CMAKE_CONFIGURATION_TYPES)
+            message(WARNING "Benchmarks are configured with CMAKE_BUILD_TYPE='${CMAKE_BUILD_TYPE}'; use Release for meaningful numbers")
+        endif ()
+        add_subdirectory(benchmarks)
+    else ()
+        message(STATUS "Benchmarks disabled")
+    endif ()
+endif ()
@@ -20,6 +20,9 @@ install(TARGETS engine-core
     FILE_SET CXX_MODULES DESTINATION include/citrus-engine
 )
 
+# Install the profiler macro header (modules can't export macros)
+install(FILES src/engine/platform/profiler.h DESTINATION include/platform)
+
 # Install assets (configurable location) only if the assets directory exists
 if (EXISTS "${CMAKE_SOURCE_DIR}/assets")
     install(DIRECTORY assets/
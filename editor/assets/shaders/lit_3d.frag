@@ -15,23 +15,29 @@ uniform vec4 u_Color;
 uniform float u_Shininess;
 uniform sampler2D u_Texture;
 
-// Camera position
-uniform vec3 u_CameraPos;
+// Per-frame camera and lights, shared by every draw (see engine::rendering::SceneUniforms)
+#define MAX_LIGHTS 256
 
-// Light properties (supporting up to 4 lights)
-#define MAX_LIGHTS 4
+// Light cluster grid (see engine::rendering::LightClusters)
+#define CLUSTER_GRID_X 16
+#define CLUSTER_GRID_Y 9
+#define CLUSTER_GRID_Z 24
+#define LIGHT_INDEX_TEXTURE_WIDTH 1024u
 
-uniform int u_NumLights;
-uniform int u_LightTypes[MAX_LIGHTS];        // 0 = directional, 1 = point, 2 = spot
-uniform vec3 u_LightPositions[MAX_LIGHTS];   // Position for point/spot, direction for directional
-uniform vec3 u_LightColors[MAX_LIGHTS];
-uniform float u_LightIntensities[MAX_LIGHTS];
-uniform float u_LightRanges[MAX_LIGHTS];     // Range for point/spot lights
-uniform float u_LightAttenuations[MAX_LIGHTS]; // Attenuation factor
+layout(std140) uniform SceneUniforms {
+    vec4 u_CameraPos;                   // xyz
+    vec4 u_Ambient;                     // rgb color, a intensity
+    ivec4 u_LightCount;                 // x directional lights (stored first), y all lights
+    vec4 u_LightPositions[MAX_LIGHTS];  // xyz position (direction for directional), w type: 0 dir, 1 point, 2 spot
+    vec4 u_LightColors[MAX_LIGHTS];     // rgb color, a intensity
+    vec4 u_LightParams[MAX_LIGHTS];     // x range, y attenuation
+    highp vec4 u_ClusterDepth;          // x near plane, y far plane, z slice scale, w slice bias
+    highp vec4 u_ClusterScreen;         // xy clusters per pixel
+};
 
-// Ambient lighting
-uniform vec3 u_AmbientColor;
-uniform float u_AmbientIntensity;
+// Point and spot lights per cluster: one texel per cluster holding (offset, count) into the light index list
+uniform highp usampler2D u_LightGrid;
+uniform highp usampler2D u_LightIndices;
 
 // Calculate Blinn-Phong lighting for a single light
 vec3 CalculateLight(
@@ -77,12 +83,28 @@ vec3 CalculateLight(
     return (diffuse + specular) * attenuation;
 }
 
+// Light i of the SceneUniforms arrays
+vec3 ShadeLight(int i, vec3 normal, vec3 viewDir) {
+    return CalculateLight(
+        int(u_LightPositions[i].w),
+        u_LightPositions[i].xyz,
+        u_LightColors[i].rgb,
+        u_LightColors[i].a,
+        u_LightParams[i].x,
+        u_LightParams[i].y,
+        normal,
+        vWorldPos,
+        viewDir,
+        u_Shininess
+    );
+}
+
 void main() {
     // Normalize interpolated normal
     vec3 normal = normalize(vNormal);
     
     // Calculate view direction
-    vec3 viewDir = normalize(u_CameraPos - vWorldPos);
+    vec3 viewDir = normalize(u_CameraPos.xyz - vWorldPos);
     
     // Sample texture
     vec4 texColor = texture(u_Texture, vUV);
@@ -91,25 +113,29 @@ void main() {
     vec4 baseColor = texColor * u_Color * vColor;
     
     // Ambient lighting
-    vec3 ambient = u_AmbientColor * u_AmbientIntensity;
+    vec3 ambient = u_Ambient.rgb * u_Ambient.a;
     
-    // Accumulate lighting from all lights
+    // Directional lights reach every fragment
     vec3 lighting = ambient;
-    for (int i = 0; i < MAX_LIGHTS; i++) {
-        if (i >= u_NumLights) break;
-        
-        lighting += CalculateLight(
-            u_LightTypes[i],
-            u_LightPositions[i],
-            u_LightColors[i],
-            u_LightIntensities[i],
-            u_LightRanges[i],
-            u_LightAttenuations[i],
-            normal,
-            vWorldPos,
-            viewDir,
-            u_Shininess
-        );
+    for (int i = 0; i < u_LightCount.x; i++) {
+        lighting += ShadeLight(i, normal, viewDir);
+    }
+
+    // Point and spot lights come from this fragment's cluster: screen tile plus exponential depth slice
+    highp float near = u_ClusterDepth.x;
+    highp float far = u_ClusterDepth.y;
+    highp float viewDepth = 2.0 * near * far / (far + near - (gl_FragCoord.z * 2.0 - 1.0) * (far - near));
+    int slice = clamp(int(log(viewDepth) * u_ClusterDepth.z + u_ClusterDepth.w), 0, CLUSTER_GRID_Z - 1);
+    ivec2 tile = clamp(
+        ivec2(gl_FragCoord.xy * u_ClusterScreen.xy),
+        ivec2(0),
+        ivec2(CLUSTER_GRID_X - 1, CLUSTER_GRID_Y - 1)
+    );
+    highp uvec2 cluster = texelFetch(u_LightGrid, ivec2(tile.y * CLUSTER_GRID_X + tile.x, slice), 0).rg;
+    for (highp uint i = 0u; i < cluster.y; i++) {
+        highp uint entry = cluster.x + i;
+        ivec2 texel = ivec2(entry % LIGHT_INDEX_TEXTURE_WIDTH, entry / LIGHT_INDEX_TEXTURE_WIDTH);
+        lighting += ShadeLight(int(texelFetch(u_LightIndices, texel, 0).r), normal, viewDir);
     }
     
     // Final color
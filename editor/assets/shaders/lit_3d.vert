@@ -6,10 +6,16 @@ layout(location = 1) in vec3 aNormal;
 layout(location = 2) in vec2 aUV;
 layout(location = 3) in vec4 aColor;
 
+// Per-instance attributes, only read when u_Instanced is set (see engine::rendering::InstanceData)
+layout(location = 4) in mat4 aInstanceModel;
+layout(location = 8) in mat4 aInstanceNormalMatrix;
+
 // Uniforms
 uniform mat4 u_Model;
 uniform mat4 u_MVP;
 uniform mat4 u_NormalMatrix;
+uniform mat4 u_ViewProjection;
+uniform bool u_Instanced;
 
 // Outputs to fragment shader
 out vec3 vWorldPos;
@@ -18,12 +24,15 @@ out vec2 vUV;
 out vec4 vColor;
 
 void main() {
+    mat4 model = u_Instanced ? aInstanceModel : u_Model;
+    mat4 normalMatrix = u_Instanced ? aInstanceNormalMatrix : u_NormalMatrix;
+
     // Transform position to world space
-    vec4 worldPos = u_Model * vec4(aPos, 1.0);
+    vec4 worldPos = model * vec4(aPos, 1.0);
     vWorldPos = worldPos.xyz;
     
     // Transform normal to world space (using normal matrix to handle non-uniform scaling)
-    vNormal = mat3(u_NormalMatrix) * aNormal;
+    vNormal = mat3(normalMatrix) * aNormal;
     
     // Pass UV coordinates
     vUV = aUV;
@@ -32,5 +41,5 @@ void main() {
     vColor = aColor;
     
     // Transform to clip space
-    gl_Position = u_MVP * vec4(aPos, 1.0);
+    gl_Position = u_Instanced ? u_ViewProjection * worldPos : u_MVP * vec4(aPos, 1.0);
 }
@@ -149,8 +149,8 @@ private:
 	int dragging_axis_ = -1; // -1=none, 0=X, 1=Y, 2=Z
 	ImVec2 drag_start_mouse_{};
 	glm::vec3 drag_start_position_{};
-	glm::vec3 drag_start_rotation_{};              // For rotation gizmo
-	glm::vec3 drag_start_scale_{1.0f, 1.0f, 1.0f}; // For scale gizmo
+	glm::quat drag_start_rotation_{1.0f, 0.0f, 0.0f, 0.0f}; // For rotation gizmo
+	glm::vec3 drag_start_scale_{1.0f, 1.0f, 1.0f};          // For scale gizmo
 	ImVec2 drag_axis_screen_dir_{};
 	float drag_world_per_pixel_ = 0.0f;
 	float drag_start_angle_ = 0.0f; // For rotation gizmo
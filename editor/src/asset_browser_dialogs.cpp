@@ -246,7 +246,7 @@ void AssetBrowserPanel::CreateNewSceneFile() {
 
 		// Create default scene JSON content
 		json scene_doc;
-		scene_doc["version"] = 1;
+		scene_doc["version"] = engine::scene::SCENE_FORMAT_VERSION;
 		scene_doc["name"] = new_scene.stem().stem().string(); // Remove .scene.json to get base name
 
 		// Metadata
@@ -296,7 +296,7 @@ void AssetBrowserPanel::CreateNewPrefabFile() {
 
 		// Create default prefab JSON content
 		json prefab_doc;
-		prefab_doc["version"] = 1;
+		prefab_doc["version"] = engine::scene::PREFAB_FORMAT_VERSION;
 		prefab_doc["name"] = new_prefab.stem().stem().string(); // Remove .prefab.json to get base name
 
 		// Empty entity data (single entity with just a name)
@@ -335,6 +335,7 @@ void EditorScene::RenderUI(engine::Engine& engine) {
 		if (ImGui::Button("Ok", ImVec2(120, 0)) && selected_entity_.set_name(rename_entity_buffer_)) {
 			auto& scene_entity = selected_entity_.get_mut<engine::ecs::SceneEntity>();
 			scene_entity.name = std::string(rename_entity_buffer_);
+			selected_entity_.modified<engine::ecs::SceneEntity>();
 			rename_entity_buffer_[0] = '\0';
 			// Note: Renaming doesn't go through command history yet (would need a RenameEntityCommand)
 			// Mark scene as modified
@@ -10,6 +10,7 @@
 #include "file_dialog.h"
 
 import engine;
+import glm;
 
 namespace editor {
 
@@ -85,6 +86,18 @@ bool RenderFieldWidget(const engine::ecs::FieldInfo& field, void* data, engine::
 
 	case engine::ecs::FieldType::Vec4: return ImGui::InputFloat4(label, static_cast<float*>(data));
 
+	case engine::ecs::FieldType::Quat:
+	{
+		// Stored as a quaternion; edited as euler angles in degrees for usability
+		auto* rotation = static_cast<glm::quat*>(data);
+		glm::vec3 euler = glm::degrees(glm::eulerAngles(*rotation));
+		if (ImGui::InputFloat3(label, &euler[0])) {
+			*rotation = glm::quat(glm::radians(euler));
+			return true;
+		}
+		return false;
+	}
+
 	case engine::ecs::FieldType::Color: return ImGui::ColorEdit4(label, static_cast<float*>(data));
 
 	case engine::ecs::FieldType::ReadOnly: ImGui::Text("%s: (read-only)", label); return false;
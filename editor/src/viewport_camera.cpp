@@ -83,7 +83,7 @@ void ViewportPanel::HandleCameraInput(const flecs::entity editor_camera, const f
 
 	// Update transform rotation and camera target
 	if (camera_dirty) {
-		transform.rotation = glm::eulerAngles(camera_orientation_);
+		transform.rotation = camera_orientation_;
 		editor_camera.modified<engine::components::Transform>();
 
 		if (editor_camera.has<engine::components::Camera>()) {
@@ -80,9 +80,9 @@ void ViewportPanel::RenderTranslateGizmo(
 
 	// Determine axis directions based on gizmo space (local or world)
 	glm::vec3 axes[3];
-	if (gizmo_space_ == GizmoSpace::Local && entity_transform.rotation != glm::vec3(0.0f)) {
+	if (gizmo_space_ == GizmoSpace::Local && entity_transform.rotation != glm::quat(1.0f, 0.0f, 0.0f, 0.0f)) {
 		// Local space: transform axes by entity's rotation
-		const glm::quat entity_quat = glm::quat(entity_transform.rotation);
+		const glm::quat& entity_quat = entity_transform.rotation;
 		axes[0] = entity_quat * glm::vec3(axis_world_len, 0.0f, 0.0f);
 		axes[1] = entity_quat * glm::vec3(0.0f, axis_world_len, 0.0f);
 		axes[2] = entity_quat * glm::vec3(0.0f, 0.0f, axis_world_len);
@@ -159,9 +159,9 @@ void ViewportPanel::RenderTranslateGizmo(
 
 			// Compute axis direction in world space
 			glm::vec3 axis_dir(0.0f);
-			if (gizmo_space_ == GizmoSpace::Local && drag_start_rotation_ != glm::vec3(0.0f)) {
+			if (gizmo_space_ == GizmoSpace::Local && drag_start_rotation_ != glm::quat(1.0f, 0.0f, 0.0f, 0.0f)) {
 				// Local space: axis is rotated by entity's rotation at drag start
-				const glm::quat entity_quat = glm::quat(drag_start_rotation_);
+				const glm::quat& entity_quat = drag_start_rotation_;
 				glm::vec3 local_axis(0.0f);
 				local_axis[dragging_axis_] = 1.0f;
 				axis_dir = entity_quat * local_axis;
@@ -248,9 +248,9 @@ void ViewportPanel::RenderRotationGizmo(
 
 	// Define rotation plane normals (axes of rotation) - in local or world space
 	glm::vec3 rotation_axes[3];
-	if (gizmo_space_ == GizmoSpace::Local && entity_transform.rotation != glm::vec3(0.0f)) {
+	if (gizmo_space_ == GizmoSpace::Local && entity_transform.rotation != glm::quat(1.0f, 0.0f, 0.0f, 0.0f)) {
 		// Local space: rotate axes by entity's rotation
-		const glm::quat entity_quat = glm::quat(entity_transform.rotation);
+		const glm::quat& entity_quat = entity_transform.rotation;
 		rotation_axes[0] = entity_quat * glm::vec3(1.0f, 0.0f, 0.0f); // X axis
 		rotation_axes[1] = entity_quat * glm::vec3(0.0f, 1.0f, 0.0f); // Y axis
 		rotation_axes[2] = entity_quat * glm::vec3(0.0f, 0.0f, 1.0f); // Z axis
@@ -357,9 +357,9 @@ void ViewportPanel::RenderRotationGizmo(
 			// Apply rotation to entity
 			auto& transform = selected_entity.get_mut<engine::components::Transform>();
 			const glm::quat rotation_quat = glm::angleAxis(angle_delta, axis_normal);
-			const glm::quat start_quat = glm::quat(drag_start_rotation_);
+			const glm::quat& start_quat = drag_start_rotation_;
 			const glm::quat new_quat = rotation_quat * start_quat;
-			transform.rotation = glm::eulerAngles(new_quat);
+			transform.rotation = glm::normalize(new_quat);
 			selected_entity.modified<engine::components::Transform>();
 		}
 		else {
@@ -444,9 +444,9 @@ void ViewportPanel::RenderScaleGizmo(
 
 	// Determine axis directions based on gizmo space (local or world)
 	glm::vec3 axes[3];
-	if (gizmo_space_ == GizmoSpace::Local && entity_transform.rotation != glm::vec3(0.0f)) {
+	if (gizmo_space_ == GizmoSpace::Local && entity_transform.rotation != glm::quat(1.0f, 0.0f, 0.0f, 0.0f)) {
 		// Local space: transform axes by entity's rotation
-		const glm::quat entity_quat = glm::quat(entity_transform.rotation);
+		const glm::quat& entity_quat = entity_transform.rotation;
 		axes[0] = entity_quat * glm::vec3(axis_world_len, 0.0f, 0.0f);
 		axes[1] = entity_quat * glm::vec3(0.0f, axis_world_len, 0.0f);
 		axes[2] = entity_quat * glm::vec3(0.0f, 0.0f, axis_world_len);
@@ -15,7 +15,13 @@ uniform sampler2D u_Textures[8];
 void main() {
     // Sample from the correct texture based on texture index
     vec4 texColor;
-    int texIdx = int(vTexIndex + 0.5);// Round to nearest int
+    int texIdx = int(vTexIndex + 0.5); // Round to nearest int
+
+    // Slots 8-15 are slots 0-7 holding a signed distance field (BatchRenderer::SubmitSdfQuad)
+    bool isSdf = texIdx >= 8;
+    if (isSdf) {
+        texIdx -= 8;
+    }
 
     // Manual texture selection (GLSL ES doesn't support dynamic indexing easily)
     if (texIdx == 0) {
@@ -36,6 +42,15 @@ void main() {
         texColor = texture(u_Textures[7], vTexCoord);
     }
 
+    if (isSdf) {
+        // Alpha is distance to the outline (0.5 on it); blend over about one screen pixel at any scale
+        float dist = texColor.a;
+        float edge = max(fwidth(dist), 0.0001);
+        float coverage = smoothstep(0.5 - edge, 0.5 + edge, dist);
+        FragColor = vec4(vColor.rgb, vColor.a * coverage);
+        return;
+    }
+
     // Multiply texture by vertex color (standard)
     FragColor = texColor * vColor;
 }
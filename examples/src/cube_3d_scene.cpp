@@ -94,19 +94,19 @@ public:
 
 		auto& cube_pos = cube_entity_.get_mut<Transform>();
 		auto& position_ = cube_pos.position;
-		auto& rotation_ = cube_pos.rotation;
+		const glm::vec3 rotation = cube_pos.GetEulerAngles();
 		float scale_ = cube_pos.scale.x; // Uniform scale
 
 		ImGui::Text("Transform:");
 		ImGui::Text("Position: (%.1f, %.1f, %.1f)", position_.x, position_.y, position_.z);
-		ImGui::Text("Rotation: (%.2f, %.2f, %.2f)", rotation_.x, rotation_.y, rotation_.z);
+		ImGui::Text("Rotation: (%.2f, %.2f, %.2f)", rotation.x, rotation.y, rotation.z);
 		if (ImGui::SliderFloat("Scale", &scale_, 0.5f, 3.0f)) {
 			cube_pos.scale = glm::vec3(scale_); // Update uniform scale
 		}
 
 		if (ImGui::Button("Reset Position")) {
 			position_ = glm::vec3(0.0f, 0.0f, -5.0f);
-			rotation_ = glm::vec3(0.0f, 0.0f, 0.0f);
+			cube_pos.rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
 		}
 
 		ImGui::Separator();
@@ -20,9 +20,12 @@ AnimationSystem::AnimationSystem(flecs::world& world) : world_(world) {
 }
 
 void AnimationSystem::Register(const flecs::world& world) {
-	// Register the animation update system
+	// Register the animation update system. Each entity only writes its own Transform, so entities are
+	// split across worker threads.
 	world.system<Animator>("AnimationUpdateSystem")
 		.kind(flecs::OnUpdate)
+		.multi_threaded()
+		.write<components::Transform>()
 		.each([](flecs::iter itr, std::size_t index, Animator& animator) {
 			const float dt = itr.delta_time();
 
@@ -129,23 +132,30 @@ void AnimationSystem::ApplyAnimatedValue(
 				}
 			}
 			else if (property_name == "rotation") {
+				// Rotation tracks are authored as euler angles (radians)
 				if constexpr (std::is_same_v<T, glm::vec3>) {
-					transform.rotation = val;
+					transform.SetEulerAngles(val);
 				}
 			}
 			else if (property_name == "rotation.x") {
 				if constexpr (std::is_same_v<T, float>) {
-					transform.rotation.x = val;
+					glm::vec3 euler = transform.GetEulerAngles();
+					euler.x = val;
+					transform.SetEulerAngles(euler);
 				}
 			}
 			else if (property_name == "rotation.y") {
 				if constexpr (std::is_same_v<T, float>) {
-					transform.rotation.y = val;
+					glm::vec3 euler = transform.GetEulerAngles();
+					euler.y = val;
+					transform.SetEulerAngles(euler);
 				}
 			}
 			else if (property_name == "rotation.z") {
 				if constexpr (std::is_same_v<T, float>) {
-					transform.rotation.z = val;
+					glm::vec3 euler = transform.GetEulerAngles();
+					euler.z = val;
+					transform.SetEulerAngles(euler);
 				}
 			}
 			else if (property_name == "scale") {
@@ -9,6 +9,8 @@ module;
 #include <optional>
 #include <stb_image.h>
 
+#include "platform/profiler.h"
+
 module engine.assets;
 
 import engine.platform;
@@ -26,6 +28,7 @@ std::shared_ptr<Image> AssetManager::LoadImage(const std::string& path) {
 }
 
 std::shared_ptr<Image> AssetManager::LoadImage(const std::filesystem::path& absolute_path) {
+	PROFILE_FUNCTION();
 	using namespace engine::platform;
 	std::cout << "Loading image from: " << absolute_path.string() << '\n';
 	fs::File file;
@@ -83,6 +86,7 @@ bool AssetManager::SaveBinaryFile(const std::string& path, const std::vector<uin
 }
 
 std::optional<std::string> AssetManager::LoadTextFile(const std::filesystem::path& absolute_path) {
+	PROFILE_FUNCTION();
 	using namespace engine::platform;
 	fs::File file;
 	if (!file.Open(absolute_path, fs::FileMode::Read, fs::FileType::Text)) {
@@ -96,6 +100,7 @@ std::optional<std::string> AssetManager::LoadTextFile(const std::filesystem::pat
 }
 
 std::optional<std::vector<uint8_t>> AssetManager::LoadBinaryFile(const std::filesystem::path& absolute_path) {
+	PROFILE_FUNCTION();
 	using namespace engine::platform;
 	fs::File file;
 	if (!file.Open(absolute_path, fs::FileMode::Read)) {
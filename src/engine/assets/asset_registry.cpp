@@ -15,6 +15,8 @@ module;
 #include <utility>
 #include <vector>
 
+#include "platform/profiler.h"
+
 module engine.asset_registry;
 
 import engine.rendering;
@@ -88,6 +90,10 @@ bool AssetInfo::Load() {
 		return true;
 	}
 	loading_ = true;
+	// Name the zone after the asset; the name is only interned while profiling
+	const platform::profiling::ScopedZone zone(
+		platform::profiling::IsEnabled() ? platform::profiling::Intern("Load " + name) : "AssetInfo::Load"
+	);
 	// Reset the re-entrancy guard on any exit path (including exceptions from DoLoad).
 	struct LoadingGuard {
 		bool& flag;
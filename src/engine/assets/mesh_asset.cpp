@@ -10,6 +10,7 @@ module engine.asset_registry;
 
 import engine.rendering;
 import engine.platform;
+import engine.assets;
 import engine.ecs.component_registry;
 
 namespace engine::assets {
@@ -38,8 +39,18 @@ bool MeshAssetInfo::DoLoad() {
 		return false;
 	}
 	else if (mesh_type == mesh_types::FILE) {
-		std::cerr << "MeshAssetInfo: File mesh loading not yet implemented: " << file_path << '\n';
-		return false;
+		// Only the pre-optimised binary form is loaded at runtime; source formats go through the import pass offline
+		const auto data = AssetManager::LoadBinaryFile(file_path);
+		if (!data) {
+			std::cerr << "MeshAssetInfo: Failed to read mesh file: " << file_path << '\n';
+			return false;
+		}
+		const auto mesh = rendering::ReadMeshBinary(*data);
+		if (!mesh) {
+			std::cerr << "MeshAssetInfo: Not a binary mesh of the current version: " << file_path << '\n';
+			return false;
+		}
+		success = mesh_mgr.GenerateMeshGeometry(id, *mesh);
 	}
 	else {
 		std::cerr << "MeshAssetInfo: Unknown mesh type: " << mesh_type << '\n';
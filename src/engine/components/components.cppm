@@ -16,36 +16,58 @@ import engine.assets;
 export namespace engine::components {
 // === CORE COMPONENTS ===
 
+// Compose a T * R * S matrix straight from a quaternion. The rotation basis is written column by
+// column and scaled in place, so there are no per-axis rotate matrices or full mat4 multiplies.
+inline glm::mat4 ComposeTransformMatrix(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale) {
+	const float xx = rotation.x * rotation.x;
+	const float yy = rotation.y * rotation.y;
+	const float zz = rotation.z * rotation.z;
+	const float xy = rotation.x * rotation.y;
+	const float xz = rotation.x * rotation.z;
+	const float yz = rotation.y * rotation.z;
+	const float wx = rotation.w * rotation.x;
+	const float wy = rotation.w * rotation.y;
+	const float wz = rotation.w * rotation.z;
+
+	return {
+		glm::vec4(1.0F - 2.0F * (yy + zz), 2.0F * (xy + wz), 2.0F * (xz - wy), 0.0F) * scale.x,
+		glm::vec4(2.0F * (xy - wz), 1.0F - 2.0F * (xx + zz), 2.0F * (yz + wx), 0.0F) * scale.y,
+		glm::vec4(2.0F * (xz + wy), 2.0F * (yz - wx), 1.0F - 2.0F * (xx + yy), 0.0F) * scale.z,
+		glm::vec4(position, 1.0F)
+	};
+}
+
 // Transform component for position, rotation, scale
 struct Transform {
 	glm::vec3 position{0.0F};
-	glm::vec3 rotation{0.0F}; // Euler angles in radians
+	glm::quat rotation{1.0F, 0.0F, 0.0F, 0.0F}; // GLM quaternion order: (w, x, y, z)
 	glm::vec3 scale{1.0F};
 
 	void Translate(const glm::vec3& offset) { position += offset; }
 
-	void Rotate(const glm::vec3& euler_angles) { rotation += euler_angles; }
+	// Rotate by euler angles (radians) about the local axes
+	void Rotate(const glm::vec3& euler_angles) { rotation = glm::normalize(rotation * glm::quat(euler_angles)); }
 
 	void SetScale(const glm::vec3& new_scale) { scale = new_scale; }
 
 	void SetScale(const float uniform_scale) { scale = glm::vec3(uniform_scale); }
+
+	// Euler angles (radians, XYZ applied as Z * Y * X) for editor and UI display only
+	[[nodiscard]] glm::vec3 GetEulerAngles() const { return glm::eulerAngles(rotation); }
+
+	void SetEulerAngles(const glm::vec3& euler_angles) { rotation = glm::quat(euler_angles); }
+
+	[[nodiscard]] glm::mat4 ComputeMatrix() const { return ComposeTransformMatrix(position, rotation, scale); }
 };
 
 struct WorldTransform {
 	glm::vec3 position{0.0F};
-	glm::vec3 rotation{0.0F}; // Euler angles in radians (world-space)
+	glm::quat rotation{1.0F, 0.0F, 0.0F, 0.0F}; // World-space orientation
 	glm::vec3 scale{1.0F};
 	glm::mat4 matrix{1.0F};
 
 	// Recompute matrix from position/rotation/scale
-	void ComputeMatrix() {
-		const glm::mat4 t = glm::translate(glm::mat4(1.0F), position);
-		const glm::mat4 rx = glm::rotate(glm::mat4(1.0F), rotation.x, glm::vec3(1, 0, 0));
-		const glm::mat4 ry = glm::rotate(glm::mat4(1.0F), rotation.y, glm::vec3(0, 1, 0));
-		const glm::mat4 rz = glm::rotate(glm::mat4(1.0F), rotation.z, glm::vec3(0, 0, 1));
-		const glm::mat4 s = glm::scale(glm::mat4(1.0F), scale);
-		matrix = t * rz * ry * rx * s;
-	}
+	void ComputeMatrix() { matrix = ComposeTransformMatrix(position, rotation, scale); }
 };
 
 // Velocity component for movement
@@ -36,7 +36,8 @@ enum class FieldType {
 	Enum,           // Integer-backed enum displayed as combo box
 	FilePath,       // String displayed with file browser hint
 	Selection,      // String-backed dropdown with fixed options
-	Slider          // Float displayed as slider with configurable min/max
+	Slider,         // Float displayed as slider with configurable min/max
+	Quat            // Quaternion displayed as euler angles in degrees
 };
 
 /**
@@ -128,6 +129,11 @@ struct FieldTypeTraits<glm::vec4> {
 	static constexpr auto TYPE = FieldType::Vec4;
 };
 
+template<>
+struct FieldTypeTraits<glm::quat> {
+	static constexpr auto TYPE = FieldType::Quat;
+};
+
 template<>
 struct FieldTypeTraits<std::vector<int>> {
 	static constexpr auto TYPE = FieldType::ListInt;
@@ -356,6 +362,9 @@ public:
 		else if constexpr (std::is_same_v<FieldT, glm::vec4>) {
 			component_.member<glm::vec4>(field_name.c_str());
 		}
+		else if constexpr (std::is_same_v<FieldT, glm::quat>) {
+			component_.member<glm::quat>(field_name.c_str());
+		}
 		else if constexpr (std::is_same_v<FieldT, glm::ivec2>) {
 			component_.member<glm::ivec2>(field_name.c_str());
 		}
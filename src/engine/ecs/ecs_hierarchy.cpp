@@ -0,0 +1,213 @@
+module;
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <flecs.h>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+module engine.ecs;
+import engine;
+
+namespace engine::ecs {
+
+namespace {
+// Upper bound on roots with a cached descendant list; past it the least recently queried root is evicted
+constexpr size_t MAX_CACHED_DESCENDANT_ROOTS = 64;
+
+struct NameHash {
+	using is_transparent = void;
+	size_t operator()(const std::string_view name) const { return std::hash<std::string_view>{}(name); }
+};
+
+// Singleton mapping SceneEntity names to the entities carrying them. Each distinct name is stored once,
+// as a map key, and entities point back at their interned name so a rename can leave its old bucket.
+// Lookups take a string_view, so finding an entity never allocates.
+struct SceneNameIndex {
+	std::unordered_map<std::string, std::vector<flecs::entity_t>, NameHash, std::equal_to<>> entities_by_name;
+	std::unordered_map<flecs::entity_t, const std::string*> name_of;
+};
+
+// Singleton caching pre-order descendant lists per root. Any ChildOf change bumps the version, which
+// lazily invalidates every cached list. Entries are map nodes, so a list's storage only moves when its
+// own root is rebuilt or evicted.
+struct DescendantCache {
+	struct Entry {
+		uint64_t version = 0;
+		uint64_t last_used = 0;
+		std::vector<flecs::entity> descendants;
+	};
+
+	uint64_t hierarchy_version = 1;
+	uint64_t query_count = 0;
+	std::unordered_map<flecs::entity_t, Entry> entries;
+};
+
+void Unindex(SceneNameIndex& index, const flecs::entity_t entity) {
+	const auto it = index.name_of.find(entity);
+	if (it == index.name_of.end()) {
+		return;
+	}
+	const auto bucket = index.entities_by_name.find(*it->second);
+	index.name_of.erase(it);
+
+	std::erase(bucket->second, entity);
+	if (bucket->second.empty()) {
+		index.entities_by_name.erase(bucket);
+	}
+}
+
+void Index(SceneNameIndex& index, const flecs::entity_t entity, const std::string& name) {
+	if (const auto it = index.name_of.find(entity); it != index.name_of.end() && *it->second == name) {
+		return; // Some other SceneEntity field changed
+	}
+	Unindex(index, entity);
+	if (name.empty()) {
+		return;
+	}
+	const auto [bucket, inserted] = index.entities_by_name.try_emplace(name);
+	bucket->second.push_back(entity);
+	index.name_of[entity] = &bucket->first;
+}
+
+void CollectDescendants(const flecs::entity entity, std::vector<flecs::entity>& out) {
+	entity.children([&out](const flecs::entity child) {
+		out.push_back(child);
+		CollectDescendants(child, out);
+	});
+}
+
+const std::vector<flecs::entity>& CachedDescendants(DescendantCache& cache, const flecs::entity root) {
+	auto it = cache.entries.find(root.id());
+	if (it == cache.entries.end()) {
+		if (cache.entries.size() >= MAX_CACHED_DESCENDANT_ROOTS) {
+			// Evicting only the least recently used list keeps every view handed out in the last
+			// MAX_CACHED_DESCENDANT_ROOTS queries alive
+			cache.entries.erase(std::ranges::min_element(cache.entries, {}, [](const auto& pair) {
+				return pair.second.last_used;
+			}));
+		}
+		it = cache.entries.try_emplace(root.id()).first;
+	}
+
+	auto& entry = it->second;
+	entry.last_used = ++cache.query_count;
+	if (entry.version != cache.hierarchy_version) {
+		entry.descendants.clear(); // Keeps capacity, so rebuilding a steady-size hierarchy doesn't allocate
+		CollectDescendants(root, entry.descendants);
+		entry.version = cache.hierarchy_version;
+	}
+	return entry.descendants;
+}
+
+// Strip one trailing segment off a slash-separated path, ignoring empty segments
+std::string_view PopLastSegment(std::string_view& path) {
+	while (!path.empty() && path.back() == '/') {
+		path.remove_suffix(1);
+	}
+	const size_t slash = path.rfind('/');
+	const std::string_view segment = slash == std::string_view::npos ? path : path.substr(slash + 1);
+	path = slash == std::string_view::npos ? std::string_view{} : path.substr(0, slash);
+	return segment;
+}
+
+// Check that entity's ancestors carry the names in parent_path (innermost last), ending at root if given
+bool AncestorsMatchPath(const flecs::entity entity, std::string_view parent_path, const flecs::entity root) {
+	flecs::entity current = entity.parent();
+	while (true) {
+		const std::string_view segment = PopLastSegment(parent_path);
+		if (segment.empty()) {
+			return !root.is_valid() || current == root;
+		}
+		const auto* scene_entity = current.is_valid() ? current.try_get<SceneEntity>() : nullptr;
+		if (!scene_entity || scene_entity->name != segment) {
+			return false;
+		}
+		current = current.parent();
+	}
+}
+} // namespace
+
+void ECSWorld::SetupHierarchyIndex() const {
+	world_.set<SceneNameIndex>({});
+	world_.set<DescendantCache>({});
+
+	world_.observer<const SceneEntity>("SceneNameIndexUpdate")
+		.event(flecs::OnSet)
+		.each([](const flecs::entity entity, const SceneEntity& scene_entity) {
+			Index(entity.world().get_mut<SceneNameIndex>(), entity.id(), scene_entity.name);
+		});
+
+	world_.observer<const SceneEntity>("SceneNameIndexRemove")
+		.event(flecs::OnRemove)
+		.each([](const flecs::entity entity, const SceneEntity&) {
+			if (auto* index = entity.world().try_get_mut<SceneNameIndex>()) {
+				Unindex(*index, entity.id());
+			}
+		});
+
+	// Creating, reparenting and deleting entities all add or remove a ChildOf pair
+	world_.observer("DescendantCacheInvalidate")
+		.with(flecs::ChildOf, flecs::Wildcard)
+		.event(flecs::OnAdd)
+		.event(flecs::OnRemove)
+		.each([](const flecs::entity entity) {
+			if (auto* cache = entity.world().try_get_mut<DescendantCache>()) {
+				++cache->hierarchy_version;
+			}
+		});
+}
+
+// Get all descendants (recursive)
+std::vector<flecs::entity> ECSWorld::GetDescendants(const flecs::entity root) {
+	if (auto* cache = root.world().try_get_mut<DescendantCache>()) {
+		return CachedDescendants(*cache, root);
+	}
+	std::vector<flecs::entity> descendants;
+	CollectDescendants(root, descendants);
+	return descendants;
+}
+
+std::span<const flecs::entity> ECSWorld::GetDescendantsView(const flecs::entity root) const {
+	return CachedDescendants(world_.get_mut<DescendantCache>(), root);
+}
+
+// Find entity by name in hierarchy
+flecs::entity ECSWorld::FindEntityByName(const char* name, const flecs::entity root) const {
+	const auto& index = world_.get<SceneNameIndex>();
+	const auto bucket = index.entities_by_name.find(std::string_view(name));
+	if (bucket == index.entities_by_name.end()) {
+		return {};
+	}
+	for (const flecs::entity_t id : bucket->second) {
+		// If root specified, check if entity is descendant
+		if (const flecs::entity entity(world_, id); !root.is_valid() || IsDescendantOf(entity, root)) {
+			return entity;
+		}
+	}
+	return {};
+}
+
+// Find entity by slash-separated path of names
+flecs::entity ECSWorld::FindEntityByPath(std::string_view path, const flecs::entity root) const {
+	// Look up candidates by the last segment, then confirm the rest of the path against their ancestors
+	const std::string_view name = PopLastSegment(path);
+	const auto& index = world_.get<SceneNameIndex>();
+	const auto bucket = index.entities_by_name.find(name);
+	if (name.empty() || bucket == index.entities_by_name.end()) {
+		return {};
+	}
+	for (const flecs::entity_t id : bucket->second) {
+		if (const flecs::entity entity(world_, id); AncestorsMatchPath(entity, path, root)) {
+			return entity;
+		}
+	}
+	return {};
+}
+
+} // namespace engine::ecs
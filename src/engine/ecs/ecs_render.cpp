@@ -1,10 +1,16 @@
 module;
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <flecs.h>
 #include <iostream>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "platform/profiler.h"
+
 module engine.ecs;
 import engine;
 import engine.physics;
@@ -15,9 +21,35 @@ using namespace engine::rendering;
 using namespace engine::assets;
 
 namespace engine::ecs {
+namespace {
+// Shortest run of identical draws worth an instance buffer upload
+constexpr size_t MIN_INSTANCED_RUN = 2;
+
+// Inverse transpose of the upper 3x3, which is all a normal transform needs and much cheaper than a 4x4 inverse
+glm::mat4 NormalMatrix(const glm::mat4& transform) {
+	return glm::mat4(glm::transpose(glm::inverse(glm::mat3(transform))));
+}
+
+// Local Spatial bounds moved into world space, for entities that have them
+void SetWorldBounds(RenderEntry& entry, const WorldTransform& transform, const Spatial* spatial) {
+	if (spatial) {
+		const spatial::Aabb local_bounds{.min = spatial->bounding_min, .max = spatial->bounding_max};
+		entry.world_bounds = local_bounds.Transformed(transform.matrix);
+		entry.has_bounds = true;
+	}
+}
+
+bool CanInstanceTogether(const RenderEntry& first, const RenderEntry& other) {
+	const RenderCommand& a = first.command;
+	const RenderCommand& b = other.command;
+	return a.mesh == b.mesh && a.material == b.material && a.shader == b.shader
+		&& first.transparent == other.transparent && a.render_state_stack == b.render_state_stack;
+}
+} // namespace
 
 // Submit render commands for all renderable entities
 void ECSWorld::SubmitRenderCommands(const Renderer& renderer) {
+	PROFILE_FUNCTION();
 	// Static default camera to avoid recreation every frame
 	static const Camera default_camera = []() {
 		Camera cam;
@@ -38,27 +70,6 @@ void ECSWorld::SubmitRenderCommands(const Renderer& renderer) {
 		active_camera = &camera_data;
 	}
 
-	// Collect all lights in the scene (up to 4)
-	constexpr int max_lights = 4;
-	std::vector<Light> scene_lights;
-	std::vector<glm::vec3> light_positions;
-
-	// Query all entities with Light component and Transform
-	world_.query<const Light, const Transform>().each(
-		[&scene_lights, &light_positions](flecs::entity, const Light& light, const Transform& transform) {
-			if (scene_lights.size() < max_lights) {
-				scene_lights.push_back(light);
-				light_positions.push_back(transform.position);
-			}
-		}
-	);
-
-	// TEMP: Hold the first light for backward compatability
-	glm::vec3 light_dir{0.2F, -1.0F, -0.3F}; // Default fallback
-	if (!scene_lights.empty()) {
-		light_dir = glm::normalize(scene_lights[0].direction);
-	}
-
 	// Get camera position for specular calculations
 	glm::vec3 camera_position{0.0F, 0.0F, 10.0F}; // Default
 	if (camera_entity.is_valid() && camera_entity.has<Transform>()) {
@@ -66,84 +77,240 @@ void ECSWorld::SubmitRenderCommands(const Renderer& renderer) {
 		camera_position = cam_transform.position;
 	}
 
+	// Pack the camera and lights into one buffer, uploaded once for the whole frame. Directional lights light
+	// everything and go first; the point and spot lights after them are binned into view clusters by the renderer,
+	// so each fragment only shades the ones in range.
+	SceneUniforms scene_uniforms{.camera_position = glm::vec4(camera_position, 1.0F)};
+	int num_lights = 0;
+	glm::vec3 light_dir{0.2F, -1.0F, -0.3F}; // Default fallback
+	const auto store_light = [&scene_uniforms, &num_lights](const Light& light, const glm::vec3& position) {
+		// Position/Direction (for directional lights, this is the direction); w carries the type
+		scene_uniforms.light_positions[num_lights] = glm::vec4(position, static_cast<float>(light.type));
+		scene_uniforms.light_colors[num_lights] =
+			glm::vec4(light.color.r, light.color.g, light.color.b, light.intensity);
+		scene_uniforms.light_params[num_lights] = glm::vec4(light.range, light.attenuation, 0.0F, 0.0F);
+		++num_lights;
+	};
+	const auto lights = world_.query<const Light, const Transform>();
+	lights.each([&](flecs::entity, const Light& light, const Transform&) {
+		if (light.type != Light::Type::Directional || num_lights >= MAX_SCENE_LIGHTS) {
+			return;
+		}
+		// TEMP: Hold the first directional light for backward compatability
+		if (num_lights == 0) {
+			light_dir = glm::normalize(light.direction);
+		}
+		store_light(light, glm::normalize(light.direction));
+	});
+	scene_uniforms.light_count[0] = num_lights;
+	lights.each([&](flecs::entity, const Light& light, const Transform& transform) {
+		if (light.type != Light::Type::Directional && num_lights < MAX_SCENE_LIGHTS) {
+			store_light(light, transform.position);
+		}
+	});
+	scene_uniforms.light_count[1] = num_lights;
+	renderer.SetSceneUniforms(scene_uniforms, active_camera->view_matrix);
+
 	auto& mat_mgr = renderer.GetMaterialManager();
 	auto& shader_mgr = renderer.GetShaderManager();
 
-	// Single query loop for all renderables
-	const auto renderable_query = world_.query<const WorldTransform, const Renderable>();
-	renderable_query.each([&](flecs::iter, size_t, const WorldTransform& transform, const Renderable& renderable) {
-		if (!renderable.visible) {
-			return;
-		}
-		RenderCommand cmd{
-			.mesh = renderable.mesh,
-			.shader = renderable.shader,
-			.material = renderable.material,
-			.render_state_stack = renderable.render_state_stack,
-			.camera_view = active_camera->view_matrix
-		};
+	// Lit shaders read the scene from the uniform block; only the legacy single-light uniform and the light cluster
+	// texture units are set per program
+	std::vector<ShaderId> prepared_shaders;
+	const auto prepare_shader = [&](const Shader& shader) {
+		shader.BindUniformBlock(SCENE_UNIFORM_BLOCK, SCENE_UNIFORM_BINDING);
 
-		cmd.transform = transform.matrix;
+		// TEMP: Use the first light, backward compatability
+		shader.SetUniform("u_LightDir", light_dir);
 
-		// Set lighting uniforms for lit shaders
-		if (const auto& shader = shader_mgr.GetShader(renderable.shader); shader.IsValid()) {
-			shader.Use();
-			// TEMP: Use the first light, backward compatability
-			shader.SetUniform("u_LightDir", light_dir);
+		shader.SetUniform("u_LightGrid", static_cast<int>(LIGHT_GRID_TEXTURE_UNIT));
+		shader.SetUniform("u_LightIndices", static_cast<int>(LIGHT_INDEX_TEXTURE_UNIT));
+	};
 
-			// Set camera position
-			shader.SetUniform("u_CameraPos", camera_position);
+	// The renderer draws with the material's shader when there is one
+	const auto bound_shader_of = [&](const RenderCommand& cmd) {
+		return mat_mgr.IsValid(cmd.material) ? mat_mgr.GetMaterial(cmd.material).GetShader() : cmd.shader;
+	};
 
-			// Set ambient lighting
-			shader.SetUniform("u_AmbientColor", glm::vec3(1.0F, 1.0F, 1.0F));
-			shader.SetUniform("u_AmbientIntensity", 0.5F);
+	// Bind the program the command draws with, along with the scene and material uniforms. Draws arrive sorted, so consecutive draws
+	// usually share a shader and material and the material only needs applying when the pair changes.
+	ShaderId last_shader = INVALID_SHADER;
+	MaterialId last_material = INVALID_MATERIAL;
+	bool material_applied = false;
+	const auto bind_shader = [&](RenderCommand& cmd) -> const Shader* {
+		cmd.camera_view = active_camera->view_matrix;
+
+		// Lit shaders get the scene's lighting the first time they draw this frame
+		const ShaderId program = bound_shader_of(cmd);
+		const auto& shader = shader_mgr.GetShader(program);
+		if (shader.IsValid()) {
+			shader.Use();
+			if (std::ranges::find(prepared_shaders, program) == prepared_shaders.end()) {
+				prepared_shaders.push_back(program);
+				prepare_shader(shader);
+			}
 
 			// Set material properties from the entity's material (if valid)
-			if (mat_mgr.IsValid(renderable.material)) {
-				const auto& material = mat_mgr.GetMaterial(renderable.material);
-				material.Apply(shader);
+			if (!material_applied || program != last_shader || cmd.material != last_material) {
+				if (mat_mgr.IsValid(cmd.material)) {
+					const auto& material = mat_mgr.GetMaterial(cmd.material);
+					material.Apply(shader);
+				}
+				else {
+					shader.SetUniform(shader.GetStandardUniforms().color, glm::vec4(1.0F, 1.0F, 1.0F, 1.0F));
+					shader.SetUniform(shader.GetStandardUniforms().shininess, 32.0F);
+				}
+				last_shader = program;
+				last_material = cmd.material;
+				material_applied = true;
 			}
-			else {
-				shader.SetUniform("u_Color", glm::vec4(1.0F, 1.0F, 1.0F, 1.0F));
-				shader.SetUniform("u_Shininess", 32.0F);
+			return &shader;
+		}
+		return nullptr;
+	};
+
+	// Static entities: commands and normal matrices are built once and reused until one of them is invalidated
+	auto& static_cache = world_.get_mut<StaticEntityCache>();
+	if (static_cache.render_entries_dirty) {
+		static_cache.render_entries.clear();
+		const auto static_query =
+			world_.query_builder<const WorldTransform, const Renderable, const Spatial*>().with<StaticEntity>().build();
+		static_query.each(
+			[&static_cache](const WorldTransform& transform, const Renderable& renderable, const Spatial* spatial) {
+				if (!renderable.visible) {
+					return;
+				}
+				RenderCommand cmd{
+					.mesh = renderable.mesh,
+					.shader = renderable.shader,
+					.material = renderable.material,
+					.transform = transform.matrix,
+					.render_state_stack = renderable.render_state_stack,
+					.layer = static_cast<int>(renderable.render_layer)
+				};
+				const glm::mat4 normal_matrix = NormalMatrix(cmd.transform);
+				static_cache.render_entries.push_back({
+					.command = std::move(cmd),
+					.normal_matrix = normal_matrix,
+					.transparent = renderable.alpha < 1.0F
+				});
+				SetWorldBounds(static_cache.render_entries.back(), transform, spatial);
 			}
+		);
+		static_cache.render_entries_dirty = false;
+	}
 
-			// Calculate normal matrix (inverse transpose of model matrix)
-			glm::mat4 normal_matrix = glm::transpose(glm::inverse(cmd.transform));
-			shader.SetUniform("u_NormalMatrix", normal_matrix);
+	// Everything else is rebuilt every frame
+	auto& frame = world_.get_mut<RenderFrameCache>();
+	frame.dynamic_entries.clear();
+	const auto renderable_query =
+		world_.query_builder<const WorldTransform, const Renderable, const Spatial*>().without<StaticEntity>().build();
+	renderable_query.each(
+		[&frame](const WorldTransform& transform, const Renderable& renderable, const Spatial* spatial) {
+			if (!renderable.visible) {
+				return;
+			}
+			RenderCommand cmd{
+				.mesh = renderable.mesh,
+				.shader = renderable.shader,
+				.material = renderable.material,
+				.render_state_stack = renderable.render_state_stack,
+				.layer = static_cast<int>(renderable.render_layer)
+			};
 
-			// Set number of lights
-			shader.SetUniform("u_NumLights", static_cast<int>(scene_lights.size()));
+			cmd.transform = transform.matrix;
 
-			// Set light properties
-			for (size_t i = 0; i < scene_lights.size() && i < max_lights; ++i) {
-				const Light& light = scene_lights[i];
-				const std::string idx = "[" + std::to_string(i) + "]";
+			const glm::mat4 normal_matrix = NormalMatrix(cmd.transform);
+			frame.dynamic_entries.push_back({
+				.command = std::move(cmd),
+				.normal_matrix = normal_matrix,
+				.transparent = renderable.alpha < 1.0F
+			});
+			SetWorldBounds(frame.dynamic_entries.back(), transform, spatial);
+		}
+	);
 
-				// Light type
-				shader.SetUniform("u_LightTypes" + idx, static_cast<int>(light.type));
+	// Record every draw with its sort key, then execute in key order rather than flecs table order. Indices
+	// below static_count refer to static entries, the rest to this frame's dynamic entries.
+	const auto static_count = static_cast<uint32_t>(static_cache.render_entries.size());
+	const auto entry_at = [&](const uint32_t index) -> RenderEntry& {
+		return index < static_count ? static_cache.render_entries[index] : frame.dynamic_entries[index - static_count];
+	};
+	const auto entry_count = static_count + static_cast<uint32_t>(frame.dynamic_entries.size());
+	const glm::mat4& view = active_camera->view_matrix;
+	frame.queue.Clear();
+	frame.queue.Reserve(entry_count);
+	const auto enqueue = [&](const uint32_t index) {
+		const RenderEntry& entry = entry_at(index);
+		const RenderCommand& cmd = entry.command;
+		const SortKeyFields key{
+			.layer = static_cast<uint32_t>(std::max(cmd.layer, 0)),
+			.transparent = entry.transparent,
+			.shader = bound_shader_of(cmd),
+			.material = cmd.material,
+			.mesh = cmd.mesh,
+			.view_depth = -(view * cmd.transform[3]).z
+		};
+		frame.queue.Push(RenderQueue::MakeKey(key), index);
+	};
 
-				// Position/Direction (for directional lights, this is the direction)
-				if (light.type == Light::Type::Directional) {
-					shader.SetUniform("u_LightPositions" + idx, glm::normalize(light.direction));
-				}
-				else {
-					shader.SetUniform("u_LightPositions" + idx, light_positions[i]);
-				}
+	// Only entries whose bounds reach into the frustum the renderer draws with are queued. Entries without
+	// bounds can't be culled and are always queued.
+	frame.cull_boxes.Clear();
+	frame.cull_entries.clear();
+	frame.visible_boxes.clear();
+	for (uint32_t index = 0; index < entry_count; ++index) {
+		if (const RenderEntry& entry = entry_at(index); entry.has_bounds) {
+			frame.cull_boxes.Push(entry.world_bounds);
+			frame.cull_entries.push_back(index);
+		}
+		else {
+			enqueue(index);
+		}
+	}
+	spatial::CullAabbs(
+		spatial::Frustum::FromMatrix(renderer.GetProjection() * view),
+		frame.cull_boxes,
+		frame.visible_boxes
+	);
+	for (const uint32_t box : frame.visible_boxes) {
+		enqueue(frame.cull_entries[box]);
+	}
+	const auto culled_count = static_cast<uint32_t>(frame.cull_entries.size() - frame.visible_boxes.size());
+	renderer.AddCullingStats(entry_count - culled_count, culled_count);
+	frame.queue.Sort();
 
-				// Color and intensity
-				glm::vec3 light_color(light.color.r, light.color.g, light.color.b);
-				shader.SetUniform("u_LightColors" + idx, light_color);
-				shader.SetUniform("u_LightIntensities" + idx, light.intensity);
+	// Runs of draws that differ only in their transform become one instanced draw. The sort keeps identical
+	// shader, material and mesh adjacent (and transparent runs stay in back-to-front order within the call).
+	const auto items = frame.queue.Items();
+	for (size_t run_start = 0; run_start < items.size();) {
+		auto& first = entry_at(items[run_start].index);
+		const Shader* shader = bind_shader(first.command);
 
-				// Range and attenuation (for point/spot lights)
-				shader.SetUniform("u_LightRanges" + idx, light.range);
-				shader.SetUniform("u_LightAttenuations" + idx, light.attenuation);
+		size_t run_end = run_start + 1;
+		if (shader && shader->GetStandardUniforms().instanced.IsValid()) {
+			while (run_end < items.size() && CanInstanceTogether(first, entry_at(items[run_end].index))) {
+				++run_end;
 			}
 		}
 
-		renderer.SubmitRenderCommand(cmd);
-	});
+		if (run_end - run_start < MIN_INSTANCED_RUN) {
+			run_end = run_start + 1;
+			if (shader) {
+				shader->SetUniform(shader->GetStandardUniforms().normal_matrix, first.normal_matrix);
+			}
+			renderer.SubmitRenderCommand(first.command);
+		}
+		else {
+			frame.instances.clear();
+			for (size_t i = run_start; i < run_end; ++i) {
+				const RenderEntry& entry = entry_at(items[i].index);
+				frame.instances.push_back({.model = entry.command.transform, .normal_matrix = entry.normal_matrix});
+			}
+			renderer.SubmitInstancedRenderCommand(first.command, frame.instances);
+		}
+		run_start = run_end;
+	}
 
 	// Physics debug drawing — delegate to the active physics backend
 	if (world_.has<physics::PhysicsWorldConfig>()) {
@@ -159,6 +326,25 @@ void ECSWorld::SubmitRenderCommands(const Renderer& renderer) {
 			renderer.FlushDebugLines();
 		}
 	}
+
+	// Sprites are screen-space overlays. They are drawn here rather than at EndFrame so they land in the same
+	// render target as the scene.
+	world_.query<const Sprite>().each([&renderer](const Sprite& sprite) {
+		renderer.SubmitSprite({
+			.texture = sprite.texture,
+			.position = sprite.position,
+			.size = sprite.size,
+			.rotation = sprite.rotation,
+			.color = sprite.color,
+			.texture_offset = sprite.texture_offset,
+			.texture_scale = sprite.texture_scale,
+			.layer = sprite.layer,
+			.pivot = sprite.pivot,
+			.flip_x = sprite.flip_x,
+			.flip_y = sprite.flip_y
+		});
+	});
+	renderer.FlushSprites();
 }
 
 } // namespace engine::ecs
@@ -0,0 +1,101 @@
+module;
+
+#include <algorithm>
+#include <cstddef>
+#include <flecs.h>
+#include <vector>
+
+module engine.ecs;
+import engine;
+import glm;
+
+using namespace engine::components;
+
+namespace engine::ecs {
+
+void ECSWorld::SetupStaticEntities() const {
+	world_.set<StaticEntityCache>({});
+
+	// The tag gives static entities their own archetype, so per-frame queries can exclude them wholesale
+	world_.observer<const SceneEntity>("StaticEntitySync")
+		.event(flecs::OnSet)
+		.each([](const flecs::entity entity, const SceneEntity& scene_entity) {
+			if (scene_entity.static_entity != entity.has<StaticEntity>()) {
+				entity.add_if<StaticEntity>(scene_entity.static_entity);
+			}
+		});
+
+	// Joining the static set computes the entity once; leaving it resumes normal tracking from its next move
+	world_.observer("StaticEntityMembership")
+		.with<StaticEntity>()
+		.event(flecs::OnAdd)
+		.event(flecs::OnRemove)
+		.each([](flecs::iter& it, const size_t row) {
+			const flecs::entity entity = it.entity(row);
+			if (auto* cache = entity.world().try_get_mut<StaticEntityCache>()) {
+				cache->render_entries_dirty = true;
+			}
+			if (it.event() == flecs::OnAdd) {
+				InvalidateStatic(entity);
+			}
+		});
+
+	world_.observer<const rendering::Renderable>("StaticRenderableChanged")
+		.with<StaticEntity>()
+		.event(flecs::OnSet)
+		.event(flecs::OnRemove)
+		.each([](const flecs::entity entity, const rendering::Renderable&) {
+			if (auto* cache = entity.world().try_get_mut<StaticEntityCache>()) {
+				cache->render_entries_dirty = true;
+			}
+		});
+
+	world_.observer<const Spatial>("StaticSpatialChanged")
+		.with<StaticEntity>()
+		.event(flecs::OnSet)
+		.each([](const flecs::entity entity, const Spatial&) {
+			entity.world().get_mut<StaticEntityCache>().refreshed.push_back(entity.id());
+		});
+
+	// Refit static entities recomputed by TransformPropagation (or with edited bounds) in the broadphase and
+	// rebuild their cached render commands. Runs after SpatialIndexUpdate, which skips them.
+	world_.system("StaticEntityRefresh")
+		.kind(post_simulation_phase_)
+		.read<WorldTransform>()
+		.write<Spatial>()
+		.run([index = spatial_index_.get()](const flecs::iter& it) {
+			auto& cache = it.world().get_mut<StaticEntityCache>();
+			if (cache.refreshed.empty()) {
+				return;
+			}
+
+			std::ranges::sort(cache.refreshed);
+			const auto duplicates = std::ranges::unique(cache.refreshed);
+			cache.refreshed.erase(duplicates.begin(), duplicates.end());
+			for (const flecs::entity_t id : cache.refreshed) {
+				const flecs::entity entity = it.world().entity(id);
+				if (!entity.is_alive()) {
+					continue;
+				}
+				const auto* world_transform = entity.try_get<WorldTransform>();
+				auto* spatial = entity.try_get_mut<Spatial>();
+				if (!world_transform || !spatial) {
+					continue;
+				}
+				const spatial::Aabb local_bounds{.min = spatial->bounding_min, .max = spatial->bounding_max};
+				index->Update(entity.id(), local_bounds.Transformed(world_transform->matrix), spatial->spatial_layer);
+				spatial->bounds_dirty = false;
+			}
+			cache.refreshed.clear();
+			cache.render_entries_dirty = true;
+		});
+}
+
+void ECSWorld::InvalidateStatic(const flecs::entity entity) {
+	// Flags the entity for TransformPropagation, which carries the refresh down to its static descendants
+	if (entity.has<Transform>()) {
+		entity.modified<Transform>();
+	}
+}
+
+} // namespace engine::ecs
@@ -4,6 +4,7 @@ module;
 
 module engine.ecs;
 import engine;
+import engine.physics;
 import glm;
 
 using namespace engine::components;
@@ -12,22 +13,29 @@ using namespace engine::animation;
 namespace engine::ecs {
 
 void ECSWorld::SetupMovementSystem() const {
-	// System to update positions based on velocity (Simulation phase)
-	world_.system<Transform, const Velocity>()
+	// System to update positions based on velocity (Simulation phase). Touches only its own entity, so
+	// it is split across worker threads.
+	world_.system<Transform, const Velocity>("MovementSystem")
 		.kind(simulation_phase_)
+		.multi_threaded()
 		.each([](const flecs::iter itr, const size_t index, Transform& transform, const Velocity& velocity) {
 			transform.position += velocity.linear * itr.delta_time();
-			transform.rotation += velocity.angular * itr.delta_time();
+			if (const float speed = glm::length(velocity.angular); speed > 0.0F) {
+				const glm::quat spin = glm::angleAxis(speed * itr.delta_time(), velocity.angular / speed);
+				transform.rotation = glm::normalize(spin * transform.rotation);
+			}
 			itr.entity(index).modified<Transform>();
 		});
 }
 
 void ECSWorld::SetupRotationSystem() const {
 	// System for entities with Rotating tag - simple rotation animation (Simulation phase)
-	world_.system<Transform, Rotating>()
+	world_.system<Transform, Rotating>("RotationSystem")
 		.kind(simulation_phase_)
+		.multi_threaded()
 		.each([](const flecs::iter itr, const size_t index, Transform& transform, Rotating) {
-			transform.rotation.y += 1.0F * itr.delta_time(); // 1 radian per second
+			const glm::quat spin = glm::angleAxis(1.0F * itr.delta_time(), glm::vec3(0, 1, 0)); // 1 radian per second
+			transform.rotation = glm::normalize(spin * transform.rotation);
 			itr.entity(index).modified<Transform>();
 		});
 }
@@ -48,6 +56,46 @@ void ECSWorld::SetupSpatialSystem() const {
 	world_.observer<const Transform, Spatial>("SpatialBoundsUpdate")
 		.event(flecs::OnSet)
 		.each([](flecs::entity, const Transform&, Spatial& spatial) { spatial.bounds_dirty = true; });
+
+	// Edited local bounds or layer need refitting too
+	world_.observer<Spatial>("SpatialComponentSet")
+		.event(flecs::OnSet)
+		.each([](flecs::entity, Spatial& spatial) { spatial.bounds_dirty = true; });
+
+	world_.observer<const Spatial>("SpatialIndexRemove")
+		.event(flecs::OnRemove)
+		.each([index = spatial_index_.get()](const flecs::entity entity, const Spatial&) {
+			index->Remove(entity.id());
+		});
+
+	// Physics writes WorldTransform of dynamic bodies directly, so no Transform change flags them
+	world_.system<Spatial, const physics::RigidBody>("SpatialPhysicsBounds")
+		.without<StaticEntity>()
+		.kind(post_simulation_phase_)
+		.multi_threaded()
+		.each([&sim_phase = simulation_phase_](Spatial& spatial, const physics::RigidBody& rigid_body) {
+			if (sim_phase.enabled() && rigid_body.motion_type == physics::MotionType::Dynamic) {
+				spatial.bounds_dirty = true;
+			}
+		});
+
+	// Refit moved entities in the broadphase. Runs after TransformPropagation in the same phase.
+	// Static entities are refit by StaticEntityRefresh only when invalidated.
+	world_.system<const WorldTransform, Spatial>("SpatialIndexUpdate")
+		.without<StaticEntity>()
+		.kind(post_simulation_phase_)
+		.each([index = spatial_index_.get()](
+				  const flecs::entity entity,
+				  const WorldTransform& world_transform,
+				  Spatial& spatial
+			  ) {
+			if (!spatial.bounds_dirty) {
+				return;
+			}
+			const spatial::Aabb local_bounds{.min = spatial.bounding_min, .max = spatial.bounding_max};
+			index->Update(entity.id(), local_bounds.Transformed(world_transform.matrix), spatial.spatial_layer);
+			spatial.bounds_dirty = false;
+		});
 }
 
 void ECSWorld::SetupAnimationSystem() const {
@@ -60,6 +108,7 @@ void ECSWorld::SetupAudioSystem() const {
 	// Runs in simulation phase — only active during play mode, not in editor mode
 	world_.system<audio::AudioSource>("AudioSourceSystem")
 		.kind(simulation_phase_)
+		.read<WorldTransform>()
 		.each([](flecs::entity entity, audio::AudioSource& source) {
 			auto& audio_sys = audio::AudioSystem::Get();
 			if (!audio_sys.IsInitialized()) {
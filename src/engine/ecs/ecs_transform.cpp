@@ -1,6 +1,11 @@
 module;
 
+#include <algorithm>
+#include <cstddef>
 #include <flecs.h>
+#include <iterator>
+#include <unordered_set>
+#include <vector>
 
 module engine.ecs;
 import engine;
@@ -11,70 +16,290 @@ using namespace engine::components;
 
 namespace engine::ecs {
 
-void ECSWorld::SetupTransformSystem() const {
-	world_.observer<const Transform, WorldTransform&>("TransformPropagation")
-		.event(flecs::OnAdd)
-		.event(flecs::OnSet)
-		.each([&sim_phase = simulation_phase_](
-				  const flecs::entity entity,
-				  const Transform& transform,
-				  WorldTransform& world_transform
-			  ) {
-			// In play mode, dynamic physics bodies own WorldTransform — skip recomputing.
-			// In edit mode (simulation disabled), always recompute so the user can edit Transform.
-			if (sim_phase.enabled() && entity.has<physics::RigidBody>()) {
-				if (const auto rigid_body = entity.get<physics::RigidBody>();
-					rigid_body.motion_type == physics::MotionType::Dynamic) {
-					// Cascade to children only — WorldTransform was set by physics
-					entity.children([](const flecs::entity child) {
-						if (child.has<Transform>()) {
-							child.modified<Transform>();
-						}
-					});
-					return;
-				}
-			}
+namespace {
+// Levels smaller than this are cheaper to compute inline than to split across workers
+constexpr size_t PARALLEL_LEVEL_THRESHOLD = 512;
+constexpr size_t PROPAGATION_GRAIN_SIZE = 256;
 
-			glm::mat4 world_matrix = component_helpers::ComputeTransformMatrix(transform);
+// One entity to recompute. Pointers are resolved serially before the parallel math runs, so
+// worker threads never touch the flecs API.
+struct PropagationItem {
+	flecs::entity entity;
+	const Transform* local = nullptr;
+	WorldTransform* world = nullptr;
+	const WorldTransform* parent_world = nullptr; // nullptr for unparented entities
+	bool owned_by_physics = false;                // Dynamic body in play mode: physics wrote WorldTransform
+	bool refreshing_static = false;               // Entity or an ancestor in this pass is an invalidated static entity
+};
 
-			if (const auto parent = entity.parent(); parent.is_valid() && parent.has<WorldTransform>()) {
-				const auto& parent_wt = parent.get<WorldTransform>();
-				world_matrix = parent_wt.matrix * world_matrix;
+// A grouping entity without its own Transform/WorldTransform pair. It is walked through rather than ending
+// the cascade, and its children compose against the nearest world transform above them.
+struct PassThroughNode {
+	flecs::entity entity;
+	const WorldTransform* parent_world = nullptr;
+};
+
+// Singleton holding entities whose Transform changed since the last propagation pass.
+// The level buffers are kept between frames so steady-state passes don't allocate.
+struct TransformPropagationState {
+	std::vector<flecs::entity_t> dirty;
+	std::unordered_set<flecs::entity_t> dirty_lookup;
+	std::vector<std::vector<PropagationItem>> levels;
+	std::vector<flecs::entity> physics_bodies;
+	std::vector<PassThroughNode> pass_through;
+};
+
+// Compose a world transform from the local transform and the parent's world transform. Position,
+// rotation and scale are carried through directly alongside the matrix, so nothing is decomposed
+// back out of it (the TRS fields are exact unless a non-uniformly scaled parent meets a rotated child,
+// where only the matrix can represent the resulting shear).
+void ComposeWorldTransform(WorldTransform& world, const Transform& local, const WorldTransform* parent_world) {
+	if (!parent_world) {
+		world.position = local.position;
+		world.rotation = local.rotation;
+		world.scale = local.scale;
+		world.ComputeMatrix();
+		return;
+	}
+	world.position = glm::vec3(parent_world->matrix * glm::vec4(local.position, 1.0F));
+	world.rotation = glm::normalize(parent_world->rotation * local.rotation);
+	world.scale = parent_world->scale * local.scale;
+	world.matrix = parent_world->matrix * local.ComputeMatrix();
+}
+
+void ComputeItem(const PropagationItem& item) {
+	if (item.owned_by_physics) {
+		return;
+	}
+	ComposeWorldTransform(*item.world, *item.local, item.parent_world);
+}
+
+// Closest ancestor world transform, skipping intermediates that have none
+const WorldTransform* FindAncestorWorld(const flecs::entity entity) {
+	for (flecs::entity ancestor = entity.parent(); ancestor.is_valid(); ancestor = ancestor.parent()) {
+		if (const auto* ancestor_world = ancestor.try_get<WorldTransform>()) {
+			return ancestor_world;
+		}
+	}
+	return nullptr;
+}
+
+// Whether the breadth-first pass will reach entity from one of its dirty ancestors. It mirrors the pass's
+// static pruning: a clean static entity stops a moving non-static ancestor from reaching what lies below it,
+// while a dirty static ancestor refreshes its whole subtree.
+bool ReachedFromDirtyAncestor(const flecs::entity entity, const std::unordered_set<flecs::entity_t>& dirty) {
+	bool behind_clean_static = false;
+	for (flecs::entity ancestor = entity.parent(); ancestor.is_valid(); ancestor = ancestor.parent()) {
+		const bool is_static =
+			ancestor.has<StaticEntity>() && ancestor.has<Transform>() && ancestor.has<WorldTransform>();
+		if (dirty.contains(ancestor.id())) {
+			if (is_static || !behind_clean_static) {
+				return true;
 			}
+		}
+		else if (is_static) {
+			behind_clean_static = true;
+		}
+	}
+	return false;
+}
+
+bool IsOwnedByPhysics(const flecs::entity entity, const bool simulation_running) {
+	if (!simulation_running) {
+		return false;
+	}
+	const auto* rigid_body = entity.try_get<physics::RigidBody>();
+	return rigid_body && rigid_body->motion_type == physics::MotionType::Dynamic;
+}
+
+// Compose the world transform from local transforms down the parent chain. Used for one-off placement
+// when the cached parent WorldTransforms may not have been propagated yet this frame.
+WorldTransform ResolveWorldTransform(const flecs::entity entity, const Transform& local, const bool simulation_running) {
+	std::vector<const Transform*> chain{&local};
+	const WorldTransform* base = nullptr;
+	for (flecs::entity ancestor = entity.parent(); ancestor.is_valid(); ancestor = ancestor.parent()) {
+		const auto* ancestor_world = ancestor.try_get<WorldTransform>();
+		if (!ancestor_world) {
+			continue; // Grouping entity without a world transform; compose against the next one up
+		}
+		const auto* ancestor_local = ancestor.try_get<Transform>();
+		if (!ancestor_local || IsOwnedByPhysics(ancestor, simulation_running)) {
+			// Physics-owned (or Transform-less) ancestors are authoritative in world space
+			base = ancestor_world;
+			break;
+		}
+		chain.push_back(ancestor_local);
+	}
+
+	WorldTransform composed;
+	ComposeWorldTransform(composed, *chain.back(), base);
+	for (auto it = std::next(chain.rbegin()); it != chain.rend(); ++it) {
+		const WorldTransform parent_world = composed;
+		ComposeWorldTransform(composed, **it, &parent_world);
+	}
+	return composed;
+}
 
-			// Decompose the world matrix into position/rotation/scale
-			world_transform.position = glm::vec3(world_matrix[3]);
-
-			const glm::vec3 col0(world_matrix[0]);
-			const glm::vec3 col1(world_matrix[1]);
-			const glm::vec3 col2(world_matrix[2]);
-			world_transform.scale = glm::vec3(glm::length(col0), glm::length(col1), glm::length(col2));
-
-			if (constexpr float k_epsilon = 1e-6F; world_transform.scale.x > k_epsilon
-												  && world_transform.scale.y > k_epsilon
-												  && world_transform.scale.z > k_epsilon) {
-				const glm::mat3 rot_mat(
-					col0 / world_transform.scale.x,
-					col1 / world_transform.scale.y,
-					col2 / world_transform.scale.z
-				);
-				world_transform.rotation = glm::eulerAngles(glm::quat_cast(rot_mat));
+void RunLevel(const std::vector<PropagationItem>& level) {
+	if (level.size() < PARALLEL_LEVEL_THRESHOLD) {
+		for (const auto& item : level) {
+			ComputeItem(item);
+		}
+		return;
+	}
+	platform::threading::GetJobSystem().ParallelFor(
+		0,
+		level.size(),
+		PROPAGATION_GRAIN_SIZE,
+		[&level](const size_t begin, const size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				ComputeItem(level[i]);
 			}
-			else {
-				world_transform.rotation = transform.rotation;
+		}
+	);
+}
+
+void PropagateTransforms(const flecs::world& world, const bool simulation_running) {
+	auto& state = world.get_mut<TransformPropagationState>();
+	if (state.dirty.empty()) {
+		return;
+	}
+
+	// A parent moved several times this frame (or created then set) only needs propagating once
+	std::ranges::sort(state.dirty);
+	const auto duplicates = std::ranges::unique(state.dirty);
+	state.dirty.erase(duplicates.begin(), duplicates.end());
+	state.dirty_lookup.clear();
+	state.dirty_lookup.insert(state.dirty.begin(), state.dirty.end());
+
+	for (auto& level : state.levels) {
+		level.clear();
+	}
+	state.physics_bodies.clear();
+	if (state.levels.empty()) {
+		state.levels.emplace_back();
+	}
+
+	auto& static_cache = world.get_mut<StaticEntityCache>();
+	const auto make_item = [simulation_running, &state, &static_cache](
+							   const flecs::entity entity,
+							   const WorldTransform* parent_world,
+							   const bool parent_refreshing_static
+						   ) -> PropagationItem {
+		const bool is_static = entity.has<StaticEntity>();
+		if (is_static) {
+			static_cache.refreshed.push_back(entity.id());
+		}
+		if (entity.has<physics::RigidBody>()) {
+			state.physics_bodies.push_back(entity);
+		}
+		if (auto* spatial = entity.try_get_mut<Spatial>()) {
+			// Descendants moved with their parent and must be refit in the spatial index too
+			spatial->bounds_dirty = true;
+		}
+		return {
+			.entity = entity,
+			.local = entity.try_get<Transform>(),
+			.world = entity.try_get_mut<WorldTransform>(),
+			.parent_world = parent_world,
+			.owned_by_physics = IsOwnedByPhysics(entity, simulation_running),
+			.refreshing_static = is_static || parent_refreshing_static
+		};
+	};
+
+	// Level 0: dirty roots, i.e. dirty entities no dirty ancestor will reach (none exists, or the way down is
+	// pruned at a clean static entity). Their parents are up to date, so every subtree can be recomputed
+	// top-down with one visit per entity.
+	for (const flecs::entity_t id : state.dirty) {
+		const flecs::entity entity = world.entity(id);
+		if (!entity.is_alive() || !entity.has<Transform>() || !entity.has<WorldTransform>()) {
+			continue;
+		}
+
+		if (!ReachedFromDirtyAncestor(entity, state.dirty_lookup)) {
+			state.levels[0].push_back(make_item(entity, FindAncestorWorld(entity), false));
+		}
+	}
+
+	// Breadth-first: gather depth N + 1 from depth N (serial flecs reads), then compute depth N + 1
+	// across workers once depth N has been written
+	RunLevel(state.levels[0]);
+	for (size_t depth = 0; depth < state.levels.size() && !state.levels[depth].empty(); ++depth) {
+		if (state.levels.size() == depth + 1) {
+			state.levels.emplace_back();
+		}
+		auto& next = state.levels[depth + 1];
+		for (const auto& item : state.levels[depth]) {
+			// Children below Transform-less intermediates belong to this level too, so a dirty descendant
+			// hidden behind one is still reached from its dirty ancestor
+			state.pass_through.push_back({.entity = item.entity, .parent_world = item.world});
+			while (!state.pass_through.empty()) {
+				const PassThroughNode node = state.pass_through.back();
+				state.pass_through.pop_back();
+				node.entity.children([&](const flecs::entity child) {
+					if (!child.has<Transform>() || !child.has<WorldTransform>()) {
+						const auto* child_world = child.try_get<WorldTransform>();
+						state.pass_through.push_back(
+							{.entity = child, .parent_world = child_world ? child_world : node.parent_world}
+						);
+						return;
+					}
+					// Static descendants keep their cached WorldTransform until they (or a static ancestor) are
+					// invalidated, however their non-static ancestors move
+					if (child.has<StaticEntity>() && !item.refreshing_static
+						&& !state.dirty_lookup.contains(child.id())) {
+						return;
+					}
+					next.push_back(make_item(child, node.parent_world, item.refreshing_static));
+				});
 			}
+		}
+		RunLevel(next);
+	}
+
+	// Let physics SyncToBackend pick up moved static/kinematic bodies (and edit-mode moves)
+	for (const flecs::entity body : state.physics_bodies) {
+		if (!IsOwnedByPhysics(body, simulation_running)) {
+			body.modified<physics::RigidBody>();
+		}
+	}
 
-			world_transform.matrix = world_matrix;
+	state.dirty.clear();
+}
+} // namespace
+
+void ECSWorld::SetupTransformSystem() const {
+	world_.set<TransformPropagationState>({});
 
-			// Notify physics::RigidBody changed so physics SyncToBackend can update body position
-			entity.modified<physics::RigidBody>();
+	// Transform edits only record the entity; WorldTransform is rebuilt once per frame in PostSimulation
+	world_.observer<const Transform, const WorldTransform>("TransformDirtyTracking")
+		.event(flecs::OnAdd)
+		.event(flecs::OnSet)
+		.each([](const flecs::entity entity, const Transform&, const WorldTransform&) {
+			entity.world().get_mut<TransformPropagationState>().dirty.push_back(entity.id());
+		});
+
+	// A new physics body reads WorldTransform immediately to create its backend body, so resolve
+	// its placement now rather than waiting for the propagation pass
+	world_.observer<const Transform, WorldTransform>("TransformPhysicsPlacement")
+		.with<physics::RigidBody>()
+		.event(flecs::OnAdd)
+		.each([&sim_phase = simulation_phase_](
+				  const flecs::entity entity,
+				  const Transform& transform,
+				  WorldTransform& world_transform
+			  ) {
+			world_transform = ResolveWorldTransform(entity, transform, sim_phase.enabled());
+		});
 
-			// Cascade to children: trigger their Transform observers
-			entity.children([](const flecs::entity child) {
-				if (child.has<Transform>()) {
-					child.modified<Transform>();
-				}
-			});
+	// Runs on the main thread (flecs API access during gathering) and fans levels out to the job system itself
+	world_.system("TransformPropagation")
+		.kind(post_simulation_phase_)
+		.read<Transform>()
+		.write<WorldTransform>()
+		.write<Spatial>()
+		.run([&sim_phase = simulation_phase_](const flecs::iter& it) {
+			PropagateTransforms(it.world(), sim_phase.enabled());
 		});
 }
 
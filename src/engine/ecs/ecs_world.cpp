@@ -1,13 +1,17 @@
 module;
 
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <flecs.h>
-#include <functional>
-#include <glm/gtx/norm.hpp>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "platform/profiler.h"
+
 module engine.ecs;
 import engine;
 import engine.physics;
@@ -22,6 +26,67 @@ namespace engine::ecs {
 
 // === ECSWORLD IMPLEMENTATION ===
 
+namespace {
+// Singleton turning flecs' accumulated per-system time into one profiler zone per system and run
+struct SystemProfileState {
+	struct Entry {
+		ecs_ftime_t time_spent = 0;
+		const char* zone_name = nullptr;
+	};
+
+	struct Ran {
+		flecs::entity_t system = 0;
+		const char* zone_name = nullptr;
+		int64_t duration_ns = 0;
+	};
+
+	flecs::query<> systems;
+	bool measuring = false;
+	std::unordered_map<flecs::entity_t, Entry> entries;
+	std::vector<Ran> ran;
+};
+
+// One worker stage of a multi_threaded system, handed to flecs' task_new hook. flecs creates the tasks when
+// such a system starts and joins them when it ends, so they run on the engine job system rather than on
+// a second set of threads competing with it.
+struct FlecsTask {
+	ecs_os_thread_callback_t callback = nullptr;
+	void* param = nullptr;
+	void* result = nullptr;
+	platform::threading::JobCounter done;
+};
+
+ecs_os_thread_t SubmitFlecsTask(const ecs_os_thread_callback_t callback, void* param) {
+	auto* task = new FlecsTask{.callback = callback, .param = param};
+	platform::threading::GetJobSystem().Submit([task] { task->result = task->callback(task->param); }, &task->done);
+	return reinterpret_cast<ecs_os_thread_t>(task);
+}
+
+void* JoinFlecsTask(const ecs_os_thread_t handle) {
+	auto* task = reinterpret_cast<FlecsTask*>(handle);
+	// Runs queued jobs (possibly this very task) while waiting instead of blocking
+	platform::threading::GetJobSystem().Wait(task->done);
+	void* result = task->result;
+	delete task;
+	return result;
+}
+
+// The task hooks are process-wide OS API state, so they are installed once, before the first world initializes the
+// OS API with its defaults, rather than swapped in while worlds may already be running tasks
+flecs::world CreateFlecsWorld() {
+	static const bool hooks_installed = [] {
+		ecs_os_set_api_defaults();
+		ecs_os_api_t api = ecs_os_api;
+		api.task_new_ = SubmitFlecsTask;
+		api.task_join_ = JoinFlecsTask;
+		ecs_os_set_api(&api);
+		return true;
+	}();
+	static_cast<void>(hooks_installed);
+	return flecs::world();
+}
+} // namespace
+
 // Register GLM types with flecs reflection system for JSON serialization
 static void RegisterGlmTypes(const flecs::world& world) {
 	// Register glm::vec2 as a flecs struct type
@@ -33,6 +98,9 @@ static void RegisterGlmTypes(const flecs::world& world) {
 	// Register glm::vec4 as a flecs struct type (also used for Color)
 	world.component<glm::vec4>().member<float>("x").member<float>("y").member<float>("z").member<float>("w");
 
+	// Register glm::quat in its storage order (x, y, z, w) for rotations
+	world.component<glm::quat>().member<float>("x").member<float>("y").member<float>("z").member<float>("w");
+
 	// Register glm::ivec2 for tilemap tile sizes
 	world.component<glm::ivec2>().member<int>("x").member<int>("y");
 
@@ -45,7 +113,7 @@ static void RegisterGlmTypes(const flecs::world& world) {
 		.member<glm::vec4>("c3");
 }
 
-ECSWorld::ECSWorld() {
+ECSWorld::ECSWorld() : spatial_index_(std::make_unique<spatial::DynamicAabbTree>()), world_(CreateFlecsWorld()) {
 	// Set up custom pipeline phases FIRST (before any systems)
 	SetupPipeline();
 
@@ -328,12 +396,16 @@ ECSWorld::ECSWorld() {
 	assets::MeshAssetInfo::RegisterBuiltins();
 	assets::ShaderAssetInfo::RegisterBuiltins();
 
+	world_.set<RenderFrameCache>({});
+
 	// Set up built-in systems
 	SetupMovementSystem();
 	SetupRotationSystem();
 	SetupCameraSystem();
-	SetupSpatialSystem();
+	SetupHierarchyIndex();
 	SetupTransformSystem();
+	SetupSpatialSystem(); // After transforms so the index refits from this frame's WorldTransforms
+	SetupStaticEntities();
 	SetupAnimationSystem();
 	SetupAudioSystem();
 }
@@ -371,10 +443,21 @@ flecs::entity ECSWorld::CreateSceneRoot(const char* name) const {
 // === HIERARCHY MANAGEMENT ===
 
 // Set parent-child relationship using flecs built-in ChildOf
-void ECSWorld::SetParent(const flecs::entity child, const flecs::entity parent) { child.child_of(parent); }
+void ECSWorld::SetParent(const flecs::entity child, const flecs::entity parent) {
+	child.child_of(parent);
+	// Re-parenting changes the world transform without touching Transform; flag it for propagation
+	if (child.has<Transform>()) {
+		child.modified<Transform>();
+	}
+}
 
 // Remove parent relationship
-void ECSWorld::RemoveParent(const flecs::entity child) { child.remove(flecs::ChildOf, flecs::Wildcard); }
+void ECSWorld::RemoveParent(const flecs::entity child) {
+	child.remove(flecs::ChildOf, flecs::Wildcard);
+	if (child.has<Transform>()) {
+		child.modified<Transform>();
+	}
+}
 
 // Get parent entity (returns invalid entity if no parent)
 flecs::entity ECSWorld::GetParent(const flecs::entity entity) { return entity.parent(); }
@@ -386,39 +469,6 @@ std::vector<flecs::entity> ECSWorld::GetChildren(const flecs::entity parent) {
 	return children;
 }
 
-// Get all descendants (recursive)
-std::vector<flecs::entity> ECSWorld::GetDescendants(const flecs::entity root) {
-	std::vector<flecs::entity> descendants;
-
-	std::function<void(flecs::entity)> collect_recursive = [&](const flecs::entity entity) {
-		entity.children([&](const flecs::entity child) {
-			descendants.push_back(child);
-			collect_recursive(child); // Recurse
-		});
-	};
-
-	collect_recursive(root);
-	return descendants;
-}
-
-// Find entity by name in hierarchy
-flecs::entity ECSWorld::FindEntityByName(const char* name, const flecs::entity root) {
-	flecs::entity found;
-
-	const auto query = world_.query_builder<const SceneEntity>().build();
-
-	query.each([&](const flecs::entity entity, const SceneEntity& scene_entity) {
-		if (scene_entity.name == name) {
-			// If root specified, check if entity is descendant
-			if (!root.is_valid() || IsDescendantOf(entity, root)) {
-				found = entity;
-			}
-		}
-	});
-
-	return found;
-}
-
 // Check if entity is descendant of another
 bool ECSWorld::IsDescendantOf(const flecs::entity entity, const flecs::entity ancestor) {
 	flecs::entity current = entity.parent();
@@ -455,68 +505,182 @@ void ECSWorld::SetActiveCamera(const flecs::entity camera) {
 
 // === SPATIAL QUERIES ===
 
+namespace {
+std::vector<flecs::entity> ToEntities(const flecs::world& world, const std::vector<spatial::DynamicAabbTree::Id>& ids) {
+	std::vector<flecs::entity> result;
+	result.reserve(ids.size());
+	for (const auto id : ids) {
+		result.emplace_back(world, id);
+	}
+	return result;
+}
+} // namespace
+
 // Find entities at a point
 [[nodiscard]] std::vector<flecs::entity> ECSWorld::QueryPoint(const glm::vec3& point, const uint32_t layer_mask) const {
-	std::vector<flecs::entity> result;
+	std::vector<spatial::DynamicAabbTree::Id> ids;
+	spatial_index_->QueryPoint(point, layer_mask, ids);
+	return ToEntities(world_, ids);
+}
 
-	const auto query = world_.query<const Transform, const Spatial>();
-	query.each([&](const flecs::entity entity, const Transform& transform, const Spatial& spatial) {
-		if ((spatial.spatial_layer & layer_mask) == 0) {
-			return;
-		}
+// Find entities whose bounds intersect a sphere
+[[nodiscard]] std::vector<flecs::entity>
+ECSWorld::QuerySphere(const glm::vec3& center, const float radius, const uint32_t layer_mask) const {
+	std::vector<spatial::DynamicAabbTree::Id> ids;
+	spatial_index_->QuerySphere(center, radius, layer_mask, ids);
+	return ToEntities(world_, ids);
+}
 
-		// Transform bounding box to world space
-		const glm::vec3 world_min = transform.position + spatial.bounding_min;
-		const glm::vec3 world_max = transform.position + spatial.bounding_max;
-
-		if (point.x >= world_min.x
-			&& point.x <= world_max.x
-			&& point.y >= world_min.y
-			&& point.y <= world_max.y
-			&& point.z >= world_min.z
-			&& point.z <= world_max.z) {
-			result.push_back(entity);
-		}
-	});
+// Find entities whose bounds intersect a box
+[[nodiscard]] std::vector<flecs::entity>
+ECSWorld::QueryAabb(const spatial::Aabb& bounds, const uint32_t layer_mask) const {
+	std::vector<spatial::DynamicAabbTree::Id> ids;
+	spatial_index_->QueryAabb(bounds, layer_mask, ids);
+	return ToEntities(world_, ids);
+}
+
+// Find entities whose bounds a ray hits, nearest first
+[[nodiscard]] std::vector<SpatialRayHit> ECSWorld::QueryRay(const spatial::Ray& ray, const uint32_t layer_mask) const {
+	std::vector<spatial::DynamicAabbTree::RayHit> hits;
+	spatial_index_->QueryRay(ray, layer_mask, hits);
 
+	std::vector<SpatialRayHit> result;
+	result.reserve(hits.size());
+	for (const auto& [id, distance] : hits) {
+		result.push_back({.entity = flecs::entity(world_, id), .distance = distance});
+	}
 	return result;
 }
 
-// Find entities in sphere
+// Find entities whose bounds are (at least partly) inside a frustum
 [[nodiscard]] std::vector<flecs::entity>
-ECSWorld::QuerySphere(const glm::vec3& center, const float radius, const uint32_t layer_mask) const {
-	std::vector<flecs::entity> result;
-	const float radius_sq = radius * radius;
+ECSWorld::QueryFrustum(const spatial::Frustum& frustum, const uint32_t layer_mask) const {
+	std::vector<spatial::DynamicAabbTree::Id> ids;
+	spatial_index_->QueryFrustum(frustum, layer_mask, ids);
+	return ToEntities(world_, ids);
+}
+
+const spatial::DynamicAabbTree& ECSWorld::GetSpatialIndex() const { return *spatial_index_; }
+
+void ECSWorld::SetupPipeline() {
+	simulation_phase_ = world_.entity("Simulation").add(flecs::Phase).depends_on(flecs::OnUpdate);
+	// PostSimulation hangs off PostUpdate (not Simulation) so it keeps running when edit mode disables Simulation
+	post_simulation_phase_ = world_.entity("PostSimulation").add(flecs::Phase).depends_on(flecs::PostUpdate);
+	pre_render_phase_ = world_.entity("PreRender").add(flecs::Phase).depends_on(flecs::PreStore);
+
+	// Single-phase pipelines match systems by their phase tag directly, so they run even while edit mode
+	// has the phase disabled in the main pipeline
+	const auto phase_pipeline = [this](const flecs::entity phase) {
+		return world_.pipeline().with(flecs::System).with(phase).build();
+	};
+	simulation_pipeline_ = phase_pipeline(simulation_phase_);
+	post_simulation_pipeline_ = phase_pipeline(post_simulation_phase_);
+	pre_render_pipeline_ = phase_pipeline(pre_render_phase_);
+
+	world_.set<SystemProfileState>({});
+	world_.get_mut<SystemProfileState>().systems = world_.query_builder().with(flecs::System).build();
+}
+
+int64_t ECSWorld::BeginSystemProfiling() const {
+	auto& state = world_.get_mut<SystemProfileState>();
+	if (const bool enabled = platform::profiling::IsEnabled(); enabled != state.measuring) {
+		world_.measure_system_time(enabled);
+		state.measuring = enabled;
+		// Time accumulated before (or between) captures must not show up as one huge zone
+		state.entries.clear();
+		state.systems.each([&state](const flecs::entity system) {
+			if (const ecs_system_t* data = ecs_system_get(system.world().c_ptr(), system.id())) {
+				state.entries[system.id()].time_spent = data->time_spent;
+			}
+		});
+	}
+	return platform::profiling::Now();
+}
+
+void ECSWorld::EndSystemProfiling(const int64_t start_ns) const {
+	auto& state = world_.get_mut<SystemProfileState>();
+	if (!state.measuring) {
+		return;
+	}
 
-	const auto query = world_.query<const Transform, const Spatial>();
-	query.each([&](const flecs::entity entity, const Transform& transform, const Spatial& spatial) {
-		if ((spatial.spatial_layer & layer_mask) == 0) {
+	state.ran.clear();
+	state.systems.each([&state](const flecs::entity system) {
+		const ecs_system_t* data = ecs_system_get(system.world().c_ptr(), system.id());
+		if (!data) {
 			return;
 		}
-
-		// Simple distance check to entity center
-		if (const float dist_sq = glm::distance2(transform.position, center); dist_sq <= radius_sq) {
-			result.push_back(entity);
+		auto& entry = state.entries[system.id()];
+		const ecs_ftime_t delta = data->time_spent - entry.time_spent;
+		entry.time_spent = data->time_spent;
+		if (delta <= 0) {
+			return;
 		}
+		if (!entry.zone_name) {
+			const char* name = system.name().c_str();
+			entry.zone_name = platform::profiling::Intern(name && *name ? name : "Unnamed system");
+		}
+		const auto duration_ns = static_cast<int64_t>(static_cast<double>(delta) * 1e9);
+		state.ran.push_back({.system = system.id(), .zone_name = entry.zone_name, .duration_ns = duration_ns});
 	});
 
-	return result;
+	// flecs only reports how long each system took, not when it ran, so lay the systems end to end from the
+	// start of the run, ordered by entity id (roughly creation order, which need not match pipeline order):
+	// durations are exact, offsets and ordering approximate
+	std::ranges::sort(state.ran, {}, &SystemProfileState::Ran::system);
+	int64_t cursor = start_ns;
+	for (const auto& ran : state.ran) {
+		platform::profiling::RecordZone(ran.zone_name, cursor, ran.duration_ns);
+		cursor += ran.duration_ns;
+	}
 }
 
-void ECSWorld::SetupPipeline() {
-	simulation_phase_ = world_.entity("Simulation").add(flecs::Phase).depends_on(flecs::OnUpdate);
+void ECSWorld::SetThreads(const uint32_t count) {
+	thread_count_ = count == 0 ? 1 : count;
+	world_.set_task_threads(static_cast<int32_t>(thread_count_));
+}
+
+uint32_t ECSWorld::GetThreads() const { return thread_count_; }
+
+// Progress simulation phase only (gameplay systems)
+void ECSWorld::ProgressSimulation(const float delta_time) const {
+	PROFILE_ZONE("ECS Simulation");
+	const int64_t start_ns = BeginSystemProfiling();
+	world_.run_pipeline(simulation_pipeline_, delta_time);
+	EndSystemProfiling(start_ns);
+}
+
+// Progress post-simulation phase (transform propagation, bounds)
+void ECSWorld::ProgressPostSimulation(const float delta_time) const {
+	PROFILE_ZONE("ECS PostSimulation");
+	const int64_t start_ns = BeginSystemProfiling();
+	world_.run_pipeline(post_simulation_pipeline_, delta_time);
+	EndSystemProfiling(start_ns);
+}
+
+// Progress pre-render phase (render command submission, UI)
+void ECSWorld::ProgressPreRender(const float delta_time) const {
+	PROFILE_ZONE("ECS PreRender");
+	const int64_t start_ns = BeginSystemProfiling();
+	world_.run_pipeline(pre_render_pipeline_, delta_time);
+	EndSystemProfiling(start_ns);
 }
 
 // Progress all phases (standard full update)
 void ECSWorld::ProgressAll(const float delta_time) const {
+	PROFILE_ZONE("ECS Progress");
 	simulation_phase_.enable();
+	const int64_t start_ns = BeginSystemProfiling();
 	world_.progress(delta_time);
+	EndSystemProfiling(start_ns);
 }
 
 // Progress edit mode (skip simulation, run post-simulation and pre-render)
 void ECSWorld::ProgressEditMode(const float delta_time) const {
+	PROFILE_ZONE("ECS Progress (edit mode)");
 	simulation_phase_.disable();
+	const int64_t start_ns = BeginSystemProfiling();
 	world_.progress(delta_time);
+	EndSystemProfiling(start_ns);
 }
 
 // Legacy method - kept for backwards compatibility
@@ -2,12 +2,16 @@ module;
 
 #include <cstdint>
 #include <flecs.h>
+#include <memory>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 export module engine.ecs;
 
 export import engine.ecs.component_registry;
+export import engine.spatial;
 import engine.components;
 import engine.rendering;
 import glm;
@@ -24,7 +28,7 @@ using Query = flecs::query_base;
 struct SceneEntity {
 	std::string name;
 	bool visible = true;
-	bool static_entity = false; // Static entities don't move (optimization hint)
+	bool static_entity = false; // Static entities don't move; mirrored by the StaticEntity tag
 	uint32_t scene_layer = 0;   // For organizing entities within scenes
 };
 
@@ -32,7 +36,7 @@ struct SceneEntity {
 struct Spatial {
 	glm::vec3 bounding_min{-0.5F, -0.5F, -0.5F};
 	glm::vec3 bounding_max{0.5F, 0.5F, 0.5F};
-	bool bounds_dirty = true;
+	bool bounds_dirty = true;   // Set when the world-space bounds must be refit in the spatial index
 	uint32_t spatial_layer = 0; // For filtering spatial queries
 
 	void UpdateBounds(const glm::vec3& center, const glm::vec3& extents) {
@@ -65,6 +69,12 @@ struct Spatial {
 	}
 };
 
+// Result of ECSWorld::QueryRay
+struct SpatialRayHit {
+	flecs::entity entity;
+	float distance = 0.0F; // Along the ray to where it enters the entity's bounds
+};
+
 // === FLECS RELATIONSHIP TAGS ===
 
 // Built-in flecs relationships we'll use
@@ -74,18 +84,16 @@ struct Spatial {
 // Custom relationship tags
 struct SceneRoot {}; // Tag for scene root entities
 
+// Tag kept in sync with SceneEntity::static_entity. Static entities sit in their own archetype, which the
+// per-frame spatial index and render paths exclude, and moving parents don't drag them along. Their world
+// transform, spatial bounds and render command are cached until ECSWorld::InvalidateStatic() or a write to
+// their own Transform.
+struct StaticEntity {};
+
 // === COMPONENT HELPER FUNCTIONS ===
 namespace component_helpers {
 // Update transform matrix
-inline glm::mat4 ComputeTransformMatrix(const components::Transform& transform) {
-	// Create transformation matrix: T * R * S
-	const glm::mat4 translation = glm::translate(glm::mat4(1.0F), transform.position);
-	const glm::mat4 rotation_x = glm::rotate(glm::mat4(1.0F), transform.rotation.x, glm::vec3(1, 0, 0));
-	const glm::mat4 rotation_y = glm::rotate(glm::mat4(1.0F), transform.rotation.y, glm::vec3(0, 1, 0));
-	const glm::mat4 rotation_z = glm::rotate(glm::mat4(1.0F), transform.rotation.z, glm::vec3(0, 0, 1));
-	const glm::mat4 scale_mat = glm::scale(glm::mat4(1.0F), transform.scale);
-	return translation * rotation_z * rotation_y * rotation_x * scale_mat;
-}
+inline glm::mat4 ComputeTransformMatrix(const components::Transform& transform) { return transform.ComputeMatrix(); }
 
 // Update camera view matrix
 inline void UpdateCameraViewMatrix(components::Camera& camera, const glm::vec3& position) {
@@ -114,11 +122,23 @@ enum class SystemPhase {
 // Flecs world wrapper with engine-specific functionality
 class ECSWorld {
 private:
+	// Broadphase over world-space Spatial bounds, refit in PostSimulation after transform propagation.
+	// Declared before world_ so it outlives the observers that remove entities from it on shutdown.
+	std::unique_ptr<spatial::DynamicAabbTree> spatial_index_;
 	flecs::world world_;
 	flecs::entity active_camera_;
 
 	// Phase entities for custom pipeline
 	flecs::entity simulation_phase_;
+	flecs::entity post_simulation_phase_;
+	flecs::entity pre_render_phase_;
+
+	// Pipelines running a single phase, for the ProgressSimulation/PostSimulation/PreRender entry points
+	flecs::entity simulation_pipeline_;
+	flecs::entity post_simulation_pipeline_;
+	flecs::entity pre_render_pipeline_;
+
+	uint32_t thread_count_ = 1;
 
 public:
 	ECSWorld();
@@ -153,15 +173,31 @@ public:
 	// Get all children of an entity
 	static std::vector<flecs::entity> GetChildren(flecs::entity parent);
 
-	// Get all descendants (recursive)
+	// Get all descendants (recursive, pre-order)
 	static std::vector<flecs::entity> GetDescendants(flecs::entity root);
 
-	// Find entity by name in hierarchy
-	flecs::entity FindEntityByName(const char* name, flecs::entity root = {});
+	// Non-allocating view of all descendants (pre-order). Lists are cached per root and rebuilt only after
+	// the hierarchy changes. The view is invalidated by the next hierarchy change, and by later descendant
+	// queries (GetDescendants/GetDescendantsView) once 64 other roots have been queried since. Copy it if it
+	// must outlive either. Main thread only.
+	[[nodiscard]] std::span<const flecs::entity> GetDescendantsView(flecs::entity root) const;
+
+	// Find entity by SceneEntity name (hash lookup), optionally only among descendants of root
+	[[nodiscard]] flecs::entity FindEntityByName(const char* name, flecs::entity root = {}) const;
+
+	// Find entity by slash-separated SceneEntity names, e.g. "Player/Weapon/Muzzle". With a root the path
+	// starts at the root's children; without one it may start anywhere.
+	[[nodiscard]] flecs::entity FindEntityByPath(std::string_view path, flecs::entity root = {}) const;
 
 	// Check if entity is descendant of another
 	static bool IsDescendantOf(flecs::entity entity, flecs::entity ancestor);
 
+	// === STATIC ENTITIES ===
+
+	// Recompute the cached world transform, spatial bounds and render command of a static entity and its
+	// static descendants in the next PostSimulation pass, e.g. after moving one of their ancestors
+	static void InvalidateStatic(flecs::entity entity);
+
 	// === CAMERA MANAGEMENT ===
 
 	void SetActiveCamera(flecs::entity camera);
@@ -170,15 +206,40 @@ public:
 
 	// === SPATIAL QUERIES ===
 
+	// Queries test world-space Spatial bounds as of the last PostSimulation pass. Only entities whose
+	// spatial_layer shares a bit with layer_mask are returned.
+
 	// Find entities at a point
 	[[nodiscard]] std::vector<flecs::entity> QueryPoint(const glm::vec3& point, uint32_t layer_mask = 0xFFFFFFFF) const;
 
-	// Find entities in sphere
+	// Find entities whose bounds intersect a sphere
 	[[nodiscard]] std::vector<flecs::entity>
 	QuerySphere(const glm::vec3& center, float radius, uint32_t layer_mask = 0xFFFFFFFF) const;
 
+	// Find entities whose bounds intersect a box
+	[[nodiscard]] std::vector<flecs::entity>
+	QueryAabb(const spatial::Aabb& bounds, uint32_t layer_mask = 0xFFFFFFFF) const;
+
+	// Find entities whose bounds a ray hits, nearest first
+	[[nodiscard]] std::vector<SpatialRayHit> QueryRay(const spatial::Ray& ray, uint32_t layer_mask = 0xFFFFFFFF) const;
+
+	// Find entities whose bounds are (at least partly) inside a frustum
+	[[nodiscard]] std::vector<flecs::entity>
+	QueryFrustum(const spatial::Frustum& frustum, uint32_t layer_mask = 0xFFFFFFFF) const;
+
+	// Direct access to the broadphase (e.g. to reuse result buffers across queries)
+	[[nodiscard]] const spatial::DynamicAabbTree& GetSpatialIndex() const;
+
 	// === ECS UPDATE (PHASED) ===
 
+	// Worker stages (including the main thread) used by systems marked multi_threaded. Each such system
+	// splits its matched entities across the stages, whose work runs as jobs on the engine job system;
+	// flecs inserts sync points from the read/write access each system declares. 1 runs everything on
+	// the calling thread.
+	void SetThreads(uint32_t count);
+
+	[[nodiscard]] uint32_t GetThreads() const;
+
 	// Progress simulation phase only (gameplay systems)
 	void ProgressSimulation(float delta_time) const;
 
@@ -209,6 +270,11 @@ public:
 private:
 	void SetupPipeline();
 
+	// Bracket a pipeline run so each system that ran gets a profiler zone (no-ops while profiling is off)
+	[[nodiscard]] int64_t BeginSystemProfiling() const;
+
+	void EndSystemProfiling(int64_t start_ns) const;
+
 	void SetupMovementSystem() const;
 
 	void SetupRotationSystem() const;
@@ -217,10 +283,42 @@ private:
 
 	void SetupSpatialSystem() const;
 
+	void SetupHierarchyIndex() const;
+
 	void SetupTransformSystem() const;
 
+	void SetupStaticEntities() const;
+
 	void SetupAnimationSystem() const;
 
 	void SetupAudioSystem() const;
 };
 } // namespace engine::ecs
+
+// Module-internal state shared by the ECS implementation units
+namespace engine::ecs {
+struct RenderEntry {
+	rendering::RenderCommand command; // camera_view is filled in at submission
+	glm::mat4 normal_matrix{1.0F};
+	spatial::Aabb world_bounds;
+	bool has_bounds = false; // Entities without a Spatial component are never culled
+	bool transparent = false;
+};
+
+// Singleton tracking StaticEntity-tagged entities
+struct StaticEntityCache {
+	std::vector<flecs::entity_t> refreshed; // WorldTransform or Spatial changed since the last refresh pass
+	std::vector<RenderEntry> render_entries;
+	bool render_entries_dirty = true;
+};
+
+// Singleton holding SubmitRenderCommands' per-frame arrays, kept between frames so they stop reallocating
+struct RenderFrameCache {
+	std::vector<RenderEntry> dynamic_entries;
+	rendering::RenderQueue queue;
+	std::vector<rendering::InstanceData> instances; // Scratch for the instanced run being submitted
+	spatial::AabbBatch cull_boxes;      // World bounds of the entries that have them
+	std::vector<uint32_t> cull_entries; // Entry index of each box in cull_boxes
+	std::vector<uint32_t> visible_boxes;
+};
+} // namespace engine::ecs
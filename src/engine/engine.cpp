@@ -10,6 +10,8 @@ module;
 #include <exception>
 #include <memory>
 
+#include "platform/profiler.h"
+
 module engine;
 
 namespace engine {
@@ -44,6 +46,20 @@ bool Engine::Init(const uint32_t window_width, const uint32_t window_height) {
 		rendering::GetRenderer().SetWindowSize(static_cast<uint32_t>(width), static_cast<uint32_t>(height));
 	});
 
+	// Initialize audio system
+	audio::AudioSystem::Get().Initialize();
+
+	return InitCommonSystems();
+}
+
+bool Engine::InitHeadless() {
+	headless_ = true;
+	// Must precede any renderer use so resource managers never touch GL
+	rendering::SetHeadless(true);
+	return InitCommonSystems();
+}
+
+bool Engine::InitCommonSystems() {
 	// Initialize scripting system with default language (Lua)
 	try {
 		scripting_system = std::make_unique<scripting::ScriptingSystem>();
@@ -53,10 +69,9 @@ bool Engine::Init(const uint32_t window_width, const uint32_t window_height) {
 		return false;
 	}
 
-	// Initialize audio system
-	audio::AudioSystem::Get().Initialize();
-
-	// ECSWorld is constructed automatically
+	// ECSWorld is constructed automatically; its worker stages run on the shared job system, one per
+	// thread the pool can keep busy
+	ecs.SetThreads(platform::threading::GetJobSystem().MaxConcurrency());
 	scene::InitializeSceneSystem(ecs);
 	return true;
 }
@@ -64,8 +79,11 @@ bool Engine::Init(const uint32_t window_width, const uint32_t window_height) {
 void Engine::Update(const float dt) { Update(dt, UpdateMode::Full); }
 
 void Engine::Update(const float dt, const UpdateMode mode) {
+	PROFILE_ZONE("Engine::Update");
 	// Poll input events
-	input::Input::PollEvents();
+	if (!headless_) {
+		input::Input::PollEvents();
+	}
 
 	// Progress ECS world based on update mode
 	switch (mode) {
@@ -74,17 +92,35 @@ void Engine::Update(const float dt, const UpdateMode mode) {
 	}
 
 	// Render scene
-	ecs.SubmitRenderCommands(*renderer);
+	if (renderer) {
+		ecs.SubmitRenderCommands(*renderer);
+	}
 	// ...update other subsystems as needed...
 }
 
+double Engine::RunHeadless(const uint64_t frame_count, const float fixed_timestep, const bool real_time) {
+	platform::FrameRateController frame_rate(1.0 / static_cast<double>(fixed_timestep));
+	platform::Timer timer;
+	timer.Start();
+	for (uint64_t frame = 0; frame < frame_count; ++frame) {
+		frame_rate.FrameStart();
+		Update(fixed_timestep, UpdateMode::Full);
+		if (real_time) {
+			frame_rate.FrameEnd(); // Sleeps out the remainder of the tick
+		}
+	}
+	return timer.ElapsedSeconds();
+}
+
 void Engine::Shutdown() {
 	// Shutdown scripting system (unique_ptr handles cleanup automatically)
 	scripting_system.reset();
 	// Shutdown audio system
 	audio::AudioSystem::Get().Shutdown();
 	// Shutdown input system
-	input::Input::Shutdown();
+	if (!headless_) {
+		input::Input::Shutdown();
+	}
 	// Shutdown renderer
 	if (renderer) {
 		renderer->Shutdown();
@@ -19,6 +19,7 @@ export import engine.asset_registry;
 export import engine.assets;
 export import engine.platform;
 export import engine.ecs;
+export import engine.spatial;
 export import engine.scene;
 export import engine.scene.serializer;
 export import engine.scene.prefab;
@@ -56,6 +57,17 @@ public:
 
 	bool Init(std::uint32_t window_width, uint32_t window_height);
 
+	// Initialize without a window, GL context, input or audio device (dedicated servers, CI, batch
+	// simulation). Rendering resources are tracked CPU-side only and nothing is drawn; renderer stays null.
+	bool InitHeadless();
+
+	[[nodiscard]] bool IsHeadless() const { return headless_; }
+
+	// Run frame_count full updates with a fixed timestep. Unthrottled by default; with real_time set,
+	// each frame is padded to fixed_timestep of wall-clock time (a fixed-rate server tick).
+	// Returns the wall-clock seconds taken.
+	double RunHeadless(uint64_t frame_count, float fixed_timestep = 1.0F / 60.0F, bool real_time = false);
+
 	void Update(float dt);
 
 	// Update with specific mode (full or edit mode)
@@ -73,5 +85,10 @@ public:
 	// Input system: managed via input::Input namespace (no instance needed)
 	// Scene system: add if you have a SceneSystem class
 	std::unique_ptr<scripting::ScriptingSystem> scripting_system;
+
+private:
+	bool InitCommonSystems();
+
+	bool headless_{false};
 };
 } // namespace engine
@@ -11,6 +11,8 @@ module;
 
 #include <spdlog/spdlog.h>
 
+#include "platform/profiler.h"
+
 // Bullet3 includes
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
 #include <BulletDynamics/Character/btKinematicCharacterController.h>
@@ -18,6 +20,7 @@ module;
 
 module engine.physics;
 
+import engine.platform;
 import glm;
 
 namespace engine::physics {
@@ -262,6 +265,7 @@ public:
 		if (!initialized_ || !dynamics_world_) {
 			return;
 		}
+		PROFILE_ZONE("Bullet3 StepSimulation");
 
 		// Clear previous collision events
 		collision_events_.clear();
@@ -64,7 +64,13 @@ Bullet3PhysicsModule::Bullet3PhysicsModule(const flecs::world& world) {
 				  const RigidBody& rb,
 				  const CollisionShape& cs
 			  ) {
-			backend->SyncBodyToBackend(e.id(), PhysicsTransform::FromMatrix(wt.matrix), rb, cs);
+			// WorldTransform already carries the world-space orientation, so no matrix decomposition is needed
+			backend->SyncBodyToBackend(
+				e.id(),
+				{.position = wt.position, .rotation = wt.rotation, .scale = wt.scale},
+				rb,
+				cs
+			);
 
 			if (rb.motion_type == MotionType::Dynamic && !e.has<PhysicsVelocity>()) {
 				e.set<PhysicsVelocity>({});
@@ -79,6 +85,7 @@ Bullet3PhysicsModule::Bullet3PhysicsModule(const flecs::world& world) {
 	// System: Apply forces
 	world.system<const PhysicsForce>("Bullet3ApplyForces")
 		.kind(simulation_phase)
+		.write<PhysicsForce>() // Removed once applied
 		.each([backend](const flecs::entity e, const PhysicsForce& force) {
 			if (backend->HasBody(e.id())) {
 				backend->ApplyForce(e.id(), force.force, force.torque);
@@ -91,6 +98,7 @@ Bullet3PhysicsModule::Bullet3PhysicsModule(const flecs::world& world) {
 	// System: Apply impulses (consumed immediately)
 	world.system<const PhysicsImpulse>("Bullet3ApplyImpulses")
 		.kind(simulation_phase)
+		.write<PhysicsImpulse>() // Removed once applied
 		.each([backend](const flecs::entity e, const PhysicsImpulse& impulse) {
 			if (backend->HasBody(e.id())) {
 				backend->ApplyImpulse(e.id(), impulse.impulse, impulse.point);
@@ -102,28 +110,33 @@ Bullet3PhysicsModule::Bullet3PhysicsModule(const flecs::world& world) {
 	world.set<Bullet3Accumulator>({});
 
 	// System: Step simulation with fixed timestep
-	world.system("Bullet3PhysicsStep").kind(simulation_phase).run([backend](const flecs::iter& it) {
-		const auto world = it.world();
-		auto& [accumulated_time] = world.get_mut<Bullet3Accumulator>();
-		const auto& cfg = world.get<PhysicsWorldConfig>();
-
-		backend->SetGravity(cfg.gravity);
-
-		accumulated_time += it.delta_time();
-
-		int steps = 0;
-		while (accumulated_time >= cfg.fixed_timestep && steps < cfg.max_substeps) {
-			backend->StepSimulation(cfg.fixed_timestep);
-			accumulated_time -= cfg.fixed_timestep;
-			++steps;
-		}
+	world.system("Bullet3PhysicsStep")
+		.kind(simulation_phase)
+		.read<PhysicsWorldConfig>()
+		.write<Bullet3Accumulator>()
+		.run([backend](const flecs::iter& it) {
+			const auto world = it.world();
+			auto& [accumulated_time] = world.get_mut<Bullet3Accumulator>();
+			const auto& cfg = world.get<PhysicsWorldConfig>();
+
+			backend->SetGravity(cfg.gravity);
+
+			accumulated_time += it.delta_time();
+
+			int steps = 0;
+			while (accumulated_time >= cfg.fixed_timestep && steps < cfg.max_substeps) {
+				backend->StepSimulation(cfg.fixed_timestep);
+				accumulated_time -= cfg.fixed_timestep;
+				++steps;
+			}
 
-		accumulated_time = std::min(accumulated_time, cfg.fixed_timestep * cfg.max_substeps);
-	});
+			accumulated_time = std::min(accumulated_time, cfg.fixed_timestep * cfg.max_substeps);
+		});
 
 	// System: Sync results back to ECS
 	world.system<components::WorldTransform, PhysicsVelocity, const RigidBody>("Bullet3SyncFromBackend")
 		.kind(simulation_phase)
+		.write<components::Transform>() // Children are flagged for propagation
 		.each(
 			[backend](const flecs::entity e, components::WorldTransform& wt, PhysicsVelocity& v, const RigidBody& rb) {
 				if (rb.motion_type != MotionType::Dynamic || !backend->HasBody(e.id())) {
@@ -136,7 +149,7 @@ Bullet3PhysicsModule::Bullet3PhysicsModule(const flecs::world& world) {
 				// Physics owns WorldTransform — write world-space values directly.
 				// Transform stays local-space (initial offset from parent).
 				wt.position = position;
-				wt.rotation = glm::eulerAngles(rotation);
+				wt.rotation = rotation;
 				// Preserve scale from TransformPropagation (physics doesn't affect scale)
 				wt.ComputeMatrix();
 
@@ -153,24 +166,27 @@ Bullet3PhysicsModule::Bullet3PhysicsModule(const flecs::world& world) {
 		);
 
 	// System: Clear old collision events, then distribute new ones
-	world.system("Bullet3CollisionEvents").kind(simulation_phase).run([backend](const flecs::iter& it) {
-		const auto world = it.world();
+	world.system("Bullet3CollisionEvents")
+		.kind(simulation_phase)
+		.write<CollisionEvents>()
+		.run([backend](const flecs::iter& it) {
+			const auto world = it.world();
 
-		// Clear previous frame's collision events
-		world.query<CollisionEvents>().each([](CollisionEvents& ce) { ce.events.clear(); });
+			// Clear previous frame's collision events
+			world.query<CollisionEvents>().each([](CollisionEvents& ce) { ce.events.clear(); });
 
-		for (const auto events = backend->GetCollisionEvents(); const auto& event : events) {
-			auto entity_a = world.entity(event.entity_a);
-			auto entity_b = world.entity(event.entity_b);
+			for (const auto events = backend->GetCollisionEvents(); const auto& event : events) {
+				auto entity_a = world.entity(event.entity_a);
+				auto entity_b = world.entity(event.entity_b);
 
-			if (entity_a.is_valid() && entity_a.has<CollisionEvents>()) {
-				entity_a.get_mut<CollisionEvents>().events.push_back(event);
-			}
-			if (entity_b.is_valid() && entity_b.has<CollisionEvents>()) {
-				entity_b.get_mut<CollisionEvents>().events.push_back(event);
+				if (entity_a.is_valid() && entity_a.has<CollisionEvents>()) {
+					entity_a.get_mut<CollisionEvents>().events.push_back(event);
+				}
+				if (entity_b.is_valid() && entity_b.has<CollisionEvents>()) {
+					entity_b.get_mut<CollisionEvents>().events.push_back(event);
+				}
 			}
-		}
-	});
+		});
 
 	spdlog::info("[Bullet3PhysicsModule] Registered with flecs");
 }
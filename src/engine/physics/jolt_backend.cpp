@@ -13,13 +13,15 @@ module;
 
 #include <spdlog/spdlog.h>
 
+#include "platform/profiler.h"
+
 // Jolt Physics includes. Order matters here.
 // clang-format off
 #include <Jolt/Jolt.h>
 #include <Jolt/RegisterTypes.h>
 #include <Jolt/Core/Factory.h>
 #include <Jolt/Core/TempAllocator.h>
-#include <Jolt/Core/JobSystemThreadPool.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
 #include <Jolt/Physics/PhysicsSettings.h>
 #include <Jolt/Physics/PhysicsSystem.h>
 #include <Jolt/Physics/Collision/Shape/BoxShape.h>
@@ -42,6 +44,7 @@ module;
 
 module engine.physics;
 
+import engine.platform;
 import glm;
 
 // Jolt callback for trace messages
@@ -184,6 +187,52 @@ private:
 	std::vector<CollisionInfo> collision_events_;
 };
 
+// Routes Jolt's physics jobs onto the engine-wide job system instead of a private thread pool,
+// so the physics step shares worker threads with ECS and asset work rather than oversubscribing cores
+class EngineJobSystemAdapter final : public JPH::JobSystemWithBarrier {
+public:
+	explicit EngineJobSystemAdapter(platform::threading::JobSystem& job_system, const uint32_t max_barriers) :
+			JPH::JobSystemWithBarrier(max_barriers), job_system_(job_system) {}
+
+	[[nodiscard]] int GetMaxConcurrency() const override { return static_cast<int>(job_system_.MaxConcurrency()); }
+
+	JobHandle CreateJob(
+		const char* inName,
+		JPH::ColorArg inColor,
+		const JobFunction& inJobFunction,
+		const JPH::uint32 inNumDependencies
+	) override {
+		// JobHandle takes a reference; the job frees itself through FreeJob once all references drop
+		auto* job = new Job(inName, inColor, this, inJobFunction, inNumDependencies);
+		JobHandle handle(job);
+		if (inNumDependencies == 0) {
+			QueueJob(job);
+		}
+		return handle;
+	}
+
+protected:
+	void QueueJob(Job* inJob) override {
+		// Keep the job alive until the worker has run it
+		inJob->AddRef();
+		job_system_.Submit([inJob]() {
+			inJob->Execute();
+			inJob->Release();
+		});
+	}
+
+	void QueueJobs(Job** inJobs, const JPH::uint inNumJobs) override {
+		for (JPH::uint i = 0; i < inNumJobs; ++i) {
+			QueueJob(inJobs[i]);
+		}
+	}
+
+	void FreeJob(Job* inJob) override { delete inJob; }
+
+private:
+	platform::threading::JobSystem& job_system_;
+};
+
 // JoltPhysics backend implementation
 class JoltPhysicsBackend : public IPhysicsBackend {
 private:
@@ -192,7 +241,7 @@ private:
 
 	// Jolt objects
 	std::unique_ptr<JPH::TempAllocatorImpl> temp_allocator_;
-	std::unique_ptr<JPH::JobSystemThreadPool> job_system_;
+	std::unique_ptr<EngineJobSystemAdapter> job_system_;
 	std::unique_ptr<BPLayerInterfaceImpl> broad_phase_layer_interface_;
 	std::unique_ptr<ObjectVsBroadPhaseLayerFilterImpl> object_vs_broad_phase_layer_filter_;
 	std::unique_ptr<ObjectLayerPairFilterImpl> object_layer_pair_filter_;
@@ -375,13 +424,10 @@ public:
 		// Create temp allocator (10MB)
 		temp_allocator_ = std::make_unique<JPH::TempAllocatorImpl>(10 * 1024 * 1024);
 
-		// Create job system (use hardware thread count - 1, min 1)
-		auto num_threads = std::max(1U, std::thread::hardware_concurrency() - 1);
-		job_system_ = std::make_unique<JPH::JobSystemThreadPool>(
-			JPH::cMaxPhysicsJobs,
-			JPH::cMaxPhysicsBarriers,
-			static_cast<int>(num_threads)
-		);
+		// Run physics jobs on the shared engine job system
+		auto& engine_jobs = platform::threading::GetJobSystem();
+		const auto num_threads = engine_jobs.WorkerCount();
+		job_system_ = std::make_unique<EngineJobSystemAdapter>(engine_jobs, JPH::cMaxPhysicsBarriers);
 
 		// Create broad phase layer interface
 		broad_phase_layer_interface_ = std::make_unique<BPLayerInterfaceImpl>();
@@ -466,6 +512,7 @@ public:
 		if (!initialized_ || !physics_system_) {
 			return;
 		}
+		PROFILE_ZONE("Jolt StepSimulation");
 
 		// Clear collision events from previous frame
 		if (contact_listener_) {
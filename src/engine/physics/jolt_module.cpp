@@ -67,7 +67,13 @@ JoltPhysicsModule::JoltPhysicsModule(const flecs::world& world) {
 				  const RigidBody& rb,
 				  const CollisionShape& cs
 			  ) {
-			backend->SyncBodyToBackend(e.id(), PhysicsTransform::FromMatrix(wt.matrix), rb, cs);
+			// WorldTransform already carries the world-space orientation, so no matrix decomposition is needed
+			backend->SyncBodyToBackend(
+				e.id(),
+				{.position = wt.position, .rotation = wt.rotation, .scale = wt.scale},
+				rb,
+				cs
+			);
 
 			// Add PhysicsVelocity if not present (for dynamic bodies)
 			if (rb.motion_type == MotionType::Dynamic && !e.has<PhysicsVelocity>()) {
@@ -83,6 +89,7 @@ JoltPhysicsModule::JoltPhysicsModule(const flecs::world& world) {
 	// System: Apply forces from PhysicsForce components
 	world.system<const PhysicsForce>("JoltApplyForces")
 		.kind(simulation_phase)
+		.write<PhysicsForce>() // Removed once applied
 		.each([backend](const flecs::entity e, const PhysicsForce& force) {
 			if (backend->HasBody(e.id())) {
 				backend->ApplyForce(e.id(), force.force, force.torque);
@@ -95,6 +102,7 @@ JoltPhysicsModule::JoltPhysicsModule(const flecs::world& world) {
 	// System: Apply impulses from PhysicsImpulse components (consumed immediately)
 	world.system<const PhysicsImpulse>("JoltApplyImpulses")
 		.kind(simulation_phase)
+		.write<PhysicsImpulse>() // Removed once applied
 		.each([backend](const flecs::entity e, const PhysicsImpulse& impulse) {
 			if (backend->HasBody(e.id())) {
 				backend->ApplyImpulse(e.id(), impulse.impulse, impulse.point);
@@ -106,29 +114,34 @@ JoltPhysicsModule::JoltPhysicsModule(const flecs::world& world) {
 	world.set<PhysicsAccumulator>({});
 
 	// System: Step physics simulation (runs once per frame, handles fixed timestep)
-	world.system("JoltPhysicsStep").kind(simulation_phase).run([backend](const flecs::iter& it) {
-		const auto world = it.world();
-		auto& [accumulated_time] = world.get_mut<PhysicsAccumulator>();
-		const auto& cfg = world.get<PhysicsWorldConfig>();
-
-		backend->SetGravity(cfg.gravity);
-
-		accumulated_time += it.delta_time();
-
-		int steps = 0;
-		while (accumulated_time >= cfg.fixed_timestep && steps < cfg.max_substeps) {
-			backend->StepSimulation(cfg.fixed_timestep);
-			accumulated_time -= cfg.fixed_timestep;
-			++steps;
-		}
+	world.system("JoltPhysicsStep")
+		.kind(simulation_phase)
+		.read<PhysicsWorldConfig>()
+		.write<PhysicsAccumulator>()
+		.run([backend](const flecs::iter& it) {
+			const auto world = it.world();
+			auto& [accumulated_time] = world.get_mut<PhysicsAccumulator>();
+			const auto& cfg = world.get<PhysicsWorldConfig>();
+
+			backend->SetGravity(cfg.gravity);
+
+			accumulated_time += it.delta_time();
+
+			int steps = 0;
+			while (accumulated_time >= cfg.fixed_timestep && steps < cfg.max_substeps) {
+				backend->StepSimulation(cfg.fixed_timestep);
+				accumulated_time -= cfg.fixed_timestep;
+				++steps;
+			}
 
-		// Clamp to prevent spiral of death
-		accumulated_time = std::min(accumulated_time, cfg.fixed_timestep * cfg.max_substeps);
-	});
+			// Clamp to prevent spiral of death
+			accumulated_time = std::min(accumulated_time, cfg.fixed_timestep * cfg.max_substeps);
+		});
 
 	// System: Sync results from backend back to ECS components
 	world.system<components::WorldTransform, PhysicsVelocity, const RigidBody>("JoltSyncFromBackend")
 		.kind(simulation_phase)
+		.write<components::Transform>() // Children are flagged for propagation
 		.each(
 			[backend](const flecs::entity e, components::WorldTransform& wt, PhysicsVelocity& v, const RigidBody& rb) {
 				if (rb.motion_type != MotionType::Dynamic || !backend->HasBody(e.id())) {
@@ -141,7 +154,7 @@ JoltPhysicsModule::JoltPhysicsModule(const flecs::world& world) {
 				// Physics owns WorldTransform — write world-space values directly.
 				// Transform stays local-space (initial offset from parent).
 				wt.position = position;
-				wt.rotation = glm::eulerAngles(rotation);
+				wt.rotation = rotation;
 				// Preserve scale from TransformPropagation (physics doesn't affect scale)
 				wt.ComputeMatrix();
 
@@ -158,24 +171,27 @@ JoltPhysicsModule::JoltPhysicsModule(const flecs::world& world) {
 		);
 
 	// System: Clear old collision events, then distribute new ones
-	world.system("JoltCollisionEvents").kind(simulation_phase).run([backend](const flecs::iter& it) {
-		const auto world = it.world();
+	world.system("JoltCollisionEvents")
+		.kind(simulation_phase)
+		.write<CollisionEvents>()
+		.run([backend](const flecs::iter& it) {
+			const auto world = it.world();
 
-		// Clear previous frame's collision events
-		world.query<CollisionEvents>().each([](CollisionEvents& ce) { ce.events.clear(); });
+			// Clear previous frame's collision events
+			world.query<CollisionEvents>().each([](CollisionEvents& ce) { ce.events.clear(); });
 
-		for (const auto events = backend->GetCollisionEvents(); const auto& event : events) {
-			auto entity_a = world.entity(event.entity_a);
-			auto entity_b = world.entity(event.entity_b);
+			for (const auto events = backend->GetCollisionEvents(); const auto& event : events) {
+				auto entity_a = world.entity(event.entity_a);
+				auto entity_b = world.entity(event.entity_b);
 
-			if (entity_a.is_valid() && entity_a.has<CollisionEvents>()) {
-				entity_a.get_mut<CollisionEvents>().events.push_back(event);
-			}
-			if (entity_b.is_valid() && entity_b.has<CollisionEvents>()) {
-				entity_b.get_mut<CollisionEvents>().events.push_back(event);
+				if (entity_a.is_valid() && entity_a.has<CollisionEvents>()) {
+					entity_a.get_mut<CollisionEvents>().events.push_back(event);
+				}
+				if (entity_b.is_valid() && entity_b.has<CollisionEvents>()) {
+					entity_b.get_mut<CollisionEvents>().events.push_back(event);
+				}
 			}
-		}
-	});
+		});
 
 	spdlog::info("[JoltPhysicsModule] Registered with flecs");
 }
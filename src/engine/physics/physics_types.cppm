@@ -233,11 +233,8 @@ struct PhysicsTransform {
 
 	[[nodiscard]] glm::mat4 GetMatrix() const {
 		const glm::mat4 translation = glm::translate(glm::mat4(1.0F), position);
-		const glm::mat4 rotation_x = glm::rotate(glm::mat4(1.0F), rotation.x, glm::vec3(1, 0, 0));
-		const glm::mat4 rotation_y = glm::rotate(glm::mat4(1.0F), rotation.y, glm::vec3(0, 1, 0));
-		const glm::mat4 rotation_z = glm::rotate(glm::mat4(1.0F), rotation.z, glm::vec3(0, 0, 1));
 		const glm::mat4 scale_mat = glm::scale(glm::mat4(1.0F), scale);
-		return translation * rotation_z * rotation_y * rotation_x * scale_mat;
+		return translation * glm::mat4_cast(rotation) * scale_mat;
 	}
 
 	static PhysicsTransform FromMatrix(const glm::mat4& matrix) {
@@ -0,0 +1,266 @@
+// Work-stealing job system implementation
+module;
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+module engine.platform;
+
+namespace engine::platform::threading {
+
+namespace {
+// Identifies which pool (if any) the current thread works for, and its deque index
+thread_local const void* tls_owner = nullptr;
+thread_local size_t tls_worker_index = 0;
+
+// Padded so neighbouring deques don't share a cache line
+struct alignas(64) WorkerQueue {
+	std::mutex mutex;
+	std::deque<Job> jobs;
+};
+} // namespace
+
+struct JobSystem::Impl {
+	std::vector<std::unique_ptr<WorkerQueue>> queues; // One per worker
+	std::vector<std::thread> workers;
+
+	std::atomic<uint32_t> queued_jobs{0};
+	std::atomic<uint32_t> next_queue{0}; // Round-robin target for submissions from non-worker threads
+	std::atomic<bool> running{true};
+
+	// Idle workers sleep here; sleeping_workers lets Enqueue skip the lock when everyone is busy
+	std::mutex sleep_mutex;
+	std::condition_variable wake;
+	std::atomic<uint32_t> sleeping_workers{0};
+
+	[[nodiscard]] bool IsOwnWorker() const { return tls_owner == this; }
+
+	bool TryAcquire(Job& out) {
+		const size_t count = queues.size();
+		const bool own_worker = IsOwnWorker();
+
+		// Owner end: LIFO keeps recently spawned (cache-warm) work on the same thread
+		if (own_worker) {
+			auto& queue = *queues[tls_worker_index];
+			std::scoped_lock lock(queue.mutex);
+			if (!queue.jobs.empty()) {
+				out = std::move(queue.jobs.back());
+				queue.jobs.pop_back();
+				queued_jobs.fetch_sub(1);
+				return true;
+			}
+		}
+
+		// Thief end: FIFO takes the oldest (usually largest) work from peers
+		const size_t start = own_worker ? tls_worker_index + 1 : next_queue.load(std::memory_order_relaxed);
+		for (size_t i = 0; i < count; ++i) {
+			const size_t index = (start + i) % count;
+			if (own_worker && index == tls_worker_index) {
+				continue;
+			}
+			auto& queue = *queues[index];
+			std::scoped_lock lock(queue.mutex);
+			if (!queue.jobs.empty()) {
+				out = std::move(queue.jobs.front());
+				queue.jobs.pop_front();
+				queued_jobs.fetch_sub(1);
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
+JobSystem::JobSystem(uint32_t worker_count) : pimpl_(std::make_unique<Impl>()) {
+	if (worker_count == 0) {
+		worker_count = std::max(1U, HardwareConcurrency() - 1);
+	}
+
+	pimpl_->queues.reserve(worker_count);
+	for (uint32_t i = 0; i < worker_count; ++i) {
+		pimpl_->queues.push_back(std::make_unique<WorkerQueue>());
+	}
+
+	pimpl_->workers.reserve(worker_count);
+	for (uint32_t i = 0; i < worker_count; ++i) {
+		pimpl_->workers.emplace_back([this, i]() {
+			tls_owner = pimpl_.get();
+			tls_worker_index = i;
+			SetCurrentThreadName("Job Worker " + std::to_string(i));
+
+			auto& impl = *pimpl_;
+			while (true) {
+				if (TryRunOne()) {
+					continue;
+				}
+
+				std::unique_lock lock(impl.sleep_mutex);
+				impl.sleeping_workers.fetch_add(1);
+				impl.wake.wait(lock, [&impl]() { return impl.queued_jobs.load() > 0 || !impl.running.load(); });
+				impl.sleeping_workers.fetch_sub(1);
+
+				// Drain remaining work before exiting so submitted jobs are never dropped
+				if (!impl.running.load() && impl.queued_jobs.load() == 0) {
+					break;
+				}
+			}
+
+			tls_owner = nullptr;
+		});
+	}
+}
+
+JobSystem::~JobSystem() {
+	{
+		std::scoped_lock lock(pimpl_->sleep_mutex);
+		pimpl_->running.store(false);
+	}
+	pimpl_->wake.notify_all();
+	for (auto& worker : pimpl_->workers) {
+		if (worker.joinable()) {
+			worker.join();
+		}
+	}
+}
+
+void JobSystem::Submit(JobFunction function, JobCounter* counter) {
+	if (counter) {
+		counter->pending_.fetch_add(1, std::memory_order_acq_rel);
+	}
+	Enqueue({.function = std::move(function), .counter = counter});
+}
+
+void JobSystem::Submit(JobFunction function, JobCounter* counter, JobCounter& dependency) {
+	if (counter) {
+		counter->pending_.fetch_add(1, std::memory_order_acq_rel);
+	}
+
+	Job job{.function = std::move(function), .counter = counter};
+	{
+		// The final Finish() on the dependency flushes continuations under this lock, so checking
+		// pending_ here cannot race with the release and lose the job
+		LockGuard lock(dependency.continuation_mutex_);
+		if (dependency.pending_.load(std::memory_order_acquire) != 0) {
+			dependency.continuations_.push_back(std::move(job));
+			return;
+		}
+	}
+	Enqueue(std::move(job));
+}
+
+void JobSystem::Wait(const JobCounter& counter) {
+	while (counter.pending_.load(std::memory_order_acquire) != 0) {
+		if (!TryRunOne()) {
+			YieldCurrentThread();
+		}
+	}
+	// The thread that dropped the count to zero still holds this lock while releasing
+	// continuations; wait for it so the caller may safely destroy the counter on return
+	LockGuard lock(counter.continuation_mutex_);
+}
+
+void JobSystem::ParallelFor(
+	const size_t begin,
+	const size_t end,
+	size_t grain_size,
+	const std::function<void(size_t, size_t)>& body
+) {
+	if (end <= begin) {
+		return;
+	}
+
+	const size_t count = end - begin;
+	if (grain_size == 0) {
+		grain_size = std::max<size_t>(1, count / (static_cast<size_t>(MaxConcurrency()) * 4));
+	}
+	if (count <= grain_size) {
+		body(begin, end);
+		return;
+	}
+
+	// Queue every chunk but the first, which the calling thread runs itself
+	JobCounter counter;
+	for (size_t chunk_begin = begin + grain_size; chunk_begin < end; chunk_begin += grain_size) {
+		const size_t chunk_end = std::min(chunk_begin + grain_size, end);
+		Submit([&body, chunk_begin, chunk_end]() { body(chunk_begin, chunk_end); }, &counter);
+	}
+	body(begin, begin + grain_size);
+	Wait(counter);
+}
+
+uint32_t JobSystem::WorkerCount() const { return static_cast<uint32_t>(pimpl_->workers.size()); }
+
+bool JobSystem::IsWorkerThread() const { return pimpl_->IsOwnWorker(); }
+
+void JobSystem::Enqueue(Job job) {
+	auto& impl = *pimpl_;
+	const size_t index = impl.IsOwnWorker() ? tls_worker_index
+											: impl.next_queue.fetch_add(1, std::memory_order_relaxed) % impl.queues.size();
+	{
+		auto& queue = *impl.queues[index];
+		std::scoped_lock lock(queue.mutex);
+		queue.jobs.push_back(std::move(job));
+	}
+	impl.queued_jobs.fetch_add(1);
+
+	if (impl.sleeping_workers.load() > 0) {
+		// Taking the lock orders this notify after a worker's predicate check, so the wake-up isn't lost
+		{ std::scoped_lock lock(impl.sleep_mutex); }
+		impl.wake.notify_one();
+	}
+}
+
+bool JobSystem::TryRunOne() {
+	Job job;
+	if (!pimpl_->TryAcquire(job)) {
+		return false;
+	}
+	job.function();
+	Finish(job.counter);
+	return true;
+}
+
+void JobSystem::Finish(JobCounter* counter) {
+	if (!counter) {
+		return;
+	}
+
+	// Fast path: not the last job, so nothing can be waiting on the transition to zero
+	uint32_t current = counter->pending_.load(std::memory_order_acquire);
+	while (current > 1) {
+		if (counter->pending_.compare_exchange_weak(current, current - 1, std::memory_order_acq_rel)) {
+			return;
+		}
+	}
+
+	// Last job: reach zero under the lock so waiters can't return (and destroy the counter)
+	// until the parked continuations have been taken
+	std::vector<Job> released;
+	{
+		LockGuard lock(counter->continuation_mutex_);
+		if (counter->pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			released.swap(counter->continuations_);
+		}
+	}
+	for (auto& job : released) {
+		Enqueue(std::move(job));
+	}
+}
+
+// Global job system (function-local static: first use may come from any thread)
+JobSystem& GetJobSystem() {
+	static JobSystem job_system;
+	return job_system;
+}
+
+} // namespace engine::platform::threading
@@ -1,6 +1,7 @@
 ﻿module;
 
 // Platform-specific includes
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <filesystem>
@@ -9,6 +10,8 @@
 #include <memory>
 #include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 export module engine.platform;
@@ -365,25 +368,33 @@ class Atomic {
 public:
 	Atomic() = default;
 
-	explicit Atomic(T value);
+	explicit Atomic(T value) : value_(value) {}
 
-	T Load() const;
+	T Load() const { return value_.load(std::memory_order_acquire); }
 
-	void Store(T value);
+	void Store(T value) { value_.store(value, std::memory_order_release); }
 
-	T Exchange(T value);
+	T Exchange(T value) { return value_.exchange(value, std::memory_order_acq_rel); }
 
-	bool CompareExchange(T& expected, T desired);
+	bool CompareExchange(T& expected, T desired) {
+		return value_.compare_exchange_strong(expected, desired, std::memory_order_acq_rel);
+	}
 
 	// For integral types
 	T FetchAdd(T value)
-		requires std::is_integral_v<T>;
+		requires std::is_integral_v<T>
+	{
+		return value_.fetch_add(value, std::memory_order_acq_rel);
+	}
 
 	T FetchSub(T value)
-		requires std::is_integral_v<T>;
+		requires std::is_integral_v<T>
+	{
+		return value_.fetch_sub(value, std::memory_order_acq_rel);
+	}
 
 private:
-	mutable std::atomic<T> value_;
+	mutable std::atomic<T> value_{};
 };
 
 // Common atomic types
@@ -392,8 +403,188 @@ using AtomicUInt32 = Atomic<uint32_t>;
 using AtomicInt64 = Atomic<int64_t>;
 using AtomicUInt64 = Atomic<uint64_t>;
 using AtomicBool = Atomic<bool>;
+
+// -----------------------------------------------------------------------------
+// Job System
+// -----------------------------------------------------------------------------
+
+using JobFunction = std::function<void()>;
+
+class JobCounter;
+
+// A unit of work plus the counter it signals when it finishes
+struct Job {
+	JobFunction function;
+	JobCounter* counter = nullptr;
+};
+
+// Tracks completion of a group of jobs. Submitting a job against a counter increments it,
+// and the counter is decremented when that job finishes. A counter can also gate other
+// jobs: jobs submitted with it as a dependency stay parked until it reaches zero.
+class JobCounter {
+public:
+	JobCounter() = default;
+
+	// Non-copyable, non-movable (jobs hold a pointer to it)
+	JobCounter(const JobCounter&) = delete;
+
+	JobCounter& operator=(const JobCounter&) = delete;
+
+	[[nodiscard]] bool IsDone() const { return pending_.load(std::memory_order_acquire) == 0; }
+
+	[[nodiscard]] uint32_t Pending() const { return pending_.load(std::memory_order_acquire); }
+
+private:
+	friend class JobSystem;
+
+	std::atomic<uint32_t> pending_{0};
+	mutable Mutex continuation_mutex_; // Also taken by waiters so the counter outlives the final Finish()
+	std::vector<Job> continuations_; // Jobs waiting for this counter to reach zero
+};
+
+// Work-stealing thread pool. Each worker owns a deque: it pushes and pops its own work
+// LIFO (cache-warm) while idle workers steal FIFO from the other end of their peers'
+// deques. Threads that wait on a counter run queued jobs instead of blocking, so nested
+// waits from inside a job cannot deadlock the pool.
+class JobSystem {
+public:
+	// worker_count == 0 sizes the pool to HardwareConcurrency() - 1 (the calling thread also helps)
+	explicit JobSystem(uint32_t worker_count = 0);
+
+	// Runs every queued job to completion, then joins the workers
+	~JobSystem();
+
+	// Non-copyable, non-movable
+	JobSystem(const JobSystem&) = delete;
+
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	// Queue a job. The counter (optional) is incremented now and decremented when the job finishes.
+	void Submit(JobFunction function, JobCounter* counter = nullptr);
+
+	// Queue a job that only becomes runnable once `dependency` reaches zero
+	void Submit(JobFunction function, JobCounter* counter, JobCounter& dependency);
+
+	// Block until the counter reaches zero, running queued jobs on the calling thread meanwhile
+	void Wait(const JobCounter& counter);
+
+	// Split [begin, end) into chunks of at most grain_size indices and run body(chunk_begin, chunk_end)
+	// across the pool. Blocks (helping) until every chunk is done. grain_size == 0 picks a chunk size
+	// that gives each thread a few chunks to balance uneven work.
+	void ParallelFor(
+		size_t begin,
+		size_t end,
+		size_t grain_size,
+		const std::function<void(size_t, size_t)>& body
+	);
+
+	// Number of dedicated worker threads (excluding threads that help while waiting)
+	[[nodiscard]] uint32_t WorkerCount() const;
+
+	// Total threads that can execute jobs concurrently (workers + the waiting thread)
+	[[nodiscard]] uint32_t MaxConcurrency() const { return WorkerCount() + 1; }
+
+	// True when called from one of this pool's worker threads
+	[[nodiscard]] bool IsWorkerThread() const;
+
+private:
+	// Push an already-counted job onto a deque and wake a sleeping worker
+	void Enqueue(Job job);
+
+	// Pop a job from this thread's deque or steal one from a peer and run it
+	bool TryRunOne();
+
+	// Decrement the job's counter and release any jobs parked on it
+	void Finish(JobCounter* counter);
+
+	struct Impl;
+	std::unique_ptr<Impl> pimpl_;
+};
+
+// Engine-wide job system shared by ECS, physics, asset decoding and animation so that
+// subsystems don't each spin up their own threads and oversubscribe the machine
+JobSystem& GetJobSystem();
 } // namespace threading
 
+// =============================================================================
+// Profiling
+// =============================================================================
+
+// Hierarchical CPU zone profiler. Zones are recorded into a fixed-size ring buffer owned by the
+// recording thread, so recording takes no locks; older events are overwritten once a buffer wraps.
+// Recording is off by default, and a disabled zone costs one relaxed atomic load. Zones are usually
+// opened with the PROFILE_ZONE / PROFILE_FUNCTION macros from platform/profiler.h.
+namespace profiling {
+// Events kept per thread before the oldest are overwritten (power of two)
+constexpr size_t EVENTS_PER_THREAD = size_t{1} << 16;
+
+// A completed zone. Names are not copied: they must be string literals or come from Intern().
+struct ZoneEvent {
+	const char* name = nullptr;
+	int64_t start_ns = 0; // Since the profiler epoch (see Now())
+	int64_t duration_ns = 0;
+	uint32_t thread_id = 0; // Profiler-assigned, in order of each thread's first zone
+	uint32_t depth = 0;     // Zones open on the thread when this one began (0 = outermost)
+};
+
+void SetEnabled(bool enabled);
+
+[[nodiscard]] bool IsEnabled();
+
+// Nanoseconds since the profiler epoch (first use of the profiler)
+[[nodiscard]] int64_t Now();
+
+// Open a zone on the calling thread and return its start time. Every BeginZone must be matched by an
+// EndZone on the same thread; prefer ScopedZone.
+int64_t BeginZone();
+
+void EndZone(const char* name, int64_t start_ns);
+
+// Record a zone measured elsewhere (e.g. system timings reported by flecs), nested under the zones
+// currently open on the calling thread
+void RecordZone(const char* name, int64_t start_ns, int64_t duration_ns);
+
+// Stable copy of a runtime string for use as a zone name. Takes a lock; cache the result.
+const char* Intern(std::string_view name);
+
+// Label the calling thread in exported traces (threading::SetCurrentThreadName also does this). Cheap: the
+// thread's event ring is only allocated once it records a zone.
+void SetThreadName(const std::string& name);
+
+// Events recorded since the last Clear(), per thread in recording order. Safe to call while other
+// threads record; events overwritten during the copy are dropped.
+[[nodiscard]] std::vector<ZoneEvent> Capture();
+
+// Drop all recorded events
+void Clear();
+
+// Captured events in the Chrome trace event format, viewable in chrome://tracing or ui.perfetto.dev
+[[nodiscard]] std::string ToChromeTraceJson();
+
+bool WriteChromeTrace(const std::filesystem::path& path);
+
+// RAII zone covering the enclosing scope. Profiling being enabled is checked once, on entry.
+class ScopedZone {
+public:
+	explicit ScopedZone(const char* name) : name_(name), start_ns_(IsEnabled() ? BeginZone() : -1) {}
+
+	~ScopedZone() {
+		if (start_ns_ >= 0) {
+			EndZone(name_, start_ns_);
+		}
+	}
+
+	// Non-copyable, non-movable
+	ScopedZone(const ScopedZone&) = delete;
+
+	ScopedZone& operator=(const ScopedZone&) = delete;
+
+private:
+	const char* name_;
+	int64_t start_ns_;
+};
+} // namespace profiling
+
 // =============================================================================
 // Utility Functions
 // =============================================================================
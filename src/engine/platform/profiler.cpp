@@ -0,0 +1,244 @@
+// CPU zone profiler implementation
+module;
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+module engine.platform;
+
+namespace engine::platform::profiling {
+
+namespace {
+static_assert((EVENTS_PER_THREAD & (EVENTS_PER_THREAD - 1)) == 0, "EVENTS_PER_THREAD must be a power of two");
+
+// Single-producer ring: only the owning thread writes events and write_count, readers copy behind it. The ring
+// is allocated with the thread's first event, so threads that are only named (or never profiled) cost a few
+// bytes rather than EVENTS_PER_THREAD events.
+struct ThreadBuffer {
+	std::unique_ptr<ZoneEvent[]> events; // Published to readers by the first write_count release
+	std::atomic<uint64_t> write_count{0};
+	std::atomic<uint64_t> cleared_at{0}; // Events before this index were dropped by Clear()
+	uint32_t thread_id = 0;
+	uint32_t depth = 0; // Owner thread only
+	std::string name;   // Guarded by Registry::mutex
+};
+
+struct Registry {
+	std::mutex mutex;
+	std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+	std::unordered_set<std::string> interned_names; // Node-based, so pointers to elements stay valid
+};
+
+std::atomic<bool> g_enabled{false};
+
+// Leaked on purpose: worker threads may still record while static destructors run at exit
+Registry& GetRegistry() {
+	static auto* registry = new Registry();
+	return *registry;
+}
+
+std::chrono::steady_clock::time_point Epoch() {
+	static const auto epoch = std::chrono::steady_clock::now();
+	return epoch;
+}
+
+ThreadBuffer& GetThreadBuffer() {
+	thread_local ThreadBuffer* buffer = nullptr;
+	if (!buffer) {
+		auto& registry = GetRegistry();
+		const std::lock_guard lock(registry.mutex);
+		auto& added = registry.buffers.emplace_back(std::make_unique<ThreadBuffer>());
+		added->thread_id = static_cast<uint32_t>(registry.buffers.size());
+		buffer = added.get();
+	}
+	return *buffer;
+}
+
+void Push(ThreadBuffer& buffer, const ZoneEvent& event) {
+	const uint64_t index = buffer.write_count.load(std::memory_order_relaxed);
+	if (!buffer.events) {
+		buffer.events = std::make_unique<ZoneEvent[]>(EVENTS_PER_THREAD);
+	}
+	buffer.events[index & (EVENTS_PER_THREAD - 1)] = event;
+	buffer.write_count.store(index + 1, std::memory_order_release);
+}
+
+void AppendEscaped(std::string& out, const std::string_view text) {
+	for (const char c : text) {
+		switch (c) {
+		case '"': out += "\\\""; break;
+		case '\\': out += "\\\\"; break;
+		case '\n': out += "\\n"; break;
+		case '\t': out += "\\t"; break;
+		default:
+			if (static_cast<unsigned char>(c) >= 0x20) {
+				out += c;
+			}
+			break;
+		}
+	}
+}
+
+// Trace timestamps are in microseconds; keep nanosecond precision as three decimals
+void AppendMicroseconds(std::string& out, const int64_t nanoseconds) {
+	out += std::to_string(nanoseconds / 1000);
+	const auto fraction = std::to_string(1000 + nanoseconds % 1000);
+	out += '.';
+	out += fraction.substr(1);
+}
+} // namespace
+
+void SetEnabled(const bool enabled) { g_enabled.store(enabled, std::memory_order_relaxed); }
+
+bool IsEnabled() { return g_enabled.load(std::memory_order_relaxed); }
+
+int64_t Now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Epoch()).count();
+}
+
+int64_t BeginZone() {
+	++GetThreadBuffer().depth;
+	return Now();
+}
+
+void EndZone(const char* name, const int64_t start_ns) {
+	const int64_t end_ns = Now();
+	auto& buffer = GetThreadBuffer();
+	buffer.depth = buffer.depth > 0 ? buffer.depth - 1 : 0;
+	const ZoneEvent event{
+		.name = name,
+		.start_ns = start_ns,
+		.duration_ns = end_ns - start_ns,
+		.thread_id = buffer.thread_id,
+		.depth = buffer.depth
+	};
+	Push(buffer, event);
+}
+
+void RecordZone(const char* name, const int64_t start_ns, const int64_t duration_ns) {
+	auto& buffer = GetThreadBuffer();
+	const ZoneEvent event{
+		.name = name,
+		.start_ns = start_ns,
+		.duration_ns = duration_ns,
+		.thread_id = buffer.thread_id,
+		.depth = buffer.depth
+	};
+	Push(buffer, event);
+}
+
+const char* Intern(const std::string_view name) {
+	auto& registry = GetRegistry();
+	const std::lock_guard lock(registry.mutex);
+	return registry.interned_names.emplace(name).first->c_str();
+}
+
+void SetThreadName(const std::string& name) {
+	auto& buffer = GetThreadBuffer();
+	auto& registry = GetRegistry();
+	const std::lock_guard lock(registry.mutex);
+	buffer.name = name;
+}
+
+std::vector<ZoneEvent> Capture() {
+	auto& registry = GetRegistry();
+	const std::lock_guard lock(registry.mutex);
+
+	std::vector<ZoneEvent> events;
+	for (const auto& buffer : registry.buffers) {
+		const uint64_t end = buffer->write_count.load(std::memory_order_acquire);
+		const uint64_t oldest = end > EVENTS_PER_THREAD ? end - EVENTS_PER_THREAD : 0;
+		const uint64_t begin = std::max(oldest, buffer->cleared_at.load(std::memory_order_relaxed));
+		const size_t first = events.size();
+		for (uint64_t i = begin; i < end; ++i) {
+			events.push_back(buffer->events[i & (EVENTS_PER_THREAD - 1)]);
+		}
+
+		// The owner kept recording during the copy; drop slots it may have overwritten meanwhile
+		const uint64_t end_after = buffer->write_count.load(std::memory_order_acquire);
+		if (const uint64_t valid_from = end_after > EVENTS_PER_THREAD ? end_after - EVENTS_PER_THREAD : 0;
+			valid_from > begin) {
+			const auto overwritten = static_cast<std::ptrdiff_t>(std::min(valid_from, end) - begin);
+			events.erase(
+				events.begin() + static_cast<std::ptrdiff_t>(first),
+				events.begin() + static_cast<std::ptrdiff_t>(first) + overwritten
+			);
+		}
+	}
+	return events;
+}
+
+void Clear() {
+	auto& registry = GetRegistry();
+	const std::lock_guard lock(registry.mutex);
+	for (const auto& buffer : registry.buffers) {
+		buffer->cleared_at.store(buffer->write_count.load(std::memory_order_acquire), std::memory_order_relaxed);
+	}
+}
+
+std::string ToChromeTraceJson() {
+	const std::vector<ZoneEvent> events = Capture();
+
+	std::string json = R"({"displayTimeUnit":"ms","traceEvents":[)";
+	bool first = true;
+	const auto separator = [&json, &first] {
+		if (!first) {
+			json += ",\n";
+		}
+		first = false;
+	};
+
+	{
+		auto& registry = GetRegistry();
+		const std::lock_guard lock(registry.mutex);
+		for (const auto& buffer : registry.buffers) {
+			if (buffer->name.empty()) {
+				continue;
+			}
+			separator();
+			json += R"({"name":"thread_name","ph":"M","pid":1,"tid":)";
+			json += std::to_string(buffer->thread_id);
+			json += R"(,"args":{"name":")";
+			AppendEscaped(json, buffer->name);
+			json += R"("}})";
+		}
+	}
+
+	for (const auto& event : events) {
+		separator();
+		json += R"({"name":")";
+		AppendEscaped(json, event.name ? event.name : "");
+		json += R"(","ph":"X","pid":1,"tid":)";
+		json += std::to_string(event.thread_id);
+		json += R"(,"ts":)";
+		AppendMicroseconds(json, event.start_ns);
+		json += R"(,"dur":)";
+		AppendMicroseconds(json, event.duration_ns);
+		json += '}';
+	}
+	json += "]}\n";
+	return json;
+}
+
+bool WriteChromeTrace(const std::filesystem::path& path) {
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		return false;
+	}
+	const std::string json = ToChromeTraceJson();
+	file.write(json.data(), static_cast<std::streamsize>(json.size()));
+	return file.good();
+}
+
+} // namespace engine::platform::profiling
@@ -0,0 +1,17 @@
+#pragma once
+
+// Zone macros for engine::platform::profiling. Modules can't export macros, so this header is included
+// alongside `import engine.platform;`. Define CITRUS_DISABLE_PROFILING to compile every zone out.
+
+#ifndef CITRUS_DISABLE_PROFILING
+#define CITRUS_PROFILE_CAT_IMPL(a, b) a##b
+#define CITRUS_PROFILE_CAT(a, b) CITRUS_PROFILE_CAT_IMPL(a, b)
+
+// Time the rest of the enclosing scope. name must be a string literal or profiling::Intern()ed.
+#define PROFILE_ZONE(name) ::engine::platform::profiling::ScopedZone CITRUS_PROFILE_CAT(profile_zone_, __LINE__)(name)
+
+#define PROFILE_FUNCTION() PROFILE_ZONE(__func__)
+#else
+#define PROFILE_ZONE(name)
+#define PROFILE_FUNCTION()
+#endif
@@ -0,0 +1,59 @@
+// Threading primitives implementation
+module;
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <pthread.h>
+#endif
+
+module engine.platform;
+
+namespace engine::platform::threading {
+
+uint32_t HardwareConcurrency() {
+	// hardware_concurrency() may return 0 when the value is not computable
+	const uint32_t count = std::thread::hardware_concurrency();
+	return count == 0 ? 1 : count;
+}
+
+void SetCurrentThreadName(const std::string& name) {
+	profiling::SetThreadName(name);
+#if defined(__linux__)
+	// Linux limits thread names to 15 characters plus the terminator
+	pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#elif defined(__APPLE__)
+	pthread_setname_np(name.c_str());
+#else
+	(void) name;
+#endif
+}
+
+void YieldCurrentThread() { std::this_thread::yield(); }
+
+void SleepFor(const Duration duration) { std::this_thread::sleep_for(duration); }
+
+// Mutex implementation
+struct Mutex::Impl {
+	std::mutex mutex;
+};
+
+Mutex::Mutex() : pimpl_(std::make_unique<Impl>()) {}
+
+Mutex::~Mutex() = default;
+
+void Mutex::Lock() { pimpl_->mutex.lock(); }
+
+bool Mutex::TryLock() { return pimpl_->mutex.try_lock(); }
+
+void Mutex::Unlock() { pimpl_->mutex.unlock(); }
+
+// LockGuard implementation
+LockGuard::LockGuard(Mutex& mutex) : mutex_(mutex) { mutex_.Lock(); }
+
+LockGuard::~LockGuard() { mutex_.Unlock(); }
+
+} // namespace engine::platform::threading
@@ -62,7 +62,7 @@ bool Framebuffer::Create(const uint32_t width, const uint32_t height) {
 
 	// Create color texture attachment
 	glGenTextures(1, &color_texture_id_);
-	glBindTexture(GL_TEXTURE_2D, color_texture_id_);
+	GetGLStateCache().BindTexture(0, color_texture_id_);
 	glTexImage2D(
 		GL_TEXTURE_2D,
 		0,
@@ -110,6 +110,7 @@ void Framebuffer::Destroy() {
 	if (color_texture_id_ != 0) {
 		glDeleteTextures(1, &color_texture_id_);
 		color_texture_id_ = 0;
+		GetGLStateCache().Invalidate();
 	}
 	if (depth_rbo_id_ != 0) {
 		glDeleteRenderbuffers(1, &depth_rbo_id_);
@@ -0,0 +1,145 @@
+module;
+
+#include <bit>
+#include <cstdint>
+#include <optional>
+#ifdef __EMSCRIPTEN__
+#include <GLES3/gl3.h>
+#else
+#include <glad/glad.h>
+#endif
+
+module engine.rendering;
+
+import :gl_state;
+
+namespace engine::rendering {
+namespace {
+size_t FlagIndex(const RenderFlag flag) { return static_cast<size_t>(std::countr_zero(static_cast<uint32_t>(flag))); }
+
+GLenum FlagCapability(const RenderFlag flag) {
+	switch (flag) {
+	case RenderFlag::DepthTest: return GL_DEPTH_TEST;
+	case RenderFlag::Blend: return GL_BLEND;
+	case RenderFlag::CullFace: return GL_CULL_FACE;
+	case RenderFlag::StencilTest: return GL_STENCIL_TEST;
+	case RenderFlag::ScissorTest: return GL_SCISSOR_TEST;
+	default: return 0;
+	}
+}
+} // namespace
+
+GLFunctions GetDefaultGLFunctions() {
+	GLFunctions functions{
+		.enable = [](const uint32_t capability) { glEnable(capability); },
+		.disable = [](const uint32_t capability) { glDisable(capability); },
+		.depth_mask = [](const bool enabled) { glDepthMask(enabled ? GL_TRUE : GL_FALSE); },
+		.blend_func = [](const uint32_t source, const uint32_t destination) { glBlendFunc(source, destination); },
+		.use_program = [](const uint32_t program) { glUseProgram(program); },
+		.bind_vertex_array = [](const uint32_t vao) { glBindVertexArray(vao); },
+		.active_texture = [](const uint32_t unit) { glActiveTexture(unit); },
+		.bind_texture = [](const uint32_t target, const uint32_t texture) { glBindTexture(target, texture); }
+	};
+#ifndef __EMSCRIPTEN__
+	functions.polygon_mode = [](const uint32_t face, const uint32_t mode) { glPolygonMode(face, mode); };
+#endif
+	return functions;
+}
+
+GLStateCache::GLStateCache(const GLFunctions& functions) : functions_(functions) {}
+
+bool GLStateCache::Changes(const bool unchanged) {
+	if (unchanged) {
+		++stats_.calls_eliminated;
+		return false;
+	}
+	++stats_.calls_issued;
+	return true;
+}
+
+void GLStateCache::SetFlag(const RenderFlag flag, const bool enabled) {
+	auto& shadow = flags_[FlagIndex(flag)];
+	if (flag == RenderFlag::Wireframe && !functions_.polygon_mode) {
+		return;
+	}
+	if (!Changes(shadow == enabled)) {
+		return;
+	}
+	shadow = enabled;
+
+	if (flag == RenderFlag::DepthMask) {
+		functions_.depth_mask(enabled);
+	}
+	else if (flag == RenderFlag::Wireframe) {
+		functions_.polygon_mode(GL_FRONT_AND_BACK, enabled ? GL_LINE : GL_FILL);
+	}
+	else if (enabled) {
+		functions_.enable(FlagCapability(flag));
+	}
+	else {
+		functions_.disable(FlagCapability(flag));
+	}
+}
+
+void GLStateCache::SetBlendFunc(const uint32_t source, const uint32_t destination) {
+	if (Changes(blend_source_ == source && blend_destination_ == destination)) {
+		blend_source_ = source;
+		blend_destination_ = destination;
+		functions_.blend_func(source, destination);
+	}
+}
+
+void GLStateCache::UseProgram(const uint32_t program) {
+	if (Changes(program_ == program)) {
+		program_ = program;
+		functions_.use_program(program);
+	}
+}
+
+void GLStateCache::BindVertexArray(const uint32_t vao) {
+	if (Changes(vao_ == vao)) {
+		vao_ = vao;
+		functions_.bind_vertex_array(vao);
+	}
+}
+
+void GLStateCache::SetActiveTexture(const uint32_t unit) {
+	if (Changes(active_texture_unit_ == unit)) {
+		active_texture_unit_ = unit;
+		functions_.active_texture(GL_TEXTURE0 + unit);
+	}
+}
+
+void GLStateCache::BindTexture(const uint32_t unit, const uint32_t texture) {
+	if (unit >= MAX_TEXTURE_UNITS) {
+		// Not shadowed; forward both calls and forget the active unit
+		++stats_.calls_issued;
+		functions_.active_texture(GL_TEXTURE0 + unit);
+		functions_.bind_texture(GL_TEXTURE_2D, texture);
+		active_texture_unit_.reset();
+		return;
+	}
+	if (!Changes(textures_[unit] == texture)) {
+		return;
+	}
+	textures_[unit] = texture;
+	SetActiveTexture(unit);
+	functions_.bind_texture(GL_TEXTURE_2D, texture);
+}
+
+void GLStateCache::Invalidate() {
+	flags_ = {};
+	blend_source_.reset();
+	blend_destination_.reset();
+	program_.reset();
+	vao_.reset();
+	active_texture_unit_.reset();
+	textures_ = {};
+}
+
+GLStateCache& GetGLStateCache() {
+	static GLStateCache cache(GetDefaultGLFunctions());
+	return cache;
+}
+
+} // namespace engine::rendering
@@ -0,0 +1,91 @@
+module;
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+export module engine.rendering:gl_state;
+
+import :types;
+
+export namespace engine::rendering {
+
+// GL entry points the state cache forwards to. The engine uses GetDefaultGLFunctions(); tests pass their own table
+// to observe exactly which calls get through. Enum arguments are raw GLenum values.
+struct GLFunctions {
+	void (*enable)(uint32_t capability) = nullptr;
+	void (*disable)(uint32_t capability) = nullptr;
+	void (*depth_mask)(bool enabled) = nullptr;
+	void (*polygon_mode)(uint32_t face, uint32_t mode) = nullptr; // Null where unsupported (GLES/WebGL)
+	void (*blend_func)(uint32_t source, uint32_t destination) = nullptr;
+	void (*use_program)(uint32_t program) = nullptr;
+	void (*bind_vertex_array)(uint32_t vao) = nullptr;
+	void (*active_texture)(uint32_t unit) = nullptr; // GL_TEXTURE0 + unit
+	void (*bind_texture)(uint32_t target, uint32_t texture) = nullptr;
+};
+
+// Table that calls straight into the loaded GL functions
+[[nodiscard]] GLFunctions GetDefaultGLFunctions();
+
+struct GLStateStats {
+	uint32_t calls_issued = 0;     // State calls forwarded to GL
+	uint32_t calls_eliminated = 0; // State calls dropped because GL was already in the requested state
+};
+
+/**
+ * @brief Shadow copy of the GL state the renderer touches
+ *
+ * Every setter compares against the shadowed value and only forwards the call when it changes something. State
+ * starts out unknown, so the first call for each piece of state always goes through. Code that changes GL state
+ * without going through the cache, or deletes a texture, VAO or program the cache may have shadowed (GL reuses
+ * names), must call Invalidate() afterwards.
+ */
+class GLStateCache {
+public:
+	static constexpr uint32_t MAX_TEXTURE_UNITS = 16;
+
+	explicit GLStateCache(const GLFunctions& functions);
+
+	// Any RenderFlag: DepthTest, Blend, CullFace, StencilTest and ScissorTest toggle the capability, DepthMask sets
+	// the depth write mask and Wireframe switches the polygon mode between lines and fill
+	void SetFlag(RenderFlag flag, bool enabled);
+
+	void SetBlendFunc(uint32_t source, uint32_t destination);
+
+	void UseProgram(uint32_t program);
+
+	void BindVertexArray(uint32_t vao);
+
+	void SetActiveTexture(uint32_t unit);
+
+	// Binds a GL_TEXTURE_2D handle to a texture unit, switching the active unit if needed
+	void BindTexture(uint32_t unit, uint32_t texture);
+
+	// Forget all shadowed state; the next call for each piece of state is issued unconditionally
+	void Invalidate();
+
+	[[nodiscard]] const GLStateStats& GetStats() const { return stats_; }
+
+	void ResetStats() { stats_ = {}; }
+
+private:
+	static constexpr size_t FLAG_COUNT = 7;
+
+	// Counts the call and reports whether it must be issued
+	bool Changes(bool unchanged);
+
+	GLFunctions functions_;
+	GLStateStats stats_;
+	std::array<std::optional<bool>, FLAG_COUNT> flags_{};
+	std::optional<uint32_t> blend_source_;
+	std::optional<uint32_t> blend_destination_;
+	std::optional<uint32_t> program_;
+	std::optional<uint32_t> vao_;
+	std::optional<uint32_t> active_texture_unit_;
+	std::array<std::optional<uint32_t>, MAX_TEXTURE_UNITS> textures_{};
+};
+
+// The cache for the current GL context, backed by GetDefaultGLFunctions()
+GLStateCache& GetGLStateCache();
+
+} // namespace engine::rendering
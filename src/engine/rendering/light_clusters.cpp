@@ -0,0 +1,142 @@
+module;
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+module engine.rendering;
+
+import :light_clusters;
+import engine.platform;
+import glm;
+
+namespace engine::rendering {
+namespace {
+// Fewer lights than this are assigned on the calling thread
+constexpr size_t PARALLEL_ASSIGN_THRESHOLD = 64;
+
+float DistanceSquared(const Vec3& point, const Vec3& min, const Vec3& max) {
+	const Vec3 closest = glm::clamp(point, min, max);
+	const Vec3 offset = point - closest;
+	return glm::dot(offset, offset);
+}
+} // namespace
+
+void LightClusters::SetProjection(const glm::mat4& projection, const float near_plane, const float far_plane) {
+	if (projection == projection_ && near_plane == near_ && far_plane == far_) {
+		return;
+	}
+	projection_ = projection;
+	near_ = near_plane;
+	far_ = far_plane;
+	const float depth_ratio = far_plane / near_plane;
+	slice_scale_ = static_cast<float>(LIGHT_CLUSTER_GRID_Z) / std::log(depth_ratio);
+	slice_bias_ = -slice_scale_ * std::log(near_plane);
+
+	// Tile corner directions, scaled so their view-space z is -1; a corner at view distance d is then direction * d
+	const glm::mat4 inverse_projection = glm::inverse(projection);
+	const auto corner_direction = [&inverse_projection](const uint32_t x, const uint32_t y) {
+		const glm::vec4 ndc(
+			2.0F * static_cast<float>(x) / static_cast<float>(LIGHT_CLUSTER_GRID_X) - 1.0F,
+			2.0F * static_cast<float>(y) / static_cast<float>(LIGHT_CLUSTER_GRID_Y) - 1.0F,
+			-1.0F,
+			1.0F
+		);
+		const glm::vec4 view = inverse_projection * ndc;
+		const Vec3 point = Vec3(view) / view.w;
+		return point / -point.z;
+	};
+
+	for (uint32_t z = 0; z < LIGHT_CLUSTER_GRID_Z; ++z) {
+		const float slice_near = near_plane * std::pow(depth_ratio, static_cast<float>(z) / LIGHT_CLUSTER_GRID_Z);
+		const float slice_far = near_plane * std::pow(depth_ratio, static_cast<float>(z + 1) / LIGHT_CLUSTER_GRID_Z);
+		for (uint32_t y = 0; y < LIGHT_CLUSTER_GRID_Y; ++y) {
+			for (uint32_t x = 0; x < LIGHT_CLUSTER_GRID_X; ++x) {
+				Bounds& bounds = bounds_[ClusterIndex(x, y, z)];
+				bounds.min = Vec3(std::numeric_limits<float>::max());
+				bounds.max = Vec3(std::numeric_limits<float>::lowest());
+				for (const uint32_t corner : {0U, 1U, 2U, 3U}) {
+					const Vec3 direction = corner_direction(x + (corner & 1U), y + (corner >> 1U));
+					for (const float distance : {slice_near, slice_far}) {
+						bounds.min = glm::min(bounds.min, direction * distance);
+						bounds.max = glm::max(bounds.max, direction * distance);
+					}
+				}
+			}
+		}
+	}
+}
+
+uint32_t LightClusters::SliceOf(const float view_distance) const {
+	const float slice = std::floor(std::log(std::max(view_distance, near_)) * slice_scale_ + slice_bias_);
+	return static_cast<uint32_t>(std::clamp(slice, 0.0F, static_cast<float>(LIGHT_CLUSTER_GRID_Z - 1)));
+}
+
+void LightClusters::Assign(const std::span<const ClusterLight> lights, const glm::mat4& view) {
+	// Lights entirely in front of the near plane or beyond the far plane touch no cluster
+	view_lights_.clear();
+	for (const ClusterLight& light : lights) {
+		const Vec3 center(view * glm::vec4(light.position, 1.0F));
+		const float distance = -center.z;
+		if (light.range <= 0.0F || distance + light.range < near_ || distance - light.range > far_) {
+			continue;
+		}
+		view_lights_.push_back({
+			.center = center,
+			.radius_squared = light.range * light.range,
+			.index = light.index,
+			.first_slice = SliceOf(distance - light.range),
+			.last_slice = SliceOf(distance + light.range)
+		});
+	}
+
+	// Slices write disjoint parts of cluster_slots_, so they can be filled independently
+	cluster_slots_.resize(static_cast<size_t>(LIGHT_CLUSTER_COUNT) * MAX_LIGHTS_PER_CLUSTER);
+	const auto assign_slices = [this](const size_t begin, const size_t end) {
+		for (size_t slice = begin; slice < end; ++slice) {
+			AssignSlice(static_cast<uint32_t>(slice));
+		}
+	};
+	if (view_lights_.size() < PARALLEL_ASSIGN_THRESHOLD) {
+		assign_slices(0, LIGHT_CLUSTER_GRID_Z);
+	}
+	else {
+		platform::threading::GetJobSystem().ParallelFor(0, LIGHT_CLUSTER_GRID_Z, 1, assign_slices);
+	}
+
+	// Compact the fixed-size slots into one list
+	light_indices_.clear();
+	for (uint32_t cluster = 0; cluster < LIGHT_CLUSTER_COUNT; ++cluster) {
+		LightClusterRange& range = clusters_[cluster];
+		const auto first = cluster_slots_.begin() + static_cast<ptrdiff_t>(cluster) * MAX_LIGHTS_PER_CLUSTER;
+		range.offset = static_cast<uint32_t>(light_indices_.size());
+		light_indices_.insert(light_indices_.end(), first, first + range.count);
+	}
+}
+
+void LightClusters::AssignSlice(const uint32_t slice) {
+	const uint32_t first_cluster = ClusterIndex(0, 0, slice);
+	const uint32_t end_cluster = first_cluster + LIGHT_CLUSTER_GRID_X * LIGHT_CLUSTER_GRID_Y;
+	for (uint32_t cluster = first_cluster; cluster < end_cluster; ++cluster) {
+		clusters_[cluster].count = 0;
+	}
+
+	for (const ViewLight& light : view_lights_) {
+		if (slice < light.first_slice || slice > light.last_slice) {
+			continue;
+		}
+		for (uint32_t cluster = first_cluster; cluster < end_cluster; ++cluster) {
+			const Bounds& bounds = bounds_[cluster];
+			uint32_t& count = clusters_[cluster].count;
+			if (count < MAX_LIGHTS_PER_CLUSTER
+				&& DistanceSquared(light.center, bounds.min, bounds.max) <= light.radius_squared) {
+				cluster_slots_[static_cast<size_t>(cluster) * MAX_LIGHTS_PER_CLUSTER + count++] = light.index;
+			}
+		}
+	}
+}
+
+} // namespace engine::rendering
@@ -0,0 +1,101 @@
+module;
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+export module engine.rendering:light_clusters;
+
+import :types;
+import glm;
+
+export namespace engine::rendering {
+// The view frustum is split into screen tiles and exponentially spaced depth slices. lit_3d.frag repeats these.
+constexpr uint32_t LIGHT_CLUSTER_GRID_X = 16;
+constexpr uint32_t LIGHT_CLUSTER_GRID_Y = 9;
+constexpr uint32_t LIGHT_CLUSTER_GRID_Z = 24;
+constexpr uint32_t LIGHT_CLUSTER_COUNT = LIGHT_CLUSTER_GRID_X * LIGHT_CLUSTER_GRID_Y * LIGHT_CLUSTER_GRID_Z;
+
+// Further lights touching a cluster that already references this many are dropped for that cluster
+constexpr uint32_t MAX_LIGHTS_PER_CLUSTER = 64;
+
+// Row length of the light index texture; longer index lists wrap onto further rows
+constexpr uint32_t LIGHT_INDEX_TEXTURE_WIDTH = 1024;
+
+// Texture units the cluster textures stay bound to, clear of the units materials use
+constexpr uint32_t LIGHT_GRID_TEXTURE_UNIT = 14;
+constexpr uint32_t LIGHT_INDEX_TEXTURE_UNIT = 15;
+
+// A point or spot light to bin, bounded by a sphere of its range around its world position
+struct ClusterLight {
+	Vec3 position{0.0F};
+	float range = 0.0F;
+	uint32_t index = 0; // What the cluster lists store for this light; the light's slot in SceneUniforms
+};
+
+// A cluster's run of entries in the light index list
+struct LightClusterRange {
+	uint32_t offset = 0;
+	uint32_t count = 0;
+};
+
+/**
+ * @brief CPU light assignment for clustered forward shading
+ *
+ * Bins lights into the clusters their range sphere overlaps and produces a compact index list plus one range per
+ * cluster, so a fragment only loops over the lights near it. Cluster x runs fastest, then y, then the depth slice;
+ * tile (0, 0) is the bottom-left of the screen. Each cluster lists its lights in input order. Large light counts
+ * are assigned a depth slice at a time across the job system.
+ */
+class LightClusters {
+public:
+	// Rebuild the cluster bounds for a perspective projection with the given clip planes; a no-op when unchanged
+	void SetProjection(const glm::mat4& projection, float near_plane, float far_plane);
+
+	void Assign(std::span<const ClusterLight> lights, const glm::mat4& view);
+
+	[[nodiscard]] std::span<const LightClusterRange> GetClusters() const { return clusters_; }
+
+	[[nodiscard]] std::span<const uint32_t> GetLightIndices() const { return light_indices_; }
+
+	// Depth slice of a view distance is floor(log(distance) * scale + bias), clamped to the grid
+	[[nodiscard]] float GetSliceScale() const { return slice_scale_; }
+
+	[[nodiscard]] float GetSliceBias() const { return slice_bias_; }
+
+	[[nodiscard]] uint32_t SliceOf(float view_distance) const;
+
+	[[nodiscard]] static constexpr uint32_t ClusterIndex(const uint32_t x, const uint32_t y, const uint32_t z) {
+		return (z * LIGHT_CLUSTER_GRID_Y + y) * LIGHT_CLUSTER_GRID_X + x;
+	}
+
+private:
+	struct Bounds {
+		Vec3 min{0.0F};
+		Vec3 max{0.0F};
+	};
+
+	struct ViewLight {
+		Vec3 center{0.0F}; // View space
+		float radius_squared = 0.0F;
+		uint32_t index = 0;
+		uint32_t first_slice = 0;
+		uint32_t last_slice = 0;
+	};
+
+	void AssignSlice(uint32_t slice);
+
+	glm::mat4 projection_{0.0F};
+	float near_ = 0.0F;
+	float far_ = 0.0F;
+	float slice_scale_ = 0.0F;
+	float slice_bias_ = 0.0F;
+	std::vector<Bounds> bounds_ = std::vector<Bounds>(LIGHT_CLUSTER_COUNT); // View space
+
+	std::vector<ViewLight> view_lights_;
+	std::vector<uint32_t> cluster_slots_; // MAX_LIGHTS_PER_CLUSTER entries per cluster, filled before compaction
+	std::vector<LightClusterRange> clusters_ = std::vector<LightClusterRange>(LIGHT_CLUSTER_COUNT);
+	std::vector<uint32_t> light_indices_;
+};
+} // namespace engine::rendering
@@ -91,7 +91,7 @@ void Material::Apply(const Shader& shader) const {
 		++texture_unit;
 	}
 	// Optionally: reset active texture to 0
-	glActiveTexture(GL_TEXTURE0);
+	GetGLStateCache().SetActiveTexture(0);
 }
 
 // MaterialManager implementation
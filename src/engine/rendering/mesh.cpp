@@ -2,8 +2,10 @@
 module;
 
 #include <cmath>
+#include <cstdint>
 #include <memory>
 #include <numbers>
+#include <ranges>
 #include <span>
 #include <string>
 #include <unordered_map>
@@ -19,6 +21,7 @@ module engine.rendering;
 import glm;
 
 import :mesh;
+import :mesh_import;
 import :types;
 
 namespace engine::rendering {
@@ -39,6 +42,12 @@ GLMesh* GetGLMesh(const MeshId id) {
 	return it != g_mesh_gl.end() ? &it->second : nullptr;
 }
 
+void ResetGLMeshInstanceAttributes() {
+	for (auto& gl_mesh : g_mesh_gl | std::views::values) {
+		gl_mesh.instance_attributes = false;
+	}
+}
+
 MeshManager::MeshManager() : pimpl_(std::make_unique<Impl>()) {}
 
 MeshManager::~MeshManager() = default;
@@ -72,23 +81,29 @@ std::string MeshManager::GetMeshName(const MeshId id) const {
 }
 
 namespace {
+// Uploads the indices as 16-bit when the vertex count allows it, halving index memory and fetch bandwidth
+GLenum UploadIndices(const std::vector<uint32_t>& indices, const size_t vertex_count) {
+	if (vertex_count > MAX_16BIT_INDEXED_VERTICES) {
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+		return GL_UNSIGNED_INT;
+	}
+	const std::vector<uint16_t> narrow(indices.begin(), indices.end());
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, narrow.size() * sizeof(uint16_t), narrow.data(), GL_STATIC_DRAW);
+	return GL_UNSIGNED_SHORT;
+}
+
 // Helper to create or update GL mesh resources
 void SetupGLMesh(const MeshId id, const MeshCreateInfo& info) {
 	if (const auto it = g_mesh_gl.find(id); it != g_mesh_gl.end()) {
-		auto& [vao, vbo, ebo, index_count] = it->second;
-		index_count = static_cast<uint32_t>(info.indices.size());
+		GLMesh& gl_mesh = it->second;
+		gl_mesh.index_count = static_cast<uint32_t>(info.indices.size());
 
-		glBindVertexArray(vao);
-		glBindBuffer(GL_ARRAY_BUFFER, vbo);
+		GetGLStateCache().BindVertexArray(gl_mesh.vao);
+		glBindBuffer(GL_ARRAY_BUFFER, gl_mesh.vbo);
 		glBufferData(GL_ARRAY_BUFFER, info.vertices.size() * sizeof(Vertex), info.vertices.data(), GL_STATIC_DRAW);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-		glBufferData(
-			GL_ELEMENT_ARRAY_BUFFER,
-			info.indices.size() * sizeof(uint32_t),
-			info.indices.data(),
-			GL_STATIC_DRAW
-		);
-		glBindVertexArray(0);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gl_mesh.ebo);
+		gl_mesh.index_type = UploadIndices(info.indices, info.vertices.size());
+		GetGLStateCache().BindVertexArray(0);
 		return;
 	}
 
@@ -99,11 +114,11 @@ void SetupGLMesh(const MeshId id, const MeshCreateInfo& info) {
 	glGenBuffers(1, &gl_mesh.ebo);
 	gl_mesh.index_count = static_cast<uint32_t>(info.indices.size());
 
-	glBindVertexArray(gl_mesh.vao);
+	GetGLStateCache().BindVertexArray(gl_mesh.vao);
 	glBindBuffer(GL_ARRAY_BUFFER, gl_mesh.vbo);
 	glBufferData(GL_ARRAY_BUFFER, info.vertices.size() * sizeof(Vertex), info.vertices.data(), GL_STATIC_DRAW);
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gl_mesh.ebo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, info.indices.size() * sizeof(uint32_t), info.indices.data(), GL_STATIC_DRAW);
+	gl_mesh.index_type = UploadIndices(info.indices, info.vertices.size());
 
 	// Position
 	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*) offsetof(Vertex, position));
@@ -118,7 +133,7 @@ void SetupGLMesh(const MeshId id, const MeshCreateInfo& info) {
 	glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*) offsetof(Vertex, color));
 	glEnableVertexAttribArray(3);
 
-	glBindVertexArray(0);
+	GetGLStateCache().BindVertexArray(0);
 
 	g_mesh_gl[id] = gl_mesh;
 }
@@ -129,7 +144,9 @@ bool MeshManager::GenerateMeshGeometry(const MeshId id, const MeshCreateInfo& in
 		return false;
 	}
 	pimpl_->meshes[id] = info;
-	SetupGLMesh(id, info);
+	if (!IsHeadless()) {
+		SetupGLMesh(id, info);
+	}
 	return true;
 }
 
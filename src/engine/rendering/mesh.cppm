@@ -21,10 +21,16 @@ struct GLMesh {
 	GLuint vbo = 0;
 	GLuint ebo = 0;
 	uint32_t index_count = 0;
+	GLenum index_type = GL_UNSIGNED_INT; // GL_UNSIGNED_SHORT when every index fits in 16 bits
+	bool instance_attributes = false; // The renderer's instance buffer is attached to vao
 };
 
 GLMesh* GetGLMesh(MeshId id);
 
+// Clear every mesh's instance_attributes flag once the renderer's instance buffer is deleted, so the next
+// instanced draw re-attaches whichever buffer is current
+void ResetGLMeshInstanceAttributes();
+
 struct Vertex {
 	Vec3 position;
 	Vec3 normal;
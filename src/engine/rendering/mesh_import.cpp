@@ -0,0 +1,311 @@
+module;
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+module engine.rendering;
+
+import :mesh;
+import :mesh_import;
+
+namespace engine::rendering {
+namespace {
+// Forsyth's published tuning
+constexpr float CACHE_DECAY_POWER = 1.5F;
+constexpr float LAST_TRIANGLE_SCORE = 0.75F;
+constexpr float VALENCE_BOOST_SCALE = 2.0F;
+constexpr float VALENCE_BOOST_POWER = 0.5F;
+
+float VertexScore(const int32_t cache_position, const uint32_t remaining_triangles) {
+	if (remaining_triangles == 0) {
+		return -1.0F;
+	}
+	float score = 0.0F;
+	if (cache_position >= 0) {
+		if (cache_position < 3) {
+			// Scored flat so the triangle just emitted does not pull the next one towards any particular edge
+			score = LAST_TRIANGLE_SCORE;
+		}
+		else {
+			const float age = static_cast<float>(cache_position - 3) / static_cast<float>(VERTEX_CACHE_SIZE - 3);
+			score = std::pow(1.0F - age, CACHE_DECAY_POWER);
+		}
+	}
+	return score
+		   + VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remaining_triangles), -VALENCE_BOOST_POWER);
+}
+
+size_t AlignUp(const size_t offset) { return (offset + 3) & ~size_t{3}; }
+
+struct VertexHash {
+	size_t operator()(const Vertex* vertex) const {
+		// FNV-1a over the raw bytes, matching the bitwise equality below
+		const std::string_view bytes(reinterpret_cast<const char*>(vertex), sizeof(Vertex));
+		uint64_t hash = 14695981039346656037ULL;
+		for (const char byte : bytes) {
+			hash = (hash ^ static_cast<uint8_t>(byte)) * 1099511628211ULL;
+		}
+		return static_cast<size_t>(hash);
+	}
+};
+
+struct VertexEqual {
+	bool operator()(const Vertex* a, const Vertex* b) const { return std::memcmp(a, b, sizeof(Vertex)) == 0; }
+};
+} // namespace
+
+size_t DeduplicateVertices(MeshCreateInfo& mesh) {
+	if (mesh.indices.empty()) {
+		mesh.indices.resize(mesh.vertices.size());
+		std::iota(mesh.indices.begin(), mesh.indices.end(), 0U);
+	}
+
+	std::vector<uint32_t> remap(mesh.vertices.size());
+	std::vector<Vertex> unique;
+	unique.reserve(mesh.vertices.size());
+	{
+		// Keys point into the source vertices, which stay untouched until the lookup is done
+		std::unordered_map<const Vertex*, uint32_t, VertexHash, VertexEqual> first_seen;
+		first_seen.reserve(mesh.vertices.size());
+		for (size_t i = 0; i < mesh.vertices.size(); ++i) {
+			const auto [it, inserted] = first_seen.try_emplace(&mesh.vertices[i], static_cast<uint32_t>(unique.size()));
+			if (inserted) {
+				unique.push_back(mesh.vertices[i]);
+			}
+			remap[i] = it->second;
+		}
+	}
+
+	for (uint32_t& index : mesh.indices) {
+		index = remap[index];
+	}
+	const size_t removed = mesh.vertices.size() - unique.size();
+	mesh.vertices = std::move(unique);
+	return removed;
+}
+
+void OptimizeVertexCache(const std::span<uint32_t> indices, const size_t vertex_count) {
+	const size_t triangle_count = indices.size() / 3;
+	if (triangle_count == 0) {
+		return;
+	}
+
+	// Triangles using each vertex; a vertex's live triangles are the first remaining[v] of its list
+	std::vector<uint32_t> remaining(vertex_count, 0);
+	for (size_t i = 0; i < triangle_count * 3; ++i) {
+		++remaining[indices[i]];
+	}
+	std::vector<uint32_t> first_triangle(vertex_count + 1, 0);
+	std::partial_sum(remaining.begin(), remaining.end(), first_triangle.begin() + 1);
+	std::vector<uint32_t> adjacency(triangle_count * 3);
+	{
+		std::vector<uint32_t> cursor(first_triangle.begin(), first_triangle.end() - 1);
+		for (size_t i = 0; i < triangle_count * 3; ++i) {
+			adjacency[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+		}
+	}
+
+	std::vector<int32_t> cache_position(vertex_count, -1);
+	std::vector<float> vertex_score(vertex_count);
+	for (size_t vertex = 0; vertex < vertex_count; ++vertex) {
+		vertex_score[vertex] = VertexScore(-1, remaining[vertex]);
+	}
+	const auto triangle_score = [&](const size_t triangle) {
+		return vertex_score[indices[triangle * 3]] + vertex_score[indices[triangle * 3 + 1]]
+			   + vertex_score[indices[triangle * 3 + 2]];
+	};
+
+	std::vector<bool> emitted(triangle_count, false);
+	std::vector<uint32_t> output;
+	output.reserve(triangle_count * 3);
+
+	// Up to three new vertices are pushed in front of a full cache before the overflow is evicted
+	std::array<uint32_t, VERTEX_CACHE_SIZE + 3> cache{};
+	std::array<uint32_t, VERTEX_CACHE_SIZE + 3> next_cache{};
+	size_t cache_count = 0;
+
+	size_t best = 0;
+	float best_score = -1.0F;
+	for (size_t triangle = 0; triangle < triangle_count; ++triangle) {
+		if (const float score = triangle_score(triangle); score > best_score) {
+			best = triangle;
+			best_score = score;
+		}
+	}
+	size_t scan_cursor = 0;
+
+	while (output.size() < triangle_count * 3) {
+		if (best_score < 0.0F) {
+			// Nothing in the cache has triangles left; restart from the next unemitted triangle in input order
+			while (emitted[scan_cursor]) {
+				++scan_cursor;
+			}
+			best = scan_cursor;
+		}
+
+		emitted[best] = true;
+		const std::array<uint32_t, 3> corners{indices[best * 3], indices[best * 3 + 1], indices[best * 3 + 2]};
+		size_t next_count = 0;
+		for (const uint32_t vertex : corners) {
+			output.push_back(vertex);
+
+			// Swap the triangle out of the vertex's live range
+			const auto live_begin = adjacency.begin() + first_triangle[vertex];
+			const auto live_end = live_begin + remaining[vertex];
+			std::iter_swap(std::find(live_begin, live_end, static_cast<uint32_t>(best)), live_end - 1);
+			--remaining[vertex];
+
+			if (std::find(next_cache.begin(), next_cache.begin() + next_count, vertex)
+				== next_cache.begin() + next_count) {
+				next_cache[next_count++] = vertex;
+			}
+		}
+		for (size_t i = 0; i < cache_count; ++i) {
+			if (std::ranges::find(corners, cache[i]) == corners.end()) {
+				next_cache[next_count++] = cache[i];
+			}
+		}
+
+		for (size_t i = 0; i < next_count; ++i) {
+			const uint32_t vertex = next_cache[i];
+			cache_position[vertex] = i < VERTEX_CACHE_SIZE ? static_cast<int32_t>(i) : -1;
+			vertex_score[vertex] = VertexScore(cache_position[vertex], remaining[vertex]);
+		}
+		cache_count = std::min<size_t>(next_count, VERTEX_CACHE_SIZE);
+		std::copy_n(next_cache.begin(), cache_count, cache.begin());
+
+		// Only triangles around cached vertices changed score, so the next pick comes from them
+		best_score = -1.0F;
+		for (size_t i = 0; i < cache_count; ++i) {
+			const uint32_t vertex = cache[i];
+			for (uint32_t j = 0; j < remaining[vertex]; ++j) {
+				const uint32_t triangle = adjacency[first_triangle[vertex] + j];
+				if (const float score = triangle_score(triangle); score > best_score) {
+					best = triangle;
+					best_score = score;
+				}
+			}
+		}
+	}
+
+	std::ranges::copy(output, indices.begin());
+}
+
+void OptimizeVertexFetch(MeshCreateInfo& mesh) {
+	constexpr uint32_t unassigned = ~0U;
+	std::vector<uint32_t> remap(mesh.vertices.size(), unassigned);
+	std::vector<Vertex> ordered;
+	ordered.reserve(mesh.vertices.size());
+	for (uint32_t& index : mesh.indices) {
+		if (remap[index] == unassigned) {
+			remap[index] = static_cast<uint32_t>(ordered.size());
+			ordered.push_back(mesh.vertices[index]);
+		}
+		index = remap[index];
+	}
+	mesh.vertices = std::move(ordered);
+}
+
+void OptimizeMesh(MeshCreateInfo& mesh) {
+	DeduplicateVertices(mesh);
+	OptimizeVertexCache(mesh.indices, mesh.vertices.size());
+	OptimizeVertexFetch(mesh);
+}
+
+float ComputeACMR(const std::span<const uint32_t> indices, const uint32_t cache_size) {
+	const size_t triangle_count = indices.size() / 3;
+	if (triangle_count == 0 || cache_size == 0) {
+		return 0.0F;
+	}
+	std::vector<uint32_t> fifo(cache_size, ~0U);
+	size_t head = 0;
+	size_t misses = 0;
+	for (size_t i = 0; i < triangle_count * 3; ++i) {
+		if (std::ranges::find(fifo, indices[i]) == fifo.end()) {
+			fifo[head] = indices[i];
+			head = (head + 1) % cache_size;
+			++misses;
+		}
+	}
+	return static_cast<float>(misses) / static_cast<float>(triangle_count);
+}
+
+std::vector<uint8_t> WriteMeshBinary(const MeshCreateInfo& mesh) {
+	MeshBinaryHeader header;
+	header.vertex_count = static_cast<uint32_t>(mesh.vertices.size());
+	header.index_count = static_cast<uint32_t>(mesh.indices.size());
+	header.index_size = mesh.vertices.size() <= MAX_16BIT_INDEXED_VERTICES ? sizeof(uint16_t) : sizeof(uint32_t);
+
+	const size_t vertex_offset = AlignUp(sizeof(MeshBinaryHeader));
+	const size_t index_offset = AlignUp(vertex_offset + mesh.vertices.size() * sizeof(Vertex));
+	std::vector<uint8_t> data(AlignUp(index_offset + mesh.indices.size() * header.index_size), 0);
+
+	std::memcpy(data.data(), &header, sizeof(header));
+	if (!mesh.vertices.empty()) {
+		std::memcpy(data.data() + vertex_offset, mesh.vertices.data(), mesh.vertices.size() * sizeof(Vertex));
+	}
+	if (header.index_size == sizeof(uint16_t)) {
+		for (size_t i = 0; i < mesh.indices.size(); ++i) {
+			const auto index = static_cast<uint16_t>(mesh.indices[i]);
+			std::memcpy(data.data() + index_offset + i * sizeof(uint16_t), &index, sizeof(index));
+		}
+	}
+	else if (!mesh.indices.empty()) {
+		std::memcpy(data.data() + index_offset, mesh.indices.data(), mesh.indices.size() * sizeof(uint32_t));
+	}
+	return data;
+}
+
+std::optional<MeshCreateInfo> ReadMeshBinary(const std::span<const uint8_t> data) {
+	MeshBinaryHeader header;
+	if (data.size() < sizeof(header)) {
+		return std::nullopt;
+	}
+	std::memcpy(&header, data.data(), sizeof(header));
+	if (header.magic != MESH_BINARY_MAGIC || header.version != MESH_BINARY_VERSION
+		|| header.vertex_size != sizeof(Vertex)
+		|| (header.index_size != sizeof(uint16_t) && header.index_size != sizeof(uint32_t))) {
+		return std::nullopt;
+	}
+
+	const size_t vertex_offset = AlignUp(sizeof(MeshBinaryHeader));
+	const size_t index_offset = AlignUp(vertex_offset + static_cast<size_t>(header.vertex_count) * sizeof(Vertex));
+	if (data.size() < index_offset + static_cast<size_t>(header.index_count) * header.index_size) {
+		return std::nullopt;
+	}
+
+	MeshCreateInfo mesh;
+	mesh.vertices.resize(header.vertex_count);
+	if (header.vertex_count > 0) {
+		std::memcpy(mesh.vertices.data(), data.data() + vertex_offset, mesh.vertices.size() * sizeof(Vertex));
+	}
+	mesh.indices.resize(header.index_count);
+	if (header.index_size == sizeof(uint16_t)) {
+		for (size_t i = 0; i < mesh.indices.size(); ++i) {
+			uint16_t index = 0;
+			std::memcpy(&index, data.data() + index_offset + i * sizeof(uint16_t), sizeof(index));
+			mesh.indices[i] = index;
+		}
+	}
+	else if (header.index_count > 0) {
+		std::memcpy(mesh.indices.data(), data.data() + index_offset, mesh.indices.size() * sizeof(uint32_t));
+	}
+
+	// Corrupt indices would otherwise read past the vertex buffer on the GPU
+	if (std::ranges::any_of(mesh.indices, [&header](const uint32_t index) { return index >= header.vertex_count; })) {
+		return std::nullopt;
+	}
+	return mesh;
+}
+
+} // namespace engine::rendering
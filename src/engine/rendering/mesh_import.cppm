@@ -0,0 +1,70 @@
+module;
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+export module engine.rendering:mesh_import;
+
+import :mesh;
+
+export namespace engine::rendering {
+
+// Leading bytes of a binary mesh: "CMSH" read as a little-endian uint32
+constexpr uint32_t MESH_BINARY_MAGIC = 0x48534D43;
+// Bump when the header or the Vertex layout changes; older blobs are rejected and must be re-imported
+constexpr uint32_t MESH_BINARY_VERSION = 1;
+constexpr auto MESH_BINARY_EXTENSION = ".cmesh";
+
+// Meshes with at most this many vertices store and draw 16-bit indices
+constexpr size_t MAX_16BIT_INDEXED_VERTICES = 65536;
+
+// Vertices a post-transform cache is assumed to hold when scoring and measuring triangle order
+constexpr uint32_t VERTEX_CACHE_SIZE = 32;
+
+/**
+ * @brief Fixed header at the start of a binary mesh
+ *
+ * Followed by vertex_count Vertex structs exactly as they sit in memory, then index_count indices of index_size
+ * bytes. Both arrays start 4-byte aligned, so the blob can be read in place.
+ */
+struct MeshBinaryHeader {
+	uint32_t magic = MESH_BINARY_MAGIC;
+	uint32_t version = MESH_BINARY_VERSION;
+	uint32_t vertex_size = sizeof(Vertex);
+	uint32_t vertex_count = 0;
+	uint32_t index_size = sizeof(uint32_t); // 2 or 4
+	uint32_t index_count = 0;
+};
+
+// Merge vertices that are bitwise identical and remap the indices onto the survivors. A mesh without indices is
+// treated as a triangle list and gets them. Returns the number of vertices removed.
+size_t DeduplicateVertices(MeshCreateInfo& mesh);
+
+/**
+ * @brief Reorder triangles so consecutive ones share vertices still in the post-transform cache
+ *
+ * Greedy scoring in the style of Forsyth's linear-speed optimiser: each step emits the best-scoring triangle
+ * touching the simulated cache, favouring vertices used recently and vertices with few triangles left.
+ */
+void OptimizeVertexCache(std::span<uint32_t> indices, size_t vertex_count);
+
+// Reorder vertices into the order the indices first use them, dropping any that are never referenced
+void OptimizeVertexFetch(MeshCreateInfo& mesh);
+
+// Full import pass: deduplicate, reorder for the vertex cache, then for vertex fetch
+void OptimizeMesh(MeshCreateInfo& mesh);
+
+// Average cache miss ratio: transformed vertices per triangle with a FIFO cache of cache_size (0.5 is ideal for
+// a regular grid, 3 means nothing is reused)
+[[nodiscard]] float ComputeACMR(std::span<const uint32_t> indices, uint32_t cache_size = VERTEX_CACHE_SIZE);
+
+// Serialize to the binary mesh format, narrowing indices to 16 bits when the vertex count allows it
+[[nodiscard]] std::vector<uint8_t> WriteMeshBinary(const MeshCreateInfo& mesh);
+
+// Parse a blob written by WriteMeshBinary. Returns nullopt when the header, version or sizes do not match.
+[[nodiscard]] std::optional<MeshCreateInfo> ReadMeshBinary(std::span<const uint8_t> data);
+
+} // namespace engine::rendering
@@ -0,0 +1,400 @@
+module;
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+#ifndef __EMSCRIPTEN__
+#include <glad/glad.h>
+#endif
+
+module engine.rendering;
+
+import :gl_state;
+import :null_device;
+
+namespace engine::rendering {
+namespace {
+NullDeviceStats g_stats;
+bool g_recording = false;
+std::vector<std::string_view> g_calls;
+std::vector<uint8_t> g_mapped; // Backing memory for the one range mapped at a time
+
+#ifndef __EMSCRIPTEN__
+GLuint g_next_name = 1; // One name space for every object type; GL only requires uniqueness per type
+
+void Record(const std::string_view call) {
+	if (g_recording) {
+		g_calls.push_back(call);
+	}
+}
+
+void StateChange(const std::string_view call) {
+	Record(call);
+	++g_stats.state_changes;
+}
+
+void UniformUpload(const std::string_view call) {
+	Record(call);
+	++g_stats.uniform_uploads;
+}
+
+void GenNames(const std::string_view call, const GLsizei count, GLuint* names) {
+	Record(call);
+	for (GLsizei i = 0; i < count; ++i) {
+		names[i] = g_next_name++;
+	}
+	g_stats.objects_created += static_cast<uint64_t>(count);
+}
+
+void DeleteNames(const std::string_view call, const GLsizei count) {
+	Record(call);
+	g_stats.objects_deleted += static_cast<uint64_t>(count);
+}
+
+void Draw(const std::string_view call, const GLsizei vertices, const GLsizei instances) {
+	Record(call);
+	++g_stats.draw_calls;
+	g_stats.vertices_submitted += static_cast<uint64_t>(vertices) * static_cast<uint64_t>(instances);
+}
+
+uint64_t PixelBytes(const GLenum format, const GLenum type) {
+	if (type == GL_UNSIGNED_INT_24_8) {
+		return 4;
+	}
+	uint64_t channels = 4;
+	switch (format) {
+	case GL_RED:
+	case GL_RED_INTEGER:
+	case GL_DEPTH_COMPONENT: channels = 1; break;
+	case GL_RG:
+	case GL_RG_INTEGER: channels = 2; break;
+	case GL_RGB:
+	case GL_RGB_INTEGER: channels = 3; break;
+	default: break;
+	}
+	switch (type) {
+	case GL_FLOAT:
+	case GL_UNSIGNED_INT: return channels * 4;
+	case GL_HALF_FLOAT:
+	case GL_UNSIGNED_SHORT: return channels * 2;
+	default: return channels;
+	}
+}
+
+void TextureUpload(
+	const std::string_view call,
+	const GLsizei width,
+	const GLsizei height,
+	const GLenum format,
+	const GLenum type,
+	const void* pixels
+) {
+	Record(call);
+	if (pixels) {
+		g_stats.texture_upload_bytes +=
+			static_cast<uint64_t>(width) * static_cast<uint64_t>(height) * PixelBytes(format, type);
+	}
+}
+
+// === STATE ===
+
+void APIENTRY NullEnable(GLenum) { StateChange("glEnable"); }
+void APIENTRY NullDisable(GLenum) { StateChange("glDisable"); }
+void APIENTRY NullDepthMask(GLboolean) { StateChange("glDepthMask"); }
+void APIENTRY NullDepthFunc(GLenum) { StateChange("glDepthFunc"); }
+void APIENTRY NullPolygonMode(GLenum, GLenum) { StateChange("glPolygonMode"); }
+void APIENTRY NullBlendFunc(GLenum, GLenum) { StateChange("glBlendFunc"); }
+void APIENTRY NullCullFace(GLenum) { StateChange("glCullFace"); }
+void APIENTRY NullFrontFace(GLenum) { StateChange("glFrontFace"); }
+void APIENTRY NullViewport(GLint, GLint, GLsizei, GLsizei) { StateChange("glViewport"); }
+void APIENTRY NullScissor(GLint, GLint, GLsizei, GLsizei) { StateChange("glScissor"); }
+void APIENTRY NullClearColor(GLfloat, GLfloat, GLfloat, GLfloat) { StateChange("glClearColor"); }
+void APIENTRY NullClear(GLbitfield) { Record("glClear"); }
+void APIENTRY NullUseProgram(GLuint) { StateChange("glUseProgram"); }
+void APIENTRY NullBindVertexArray(GLuint) { StateChange("glBindVertexArray"); }
+void APIENTRY NullBindFramebuffer(GLenum, GLuint) { StateChange("glBindFramebuffer"); }
+GLenum APIENTRY NullGetError() { return GL_NO_ERROR; }
+
+// Every fence has already signalled, as if the GPU kept up
+GLsync APIENTRY NullFenceSync(GLenum, GLbitfield) {
+	Record("glFenceSync");
+	return reinterpret_cast<GLsync>(static_cast<uintptr_t>(g_next_name++));
+}
+GLenum APIENTRY NullClientWaitSync(GLsync, GLbitfield, GLuint64) { return GL_ALREADY_SIGNALED; }
+void APIENTRY NullDeleteSync(GLsync) { Record("glDeleteSync"); }
+
+// === BUFFERS AND VERTEX ARRAYS ===
+
+void APIENTRY NullGenBuffers(const GLsizei n, GLuint* buffers) { GenNames("glGenBuffers", n, buffers); }
+void APIENTRY NullDeleteBuffers(const GLsizei n, const GLuint*) { DeleteNames("glDeleteBuffers", n); }
+
+void APIENTRY NullBindBuffer(GLenum, GLuint) {
+	Record("glBindBuffer");
+	++g_stats.buffer_binds;
+}
+
+void APIENTRY NullBindBufferBase(GLenum, GLuint, GLuint) {
+	Record("glBindBufferBase");
+	++g_stats.buffer_binds;
+}
+
+void APIENTRY NullBufferData(GLenum, const GLsizeiptr size, const void* data, GLenum) {
+	Record("glBufferData");
+	if (data) {
+		g_stats.buffer_upload_bytes += static_cast<uint64_t>(size);
+	}
+}
+
+void APIENTRY NullBufferSubData(GLenum, GLintptr, const GLsizeiptr size, const void*) {
+	Record("glBufferSubData");
+	g_stats.buffer_upload_bytes += static_cast<uint64_t>(size);
+}
+
+// Mapped ranges are written by the caller, so they count as uploaded
+void* APIENTRY NullMapBufferRange(GLenum, GLintptr, const GLsizeiptr length, GLbitfield) {
+	Record("glMapBufferRange");
+	g_stats.buffer_upload_bytes += static_cast<uint64_t>(length);
+	g_mapped.resize(static_cast<size_t>(length));
+	return g_mapped.data();
+}
+
+GLboolean APIENTRY NullUnmapBuffer(GLenum) {
+	Record("glUnmapBuffer");
+	return GL_TRUE;
+}
+
+void APIENTRY NullGenVertexArrays(const GLsizei n, GLuint* arrays) { GenNames("glGenVertexArrays", n, arrays); }
+void APIENTRY NullDeleteVertexArrays(const GLsizei n, const GLuint*) { DeleteNames("glDeleteVertexArrays", n); }
+void APIENTRY NullEnableVertexAttribArray(GLuint) { Record("glEnableVertexAttribArray"); }
+void APIENTRY NullVertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) {
+	Record("glVertexAttribPointer");
+}
+void APIENTRY NullVertexAttribDivisor(GLuint, GLuint) { Record("glVertexAttribDivisor"); }
+
+// === DRAWS ===
+
+void APIENTRY NullDrawArrays(GLenum, GLint, const GLsizei count) { Draw("glDrawArrays", count, 1); }
+void APIENTRY NullDrawElements(GLenum, const GLsizei count, GLenum, const void*) { Draw("glDrawElements", count, 1); }
+void APIENTRY NullDrawElementsInstanced(GLenum, const GLsizei count, GLenum, const void*, const GLsizei instances) {
+	Draw("glDrawElementsInstanced", count, instances);
+}
+
+// === TEXTURES ===
+
+void APIENTRY NullGenTextures(const GLsizei n, GLuint* textures) { GenNames("glGenTextures", n, textures); }
+void APIENTRY NullDeleteTextures(const GLsizei n, const GLuint*) { DeleteNames("glDeleteTextures", n); }
+void APIENTRY NullActiveTexture(GLenum) { Record("glActiveTexture"); }
+
+void APIENTRY NullBindTexture(GLenum, GLuint) {
+	Record("glBindTexture");
+	++g_stats.texture_binds;
+}
+
+void APIENTRY NullTexImage2D(
+	GLenum,
+	GLint,
+	GLint,
+	const GLsizei width,
+	const GLsizei height,
+	GLint,
+	const GLenum format,
+	const GLenum type,
+	const void* pixels
+) {
+	TextureUpload("glTexImage2D", width, height, format, type, pixels);
+}
+
+void APIENTRY NullTexSubImage2D(
+	GLenum,
+	GLint,
+	GLint,
+	GLint,
+	const GLsizei width,
+	const GLsizei height,
+	const GLenum format,
+	const GLenum type,
+	const void* pixels
+) {
+	TextureUpload("glTexSubImage2D", width, height, format, type, pixels);
+}
+
+void APIENTRY NullTexParameteri(GLenum, GLenum, GLint) { Record("glTexParameteri"); }
+void APIENTRY NullGenerateMipmap(GLenum) { Record("glGenerateMipmap"); }
+
+// === FRAMEBUFFERS ===
+
+void APIENTRY NullGenFramebuffers(const GLsizei n, GLuint* framebuffers) {
+	GenNames("glGenFramebuffers", n, framebuffers);
+}
+void APIENTRY NullDeleteFramebuffers(const GLsizei n, const GLuint*) { DeleteNames("glDeleteFramebuffers", n); }
+void APIENTRY NullFramebufferTexture2D(GLenum, GLenum, GLenum, GLuint, GLint) { Record("glFramebufferTexture2D"); }
+GLenum APIENTRY NullCheckFramebufferStatus(GLenum) { return GL_FRAMEBUFFER_COMPLETE; }
+void APIENTRY NullGenRenderbuffers(const GLsizei n, GLuint* renderbuffers) {
+	GenNames("glGenRenderbuffers", n, renderbuffers);
+}
+void APIENTRY NullDeleteRenderbuffers(const GLsizei n, const GLuint*) { DeleteNames("glDeleteRenderbuffers", n); }
+void APIENTRY NullBindRenderbuffer(GLenum, GLuint) { Record("glBindRenderbuffer"); }
+void APIENTRY NullRenderbufferStorage(GLenum, GLenum, GLsizei, GLsizei) { Record("glRenderbufferStorage"); }
+void APIENTRY NullFramebufferRenderbuffer(GLenum, GLenum, GLenum, GLuint) { Record("glFramebufferRenderbuffer"); }
+
+// === SHADERS ===
+
+GLuint APIENTRY NullCreateShader(GLenum) {
+	Record("glCreateShader");
+	++g_stats.objects_created;
+	return g_next_name++;
+}
+
+GLuint APIENTRY NullCreateProgram() {
+	Record("glCreateProgram");
+	++g_stats.objects_created;
+	return g_next_name++;
+}
+
+void APIENTRY NullDeleteShader(GLuint) { DeleteNames("glDeleteShader", 1); }
+void APIENTRY NullDeleteProgram(GLuint) { DeleteNames("glDeleteProgram", 1); }
+void APIENTRY NullShaderSource(GLuint, GLsizei, const GLchar* const*, const GLint*) { Record("glShaderSource"); }
+void APIENTRY NullCompileShader(GLuint) { Record("glCompileShader"); }
+void APIENTRY NullAttachShader(GLuint, GLuint) { Record("glAttachShader"); }
+void APIENTRY NullLinkProgram(GLuint) { Record("glLinkProgram"); }
+
+// Everything compiles and links, with an empty info log
+void APIENTRY NullGetShaderiv(GLuint, const GLenum pname, GLint* params) {
+	*params = pname == GL_COMPILE_STATUS ? GL_TRUE : 0;
+}
+void APIENTRY NullGetProgramiv(GLuint, const GLenum pname, GLint* params) {
+	*params = pname == GL_LINK_STATUS ? GL_TRUE : 0;
+}
+
+void APIENTRY NullGetInfoLog(GLuint, const GLsizei buffer_size, GLsizei* length, GLchar* info_log) {
+	if (length) {
+		*length = 0;
+	}
+	if (buffer_size > 0) {
+		info_log[0] = '\0';
+	}
+}
+
+// Every lookup gets a fresh valid location; callers cache them per program, so uniqueness is all that matters
+GLint APIENTRY NullGetUniformLocation(GLuint, const GLchar*) {
+	static GLint next_location = 0;
+	return next_location++;
+}
+GLuint APIENTRY NullGetUniformBlockIndex(GLuint, const GLchar*) { return 0; }
+void APIENTRY NullUniformBlockBinding(GLuint, GLuint, GLuint) { Record("glUniformBlockBinding"); }
+
+void APIENTRY NullUniform1i(GLint, GLint) { UniformUpload("glUniform1i"); }
+void APIENTRY NullUniform1f(GLint, GLfloat) { UniformUpload("glUniform1f"); }
+void APIENTRY NullUniform1iv(GLint, GLsizei, const GLint*) { UniformUpload("glUniform1iv"); }
+void APIENTRY NullUniform2fv(GLint, GLsizei, const GLfloat*) { UniformUpload("glUniform2fv"); }
+void APIENTRY NullUniform3fv(GLint, GLsizei, const GLfloat*) { UniformUpload("glUniform3fv"); }
+void APIENTRY NullUniform4fv(GLint, GLsizei, const GLfloat*) { UniformUpload("glUniform4fv"); }
+void APIENTRY NullUniformMatrix3fv(GLint, GLsizei, GLboolean, const GLfloat*) { UniformUpload("glUniformMatrix3fv"); }
+void APIENTRY NullUniformMatrix4fv(GLint, GLsizei, GLboolean, const GLfloat*) { UniformUpload("glUniformMatrix4fv"); }
+#endif
+} // namespace
+
+bool InstallNullDevice() {
+#ifdef __EMSCRIPTEN__
+	return false;
+#else
+	glad_glEnable = NullEnable;
+	glad_glDisable = NullDisable;
+	glad_glDepthMask = NullDepthMask;
+	glad_glDepthFunc = NullDepthFunc;
+	glad_glPolygonMode = NullPolygonMode;
+	glad_glBlendFunc = NullBlendFunc;
+	glad_glCullFace = NullCullFace;
+	glad_glFrontFace = NullFrontFace;
+	glad_glViewport = NullViewport;
+	glad_glScissor = NullScissor;
+	glad_glClearColor = NullClearColor;
+	glad_glClear = NullClear;
+	glad_glUseProgram = NullUseProgram;
+	glad_glBindVertexArray = NullBindVertexArray;
+	glad_glBindFramebuffer = NullBindFramebuffer;
+	glad_glGetError = NullGetError;
+	glad_glFenceSync = NullFenceSync;
+	glad_glClientWaitSync = NullClientWaitSync;
+	glad_glDeleteSync = NullDeleteSync;
+
+	glad_glGenBuffers = NullGenBuffers;
+	glad_glDeleteBuffers = NullDeleteBuffers;
+	glad_glBindBuffer = NullBindBuffer;
+	glad_glBindBufferBase = NullBindBufferBase;
+	glad_glBufferData = NullBufferData;
+	glad_glBufferSubData = NullBufferSubData;
+	glad_glMapBufferRange = NullMapBufferRange;
+	glad_glUnmapBuffer = NullUnmapBuffer;
+	glad_glGenVertexArrays = NullGenVertexArrays;
+	glad_glDeleteVertexArrays = NullDeleteVertexArrays;
+	glad_glEnableVertexAttribArray = NullEnableVertexAttribArray;
+	glad_glVertexAttribPointer = NullVertexAttribPointer;
+	glad_glVertexAttribDivisor = NullVertexAttribDivisor;
+
+	glad_glDrawArrays = NullDrawArrays;
+	glad_glDrawElements = NullDrawElements;
+	glad_glDrawElementsInstanced = NullDrawElementsInstanced;
+
+	glad_glGenTextures = NullGenTextures;
+	glad_glDeleteTextures = NullDeleteTextures;
+	glad_glActiveTexture = NullActiveTexture;
+	glad_glBindTexture = NullBindTexture;
+	glad_glTexImage2D = NullTexImage2D;
+	glad_glTexSubImage2D = NullTexSubImage2D;
+	glad_glTexParameteri = NullTexParameteri;
+	glad_glGenerateMipmap = NullGenerateMipmap;
+
+	glad_glGenFramebuffers = NullGenFramebuffers;
+	glad_glDeleteFramebuffers = NullDeleteFramebuffers;
+	glad_glFramebufferTexture2D = NullFramebufferTexture2D;
+	glad_glCheckFramebufferStatus = NullCheckFramebufferStatus;
+	glad_glGenRenderbuffers = NullGenRenderbuffers;
+	glad_glDeleteRenderbuffers = NullDeleteRenderbuffers;
+	glad_glBindRenderbuffer = NullBindRenderbuffer;
+	glad_glRenderbufferStorage = NullRenderbufferStorage;
+	glad_glFramebufferRenderbuffer = NullFramebufferRenderbuffer;
+
+	glad_glCreateShader = NullCreateShader;
+	glad_glCreateProgram = NullCreateProgram;
+	glad_glDeleteShader = NullDeleteShader;
+	glad_glDeleteProgram = NullDeleteProgram;
+	glad_glShaderSource = NullShaderSource;
+	glad_glCompileShader = NullCompileShader;
+	glad_glAttachShader = NullAttachShader;
+	glad_glLinkProgram = NullLinkProgram;
+	glad_glGetShaderiv = NullGetShaderiv;
+	glad_glGetProgramiv = NullGetProgramiv;
+	glad_glGetShaderInfoLog = NullGetInfoLog;
+	glad_glGetProgramInfoLog = NullGetInfoLog;
+	glad_glGetUniformLocation = NullGetUniformLocation;
+	glad_glGetUniformBlockIndex = NullGetUniformBlockIndex;
+	glad_glUniformBlockBinding = NullUniformBlockBinding;
+	glad_glUniform1i = NullUniform1i;
+	glad_glUniform1f = NullUniform1f;
+	glad_glUniform1iv = NullUniform1iv;
+	glad_glUniform2fv = NullUniform2fv;
+	glad_glUniform3fv = NullUniform3fv;
+	glad_glUniform4fv = NullUniform4fv;
+	glad_glUniformMatrix3fv = NullUniformMatrix3fv;
+	glad_glUniformMatrix4fv = NullUniformMatrix4fv;
+
+	// Shadowed state may describe a real context the cache saw before
+	GetGLStateCache().Invalidate();
+	return true;
+#endif
+}
+
+const NullDeviceStats& GetNullDeviceStats() { return g_stats; }
+
+void ResetNullDeviceStats() {
+	g_stats = {};
+	g_calls.clear();
+}
+
+void SetNullDeviceRecording(const bool enabled) { g_recording = enabled; }
+
+std::span<const std::string_view> GetNullDeviceCalls() { return g_calls; }
+
+} // namespace engine::rendering
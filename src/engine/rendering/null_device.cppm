@@ -0,0 +1,43 @@
+module;
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+export module engine.rendering:null_device;
+
+export namespace engine::rendering {
+
+// Work the null device saw since the last ResetNullDeviceStats()
+struct NullDeviceStats {
+	uint64_t draw_calls = 0;
+	uint64_t vertices_submitted = 0; // Vertices or indices per draw, times its instance count
+	// Capabilities, blend/depth/cull/polygon modes, viewport, scissor, clear state and program, VAO and
+	// framebuffer binds
+	uint64_t state_changes = 0;
+	uint64_t texture_binds = 0;
+	uint64_t buffer_binds = 0;
+	uint64_t uniform_uploads = 0;
+	uint64_t buffer_upload_bytes = 0; // glBufferData with data, glBufferSubData and mapped ranges
+	uint64_t texture_upload_bytes = 0;
+	uint64_t objects_created = 0; // Buffers, VAOs, textures, framebuffers, renderbuffers, shaders and programs
+	uint64_t objects_deleted = 0;
+};
+
+// Point the GL entry points at a device that counts (and optionally records) calls instead of reaching a GPU, so
+// the renderer, batchers and resource managers run their real GL paths without a context. Object creation hands
+// out unique names and shaders always compile and link. Leave headless mode off, otherwise those paths are
+// skipped. Returns false where GL is not loaded through glad (Emscripten).
+bool InstallNullDevice();
+
+[[nodiscard]] const NullDeviceStats& GetNullDeviceStats();
+
+// Zero the counters and clear the call log
+void ResetNullDeviceStats();
+
+// While enabled, the name of every GL call is appended to the call log
+void SetNullDeviceRecording(bool enabled);
+
+[[nodiscard]] std::span<const std::string_view> GetNullDeviceCalls();
+
+} // namespace engine::rendering
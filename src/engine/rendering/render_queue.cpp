@@ -0,0 +1,89 @@
+module;
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+module engine.rendering;
+
+namespace engine::rendering {
+namespace {
+constexpr uint64_t Mask(const uint32_t bits) { return (uint64_t{1} << bits) - 1; }
+
+// Non-negative IEEE floats order the same as their bit patterns, so the top bits of the pattern (exponent first)
+// are a monotonic fixed-width depth with constant relative precision and no near/far range to configure
+uint64_t QuantizeDepth(const float depth, const uint32_t bits) {
+	const float clamped = depth > 0.0F ? depth : 0.0F;
+	return static_cast<uint64_t>(std::bit_cast<uint32_t>(clamped) >> (31 - bits));
+}
+
+// Below this many items a comparison sort beats eight histogram passes
+constexpr size_t RADIX_THRESHOLD = 64;
+} // namespace
+
+uint64_t RenderQueue::MakeKey(const SortKeyFields& fields) {
+	const uint64_t layer = std::min<uint64_t>(fields.layer, Mask(8));
+	uint64_t key = layer << 56;
+	if (!fields.transparent) {
+		key |= (fields.shader & Mask(14)) << 41;
+		key |= (fields.material & Mask(14)) << 27;
+		key |= (fields.mesh & Mask(14)) << 13;
+		key |= QuantizeDepth(fields.view_depth, 13);
+		return key;
+	}
+
+	key |= uint64_t{1} << 55;
+	key |= (Mask(23) - QuantizeDepth(fields.view_depth, 23)) << 32;
+	key |= (fields.shader & Mask(11)) << 21;
+	key |= (fields.material & Mask(11)) << 10;
+	key |= fields.mesh & Mask(10);
+	return key;
+}
+
+void RenderQueue::Sort() {
+	const size_t count = items_.size();
+	if (count < RADIX_THRESHOLD) {
+		std::ranges::stable_sort(items_, {}, &Item::key);
+		return;
+	}
+
+	// One read of the keys builds the histograms for all eight byte-wide digits
+	std::array<std::array<uint32_t, 256>, 8> histograms{};
+	for (const Item& item : items_) {
+		for (size_t digit = 0; digit < 8; ++digit) {
+			++histograms[digit][(item.key >> (digit * 8)) & 0xFF];
+		}
+	}
+
+	scratch_.resize(count);
+	Item* source = items_.data();
+	Item* destination = scratch_.data();
+	for (size_t digit = 0; digit < 8; ++digit) {
+		const uint32_t shift = static_cast<uint32_t>(digit) * 8;
+		auto& histogram = histograms[digit];
+
+		// Every key has the same value in this digit (e.g. unused layer bits), so the pass would be a copy
+		if (histogram[(source[0].key >> shift) & 0xFF] == count) {
+			continue;
+		}
+
+		uint32_t offset = 0;
+		for (uint32_t& bucket : histogram) {
+			const uint32_t bucket_count = bucket;
+			bucket = offset;
+			offset += bucket_count;
+		}
+		for (size_t i = 0; i < count; ++i) {
+			destination[histogram[(source[i].key >> shift) & 0xFF]++] = source[i];
+		}
+		std::swap(source, destination);
+	}
+
+	if (source != items_.data()) {
+		items_.swap(scratch_);
+	}
+}
+} // namespace engine::rendering
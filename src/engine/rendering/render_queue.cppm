@@ -0,0 +1,60 @@
+module;
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+export module engine.rendering:render_queue;
+
+import :types;
+
+export namespace engine::rendering {
+// Inputs to RenderQueue::MakeKey
+struct SortKeyFields {
+	uint32_t layer = 0; // Lower layers draw first; clamped to 255
+	bool transparent = false;
+	ShaderId shader = INVALID_SHADER; // The program the draw will actually bind
+	MaterialId material = INVALID_MATERIAL;
+	MeshId mesh = INVALID_MESH;
+	float view_depth = 0.0F; // Distance in front of the camera; negative values count as 0
+};
+
+// Deferred draw list ordered by packed 64-bit keys. Callers keep their draw data in their own arrays and push
+// (key, index) pairs; after Sort() the items come back in execution order with the indices to draw.
+//
+// Key layout, most significant bits first:
+//   opaque:      layer:8 | 0:1 | shader:14 | material:14 | mesh:14 | depth:13 (near to far)
+//   transparent: layer:8 | 1:1 | depth:23 (far to near) | shader:11 | material:11 | mesh:10
+// Opaque draws are grouped by state to minimise program, texture and VAO switches; transparent draws have to
+// blend back to front, so depth outranks state for them. IDs wider than their field are truncated, which only
+// costs grouping, never correctness.
+class RenderQueue {
+public:
+	struct Item {
+		uint64_t key = 0;
+		uint32_t index = 0;
+	};
+
+	[[nodiscard]] static uint64_t MakeKey(const SortKeyFields& fields);
+
+	void Clear() { items_.clear(); }
+
+	void Reserve(const size_t count) { items_.reserve(count); }
+
+	void Push(const uint64_t key, const uint32_t index) { items_.push_back({.key = key, .index = index}); }
+
+	// Stable LSD radix sort by key; equal keys keep their push order
+	void Sort();
+
+	[[nodiscard]] std::span<const Item> Items() const { return items_; }
+
+	[[nodiscard]] size_t Size() const { return items_.size(); }
+
+	[[nodiscard]] bool Empty() const { return items_.empty(); }
+
+private:
+	std::vector<Item> items_;
+	std::vector<Item> scratch_; // Ping-pong buffer for the radix passes, kept to avoid per-frame allocation
+};
+} // namespace engine::rendering
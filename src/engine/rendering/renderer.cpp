@@ -1,10 +1,18 @@
 ﻿// Rendering renderer implementation stub
 module;
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <numbers>
+#include <span>
 #include <spdlog/spdlog.h>
 #include <string>
+#include <utility>
+#include <vector>
 #ifdef __EMSCRIPTEN__
 #include <GLES3/gl3.h>
 #else
@@ -33,6 +41,37 @@ static void CheckGLError(const char* context) {
 		spdlog::error("[GL ERROR] {}: {} (0x{:x})", context, error_str, err);
 	}
 }
+
+// Fixed-function state of a 3D draw with an empty render_state_stack
+using RenderFlagState = std::array<std::pair<RenderFlag, bool>, 7>;
+static constexpr RenderFlagState DEFAULT_3D_FLAGS{{
+	{RenderFlag::DepthTest, true},
+	{RenderFlag::Blend, true},
+	{RenderFlag::CullFace, true},
+	{RenderFlag::Wireframe, false},
+	{RenderFlag::StencilTest, false},
+	{RenderFlag::ScissorTest, false},
+	{RenderFlag::DepthMask, true}
+}};
+
+// Debug line vertices are x,y,z,r,g,b,a
+static constexpr size_t DEBUG_LINE_VERTEX_STRIDE = 7 * sizeof(float);
+// Starting size of each debug line stream region; grows to fit the largest flush
+static constexpr size_t DEBUG_LINE_REGION_SIZE = 1 << 20;
+
+// Clip planes of the 3D projection; the light clusters slice the same depth range
+static constexpr float PROJECTION_NEAR = 0.1F;
+static constexpr float PROJECTION_FAR = 1000.0F;
+
+static void SetFlag(RenderFlagState& flags, const RenderFlag flag, const bool enabled) {
+	for (auto& [state_flag, state_enabled] : flags) {
+		if (state_flag == flag) {
+			state_enabled = enabled;
+			return;
+		}
+	}
+}
+
 // Renderer implementation
 struct Renderer::Impl {
 	bool initialized = false;
@@ -40,6 +79,7 @@ struct Renderer::Impl {
 	Color clear_color = colors::black;
 	uint32_t window_width = 800;
 	uint32_t window_height = 600;
+	glm::mat4 projection{1.0F}; // Perspective for 3D draws, rebuilt only when the window size changes
 
 	// Resource managers
 	TextureManager texture_manager;
@@ -53,14 +93,253 @@ struct Renderer::Impl {
 
 	// Debug line rendering
 	GLuint debug_line_vao = 0;
-	GLuint debug_line_vbo = 0;
+	StreamBuffer debug_line_stream{StreamBufferTarget::Vertex};
 	std::vector<float> debug_line_vertices; // x,y,z,r,g,b,a per vertex
 	glm::mat4 debug_view_matrix{1.0F};
 	glm::mat4 debug_projection_matrix{1.0F};
 
+	// Per-frame camera and lighting, created on first use
+	UniformBuffer scene_uniform_buffer;
+	SceneUniforms scene_uniforms; // This frame's upload, with the cluster fields filled in
+
+	// Point and spot light lists per view cluster, rebuilt by SetSceneUniforms; textures are created on first use
+	LightClusters light_clusters;
+	std::vector<ClusterLight> cluster_lights;
+	std::vector<uint32_t> light_index_texels; // Index list padded to whole texture rows
+	GLuint light_grid_texture = 0;
+	GLuint light_index_texture = 0;
+	uint32_t light_index_rows = 0; // Rows allocated in light_index_texture
+
+	// Per-instance model and normal matrices for instanced draws, created on first use
+	GLuint instance_vbo = 0;
+	size_t instance_vbo_capacity = 0;
+
+	// Sprites queued by SubmitSprite until FlushSprites; GL objects are created on first flush
+	SpriteBatch sprite_batch;
+	GLuint sprite_vao = 0;
+	GLuint sprite_vbo = 0;
+	GLuint sprite_ebo = 0;
+	size_t sprite_vbo_capacity = 0;   // Bytes
+	size_t sprite_index_capacity = 0; // Quads covered by the index buffer
+
 	// Statistics
-	uint32_t draw_call_count = 0;
-	uint32_t triangle_count = 0;
+	RenderStats stats;
+	const Shader* bound_shader = nullptr; // Last shader made current by the renderer, for stats.shader_switches
+
+	void UpdateProjection() {
+		const float aspect = static_cast<float>(window_width) / static_cast<float>(std::max(window_height, 1U));
+		projection = glm::perspective(glm::radians(60.0F), aspect, PROJECTION_NEAR, PROJECTION_FAR);
+	}
+
+	void UseShader(const Shader& shader) {
+		if (&shader != bound_shader) {
+			++stats.shader_switches;
+			bound_shader = &shader;
+		}
+		shader.Use();
+	}
+
+	// Binds the command's shader, material and fixed-function state. Returns the shader to set per-draw uniforms
+	// on, or null if the command has nothing valid to draw with.
+	const Shader* PrepareMeshDraw(const RenderCommand& command) {
+		// Determine which shader to use: custom shader if material is invalid, otherwise material's shader
+		const Shader* shader = nullptr;
+		if (command.material == INVALID_MATERIAL && command.shader != INVALID_SHADER) {
+			// Use custom shader
+			shader = &shader_manager.GetShader(command.shader);
+		}
+		else if (command.material != INVALID_MATERIAL) {
+			// Use material's shader
+			const Material& material = material_manager.GetMaterial(command.material);
+			shader = &shader_manager.GetShader(material.GetShader());
+		}
+
+		if (!shader || !shader->IsValid()) {
+			return nullptr;
+		}
+
+		UseShader(*shader);
+
+		// Apply material properties if using a material
+		auto& gl_state = GetGLStateCache();
+		if (command.material != INVALID_MATERIAL) {
+			const Material& material = material_manager.GetMaterial(command.material);
+			material.Apply(*shader);
+		}
+		else if (const TextureId white_tex = texture_manager.GetWhiteTexture(); white_tex != INVALID_TEXTURE) {
+			// No material — bind the white texture as fallback so shaders that expect textures don't fail
+			if (const auto* gl_white_tex = GetGLTexture(white_tex)) {
+				gl_state.BindTexture(0, gl_white_tex->handle);
+				shader->SetUniform(shader->GetStandardUniforms().texture, 0);
+			}
+		}
+
+		// The draw's full fixed-function state is the 3D default with its render_state_stack applied on top; the
+		// cache drops whatever matches the previous draw, so nothing has to be restored afterwards
+		auto flags = DEFAULT_3D_FLAGS;
+		for (const auto& [enable_flags, disable_flags] : command.render_state_stack) {
+			for (const auto& flag : enable_flags) {
+				SetFlag(flags, flag, true);
+			}
+			for (const auto& flag : disable_flags) {
+				SetFlag(flags, flag, false);
+			}
+		}
+		for (const auto& [flag, enabled] : flags) {
+			gl_state.SetFlag(flag, enabled);
+		}
+		gl_state.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		return shader;
+	}
+
+	// Streams instance data into instance_vbo, orphaning the previous contents so the driver need not wait for
+	// draws still reading them
+	void UploadInstances(const std::span<const InstanceData> instances) {
+		if (instance_vbo == 0) {
+			glGenBuffers(1, &instance_vbo);
+		}
+		const size_t size = instances.size_bytes();
+		instance_vbo_capacity = std::max(instance_vbo_capacity, std::bit_ceil(size));
+		glBindBuffer(GL_ARRAY_BUFFER, instance_vbo);
+		glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(instance_vbo_capacity), nullptr, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(size), instances.data());
+	}
+
+	// Streams a built sprite batch into sprite_vbo the same way, and grows the index buffer when the batch has
+	// more quads than it covers. Indices are absolute, so each draw just starts at its first quad's indices.
+	void UploadSprites(const std::span<const SpriteVertex> vertices) {
+		auto& gl_state = GetGLStateCache();
+		if (sprite_vao == 0) {
+			glGenVertexArrays(1, &sprite_vao);
+			glGenBuffers(1, &sprite_vbo);
+			glGenBuffers(1, &sprite_ebo);
+			gl_state.BindVertexArray(sprite_vao);
+			glBindBuffer(GL_ARRAY_BUFFER, sprite_vbo);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, sprite_ebo);
+
+			const auto attribute = [](const GLuint location, const GLint size, const size_t offset) {
+				glEnableVertexAttribArray(location);
+				glVertexAttribPointer(
+					location,
+					size,
+					GL_FLOAT,
+					GL_FALSE,
+					sizeof(SpriteVertex),
+					reinterpret_cast<const void*>(offset)
+				);
+			};
+			attribute(0, 2, offsetof(SpriteVertex, position));
+			attribute(1, 2, offsetof(SpriteVertex, tex_coords));
+			attribute(2, 4, offsetof(SpriteVertex, color));
+			attribute(3, 1, offsetof(SpriteVertex, texture_slot));
+		}
+		gl_state.BindVertexArray(sprite_vao);
+
+		const size_t size = vertices.size_bytes();
+		sprite_vbo_capacity = std::max(sprite_vbo_capacity, std::bit_ceil(size));
+		glBindBuffer(GL_ARRAY_BUFFER, sprite_vbo);
+		glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(sprite_vbo_capacity), nullptr, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(size), vertices.data());
+
+		const size_t quad_count = vertices.size() / SpriteBatch::VERTICES_PER_QUAD;
+		if (quad_count > sprite_index_capacity) {
+			sprite_index_capacity = std::bit_ceil(quad_count);
+			std::vector<uint32_t> indices;
+			indices.reserve(sprite_index_capacity * SpriteBatch::INDICES_PER_QUAD);
+			for (uint32_t quad = 0; quad < sprite_index_capacity; ++quad) {
+				const uint32_t base = quad * SpriteBatch::VERTICES_PER_QUAD;
+				indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+			}
+			// The element buffer binding is VAO state, so this targets sprite_ebo
+			glBufferData(
+				GL_ELEMENT_ARRAY_BUFFER,
+				static_cast<GLsizeiptr>(indices.size() * sizeof(uint32_t)),
+				indices.data(),
+				GL_STATIC_DRAW
+			);
+		}
+	}
+
+	// Cluster ranges go to an RG32UI texel per cluster and the index list to R32UI rows; both stay bound to their
+	// reserved texture units
+	void UploadLightClusters() {
+		auto& gl_state = GetGLStateCache();
+		if (light_grid_texture == 0) {
+			glGenTextures(1, &light_grid_texture);
+			glGenTextures(1, &light_index_texture);
+			for (const GLuint texture : {light_grid_texture, light_index_texture}) {
+				// Integer textures are incomplete with linear filtering
+				gl_state.BindTexture(LIGHT_GRID_TEXTURE_UNIT, texture);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			}
+			gl_state.BindTexture(LIGHT_GRID_TEXTURE_UNIT, light_grid_texture);
+			glTexImage2D(
+				GL_TEXTURE_2D,
+				0,
+				GL_RG32UI,
+				LIGHT_CLUSTER_GRID_X * LIGHT_CLUSTER_GRID_Y,
+				LIGHT_CLUSTER_GRID_Z,
+				0,
+				GL_RG_INTEGER,
+				GL_UNSIGNED_INT,
+				nullptr
+			);
+		}
+
+		static_assert(sizeof(LightClusterRange) == 2 * sizeof(uint32_t), "Cluster ranges are uploaded as RG32UI");
+		gl_state.BindTexture(LIGHT_GRID_TEXTURE_UNIT, light_grid_texture);
+		glTexSubImage2D(
+			GL_TEXTURE_2D,
+			0,
+			0,
+			0,
+			LIGHT_CLUSTER_GRID_X * LIGHT_CLUSTER_GRID_Y,
+			LIGHT_CLUSTER_GRID_Z,
+			GL_RG_INTEGER,
+			GL_UNSIGNED_INT,
+			light_clusters.GetClusters().data()
+		);
+
+		const auto indices = light_clusters.GetLightIndices();
+		const auto rows = std::max<uint32_t>(
+			1,
+			static_cast<uint32_t>((indices.size() + LIGHT_INDEX_TEXTURE_WIDTH - 1) / LIGHT_INDEX_TEXTURE_WIDTH)
+		);
+		light_index_texels.assign(indices.begin(), indices.end());
+		light_index_texels.resize(static_cast<size_t>(rows) * LIGHT_INDEX_TEXTURE_WIDTH);
+
+		gl_state.BindTexture(LIGHT_INDEX_TEXTURE_UNIT, light_index_texture);
+		if (rows > light_index_rows) {
+			light_index_rows = std::bit_ceil(rows);
+			light_index_texels.resize(static_cast<size_t>(light_index_rows) * LIGHT_INDEX_TEXTURE_WIDTH);
+			glTexImage2D(
+				GL_TEXTURE_2D,
+				0,
+				GL_R32UI,
+				LIGHT_INDEX_TEXTURE_WIDTH,
+				static_cast<GLsizei>(light_index_rows),
+				0,
+				GL_RED_INTEGER,
+				GL_UNSIGNED_INT,
+				light_index_texels.data()
+			);
+			return;
+		}
+		glTexSubImage2D(
+			GL_TEXTURE_2D,
+			0,
+			0,
+			0,
+			LIGHT_INDEX_TEXTURE_WIDTH,
+			static_cast<GLsizei>(rows),
+			GL_RED_INTEGER,
+			GL_UNSIGNED_INT,
+			light_index_texels.data()
+		);
+	}
 };
 
 Renderer::Renderer() : pimpl_(std::make_unique<Impl>()) {}
@@ -70,51 +349,74 @@ Renderer::~Renderer() = default;
 bool Renderer::Initialize(const uint32_t window_width, const uint32_t window_height) const {
 	pimpl_->window_width = window_width;
 	pimpl_->window_height = window_height;
+	pimpl_->UpdateProjection();
 
 	// Enable depth testing
-	glEnable(GL_DEPTH_TEST);
+	GetGLStateCache().SetFlag(RenderFlag::DepthTest, true);
 	glDepthFunc(GL_LESS);
 
 	// Enable face culling (optional, but recommended for performance)
-	glEnable(GL_CULL_FACE);
+	GetGLStateCache().SetFlag(RenderFlag::CullFace, true);
 	glCullFace(GL_BACK);
 	glFrontFace(GL_CCW);
 
 	// Set viewport
 	glViewport(0, 0, window_width, window_height);
 
-	// Create built-in sprite shader
+	// Create built-in sprite shader. Vertices arrive pre-transformed from the SpriteBatch.
 	const std::string vertex_shader_source = R"(#version 300 es
 
-layout(location = 0) in vec3 position;
-layout(location = 1) in vec3 normal;
-layout(location = 2) in vec2 tex_coords;
+layout(location = 0) in vec2 a_Position;
+layout(location = 1) in vec2 a_TexCoord;
+layout(location = 2) in vec4 a_Color;
+layout(location = 3) in float a_TexSlot;
 
-uniform mat4 u_MVP;
-uniform vec2 u_TexOffset;
-uniform vec2 u_TexScale;
+uniform mat4 u_Projection;
 
 out vec2 v_TexCoord;
+out vec4 v_Color;
+flat out int v_TexSlot;
 
 void main() {
-    gl_Position = u_MVP * vec4(position, 1.0);
-    v_TexCoord = tex_coords * u_TexScale + u_TexOffset;
+    gl_Position = u_Projection * vec4(a_Position, 0.0, 1.0);
+    v_TexCoord = a_TexCoord;
+    v_Color = a_Color;
+    v_TexSlot = int(a_TexSlot + 0.5);
 }
 )";
 
+	// GLSL ES 3.00 can't index sampler arrays dynamically, so the slot is selected by branching
 	const std::string fragment_shader_source = R"(#version 300 es
 precision mediump float;
 
 in vec2 v_TexCoord;
+in vec4 v_Color;
+flat in int v_TexSlot;
 
-uniform sampler2D u_Texture;
-uniform vec4 u_Color;
+uniform sampler2D u_Textures[8];
 
 out vec4 FragColor;
 
 void main() {
-    vec4 texColor = texture(u_Texture, v_TexCoord);
-    FragColor = texColor * u_Color;
+    vec4 texColor;
+    if (v_TexSlot == 0) {
+        texColor = texture(u_Textures[0], v_TexCoord);
+    } else if (v_TexSlot == 1) {
+        texColor = texture(u_Textures[1], v_TexCoord);
+    } else if (v_TexSlot == 2) {
+        texColor = texture(u_Textures[2], v_TexCoord);
+    } else if (v_TexSlot == 3) {
+        texColor = texture(u_Textures[3], v_TexCoord);
+    } else if (v_TexSlot == 4) {
+        texColor = texture(u_Textures[4], v_TexCoord);
+    } else if (v_TexSlot == 5) {
+        texColor = texture(u_Textures[5], v_TexCoord);
+    } else if (v_TexSlot == 6) {
+        texColor = texture(u_Textures[6], v_TexCoord);
+    } else {
+        texColor = texture(u_Textures[7], v_TexCoord);
+    }
+    FragColor = texColor * v_Color;
 }
 )";
 
@@ -165,22 +467,20 @@ void main() {
 		return false;
 	}
 
-	// Create debug line VAO and VBO
+	// Create debug line VAO and its streaming vertex buffer
 	glGenVertexArrays(1, &pimpl_->debug_line_vao);
-	glGenBuffers(1, &pimpl_->debug_line_vbo);
-
-	glBindVertexArray(pimpl_->debug_line_vao);
-	glBindBuffer(GL_ARRAY_BUFFER, pimpl_->debug_line_vbo);
+	GetGLStateCache().BindVertexArray(pimpl_->debug_line_vao);
+	pimpl_->debug_line_stream.Create(DEBUG_LINE_REGION_SIZE);
 
 	// Position attribute (location 0)
 	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*) nullptr);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, DEBUG_LINE_VERTEX_STRIDE, (void*) nullptr);
 
 	// Color attribute (location 1)
 	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*) (3 * sizeof(float)));
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, DEBUG_LINE_VERTEX_STRIDE, (void*) (3 * sizeof(float)));
 
-	glBindVertexArray(0);
+	GetGLStateCache().BindVertexArray(0);
 
 	// Initialize and populate default shaders
 	pimpl_->shader_manager.Initialize();
@@ -196,22 +496,51 @@ void Renderer::Shutdown() const {
 		glDeleteVertexArrays(1, &pimpl_->debug_line_vao);
 		pimpl_->debug_line_vao = 0;
 	}
-	if (pimpl_->debug_line_vbo != 0) {
-		glDeleteBuffers(1, &pimpl_->debug_line_vbo);
-		pimpl_->debug_line_vbo = 0;
+	pimpl_->debug_line_stream.Destroy();
+	pimpl_->scene_uniform_buffer.Destroy();
+	if (pimpl_->instance_vbo != 0) {
+		glDeleteBuffers(1, &pimpl_->instance_vbo);
+		pimpl_->instance_vbo = 0;
+		pimpl_->instance_vbo_capacity = 0;
+		// VAOs still point their instance attributes at the deleted buffer
+		ResetGLMeshInstanceAttributes();
 	}
+	if (pimpl_->sprite_vao != 0) {
+		glDeleteVertexArrays(1, &pimpl_->sprite_vao);
+		glDeleteBuffers(1, &pimpl_->sprite_vbo);
+		glDeleteBuffers(1, &pimpl_->sprite_ebo);
+		pimpl_->sprite_vao = 0;
+		pimpl_->sprite_vbo = 0;
+		pimpl_->sprite_ebo = 0;
+		pimpl_->sprite_vbo_capacity = 0;
+		pimpl_->sprite_index_capacity = 0;
+	}
+	pimpl_->sprite_batch.Clear();
+	if (pimpl_->light_grid_texture != 0) {
+		glDeleteTextures(1, &pimpl_->light_grid_texture);
+		glDeleteTextures(1, &pimpl_->light_index_texture);
+		pimpl_->light_grid_texture = 0;
+		pimpl_->light_index_texture = 0;
+		pimpl_->light_index_rows = 0;
+	}
+	GetGLStateCache().Invalidate();
 	pimpl_->initialized = false;
 }
 
 void Renderer::BeginFrame() const {
-	pimpl_->draw_call_count = 0;
-	pimpl_->triangle_count = 0;
+	pimpl_->stats = {};
+	pimpl_->bound_shader = nullptr;
+
+	// Code outside the renderer (editor UI, game code) may have changed GL state since the last frame
+	GetGLStateCache().Invalidate();
+	GetGLStateCache().ResetStats();
 	glClearColor(pimpl_->clear_color.r, pimpl_->clear_color.g, pimpl_->clear_color.b, pimpl_->clear_color.a);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
 void Renderer::EndFrame() {
-	// TODO: Implement frame end logic
+	// Sprites submitted after the last explicit flush
+	FlushSprites();
 }
 
 void Renderer::SubmitRenderCommand(const RenderCommand& command) const {
@@ -221,217 +550,149 @@ void Renderer::SubmitRenderCommand(const RenderCommand& command) const {
 		return;
 	}
 
-	// Determine which shader to use: custom shader if material is invalid, otherwise material's shader
-	const Shader* shader = nullptr;
-	if (command.material == INVALID_MATERIAL && command.shader != INVALID_SHADER) {
-		// Use custom shader
-		shader = &pimpl_->shader_manager.GetShader(command.shader);
-	}
-	else if (command.material != INVALID_MATERIAL) {
-		// Use material's shader
-		const Material& material = pimpl_->material_manager.GetMaterial(command.material);
-		shader = &pimpl_->shader_manager.GetShader(material.GetShader());
-	}
-
-	if (!shader || !shader->IsValid()) {
+	const Shader* shader = pimpl_->PrepareMeshDraw(command);
+	if (!shader) {
 		return;
 	}
 
-	shader->Use();
+	const StandardUniforms& uniforms = shader->GetStandardUniforms();
+	shader->SetUniform(uniforms.instanced, 0);
+	shader->SetUniform(uniforms.model, command.transform);
 
-	shader->SetUniform("u_Model", command.transform);
+	const glm::mat4 mvp = pimpl_->projection * command.camera_view * command.transform;
+	shader->SetUniform(uniforms.mvp, mvp);
 
-	// Create perspective projection matrix
-	const float aspect = static_cast<float>(pimpl_->window_width) / static_cast<float>(pimpl_->window_height);
-	const glm::mat4 projection = glm::perspective(glm::radians(60.0F), aspect, 0.1F, 1000.0F);
+	GetGLStateCache().BindVertexArray(gl_mesh->vao);
+	glDrawElements(GL_TRIANGLES, gl_mesh->index_count, gl_mesh->index_type, nullptr);
 
-	const glm::mat4 mvp = projection * command.camera_view * command.transform;
-	shader->SetUniform("u_MVP", mvp);
+	pimpl_->stats.draw_calls++;
+	pimpl_->stats.triangles += gl_mesh->index_count / 3;
+}
 
-	// Apply material properties if using a material
-	if (command.material != INVALID_MATERIAL) {
-		const Material& material = pimpl_->material_manager.GetMaterial(command.material);
-		material.Apply(*shader);
-	}
-	else if (const TextureId white_tex = pimpl_->texture_manager.GetWhiteTexture(); white_tex != INVALID_TEXTURE) {
-		// No material — bind the white texture as fallback so shaders that expect textures don't fail
-		if (const auto* gl_white_tex = GetGLTexture(white_tex)) {
-			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_2D, gl_white_tex->handle);
-			shader->SetUniform("u_Texture", 0);
-		}
+void Renderer::SubmitInstancedRenderCommand(
+	const RenderCommand& command,
+	const std::span<const InstanceData> instances
+) const {
+	GLMesh* gl_mesh = GetGLMesh(command.mesh);
+	if (!gl_mesh || instances.empty()) {
+		return;
 	}
 
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-#ifndef __EMSCRIPTEN__
-	// Save current polygon mode for restoration
-	GLint previous_polygon_mode[2];
-	glGetIntegerv(GL_POLYGON_MODE, previous_polygon_mode);
-#endif
+	const Shader* shader = pimpl_->PrepareMeshDraw(command);
+	if (!shader) {
+		return;
+	}
 
-	for (const auto& [enable_flags, disable_flags] : command.render_state_stack) {
-		for (const auto& flag : enable_flags) {
-			switch (flag) {
-			case RenderFlag::DepthTest: glEnable(GL_DEPTH_TEST); break;
-			case RenderFlag::Blend: glEnable(GL_BLEND); break;
-			case RenderFlag::CullFace: glEnable(GL_CULL_FACE); break;
-			case RenderFlag::Wireframe:
-#ifdef __EMSCRIPTEN__
-// Not available in WebGL/GLES3, skip or find an alternative
-#else
-				glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-#endif
-				break;
-			case RenderFlag::DepthMask: glDepthMask(GL_TRUE); break;
-			default: break;
-			}
-		}
-		for (const auto& flag : disable_flags) {
-			switch (flag) {
-			case RenderFlag::DepthTest: glDisable(GL_DEPTH_TEST); break;
-			case RenderFlag::Blend: glDisable(GL_BLEND); break;
-			case RenderFlag::CullFace: glDisable(GL_CULL_FACE); break;
-			case RenderFlag::Wireframe:
-#ifdef __EMSCRIPTEN__
-// Not available in WebGL/GLES3, skip or find an alternative
-#else
-				glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-#endif
-				break;
-			case RenderFlag::DepthMask: glDepthMask(GL_FALSE); break;
-			default: break;
-			}
+	auto& gl_state = GetGLStateCache();
+	const StandardUniforms& uniforms = shader->GetStandardUniforms();
+	if (!uniforms.instanced.IsValid()) {
+		// The shader has no instanced path, so draw the instances one at a time
+		gl_state.BindVertexArray(gl_mesh->vao);
+		for (const auto& [model, normal_matrix] : instances) {
+			shader->SetUniform(uniforms.model, model);
+			shader->SetUniform(uniforms.mvp, pimpl_->projection * command.camera_view * model);
+			shader->SetUniform(uniforms.normal_matrix, normal_matrix);
+			glDrawElements(GL_TRIANGLES, gl_mesh->index_count, gl_mesh->index_type, nullptr);
+			pimpl_->stats.draw_calls++;
+			pimpl_->stats.triangles += gl_mesh->index_count / 3;
 		}
+		return;
 	}
 
-	glBindVertexArray(gl_mesh->vao);
-	glDrawElements(GL_TRIANGLES, gl_mesh->index_count, GL_UNSIGNED_INT, nullptr);
-	glBindVertexArray(0);
-
-	for (const auto& [enable_flags, disable_flags] : command.render_state_stack) {
-		// Restore render states (reverse the operations)
-		for (const auto& flag : disable_flags) {
-			switch (flag) {
-			case RenderFlag::DepthTest: glEnable(GL_DEPTH_TEST); break;
-			case RenderFlag::Blend: glEnable(GL_BLEND); break;
-			case RenderFlag::CullFace: glEnable(GL_CULL_FACE); break;
-			case RenderFlag::Wireframe:
-#ifdef __EMSCRIPTEN__
-// Not available in WebGL/GLES3, skip or find an alternative
-#else
-				// Restore to previous polygon mode, not just toggle to GL_LINE
-				glPolygonMode(GL_FRONT_AND_BACK, previous_polygon_mode[0]);
-#endif
-				break;
-			case RenderFlag::DepthMask: glDepthMask(GL_TRUE); break;
-			default: break;
-			}
-		}
-		for (const auto& flag : enable_flags) {
-			switch (flag) {
-			case RenderFlag::DepthTest: glDisable(GL_DEPTH_TEST); break;
-			case RenderFlag::Blend: glDisable(GL_BLEND); break;
-			case RenderFlag::CullFace: glDisable(GL_CULL_FACE); break;
-			case RenderFlag::Wireframe:
-#ifdef __EMSCRIPTEN__
-// Not available in WebGL/GLES3, skip or find an alternative
-#else
-				// Restore to previous polygon mode, not just toggle to GL_FILL
-				glPolygonMode(GL_FRONT_AND_BACK, previous_polygon_mode[0]);
-#endif
-				break;
-			case RenderFlag::DepthMask: glDepthMask(GL_FALSE); break;
-			default: break;
-			}
+	shader->SetUniform(uniforms.instanced, 1);
+	shader->SetUniform(uniforms.view_projection, pimpl_->projection * command.camera_view);
+	pimpl_->UploadInstances(instances);
+
+	gl_state.BindVertexArray(gl_mesh->vao);
+	if (!gl_mesh->instance_attributes) {
+		// Attribute pointers capture the bound buffer, so this is done once per VAO; the instance buffer is only
+		// ever resized in place and keeps its name
+		glBindBuffer(GL_ARRAY_BUFFER, pimpl_->instance_vbo);
+		for (GLuint column = 0; column < 8; ++column) {
+			const GLuint location = INSTANCE_ATTRIBUTE_LOCATION + column;
+			glEnableVertexAttribArray(location);
+			glVertexAttribPointer(
+				location,
+				4,
+				GL_FLOAT,
+				GL_FALSE,
+				sizeof(InstanceData),
+				reinterpret_cast<const void*>(static_cast<uintptr_t>(column) * sizeof(glm::vec4))
+			);
+			glVertexAttribDivisor(location, 1);
 		}
+		gl_mesh->instance_attributes = true;
 	}
 
-	pimpl_->draw_call_count++;
-	pimpl_->triangle_count += gl_mesh->index_count / 3;
-}
+	const auto count = static_cast<GLsizei>(instances.size());
+	glDrawElementsInstanced(GL_TRIANGLES, gl_mesh->index_count, gl_mesh->index_type, nullptr, count);
 
-void Renderer::SubmitSprite(const SpriteRenderCommand& command) const {
-	// Get or create a unit quad mesh for sprite rendering
-	static MeshId sprite_quad = 0;
-	if (sprite_quad == 0) {
-		sprite_quad = pimpl_->mesh_manager.CreateQuad(1.0F, 1.0F); // Unit quad
-	}
+	pimpl_->stats.draw_calls++;
+	pimpl_->stats.triangles += gl_mesh->index_count / 3 * static_cast<uint32_t>(count);
+	pimpl_->stats.instances += static_cast<uint32_t>(count);
+}
 
-	// Get the quad mesh
-	const GLMesh* gl_mesh = GetGLMesh(sprite_quad);
-	if (!gl_mesh) {
-		return;
-	}
+void Renderer::SubmitSprite(const SpriteRenderCommand& command) const { pimpl_->sprite_batch.Add(command); }
 
-	// Get sprite texture
-	if (command.texture == INVALID_TEXTURE) {
+void Renderer::FlushSprites() const {
+	auto& batch = pimpl_->sprite_batch;
+	if (batch.Size() == 0) {
 		return;
 	}
+	batch.Build();
 
-	// Use the sprite shader
 	const Shader& sprite_shader = pimpl_->shader_manager.GetShader(pimpl_->sprite_shader_id);
-	if (!sprite_shader.IsValid()) {
+	if (IsHeadless() || !sprite_shader.IsValid()) {
+		batch.Clear();
 		return;
 	}
+	pimpl_->UploadSprites(batch.GetVertices());
+
+	// Orthographic projection in screen coordinates, origin bottom-left
+	const Mat4 projection = glm::ortho(
+		0.0F,
+		static_cast<float>(pimpl_->window_width),
+		0.0F,
+		static_cast<float>(pimpl_->window_height),
+		-1.0F,
+		1.0F
+	);
+	static constexpr std::array<int, SPRITE_BATCH_MAX_TEXTURE_SLOTS> TEXTURE_UNITS{0, 1, 2, 3, 4, 5, 6, 7};
+	pimpl_->UseShader(sprite_shader);
+	sprite_shader.SetUniform("u_Projection", projection);
+	sprite_shader.SetUniformArray("u_Textures", TEXTURE_UNITS.data(), static_cast<int>(TEXTURE_UNITS.size()));
+
+	// Alpha blending and no depth testing for 2D sprites. Negative sizes mirror a quad, so culling is off too.
+	auto& gl_state = GetGLStateCache();
+	gl_state.SetFlag(RenderFlag::Blend, true);
+	gl_state.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	gl_state.SetFlag(RenderFlag::DepthTest, false);
+	gl_state.SetFlag(RenderFlag::CullFace, false);
+	gl_state.SetFlag(RenderFlag::Wireframe, false);
+	gl_state.BindVertexArray(pimpl_->sprite_vao);
+
+	for (const SpriteBatchDraw& draw : batch.GetDraws()) {
+		// WebGL requires every sampler in the array to have a valid texture, so unused slots repeat the first
+		for (uint32_t slot = 0; slot < SPRITE_BATCH_MAX_TEXTURE_SLOTS; ++slot) {
+			const TextureId texture = draw.textures[slot < draw.texture_count ? slot : 0];
+			if (const auto* gl_texture = GetGLTexture(texture)) {
+				gl_state.BindTexture(slot, gl_texture->handle);
+			}
+		}
 
-	// Create transformation matrix for the sprite
-	Mat4 transform = glm::mat4(1.0F);
-
-	// Apply translation
-	transform = glm::translate(transform, Vec3(command.position.x, command.position.y, 0.0F));
+		const size_t first_index = static_cast<size_t>(draw.first_quad) * SpriteBatch::INDICES_PER_QUAD;
+		glDrawElements(
+			GL_TRIANGLES,
+			static_cast<GLsizei>(draw.quad_count * SpriteBatch::INDICES_PER_QUAD),
+			GL_UNSIGNED_INT,
+			reinterpret_cast<const void*>(first_index * sizeof(uint32_t))
+		);
 
-	// Apply rotation around Z-axis
-	if (command.rotation != 0.0F) {
-		transform = glm::rotate(transform, command.rotation, Vec3(0, 0, 1));
+		pimpl_->stats.draw_calls++;
+		pimpl_->stats.triangles += draw.quad_count * 2;
+		pimpl_->stats.sprites += draw.quad_count;
 	}
-
-	// Apply scale
-	transform = glm::scale(transform, Vec3(command.size.x, command.size.y, 1.0F));
-
-	// Set up orthographic projection for 2D rendering (screen coordinates)
-	const float left = 0.0F;
-	const auto right = static_cast<float>(pimpl_->window_width);
-	const float bottom = 0.0F;
-	const auto top = static_cast<float>(pimpl_->window_height);
-	const float near = -1.0F;
-	const float far = 1.0F;
-
-	const Mat4 projection = glm::ortho(left, right, bottom, top, near, far);
-	const Mat4 mvp = projection * transform;
-
-	// Use sprite shader and set uniforms
-	sprite_shader.Use();
-	sprite_shader.SetUniform("u_MVP", mvp);
-	sprite_shader.SetUniform("u_Texture", 0);
-	sprite_shader.SetUniform("u_Color", command.color);
-	sprite_shader.SetUniform("u_TexOffset", command.texture_offset);
-	sprite_shader.SetUniform("u_TexScale", command.texture_scale);
-
-	// Bind texture
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, GetGLTexture(command.texture)->handle);
-
-	// Enable alpha blending for sprites
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-	// Disable depth testing for 2D sprites
-	glDisable(GL_DEPTH_TEST);
-
-	// Render the quad
-	glBindVertexArray(gl_mesh->vao);
-	glDrawElements(GL_TRIANGLES, gl_mesh->index_count, GL_UNSIGNED_INT, nullptr);
-	glBindVertexArray(0);
-
-	// Restore OpenGL state
-	glEnable(GL_DEPTH_TEST);
-	glDisable(GL_BLEND);
-	glBindTexture(GL_TEXTURE_2D, 0);
-
-	pimpl_->draw_call_count++;
-	pimpl_->triangle_count += gl_mesh->index_count / 3;
+	batch.Clear();
 }
 
 void Renderer::SubmitUIBatch(const UIBatchRenderCommand& command) const {
@@ -442,16 +703,15 @@ void Renderer::SubmitUIBatch(const UIBatchRenderCommand& command) const {
 		return;
 	}
 
-	// Save GL state
-	GLboolean const depth_test_enabled = glIsEnabled(GL_DEPTH_TEST);
-	GLboolean const cull_face_enabled = glIsEnabled(GL_CULL_FACE);
-
-	// Disable depth test and face culling for UI rendering
-	glDisable(GL_DEPTH_TEST);
-	glDisable(GL_CULL_FACE);
+	// Disable depth test and face culling for UI rendering. Consecutive batches share this state, so after the first
+	// batch these are all dropped by the cache.
+	auto& gl_state = GetGLStateCache();
+	gl_state.SetFlag(RenderFlag::DepthTest, false);
+	gl_state.SetFlag(RenderFlag::CullFace, false);
+	gl_state.SetFlag(RenderFlag::Wireframe, false);
 
 	// Use the UI batch shader
-	shader.Use();
+	pimpl_->UseShader(shader);
 	CheckGLError("After shader.Use()");
 
 	// Set projection matrix
@@ -464,12 +724,12 @@ void Renderer::SubmitUIBatch(const UIBatchRenderCommand& command) const {
 
 	// First, bind all requested textures
 	for (size_t i = 0; i < command.texture_count; ++i) {
-		glActiveTexture(GL_TEXTURE0 + static_cast<GLenum>(i));
+		const auto unit = static_cast<uint32_t>(i);
 
 		// Get the GL texture handle from our texture manager
 		auto* gl_tex = GetGLTexture(command.texture_ids[i]);
 		if (gl_tex) {
-			glBindTexture(GL_TEXTURE_2D, gl_tex->handle);
+			gl_state.BindTexture(unit, gl_tex->handle);
 		}
 		else {
 			spdlog::error("[UI Batch] Invalid texture ID: {} at slot {}", command.texture_ids[i], i);
@@ -477,7 +737,7 @@ void Renderer::SubmitUIBatch(const UIBatchRenderCommand& command) const {
 			if (i == 0 && command.texture_count > 0) {
 				auto* first_tex = GetGLTexture(command.texture_ids[0]);
 				if (first_tex) {
-					glBindTexture(GL_TEXTURE_2D, first_tex->handle);
+					gl_state.BindTexture(unit, first_tex->handle);
 				}
 			}
 		}
@@ -489,8 +749,7 @@ void Renderer::SubmitUIBatch(const UIBatchRenderCommand& command) const {
 		auto* first_tex = GetGLTexture(command.texture_ids[0]);
 		if (first_tex) {
 			for (size_t i = command.texture_count; i < UI_BATCH_MAX_TEXTURE_SLOTS; ++i) {
-				glActiveTexture(GL_TEXTURE0 + static_cast<GLenum>(i));
-				glBindTexture(GL_TEXTURE_2D, first_tex->handle);
+				gl_state.BindTexture(static_cast<uint32_t>(i), first_tex->handle);
 			}
 		}
 	}
@@ -504,7 +763,7 @@ void Renderer::SubmitUIBatch(const UIBatchRenderCommand& command) const {
 	// Apply scissor if active
 	if (command.enable_scissor) {
 		// OpenGL scissor uses bottom-left origin, but UI uses top-left origin
-		glEnable(GL_SCISSOR_TEST);
+		gl_state.SetFlag(RenderFlag::ScissorTest, true);
 		glScissor(
 			command.scissor_x,
 			static_cast<int>(pimpl_->window_height) - command.scissor_y - command.scissor_height, // Flip Y
@@ -514,47 +773,30 @@ void Renderer::SubmitUIBatch(const UIBatchRenderCommand& command) const {
 		CheckGLError("After setting scissor");
 	}
 
-	// Upload vertex and index data
-	glBindVertexArray(command.vao);
+	gl_state.BindVertexArray(command.vao);
 	CheckGLError("After binding VAO");
 
-	glBindBuffer(GL_ARRAY_BUFFER, command.vbo);
-	glBufferSubData(GL_ARRAY_BUFFER, 0, command.vertex_data_size, command.vertex_data);
-	CheckGLError("After uploading vertex data");
-
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, command.ebo);
-	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, command.index_data_size, command.index_data);
-	CheckGLError("After uploading index data");
-
 	// Enable blending for transparency
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	gl_state.SetFlag(RenderFlag::Blend, true);
+	gl_state.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	CheckGLError("After setting blend mode");
 
 	// Draw the batch
-	glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(command.index_count), GL_UNSIGNED_INT, nullptr);
+	glDrawElements(
+		GL_TRIANGLES,
+		static_cast<GLsizei>(command.index_count),
+		GL_UNSIGNED_INT,
+		reinterpret_cast<const void*>(command.index_offset)
+	);
 	CheckGLError("After glDrawElements");
 
-	// Disable blending
-	glDisable(GL_BLEND);
-
 	// Disable scissor
 	if (command.enable_scissor) {
-		glDisable(GL_SCISSOR_TEST);
-	}
-
-	glBindVertexArray(0);
-
-	// Restore GL state
-	if (depth_test_enabled) {
-		glEnable(GL_DEPTH_TEST);
-	}
-	if (cull_face_enabled) {
-		glEnable(GL_CULL_FACE);
+		gl_state.SetFlag(RenderFlag::ScissorTest, false);
 	}
 
-	pimpl_->draw_call_count++;
-	pimpl_->triangle_count += command.index_count / 3;
+	pimpl_->stats.draw_calls++;
+	pimpl_->stats.triangles += command.index_count / 3;
 }
 
 void Renderer::DrawLine(const Vec3& start, const Vec3& end, const Color& color) const {
@@ -669,16 +911,66 @@ void Renderer::GetFramebufferSize(uint32_t& width, uint32_t& height) const {
 void Renderer::SetWindowSize(const uint32_t width, const uint32_t height) const {
 	pimpl_->window_width = width;
 	pimpl_->window_height = height;
+	pimpl_->UpdateProjection();
 	SetViewport(0, 0, width, height);
 }
 
-uint32_t Renderer::GetDrawCallCount() const { return pimpl_->draw_call_count; }
+const glm::mat4& Renderer::GetProjection() const { return pimpl_->projection; }
+
+uint32_t Renderer::GetDrawCallCount() const { return pimpl_->stats.draw_calls; }
+
+uint32_t Renderer::GetTriangleCount() const { return pimpl_->stats.triangles; }
+
+void Renderer::SetSceneUniforms(const SceneUniforms& uniforms, const glm::mat4& view) const {
+	auto& buffer = pimpl_->scene_uniform_buffer;
+	if (!buffer.IsValid() && !buffer.Create(sizeof(SceneUniforms))) {
+		return;
+	}
+
+	auto& clusters = pimpl_->light_clusters;
+	clusters.SetProjection(pimpl_->projection, PROJECTION_NEAR, PROJECTION_FAR);
+	auto& cluster_lights = pimpl_->cluster_lights;
+	cluster_lights.clear();
+	const int light_count = std::min(uniforms.light_count[1], MAX_SCENE_LIGHTS);
+	for (int i = uniforms.light_count[0]; i < light_count; ++i) {
+		cluster_lights.push_back({
+			.position = Vec3(uniforms.light_positions[i]),
+			.range = uniforms.light_params[i].x,
+			.index = static_cast<uint32_t>(i)
+		});
+	}
+	clusters.Assign(cluster_lights, view);
+	pimpl_->UploadLightClusters();
+
+	SceneUniforms& scene = pimpl_->scene_uniforms;
+	scene = uniforms;
+	scene.cluster_depth = {PROJECTION_NEAR, PROJECTION_FAR, clusters.GetSliceScale(), clusters.GetSliceBias()};
+	scene.cluster_screen = {
+		static_cast<float>(LIGHT_CLUSTER_GRID_X) / static_cast<float>(std::max(pimpl_->window_width, 1U)),
+		static_cast<float>(LIGHT_CLUSTER_GRID_Y) / static_cast<float>(std::max(pimpl_->window_height, 1U)),
+		0.0F,
+		0.0F
+	};
+	buffer.Update(&scene, sizeof(SceneUniforms));
+	buffer.BindBase(SCENE_UNIFORM_BINDING);
+}
+
+const RenderStats& Renderer::GetStats() const {
+	const GLStateStats& state_stats = GetGLStateCache().GetStats();
+	pimpl_->stats.state_calls_issued = state_stats.calls_issued;
+	pimpl_->stats.state_calls_eliminated = state_stats.calls_eliminated;
+	return pimpl_->stats;
+}
 
-uint32_t Renderer::GetTriangleCount() const { return pimpl_->triangle_count; }
+void Renderer::AddCullingStats(const uint32_t visible, const uint32_t culled) const {
+	pimpl_->stats.objects_visible += visible;
+	pimpl_->stats.objects_culled += culled;
+}
 
 void Renderer::ResetStatistics() const {
-	pimpl_->draw_call_count = 0;
-	pimpl_->triangle_count = 0;
+	pimpl_->stats = {};
+	pimpl_->bound_shader = nullptr;
+	GetGLStateCache().ResetStats();
 }
 
 void Renderer::SetDebugCamera(const glm::mat4& view, const glm::mat4& projection) const {
@@ -698,43 +990,35 @@ void Renderer::FlushDebugLines() const {
 		return;
 	}
 
-	shader.Use();
+	pimpl_->UseShader(shader);
 
 	// Set view-projection matrix
 	const glm::mat4 vp = pimpl_->debug_projection_matrix * pimpl_->debug_view_matrix;
 	shader.SetUniform("u_ViewProjection", vp);
 
-	// Upload vertex data
-	glBindVertexArray(pimpl_->debug_line_vao);
-	glBindBuffer(GL_ARRAY_BUFFER, pimpl_->debug_line_vbo);
-	glBufferData(
-		GL_ARRAY_BUFFER,
-		pimpl_->debug_line_vertices.size() * sizeof(float),
-		pimpl_->debug_line_vertices.data(),
-		GL_DYNAMIC_DRAW
-	);
+	// Append to the stream; the offset is a whole number of vertices, so it becomes the draw's first vertex
+	auto& gl_state = GetGLStateCache();
+	gl_state.BindVertexArray(pimpl_->debug_line_vao);
+	const auto& vertices = pimpl_->debug_line_vertices;
+	const size_t offset =
+		pimpl_->debug_line_stream.Write(vertices.data(), vertices.size() * sizeof(float), DEBUG_LINE_VERTEX_STRIDE);
 
 	// Disable depth test so debug lines draw on top
-	glDisable(GL_DEPTH_TEST);
+	gl_state.SetFlag(RenderFlag::DepthTest, false);
+	gl_state.SetFlag(RenderFlag::Wireframe, false);
 
 	// Enable blending for transparency
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	gl_state.SetFlag(RenderFlag::Blend, true);
+	gl_state.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	// Draw lines
-	const int vertex_count = static_cast<int>(pimpl_->debug_line_vertices.size()) / 7;
-	glDrawArrays(GL_LINES, 0, vertex_count);
-
-	// Restore state
-	glEnable(GL_DEPTH_TEST);
-	glDisable(GL_BLEND);
-
-	glBindVertexArray(0);
+	const int vertex_count = static_cast<int>(vertices.size() * sizeof(float) / DEBUG_LINE_VERTEX_STRIDE);
+	glDrawArrays(GL_LINES, static_cast<GLint>(offset / DEBUG_LINE_VERTEX_STRIDE), vertex_count);
 
 	// Clear the buffer for next frame
 	pimpl_->debug_line_vertices.clear();
 
-	pimpl_->draw_call_count++;
+	pimpl_->stats.draw_calls++;
 }
 
 TextureManager& Renderer::GetTextureManager() const { return pimpl_->texture_manager; }
@@ -747,6 +1031,11 @@ MaterialManager& Renderer::GetMaterialManager() const { return pimpl_->material_
 
 // Global renderer instance
 static std::unique_ptr<Renderer> g_renderer;
+static bool g_headless = false;
+
+void SetHeadless(const bool headless) { g_headless = headless; }
+
+bool IsHeadless() { return g_headless; }
 
 Renderer& GetRenderer() {
 	if (!g_renderer) {
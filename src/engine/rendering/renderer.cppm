@@ -3,6 +3,7 @@ module;
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <span>
 
 export module engine.rendering:renderer;
 
@@ -12,6 +13,8 @@ import :texture;
 import :shader;
 import :mesh;
 import :material;
+import :uniform_buffer;
+import :light_clusters;
 
 export namespace engine::rendering {
 // Forward declarations for managers
@@ -27,6 +30,12 @@ struct RenderStats {
 	uint32_t vertices = 0;
 	uint32_t textures_bound = 0;
 	uint32_t shader_switches = 0;
+	uint32_t instances = 0; // Objects drawn through SubmitInstancedRenderCommand
+	uint32_t sprites = 0;   // Quads drawn by FlushSprites
+	uint32_t objects_visible = 0; // Renderables that passed frustum culling (see AddCullingStats)
+	uint32_t objects_culled = 0;  // Renderables skipped because their bounds were outside the view frustum
+	uint32_t state_calls_issued = 0;     // GL state calls (program, VAO, texture, capability, blend) made
+	uint32_t state_calls_eliminated = 0; // Redundant GL state calls skipped by the GLStateCache
 };
 
 // Main renderer class
@@ -58,10 +67,26 @@ public:
 	// Rendering operations
 	void SubmitRenderCommand(const RenderCommand& command) const;
 
+	// Draws command's mesh once per instance with a single instanced call. The command's transform is ignored;
+	// each instance supplies its own model and normal matrix. Shaders without a u_Instanced path fall back to one
+	// draw per instance.
+	void SubmitInstancedRenderCommand(const RenderCommand& command, std::span<const InstanceData> instances) const;
+
+	// Queue a sprite for the sprite batch. Nothing is drawn until FlushSprites(), which EndFrame() also calls;
+	// sprites are drawn in layer order with as few draw calls as their textures allow.
 	void SubmitSprite(const SpriteRenderCommand& command) const;
 
+	// Draw and clear every queued sprite into the current framebuffer
+	void FlushSprites() const;
+
 	void SubmitUIBatch(const UIBatchRenderCommand& command) const;
 
+	// Upload this frame's camera and lights to the SceneUniforms buffer at SCENE_UNIFORM_BINDING. Call once per
+	// frame before submitting lit draws; shaders read it through their attached SceneUniforms block. The point and
+	// spot lights are binned into clusters of the view frustum seen through view, and the cluster lists are bound
+	// to LIGHT_GRID_TEXTURE_UNIT and LIGHT_INDEX_TEXTURE_UNIT.
+	void SetSceneUniforms(const SceneUniforms& uniforms, const glm::mat4& view) const;
+
 	// Immediate mode rendering (for debugging)
 	void DrawLine(const Vec3& start, const Vec3& end, const Color& color = colors::white) const;
 
@@ -83,11 +108,21 @@ public:
 
 	void SetWindowSize(uint32_t width, uint32_t height) const;
 
+	// Projection used for 3D render commands; combine with a command's camera_view to get its clip space
+	[[nodiscard]] const glm::mat4& GetProjection() const;
+
 	// Statistics
 	[[nodiscard]] uint32_t GetDrawCallCount() const;
 
 	[[nodiscard]] uint32_t GetTriangleCount() const;
 
+	// Counters since BeginFrame(). shader_switches counts changes of the shader the renderer draws with; the
+	// state_calls_* counters come from GetGLStateCache() and so include GL state set outside the renderer.
+	[[nodiscard]] const RenderStats& GetStats() const;
+
+	// Culling happens before submission, so whoever culls reports its counts here
+	void AddCullingStats(uint32_t visible, uint32_t culled) const;
+
 	void ResetStatistics() const;
 
 private:
@@ -96,4 +131,10 @@ private:
 };
 
 Renderer& GetRenderer();
+
+// Headless mode: resource managers keep their CPU-side bookkeeping (IDs, names, geometry, texture info)
+// but make no GL calls, so assets can load without a context. Set before the renderer is first used.
+void SetHeadless(bool headless);
+
+[[nodiscard]] bool IsHeadless();
 } // namespace engine::rendering
@@ -6,6 +6,14 @@ export import :renderer;
 export import :texture;
 export import :shader;
 export import :mesh;
+export import :mesh_import;
 export import :material;
 export import :framebuffer;
+export import :uniform_buffer;
+export import :stream_buffer;
+export import :light_clusters;
+export import :gl_state;
 export import :tilemap_renderer;
+export import :render_queue;
+export import :sprite_batch;
+export import :null_device;
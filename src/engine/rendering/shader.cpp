@@ -1,6 +1,7 @@
 ﻿// Shader implementation stub
 module;
 
+#include <cstdint>
 #include <memory>
 #include <spdlog/spdlog.h>
 #include <string>
@@ -26,7 +27,19 @@ struct Shader::Impl {
 	std::string vertex_source;
 	std::string fragment_source;
 	std::unordered_map<std::string, int> uniform_locations;
+	std::unordered_map<std::string, uint32_t> block_bindings; // Blocks already attached, to skip redundant GL calls
+	StandardUniforms standard_uniforms;
 	GLuint program{};
+
+	bool AttachBlock(const std::string& block_name, const uint32_t binding) {
+		const GLuint block_index = glGetUniformBlockIndex(program, block_name.c_str());
+		if (block_index == GL_INVALID_INDEX) {
+			return false;
+		}
+		glUniformBlockBinding(program, block_index, binding);
+		block_bindings[block_name] = binding;
+		return true;
+	}
 };
 
 Shader::Shader() : pimpl_(std::make_unique<Impl>()) {}
@@ -40,6 +53,11 @@ Shader& Shader::operator=(Shader&&) noexcept = default;
 bool Shader::Compile(const ShaderCreateInfo& info) const {
 	pimpl_->vertex_source = info.vertex_source;
 	pimpl_->fragment_source = info.fragment_source;
+	if (IsHeadless()) {
+		// Keep the sources so the shader is usable by ID; there is no program to compile
+		pimpl_->valid = true;
+		return true;
+	}
 
 	// Compile vertex shader
 	const GLuint vertex_shader = glCreateShader(GL_VERTEX_SHADER);
@@ -96,128 +114,122 @@ bool Shader::Compile(const ShaderCreateInfo& info) const {
 	glDeleteShader(vertex_shader);
 	glDeleteShader(fragment_shader);
 
-	// Store program handle
+	// Store program handle; locations from a previous program are stale
 	pimpl_->program = program;
+	pimpl_->uniform_locations.clear();
+	pimpl_->block_bindings.clear();
+	pimpl_->standard_uniforms = {
+		.model = GetUniformHandle("u_Model"),
+		.mvp = GetUniformHandle("u_MVP"),
+		.normal_matrix = GetUniformHandle("u_NormalMatrix"),
+		.color = GetUniformHandle("u_Color"),
+		.shininess = GetUniformHandle("u_Shininess"),
+		.texture = GetUniformHandle("u_Texture"),
+		.view_projection = GetUniformHandle("u_ViewProjection"),
+		.instanced = GetUniformHandle("u_Instanced")
+	};
 	pimpl_->valid = true;
 	return true;
 }
 
 bool Shader::IsValid() const { return pimpl_->valid; }
 
-void Shader::SetUniform(const std::string& name, const int value) const {
-	GLint location = -1;
-	if (!pimpl_->uniform_locations.contains(name)) {
-		location = glGetUniformLocation(pimpl_->program, name.c_str());
-		pimpl_->uniform_locations[name] = location;
+UniformHandle Shader::GetUniformHandle(const std::string& name) const {
+	if (pimpl_->program == 0) {
+		return {};
 	}
-	else {
-		location = pimpl_->uniform_locations[name];
-	}
-	if (location != -1) {
-		glUniform1i(location, value);
+	if (const auto it = pimpl_->uniform_locations.find(name); it != pimpl_->uniform_locations.end()) {
+		return {.location = it->second};
 	}
+	const GLint location = glGetUniformLocation(pimpl_->program, name.c_str());
+	pimpl_->uniform_locations.emplace(name, location);
+	return {.location = location};
 }
 
-void Shader::SetUniform(const std::string& name, float value) const {
-	GLint location = -1;
-	if (!pimpl_->uniform_locations.contains(name)) {
-		location = glGetUniformLocation(pimpl_->program, name.c_str());
-		pimpl_->uniform_locations[name] = location;
-	}
-	else {
-		location = pimpl_->uniform_locations[name];
-	}
-	if (location != -1) {
-		glUniform1f(location, value);
+const StandardUniforms& Shader::GetStandardUniforms() const { return pimpl_->standard_uniforms; }
+
+void Shader::SetUniform(const UniformHandle handle, const int value) const {
+	if (handle.IsValid()) {
+		glUniform1i(handle.location, value);
 	}
 }
 
-void Shader::SetUniform(const std::string& name, const Vec2& value) const {
-	GLint location = -1;
-	if (!pimpl_->uniform_locations.contains(name)) {
-		location = glGetUniformLocation(pimpl_->program, name.c_str());
-		pimpl_->uniform_locations[name] = location;
-	}
-	else {
-		location = pimpl_->uniform_locations[name];
-	}
-	if (location != -1) {
-		glUniform2fv(location, 1, &value[0]);
+void Shader::SetUniform(const UniformHandle handle, const float value) const {
+	if (handle.IsValid()) {
+		glUniform1f(handle.location, value);
 	}
 }
 
-void Shader::SetUniform(const std::string& name, const Vec3& value) const {
-	GLint location = -1;
-	if (!pimpl_->uniform_locations.contains(name)) {
-		location = glGetUniformLocation(pimpl_->program, name.c_str());
-		pimpl_->uniform_locations[name] = location;
-	}
-	else {
-		location = pimpl_->uniform_locations[name];
-	}
-	if (location != -1) {
-		glUniform3fv(location, 1, &value[0]);
+void Shader::SetUniform(const UniformHandle handle, const Vec2& value) const {
+	if (handle.IsValid()) {
+		glUniform2fv(handle.location, 1, &value[0]);
 	}
 }
 
-void Shader::SetUniform(const std::string& name, const Vec4& value) const {
-	GLint location = -1;
-	if (!pimpl_->uniform_locations.contains(name)) {
-		location = glGetUniformLocation(pimpl_->program, name.c_str());
-		pimpl_->uniform_locations[name] = location;
-	}
-	else {
-		location = pimpl_->uniform_locations[name];
-	}
-	if (location != -1) {
-		glUniform4fv(location, 1, &value[0]);
+void Shader::SetUniform(const UniformHandle handle, const Vec3& value) const {
+	if (handle.IsValid()) {
+		glUniform3fv(handle.location, 1, &value[0]);
 	}
 }
 
-void Shader::SetUniform(const std::string& name, const Mat3& value) const {
-	// TODO: Implement uniform setting
+void Shader::SetUniform(const UniformHandle handle, const Vec4& value) const {
+	if (handle.IsValid()) {
+		glUniform4fv(handle.location, 1, &value[0]);
+	}
 }
 
-void Shader::SetUniform(const std::string& name, const Mat4& value) const {
-	GLint location = -1;
-	if (!pimpl_->uniform_locations.contains(name)) {
-		pimpl_->uniform_locations[name] = glGetUniformLocation(pimpl_->program, name.c_str());
+void Shader::SetUniform(const UniformHandle handle, const Mat3& value) const {
+	if (handle.IsValid()) {
+		glUniformMatrix3fv(handle.location, 1, GL_FALSE, glm::value_ptr(value));
 	}
-	location = pimpl_->uniform_locations[name];
+}
 
-	if (location != -1) {
-		glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+void Shader::SetUniform(const UniformHandle handle, const Mat4& value) const {
+	if (handle.IsValid()) {
+		glUniformMatrix4fv(handle.location, 1, GL_FALSE, glm::value_ptr(value));
 	}
 }
 
-void Shader::SetUniformArray(const std::string& name, const int* values, int count) const {
-	GLint location = -1;
-	if (!pimpl_->uniform_locations.contains(name)) {
-		location = glGetUniformLocation(pimpl_->program, name.c_str());
-		pimpl_->uniform_locations[name] = location;
-	}
-	else {
-		location = pimpl_->uniform_locations[name];
-	}
-	if (location != -1) {
-		glUniform1iv(location, count, values);
+void Shader::SetUniform(const std::string& name, const int value) const { SetUniform(GetUniformHandle(name), value); }
+
+void Shader::SetUniform(const std::string& name, const float value) const { SetUniform(GetUniformHandle(name), value); }
+
+void Shader::SetUniform(const std::string& name, const Vec2& value) const { SetUniform(GetUniformHandle(name), value); }
+
+void Shader::SetUniform(const std::string& name, const Vec3& value) const { SetUniform(GetUniformHandle(name), value); }
+
+void Shader::SetUniform(const std::string& name, const Vec4& value) const { SetUniform(GetUniformHandle(name), value); }
+
+void Shader::SetUniform(const std::string& name, const Mat3& value) const { SetUniform(GetUniformHandle(name), value); }
+
+void Shader::SetUniform(const std::string& name, const Mat4& value) const { SetUniform(GetUniformHandle(name), value); }
+
+void Shader::SetUniformArray(const std::string& name, const int* values, const int count) const {
+	if (const UniformHandle handle = GetUniformHandle(name); handle.IsValid()) {
+		glUniform1iv(handle.location, count, values);
 	}
 }
 
 void Shader::SetTexture(const std::string& name, const TextureId texture, const uint32_t slot) const {
-	GLint location = -1;
-	if (!pimpl_->uniform_locations.contains(name)) {
-		location = glGetUniformLocation(pimpl_->program, name.c_str());
-		pimpl_->uniform_locations[name] = location;
+	const UniformHandle handle = GetUniformHandle(name);
+	GetGLStateCache().BindTexture(slot, texture); // Assuming texture is a GLuint handle
+	SetUniform(handle, static_cast<int>(slot));
+}
+
+bool Shader::BindUniformBlock(const std::string& block_name, const uint32_t binding) const {
+	if (pimpl_->program == 0) {
+		return false;
+	}
+	if (const auto it = pimpl_->block_bindings.find(block_name);
+		it != pimpl_->block_bindings.end() && it->second == binding) {
+		return true;
 	}
-	glActiveTexture(GL_TEXTURE0 + slot);
-	glBindTexture(GL_TEXTURE_2D, texture); // Assuming texture is a GLuint handle
-	glUniform1i(location, slot);
+	return pimpl_->AttachBlock(block_name, binding);
 }
 
 void Shader::Use() const {
 	if (pimpl_->valid) {
-		glUseProgram(pimpl_->program);
+		GetGLStateCache().UseProgram(pimpl_->program);
 	}
 	else {
 		spdlog::error("Shader program is not valid!");
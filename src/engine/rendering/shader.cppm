@@ -14,6 +14,26 @@ import engine.platform;
 export namespace engine::rendering {
 enum class ShaderType { Vertex, Fragment };
 
+// Pre-resolved uniform location. Resolve once with Shader::GetUniformHandle and keep it; setting a uniform through
+// a handle skips the name lookup entirely. Handles are only meaningful for the shader that produced them.
+struct UniformHandle {
+	int location = -1;
+
+	[[nodiscard]] bool IsValid() const { return location != -1; }
+};
+
+// Handles for the uniforms the renderer sets on every draw, resolved when the shader links
+struct StandardUniforms {
+	UniformHandle model;           // u_Model
+	UniformHandle mvp;             // u_MVP
+	UniformHandle normal_matrix;   // u_NormalMatrix
+	UniformHandle color;           // u_Color
+	UniformHandle shininess;       // u_Shininess
+	UniformHandle texture;         // u_Texture
+	UniformHandle view_projection; // u_ViewProjection
+	UniformHandle instanced;       // u_Instanced; valid only for shaders that can read InstanceData attributes
+};
+
 struct ShaderCreateInfo {
 	std::string vertex_source;
 	std::string fragment_source;
@@ -58,6 +78,30 @@ public:
 
 	void SetTexture(const std::string& name, TextureId texture, uint32_t slot = 0) const;
 
+	// Looks the location up once and caches it; an invalid handle means the program has no such active uniform
+	[[nodiscard]] UniformHandle GetUniformHandle(const std::string& name) const;
+
+	[[nodiscard]] const StandardUniforms& GetStandardUniforms() const;
+
+	// Handle-based setters; invalid handles are ignored
+	void SetUniform(UniformHandle handle, int value) const;
+
+	void SetUniform(UniformHandle handle, float value) const;
+
+	void SetUniform(UniformHandle handle, const Vec2& value) const;
+
+	void SetUniform(UniformHandle handle, const Vec3& value) const;
+
+	void SetUniform(UniformHandle handle, const Vec4& value) const;
+
+	void SetUniform(UniformHandle handle, const Mat3& value) const;
+
+	void SetUniform(UniformHandle handle, const Mat4& value) const;
+
+	/// Attach a uniform block to a UniformBuffer binding point
+	/// @return false if the program has no block with that name
+	bool BindUniformBlock(const std::string& block_name, uint32_t binding) const;
+
 	void Use() const;
 
 	// Shader introspection
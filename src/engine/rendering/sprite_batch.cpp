@@ -0,0 +1,106 @@
+module;
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+
+module engine.rendering;
+
+import :sprite_batch;
+import engine.platform;
+import glm;
+
+namespace engine::rendering {
+namespace {
+// Below this many sprites the job system costs more than it saves
+constexpr size_t PARALLEL_BUILD_THRESHOLD = 4096;
+constexpr size_t BUILD_GRAIN_SIZE = 1024;
+
+// Unit quad corners, counter-clockwise from bottom-left; these double as the unflipped texture coordinates
+constexpr std::array<Vec2, SpriteBatch::VERTICES_PER_QUAD> QUAD_CORNERS{
+	{{0.0F, 0.0F}, {1.0F, 0.0F}, {1.0F, 1.0F}, {0.0F, 1.0F}}
+};
+
+void WriteQuad(const SpriteRenderCommand& sprite, const float texture_slot, SpriteVertex* out) {
+	const float cos_r = std::cos(sprite.rotation);
+	const float sin_r = std::sin(sprite.rotation);
+	for (const Vec2& corner : QUAD_CORNERS) {
+		const Vec2 local = (corner - sprite.pivot) * sprite.size;
+		const Vec2 uv(sprite.flip_x ? 1.0F - corner.x : corner.x, sprite.flip_y ? 1.0F - corner.y : corner.y);
+		*out++ = {
+			.position = sprite.position + Vec2(local.x * cos_r - local.y * sin_r, local.x * sin_r + local.y * cos_r),
+			.tex_coords = uv * sprite.texture_scale + sprite.texture_offset,
+			.color = sprite.color,
+			.texture_slot = texture_slot
+		};
+	}
+}
+} // namespace
+
+void SpriteBatch::Add(const SpriteRenderCommand& sprite) {
+	if (sprite.texture != INVALID_TEXTURE) {
+		sprites_.push_back(sprite);
+	}
+}
+
+void SpriteBatch::Clear() {
+	sprites_.clear();
+	order_.clear();
+	texture_slots_.clear();
+	vertices_.clear();
+	draws_.clear();
+}
+
+void SpriteBatch::Build() {
+	order_.resize(sprites_.size());
+	std::iota(order_.begin(), order_.end(), 0U);
+	std::ranges::stable_sort(order_, {}, [this](const uint32_t index) { return sprites_[index].layer; });
+
+	// Split into draws and assign texture slots; cheap and order dependent, so done serially
+	draws_.clear();
+	texture_slots_.resize(order_.size());
+	for (size_t i = 0; i < order_.size(); ++i) {
+		const TextureId texture = sprites_[order_[i]].texture;
+		size_t slot = SPRITE_BATCH_MAX_TEXTURE_SLOTS;
+		if (!draws_.empty()) {
+			const auto& textures = draws_.back().textures;
+			const auto used = textures.begin() + draws_.back().texture_count;
+			slot = static_cast<size_t>(std::find(textures.begin(), used, texture) - textures.begin());
+		}
+		// Not in the current table and no free slot left
+		if (slot == SPRITE_BATCH_MAX_TEXTURE_SLOTS) {
+			draws_.push_back({.first_quad = static_cast<uint32_t>(i)});
+			slot = 0;
+		}
+
+		SpriteBatchDraw& draw = draws_.back();
+		if (slot == draw.texture_count) {
+			draw.textures[draw.texture_count++] = texture;
+		}
+		texture_slots_[i] = static_cast<uint8_t>(slot);
+		++draw.quad_count;
+	}
+
+	// Every quad writes its own four vertices, so ranges of quads can be generated independently
+	vertices_.resize(order_.size() * VERTICES_PER_QUAD);
+	const auto write_range = [this](const size_t begin, const size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			WriteQuad(
+				sprites_[order_[i]],
+				static_cast<float>(texture_slots_[i]),
+				vertices_.data() + i * VERTICES_PER_QUAD
+			);
+		}
+	};
+	if (order_.size() < PARALLEL_BUILD_THRESHOLD) {
+		write_range(0, order_.size());
+	}
+	else {
+		platform::threading::GetJobSystem().ParallelFor(0, order_.size(), BUILD_GRAIN_SIZE, write_range);
+	}
+}
+
+} // namespace engine::rendering
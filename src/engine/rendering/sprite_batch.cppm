@@ -0,0 +1,67 @@
+module;
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+export module engine.rendering:sprite_batch;
+
+import :types;
+
+export namespace engine::rendering {
+// Texture units a single sprite batch draw samples from; the sprite shader selects among them per vertex
+constexpr size_t SPRITE_BATCH_MAX_TEXTURE_SLOTS = 8;
+
+struct SpriteVertex {
+	Vec2 position; // Screen coordinates, already rotated and scaled
+	Vec2 tex_coords;
+	Color color;
+	float texture_slot = 0.0F; // Index into the owning draw's texture table
+};
+
+// A run of consecutive quads drawn with one call. Quad i owns vertices 4i..4i+3; textures[slot] goes to unit slot.
+struct SpriteBatchDraw {
+	uint32_t first_quad = 0;
+	uint32_t quad_count = 0;
+	std::array<TextureId, SPRITE_BATCH_MAX_TEXTURE_SLOTS> textures{};
+	uint32_t texture_count = 0;
+};
+
+/**
+ * @brief CPU side of the batched sprite path
+ *
+ * Collects a frame's sprites and turns them into one stream of pre-transformed quads and a short list of draws.
+ * Sprites are ordered by layer; the sort is stable, so overlapping sprites within a layer keep their submission
+ * order. A new draw starts only when a sprite needs a texture beyond the current draw's slot table. Large frames
+ * generate their vertices across the job system.
+ */
+class SpriteBatch {
+public:
+	// Quad vertex order; indices 0-1-2 and 0-2-3 give two counter-clockwise triangles
+	static constexpr size_t VERTICES_PER_QUAD = 4;
+	static constexpr size_t INDICES_PER_QUAD = 6;
+
+	// Sprites without a texture are dropped
+	void Add(const SpriteRenderCommand& sprite);
+
+	void Clear();
+
+	// Sort everything added since Clear() and generate its vertices and draws
+	void Build();
+
+	[[nodiscard]] size_t Size() const { return sprites_.size(); }
+
+	[[nodiscard]] std::span<const SpriteVertex> GetVertices() const { return vertices_; }
+
+	[[nodiscard]] std::span<const SpriteBatchDraw> GetDraws() const { return draws_; }
+
+private:
+	std::vector<SpriteRenderCommand> sprites_;
+	std::vector<uint32_t> order_;        // Sprite indices in draw order
+	std::vector<uint8_t> texture_slots_; // Slot of each sprite in draw order
+	std::vector<SpriteVertex> vertices_;
+	std::vector<SpriteBatchDraw> draws_;
+};
+} // namespace engine::rendering
@@ -0,0 +1,133 @@
+module;
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#ifdef __EMSCRIPTEN__
+#include <GLES3/gl3.h>
+#else
+#include <glad/glad.h>
+#endif
+
+module engine.rendering;
+
+import :stream_buffer;
+
+namespace engine::rendering {
+namespace {
+size_t AlignUp(const size_t offset, const size_t alignment) { return (offset + alignment - 1) / alignment * alignment; }
+} // namespace
+
+StreamBuffer::StreamBuffer(const StreamBufferTarget target) :
+		target_(target == StreamBufferTarget::Index ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER) {}
+
+StreamBuffer::~StreamBuffer() { Destroy(); }
+
+bool StreamBuffer::Create(const size_t region_size) {
+	Destroy();
+	if (IsHeadless() || region_size == 0) {
+		return false;
+	}
+	glGenBuffers(1, &buffer_id_);
+	glBindBuffer(target_, buffer_id_);
+	Allocate(region_size);
+	return true;
+}
+
+void StreamBuffer::Destroy() {
+	DeleteFences();
+	if (buffer_id_ != 0) {
+		glDeleteBuffers(1, &buffer_id_);
+		buffer_id_ = 0;
+	}
+	region_size_ = 0;
+	region_ = 0;
+	offset_ = 0;
+}
+
+size_t StreamBuffer::Write(const void* data, const size_t size, const size_t alignment) {
+	if (buffer_id_ == 0 || size == 0) {
+		return 0;
+	}
+	glBindBuffer(target_, buffer_id_);
+
+	size_t start = AlignUp(offset_, alignment);
+	if (start + size > (region_ + 1) * region_size_) {
+		if (size + alignment > region_size_) {
+			// Fresh storage, so nothing in it needs fencing
+			Allocate(std::bit_ceil(size + alignment));
+			++orphan_count_;
+		}
+		else {
+			AdvanceRegion();
+		}
+		start = AlignUp(region_ * region_size_, alignment);
+	}
+
+#ifdef __EMSCRIPTEN__
+	// WebGL has no buffer mapping; the implementation orders sub-data uploads after earlier draws itself
+	glBufferSubData(target_, static_cast<GLintptr>(start), static_cast<GLsizeiptr>(size), data);
+#else
+	// Unsynchronized: the region fences already guarantee the GPU is done with this range, so the driver need not
+	// track it
+	void* const mapped = glMapBufferRange(
+		target_,
+		static_cast<GLintptr>(start),
+		static_cast<GLsizeiptr>(size),
+		GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT
+	);
+	if (!mapped) {
+		glBufferSubData(target_, static_cast<GLintptr>(start), static_cast<GLsizeiptr>(size), data);
+	}
+	else {
+		std::memcpy(mapped, data, size);
+		glUnmapBuffer(target_);
+	}
+#endif
+	offset_ = start + size;
+	return start;
+}
+
+void StreamBuffer::AdvanceRegion() {
+#ifdef __EMSCRIPTEN__
+	// Without mapped writes there is nothing for fences to guard: wrapping around just orphans the storage
+	region_ = (region_ + 1) % REGION_COUNT;
+	if (region_ == 0) {
+		Allocate(region_size_);
+		++orphan_count_;
+	}
+#else
+	// The GPU may still be reading the region being left; fence it so it is only rewritten once those draws are done
+	fences_[region_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	region_ = (region_ + 1) % REGION_COUNT;
+	if (auto* const fence = static_cast<GLsync>(fences_[region_])) {
+		const GLenum status = glClientWaitSync(fence, 0, 0);
+		glDeleteSync(fence);
+		fences_[region_] = nullptr;
+		if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+			Allocate(region_size_);
+			++orphan_count_;
+		}
+	}
+#endif
+}
+
+void StreamBuffer::Allocate(const size_t region_size) {
+	DeleteFences();
+	region_size_ = region_size;
+	region_ = 0;
+	offset_ = 0;
+	glBufferData(target_, static_cast<GLsizeiptr>(region_size * REGION_COUNT), nullptr, GL_STREAM_DRAW);
+}
+
+void StreamBuffer::DeleteFences() {
+	for (void*& fence : fences_) {
+		if (fence) {
+			glDeleteSync(static_cast<GLsync>(fence));
+			fence = nullptr;
+		}
+	}
+}
+
+} // namespace engine::rendering
@@ -0,0 +1,83 @@
+module;
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+export module engine.rendering:stream_buffer;
+
+export namespace engine::rendering {
+
+enum class StreamBufferTarget { Vertex, Index };
+
+/**
+ * @brief Ring-buffered GL buffer for geometry that is rewritten every frame
+ *
+ * The storage is split into REGION_COUNT equal regions. Writes append at increasing offsets inside the current
+ * region, so a flush never overwrites data an earlier draw may still be reading and the buffer is never
+ * respecified. When a region fills up it is fenced and writing moves on to the next one, which is reused only once
+ * its own fence has signalled; if the GPU is still behind, the storage is orphaned rather than waited on. Because
+ * the fences guard every range, writes map it unsynchronized instead of going through glBufferSubData. A write
+ * larger than a region grows every region to fit.
+ *
+ * WebGL cannot map buffers, so there writes use glBufferSubData (which the implementation already orders after
+ * earlier draws), no fences are kept and the storage is orphaned each time the ring wraps.
+ */
+class StreamBuffer {
+public:
+	static constexpr uint32_t REGION_COUNT = 3;
+
+	explicit StreamBuffer(StreamBufferTarget target);
+	~StreamBuffer();
+
+	StreamBuffer(const StreamBuffer&) = delete;
+	StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+	/**
+	 * @brief Allocate the buffer
+	 * @param region_size Initial size of each region in bytes
+	 * @return true if creation succeeded (always false when headless)
+	 */
+	bool Create(size_t region_size);
+
+	void Destroy();
+
+	/**
+	 * @brief Copy data into the ring
+	 *
+	 * Leaves the buffer bound to its target. Index buffers are VAO state, so bind the VAO that draws from this
+	 * buffer first.
+	 *
+	 * @param alignment The returned offset is a multiple of this
+	 * @return Byte offset of the data from the start of the buffer; 0 if the buffer was never created
+	 */
+	size_t Write(const void* data, size_t size, size_t alignment);
+
+	[[nodiscard]] uint32_t GetHandle() const { return buffer_id_; }
+
+	[[nodiscard]] size_t GetRegionSize() const { return region_size_; }
+
+	// Times the storage was thrown away instead of reused: the GPU still held the next region, or a write grew it
+	[[nodiscard]] uint32_t GetOrphanCount() const { return orphan_count_; }
+
+	[[nodiscard]] bool IsValid() const { return buffer_id_ != 0; }
+
+private:
+	// Move writing to the next region, orphaning the storage if that region may still be in use
+	void AdvanceRegion();
+
+	// Respecify the whole buffer with regions of region_size bytes and start over at region 0
+	void Allocate(size_t region_size);
+
+	void DeleteFences();
+
+	uint32_t target_;
+	uint32_t buffer_id_ = 0;
+	size_t region_size_ = 0;
+	uint32_t region_ = 0; // Region being written
+	size_t offset_ = 0;   // End of the last write, from the start of the buffer
+	std::array<void*, REGION_COUNT> fences_{}; // GLsync set when writing left each region; null once it is free
+	uint32_t orphan_count_ = 0;
+};
+
+} // namespace engine::rendering
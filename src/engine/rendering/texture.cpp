@@ -118,6 +118,9 @@ TextureId TextureManager::CreateTexture(const std::string& name, const TextureCr
 		pimpl_->textures[id] = info;
 		pimpl_->texture_cache[name] = id;
 	}
+	if (IsHeadless()) {
+		return id;
+	}
 
 	GLTexture gl_tex;
 	gl_tex.width = info.width;
@@ -128,7 +131,7 @@ TextureId TextureManager::CreateTexture(const std::string& name, const TextureCr
 	const GLenum gl_format = GetGLFormat(gl_tex.format);
 
 	glGenTextures(1, &gl_tex.handle);
-	glBindTexture(GL_TEXTURE_2D, gl_tex.handle);
+	GetGLStateCache().BindTexture(0, gl_tex.handle);
 
 	// Check for errors before texture upload
 	GLenum err = glGetError();
@@ -164,7 +167,7 @@ TextureId TextureManager::CreateTexture(const std::string& name, const TextureCr
 		);
 	}
 
-	glBindTexture(GL_TEXTURE_2D, 0);
+	GetGLStateCache().BindTexture(0, 0);
 
 	g_texture_gl[id] = gl_tex;
 	SetTextureParameters(id, info.parameters);
@@ -212,9 +215,9 @@ void TextureManager::UpdateTexture(
 
 	const GLenum gl_format = GetGLFormat(gl_tex->format);
 
-	glBindTexture(GL_TEXTURE_2D, gl_tex->handle);
+	GetGLStateCache().BindTexture(0, gl_tex->handle);
 	glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, gl_format, GL_UNSIGNED_BYTE, data);
-	glBindTexture(GL_TEXTURE_2D, 0);
+	GetGLStateCache().BindTexture(0, 0);
 }
 
 void TextureManager::SetTextureParameters(const TextureId id, const TextureParameters& parameters) const {
@@ -224,7 +227,7 @@ void TextureManager::SetTextureParameters(const TextureId id, const TextureParam
 	}
 
 	pimpl_->textures[id].parameters = parameters;
-	glBindTexture(GL_TEXTURE_2D, gl_tex->handle);
+	GetGLStateCache().BindTexture(0, gl_tex->handle);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GetGLFilterMode(parameters.min_filter));
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GetGLFilterMode(parameters.mag_filter));
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GetGLWrapMode(parameters.wrap_s));
@@ -232,7 +235,7 @@ void TextureManager::SetTextureParameters(const TextureId id, const TextureParam
 	if (parameters.generate_mipmaps) {
 		glGenerateMipmap(GL_TEXTURE_2D);
 	}
-	glBindTexture(GL_TEXTURE_2D, 0);
+	GetGLStateCache().BindTexture(0, 0);
 }
 
 uint32_t TextureManager::GetWidth(const TextureId id) const {
@@ -262,6 +265,7 @@ void TextureManager::DestroyTexture(const TextureId id) const {
 	if (const auto it = g_texture_gl.find(id); it != g_texture_gl.end()) {
 		glDeleteTextures(1, &it->second.handle);
 		g_texture_gl.erase(it);
+		GetGLStateCache().Invalidate(); // The name can be reused, so a shadowed binding of it would be stale
 	}
 }
 
@@ -288,6 +292,7 @@ void TextureManager::Clear() const {
 		glDeleteTextures(1, &gl_tex.handle);
 	}
 	g_texture_gl.clear();
+	GetGLStateCache().Invalidate();
 }
 
 TextureId TextureManager::GetWhiteTexture() const { return pimpl_->white_texture; }
@@ -25,7 +25,7 @@ bool TilemapRenderer::Initialize(const ShaderManager& shader_manager) {
 	glGenBuffers(1, &vbo_);
 	glGenBuffers(1, &ebo_);
 
-	glBindVertexArray(vao_);
+	GetGLStateCache().BindVertexArray(vao_);
 
 	// Setup vertex buffer
 	glBindBuffer(GL_ARRAY_BUFFER, vbo_);
@@ -48,7 +48,7 @@ bool TilemapRenderer::Initialize(const ShaderManager& shader_manager) {
 	glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(TileVertex), (void*) offsetof(TileVertex, opacity));
 	glEnableVertexAttribArray(2);
 
-	glBindVertexArray(0);
+	GetGLStateCache().BindVertexArray(0);
 
 	shader_id_ = CreateDefaultShader(shader_manager);
 	initialized_ = true;
@@ -61,6 +61,7 @@ void TilemapRenderer::Cleanup() {
 	if (vao_ != 0) {
 		glDeleteVertexArrays(1, &vao_);
 		vao_ = 0;
+		GetGLStateCache().Invalidate();
 	}
 	if (vbo_ != 0) {
 		glDeleteBuffers(1, &vbo_);
@@ -89,8 +90,9 @@ void TilemapRenderer::Render(
 	const glm::mat4 mvp_matrix = projection_matrix * view_matrix;
 
 	// Enable alpha blending for tile transparency
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	auto& gl_state = GetGLStateCache();
+	gl_state.SetFlag(RenderFlag::Blend, true);
+	gl_state.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	// Render each layer from bottom to top
 	constexpr float z_step = 0.01F; // Small step to avoid z-fighting
@@ -116,7 +118,7 @@ void TilemapRenderer::Render(
 		layer_index++;
 	}
 
-	glDisable(GL_BLEND);
+	gl_state.SetFlag(RenderFlag::Blend, false);
 }
 
 void TilemapRenderer::BuildLayerBatch(
@@ -229,7 +231,7 @@ void TilemapRenderer::RenderBatch(const TileBatch& batch, const glm::mat4& mvp_m
 	shader.SetTexture("u_texture", batch.texture, 0);
 
 	// Update vertex buffer
-	glBindVertexArray(vao_);
+	GetGLStateCache().BindVertexArray(vao_);
 	glBindBuffer(GL_ARRAY_BUFFER, vbo_);
 	glBufferSubData(GL_ARRAY_BUFFER, 0, batch.vertices.size() * sizeof(TileVertex), batch.vertices.data());
 
@@ -244,8 +246,6 @@ void TilemapRenderer::RenderBatch(const TileBatch& batch, const glm::mat4& mvp_m
 	stats_.draw_calls++;
 	stats_.triangles += batch.indices.size() / 3;
 	stats_.vertices += batch.vertices.size();
-
-	glBindVertexArray(0);
 }
 
 ShaderId TilemapRenderer::CreateDefaultShader(const ShaderManager& shader_manager) {
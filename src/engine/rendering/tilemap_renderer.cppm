@@ -74,8 +74,7 @@ public:
 	void SetShader(const ShaderId shader_id) { shader_id_ = shader_id; }
 	[[nodiscard]] ShaderId GetShader() const { return shader_id_; }
 
-private:
-	// Build vertex data for a single layer
+	// Build vertex data for a single layer. CPU-only, so it also runs without a GL context.
 	void BuildLayerBatch(
 		const std::shared_ptr<components::TilemapLayer>& layer,
 		const glm::ivec2& tile_size,
@@ -86,6 +85,7 @@ private:
 		float z_step
 	);
 
+private:
 	static void AddTileToBatch(
 		const glm::vec2& world_pos,
 		const glm::ivec2& tile_size,
@@ -57,6 +57,8 @@ enum class RenderFlag : uint32_t {
 struct RenderFlagStackEntry {
 	std::vector<RenderFlag> enable_flags;
 	std::vector<RenderFlag> disable_flags;
+
+	bool operator==(const RenderFlagStackEntry&) const = default;
 };
 
 struct RenderCommand {
@@ -70,6 +72,16 @@ struct RenderCommand {
 	glm::mat4 camera_view;
 };
 
+// Per-instance data for Renderer::SubmitInstancedRenderCommand, streamed to vertex attributes 4-7 (model) and 8-11
+// (normal matrix)
+struct InstanceData {
+	Mat4 model;
+	Mat4 normal_matrix;
+};
+
+// First vertex attribute location used by InstanceData; mesh vertex attributes occupy 0-3
+constexpr uint32_t INSTANCE_ATTRIBUTE_LOCATION = 4;
+
 struct SpriteRenderCommand {
 	TextureId texture;
 	Vec2 position;
@@ -79,6 +91,9 @@ struct SpriteRenderCommand {
 	Vec2 texture_offset{0.0F, 0.0F};
 	Vec2 texture_scale{1.0F, 1.0F};
 	int layer = 0;
+	Vec2 pivot{0.5F, 0.5F}; // Point of the sprite placed at position and rotated about; 0,0 = bottom-left
+	bool flip_x = false;
+	bool flip_y = false;
 };
 
 // UI Batch render command for batch renderer
@@ -88,13 +103,8 @@ constexpr size_t UI_BATCH_MAX_TEXTURE_SLOTS = 8;
 struct UIBatchRenderCommand {
 	ShaderId shader{};
 	Mat4 projection{};
-	uint32_t vao{};
-	uint32_t vbo{};
-	uint32_t ebo{};
-	const void* vertex_data{};
-	size_t vertex_data_size{};
-	const void* index_data{};
-	size_t index_data_size{};
+	uint32_t vao{};        // Vertices and indices are already uploaded to this VAO's buffers
+	size_t index_offset{}; // Byte offset of the first index in the VAO's element buffer
 	size_t index_count{};
 	const uint32_t* texture_ids{};
 	size_t texture_count{};
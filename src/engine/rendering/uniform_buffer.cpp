@@ -0,0 +1,89 @@
+module;
+
+#include <cstddef>
+#include <cstdint>
+#include <spdlog/spdlog.h>
+#ifdef __EMSCRIPTEN__
+#include <GLES3/gl3.h>
+#else
+#include <glad/glad.h>
+#endif
+
+module engine.rendering;
+
+import :uniform_buffer;
+
+namespace engine::rendering {
+
+UniformBuffer::UniformBuffer() = default;
+
+UniformBuffer::~UniformBuffer() { Destroy(); }
+
+UniformBuffer::UniformBuffer(UniformBuffer&& other) noexcept : buffer_id_(other.buffer_id_), size_(other.size_) {
+	other.buffer_id_ = 0;
+	other.size_ = 0;
+}
+
+UniformBuffer& UniformBuffer::operator=(UniformBuffer&& other) noexcept {
+	if (this != &other) {
+		Destroy();
+		buffer_id_ = other.buffer_id_;
+		size_ = other.size_;
+		other.buffer_id_ = 0;
+		other.size_ = 0;
+	}
+	return *this;
+}
+
+bool UniformBuffer::Create(const size_t size) {
+	if (size == 0) {
+		spdlog::error("UniformBuffer::Create: size must be non-zero");
+		return false;
+	}
+
+	// Clean up existing buffer if any
+	Destroy();
+	if (IsHeadless()) {
+		return false;
+	}
+
+	glGenBuffers(1, &buffer_id_);
+	glBindBuffer(GL_UNIFORM_BUFFER, buffer_id_);
+	glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	size_ = size;
+	return true;
+}
+
+void UniformBuffer::Destroy() {
+	if (buffer_id_ != 0) {
+		glDeleteBuffers(1, &buffer_id_);
+		buffer_id_ = 0;
+	}
+	size_ = 0;
+}
+
+void UniformBuffer::Update(const void* data, const size_t size, const size_t offset) const {
+	if (buffer_id_ == 0) {
+		return;
+	}
+	if (offset + size > size_) {
+		spdlog::error("UniformBuffer::Update: {} bytes at offset {} overflow a {} byte buffer", size, offset, size_);
+		return;
+	}
+	glBindBuffer(GL_UNIFORM_BUFFER, buffer_id_);
+	glBufferSubData(GL_UNIFORM_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void UniformBuffer::BindBase(const uint32_t binding) const {
+	if (buffer_id_ != 0) {
+		glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer_id_);
+	}
+}
+
+size_t UniformBuffer::GetSize() const { return size_; }
+
+bool UniformBuffer::IsValid() const { return buffer_id_ != 0; }
+
+} // namespace engine::rendering
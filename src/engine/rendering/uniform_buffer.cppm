@@ -0,0 +1,107 @@
+module;
+
+#include <cstddef>
+#include <cstdint>
+
+export module engine.rendering:uniform_buffer;
+
+import :types;
+
+export namespace engine::rendering {
+
+// Binding point the renderer attaches the per-frame SceneUniforms buffer to
+constexpr uint32_t SCENE_UNIFORM_BINDING = 0;
+
+// Name of the matching uniform block in GLSL
+constexpr auto SCENE_UNIFORM_BLOCK = "SceneUniforms";
+
+// Directional lights plus every point and spot light the clusters can reference
+constexpr int MAX_SCENE_LIGHTS = 256;
+
+/**
+ * @brief Per-frame camera and lighting data, laid out to match the std140 SceneUniforms block:
+ *
+ *     layout(std140) uniform SceneUniforms {
+ *         vec4 u_CameraPos;                   // xyz
+ *         vec4 u_Ambient;                     // rgb color, a intensity
+ *         ivec4 u_LightCount;                 // x directional lights, y all lights
+ *         vec4 u_LightPositions[MAX_LIGHTS];  // xyz position (direction for directional lights), w type
+ *         vec4 u_LightColors[MAX_LIGHTS];     // rgb color, a intensity
+ *         vec4 u_LightParams[MAX_LIGHTS];     // x range, y attenuation
+ *         vec4 u_ClusterDepth;                // x near plane, y far plane, z slice scale, w slice bias
+ *         vec4 u_ClusterScreen;               // xy clusters per pixel
+ *     };
+ *
+ * Directional lights occupy the first light_count[0] slots and light every fragment. The point and spot lights
+ * after them are only shaded by the fragments whose light cluster lists them; Renderer::SetSceneUniforms builds
+ * those lists and fills in the cluster fields. Everything is a vec4 so the C++ and std140 layouts agree without
+ * padding rules.
+ */
+struct SceneUniforms {
+	Vec4 camera_position{0.0F};
+	Vec4 ambient{1.0F, 1.0F, 1.0F, 0.5F};
+	int32_t light_count[4]{};
+	Vec4 light_positions[MAX_SCENE_LIGHTS]{};
+	Vec4 light_colors[MAX_SCENE_LIGHTS]{};
+	Vec4 light_params[MAX_SCENE_LIGHTS]{};
+	Vec4 cluster_depth{0.0F};
+	Vec4 cluster_screen{0.0F};
+};
+
+static_assert(sizeof(SceneUniforms) == 16 * (5 + 3 * MAX_SCENE_LIGHTS), "SceneUniforms must match std140 layout");
+
+/**
+ * @brief GPU uniform buffer (UBO) for data shared by many draws
+ *
+ * Upload once, bind to a binding point, and every shader whose block is attached to that point
+ * (Shader::BindUniformBlock) reads it without per-draw uniform calls.
+ */
+class UniformBuffer {
+public:
+	UniformBuffer();
+	~UniformBuffer();
+
+	// Non-copyable, movable
+	UniformBuffer(const UniformBuffer&) = delete;
+	UniformBuffer& operator=(const UniformBuffer&) = delete;
+	UniformBuffer(UniformBuffer&& other) noexcept;
+	UniformBuffer& operator=(UniformBuffer&& other) noexcept;
+
+	/**
+	 * @brief Allocate the buffer
+	 * @param size Size in bytes
+	 * @return true if creation succeeded
+	 */
+	bool Create(size_t size);
+
+	/**
+	 * @brief Release the GPU buffer
+	 */
+	void Destroy();
+
+	/**
+	 * @brief Overwrite part of the buffer
+	 * @param data Source bytes
+	 * @param size Byte count; offset + size must not exceed the buffer size
+	 * @param offset Destination offset in bytes
+	 */
+	void Update(const void* data, size_t size, size_t offset = 0) const;
+
+	/**
+	 * @brief Attach the whole buffer to an indexed uniform binding point
+	 */
+	void BindBase(uint32_t binding) const;
+
+	[[nodiscard]] size_t GetSize() const;
+
+	/**
+	 * @brief Check if the buffer has been created (always false when headless)
+	 */
+	[[nodiscard]] bool IsValid() const;
+
+private:
+	uint32_t buffer_id_ = 0;
+	size_t size_ = 0;
+};
+
+} // namespace engine::rendering
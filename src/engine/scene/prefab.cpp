@@ -13,6 +13,7 @@ import engine.asset_registry;
 import engine.ecs;
 import engine.platform;
 import engine.scene;
+import engine.scene.serializer;
 import engine.components;
 
 using json = nlohmann::json;
@@ -28,7 +29,7 @@ namespace engine::scene {
 bool PrefabUtility::WritePrefabFile(const ecs::Entity& prefab_entity, const platform::fs::Path& file_path) {
 	try {
 		json prefab_doc;
-		prefab_doc["version"] = 1;
+		prefab_doc["version"] = PREFAB_FORMAT_VERSION;
 		prefab_doc["name"] = prefab_entity.name().c_str();
 
 		json entities_array = json::array();
@@ -148,7 +149,8 @@ ecs::Entity PrefabUtility::LoadPrefab(const platform::fs::Path& prefab_path, ecs
 
 		json prefab_doc = json::parse(*text);
 
-		if (const int version = prefab_doc.value("version", 0); version != 1) {
+		const int version = prefab_doc.value("version", 0);
+		if (version != PREFAB_FORMAT_VERSION && version != 1) {
 			std::cerr << "PrefabUtility: Unsupported prefab format version: " << version << '\n';
 			return {};
 		}
@@ -168,7 +170,11 @@ ecs::Entity PrefabUtility::LoadPrefab(const platform::fs::Path& prefab_path, ecs
 
 		// Apply component data from JSON
 		if (root_entry.contains("data")) {
-			const std::string data_json = root_entry["data"];
+			std::string data_json = root_entry["data"];
+			if (version == 1) {
+				// Version 1 prefabs store euler Transform rotations
+				data_json = SceneSerializer::UpgradeLegacyEntityJson(data_json);
+			}
 			prefab_entity.from_json(data_json.c_str());
 		}
 
@@ -11,6 +11,10 @@ import engine.components;
 
 export namespace engine::scene {
 
+/// Prefab file format version
+/// Version 1 stored Transform rotations as euler angles; such files are upgraded on load.
+constexpr int PREFAB_FORMAT_VERSION = 2;
+
 /// Prefab utilities using flecs native prefab system.
 /// Prefabs are created via world.prefab() and instances via entity.is_a(prefab).
 /// Flecs handles component inheritance, sharing, and overriding natively.
@@ -57,6 +57,9 @@ public:
 	// Find entity by name within this scene
 	[[nodiscard]] ecs::Entity FindEntityByName(const std::string& name) const;
 
+	// Find entity by slash-separated path of names from the scene root (e.g. "Player/Weapon")
+	[[nodiscard]] ecs::Entity FindEntityByPath(const std::string& path) const;
+
 	// === HIERARCHY MANAGEMENT ===
 
 	// Get the scene root entity
@@ -94,6 +94,10 @@ ecs::Entity Scene::FindEntityByName(const std::string& name) const {
 	return pimpl_->ecs_world.FindEntityByName(name.c_str(), pimpl_->scene_root);
 }
 
+ecs::Entity Scene::FindEntityByPath(const std::string& path) const {
+	return pimpl_->ecs_world.FindEntityByPath(path, pimpl_->scene_root);
+}
+
 // === HIERARCHY MANAGEMENT ===
 
 ecs::Entity Scene::GetSceneRoot() const { return pimpl_->scene_root; }
@@ -19,6 +19,9 @@ using json = nlohmann::json;
 namespace engine::scene {
 
 namespace {
+// Last format version that stored Transform rotations as euler angles
+constexpr int LEGACY_EULER_FORMAT_VERSION = 1;
+
 void ImportPhysicsModule(const std::string& backend, ecs::ECSWorld& world) {
 	auto& ecs = world.GetWorld();
 	if (backend == "jolt") {
@@ -109,7 +112,8 @@ SceneId SceneSerializer::Load(const platform::fs::Path& path, SceneManager& mana
 		json doc = json::parse(*text);
 
 		// Validate version
-		if (const int version = doc.value("version", 0); version != SCENE_FORMAT_VERSION) {
+		const int version = doc.value("version", 0);
+		if (version != SCENE_FORMAT_VERSION && version != LEGACY_EULER_FORMAT_VERSION) {
 			std::cerr << "SceneSerializer: Unsupported scene format version: " << version << '\n';
 			return INVALID_SCENE;
 		}
@@ -177,7 +181,7 @@ SceneId SceneSerializer::Load(const platform::fs::Path& path, SceneManager& mana
 		// Deserialize entities
 		if (doc.contains("flecs_data")) {
 			if (const std::string flecs_json = doc["flecs_data"].get<std::string>();
-				!DeserializeEntities(flecs_json, world)) {
+				!DeserializeEntities(flecs_json, world, version)) {
 				std::cerr << "SceneSerializer: Warning - some entities may not have loaded correctly" << '\n';
 			}
 		}
@@ -239,7 +243,11 @@ std::string SceneSerializer::SerializeEntities(const Scene& scene, ecs::ECSWorld
 	return entities_array.dump();
 }
 
-bool SceneSerializer::DeserializeEntities(const std::string& flecs_json, ecs::ECSWorld& world) {
+bool SceneSerializer::DeserializeEntities(
+	const std::string& flecs_json,
+	ecs::ECSWorld& world,
+	const int format_version
+) {
 	if (flecs_json.empty() || flecs_json == "{}") {
 		return true; // Empty scene is valid
 	}
@@ -267,7 +275,10 @@ bool SceneSerializer::DeserializeEntities(const std::string& flecs_json, ecs::EC
 
 			// Deserialize entity data
 			if (entity_entry.contains("data")) {
-				const std::string data_json = entity_entry["data"];
+				std::string data_json = entity_entry["data"];
+				if (format_version == LEGACY_EULER_FORMAT_VERSION) {
+					data_json = UpgradeLegacyEntityJson(data_json);
+				}
 				entity.from_json(data_json.c_str());
 			}
 		}
@@ -312,4 +323,23 @@ bool SceneSerializer::RestoreEntities(const std::string& snapshot, const Scene&
 	return DeserializeEntities(snapshot, world);
 }
 
+std::string SceneSerializer::UpgradeLegacyEntityJson(const std::string& entity_json) {
+	json data = json::parse(entity_json);
+	if (!data.contains("components") || !data["components"].contains("engine.components.Transform")) {
+		return entity_json;
+	}
+
+	auto& transform = data["components"]["engine.components.Transform"];
+	if (!transform.is_object() || !transform.contains("rotation") || transform["rotation"].contains("w")) {
+		return entity_json;
+	}
+
+	auto& rotation = transform["rotation"];
+	const glm::quat orientation(
+		glm::vec3(rotation.value("x", 0.0F), rotation.value("y", 0.0F), rotation.value("z", 0.0F))
+	);
+	rotation = {{"x", orientation.x}, {"y", orientation.y}, {"z", orientation.z}, {"w", orientation.w}};
+	return data.dump();
+}
+
 } // namespace engine::scene
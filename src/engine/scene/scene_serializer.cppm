@@ -14,13 +14,14 @@ export namespace engine::scene {
 using SceneId = uint32_t;
 
 /// Scene serialization format version
-inline constexpr int SCENE_FORMAT_VERSION = 1;
+/// Version 1 stored Transform rotations as euler angles; such files are upgraded on load.
+inline constexpr int SCENE_FORMAT_VERSION = 2;
 
 /// Scene serializer - handles saving and loading scenes to/from JSON files
 ///
 /// File format:
 /// {
-///     "version": 1,
+///     "version": 2,
 ///     "name": "Scene Name",
 ///     "metadata": { ... },
 ///     "settings": { ... },
@@ -49,12 +50,21 @@ public:
 	/// Restore scene entities from a snapshot string (for play mode restore)
 	static bool RestoreEntities(const std::string& snapshot, const Scene& scene, ecs::ECSWorld& world);
 
+	/// Upgrade a version 1 entity JSON blob (euler Transform rotation) to the current quaternion format
+	/// @param entity_json Entity JSON as produced by flecs::entity::to_json()
+	/// @return The upgraded JSON, or the input unchanged if it needs no upgrade
+	static std::string UpgradeLegacyEntityJson(const std::string& entity_json);
+
 private:
 	/// Serialize scene entities to flecs JSON format
 	static std::string SerializeEntities(const Scene& scene, ecs::ECSWorld& world);
 
-	/// Deserialize entities from flecs JSON format
-	static bool DeserializeEntities(const std::string& flecs_json, ecs::ECSWorld& world);
+	/// Deserialize entities from flecs JSON format written with the given format version
+	static bool DeserializeEntities(
+		const std::string& flecs_json,
+		ecs::ECSWorld& world,
+		int format_version = SCENE_FORMAT_VERSION
+	);
 
 	/// Get the path of the active camera entity (empty string if none)
 	static std::string GetActiveCameraPath(const ecs::ECSWorld& world);
@@ -0,0 +1,407 @@
+// Dynamic AABB tree implementation
+module;
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+module engine.spatial;
+
+import glm;
+
+namespace engine::spatial {
+
+namespace {
+// Shared traversal stack so queries don't allocate. Each traversal only works above the depth it
+// started at, so a query issued from inside another query's callback stays correct.
+thread_local std::vector<int32_t> tls_traversal_stack;
+
+// Leaves whose fat box exceeds the tight box by more than this many margins are reinserted, so boxes
+// shrink back after an object slows down or gets smaller
+constexpr float MAX_FAT_MARGIN_MULTIPLE = 4.0F;
+} // namespace
+
+template<typename NodeTest, typename LeafVisitor>
+void DynamicAabbTree::Traverse(const uint32_t layer_mask, NodeTest&& node_test, LeafVisitor&& visit_leaf) const {
+	if (root_ == NULL_NODE) {
+		return;
+	}
+
+	auto& stack = tls_traversal_stack;
+	const size_t base = stack.size();
+	stack.push_back(root_);
+	while (stack.size() > base) {
+		const Node& node = nodes_[stack.back()];
+		stack.pop_back();
+
+		if ((node.layers & layer_mask) == 0 || !node_test(node.fat_bounds)) {
+			continue;
+		}
+		if (node.IsLeaf()) {
+			visit_leaf(node);
+		}
+		else {
+			stack.push_back(node.child1);
+			stack.push_back(node.child2);
+		}
+	}
+}
+
+bool DynamicAabbTree::Update(const Id id, const Aabb& bounds, const uint32_t layer) {
+	if (const auto it = leaves_.find(id); it != leaves_.end()) {
+		const int32_t leaf = it->second;
+		Node& node = nodes_[leaf];
+		node.tight_bounds = bounds;
+		const bool layer_changed = node.layers != layer;
+		node.layers = layer;
+
+		// Still inside a reasonably snug fat box: only the leaf (and layer bits above it) change
+		if (node.fat_bounds.Contains(bounds)
+			&& bounds.Expanded(FAT_MARGIN * MAX_FAT_MARGIN_MULTIPLE).Contains(node.fat_bounds)) {
+			if (layer_changed) {
+				RefitAncestors(node.parent);
+			}
+			return false;
+		}
+
+		RemoveLeaf(leaf);
+		nodes_[leaf].fat_bounds = bounds.Expanded(FAT_MARGIN);
+		InsertLeaf(leaf);
+		return true;
+	}
+
+	const int32_t leaf = AllocateNode();
+	Node& node = nodes_[leaf];
+	node.id = id;
+	node.tight_bounds = bounds;
+	node.fat_bounds = bounds.Expanded(FAT_MARGIN);
+	node.layers = layer;
+	leaves_.emplace(id, leaf);
+	InsertLeaf(leaf);
+	return true;
+}
+
+bool DynamicAabbTree::Remove(const Id id) {
+	const auto it = leaves_.find(id);
+	if (it == leaves_.end()) {
+		return false;
+	}
+	const int32_t leaf = it->second;
+	leaves_.erase(it);
+	RemoveLeaf(leaf);
+	FreeNode(leaf);
+	return true;
+}
+
+void DynamicAabbTree::Clear() {
+	nodes_.clear();
+	leaves_.clear();
+	root_ = NULL_NODE;
+	free_list_ = NULL_NODE;
+}
+
+int32_t DynamicAabbTree::Height() const { return root_ == NULL_NODE ? 0 : nodes_[root_].height + 1; }
+
+const Aabb* DynamicAabbTree::GetBounds(const Id id) const {
+	const auto it = leaves_.find(id);
+	return it != leaves_.end() ? &nodes_[it->second].tight_bounds : nullptr;
+}
+
+// === QUERIES ===
+
+void DynamicAabbTree::QueryPoint(const glm::vec3& point, const uint32_t layer_mask, std::vector<Id>& out) const {
+	Traverse(
+		layer_mask,
+		[&point](const Aabb& fat_bounds) { return fat_bounds.Contains(point); },
+		[&point, &out](const Node& leaf) {
+			if (leaf.tight_bounds.Contains(point)) {
+				out.push_back(leaf.id);
+			}
+		}
+	);
+}
+
+void DynamicAabbTree::QueryAabb(const Aabb& bounds, const uint32_t layer_mask, std::vector<Id>& out) const {
+	Traverse(
+		layer_mask,
+		[&bounds](const Aabb& fat_bounds) { return fat_bounds.Intersects(bounds); },
+		[&bounds, &out](const Node& leaf) {
+			if (leaf.tight_bounds.Intersects(bounds)) {
+				out.push_back(leaf.id);
+			}
+		}
+	);
+}
+
+void DynamicAabbTree::QuerySphere(
+	const glm::vec3& center,
+	const float radius,
+	const uint32_t layer_mask,
+	std::vector<Id>& out
+) const {
+	Traverse(
+		layer_mask,
+		[&center, radius](const Aabb& fat_bounds) { return fat_bounds.IntersectsSphere(center, radius); },
+		[&center, radius, &out](const Node& leaf) {
+			if (leaf.tight_bounds.IntersectsSphere(center, radius)) {
+				out.push_back(leaf.id);
+			}
+		}
+	);
+}
+
+void DynamicAabbTree::QueryRay(const Ray& ray, const uint32_t layer_mask, std::vector<RayHit>& out) const {
+	const glm::vec3 inverse_direction = 1.0F / ray.direction;
+	const size_t first_hit = out.size();
+
+	Traverse(
+		layer_mask,
+		[&ray, &inverse_direction](const Aabb& fat_bounds) {
+			float entry_distance = 0.0F;
+			return fat_bounds.IntersectsRay(ray.origin, inverse_direction, ray.max_distance, entry_distance);
+		},
+		[&ray, &inverse_direction, &out](const Node& leaf) {
+			if (float entry_distance = 0.0F;
+				leaf.tight_bounds.IntersectsRay(ray.origin, inverse_direction, ray.max_distance, entry_distance)) {
+				out.push_back({.id = leaf.id, .distance = entry_distance});
+			}
+		}
+	);
+
+	std::sort(out.begin() + static_cast<std::ptrdiff_t>(first_hit), out.end(), [](const RayHit& a, const RayHit& b) {
+		return a.distance < b.distance;
+	});
+}
+
+void DynamicAabbTree::QueryFrustum(const Frustum& frustum, const uint32_t layer_mask, std::vector<Id>& out) const {
+	Traverse(
+		layer_mask,
+		[&frustum](const Aabb& fat_bounds) { return frustum.Intersects(fat_bounds); },
+		[&frustum, &out](const Node& leaf) {
+			if (frustum.Intersects(leaf.tight_bounds)) {
+				out.push_back(leaf.id);
+			}
+		}
+	);
+}
+
+// === TREE MAINTENANCE ===
+
+int32_t DynamicAabbTree::AllocateNode() {
+	if (free_list_ == NULL_NODE) {
+		nodes_.emplace_back();
+		return static_cast<int32_t>(nodes_.size() - 1);
+	}
+	const int32_t index = free_list_;
+	free_list_ = nodes_[index].parent;
+	nodes_[index] = Node{};
+	return index;
+}
+
+void DynamicAabbTree::FreeNode(const int32_t index) {
+	nodes_[index] = Node{};
+	nodes_[index].parent = free_list_;
+	nodes_[index].height = -1;
+	free_list_ = index;
+}
+
+void DynamicAabbTree::InsertLeaf(const int32_t leaf) {
+	if (root_ == NULL_NODE) {
+		root_ = leaf;
+		nodes_[leaf].parent = NULL_NODE;
+		return;
+	}
+
+	// Descend towards the sibling that minimises the surface area added to the tree
+	const Aabb leaf_bounds = nodes_[leaf].fat_bounds;
+	int32_t index = root_;
+	while (!nodes_[index].IsLeaf()) {
+		const Node& node = nodes_[index];
+		const float area = node.fat_bounds.SurfaceArea();
+		const float combined_area = Aabb::Union(node.fat_bounds, leaf_bounds).SurfaceArea();
+
+		// Cost of pairing the leaf with this node, and the cost pushed down to either child
+		const float cost = 2.0F * combined_area;
+		const float inheritance_cost = 2.0F * (combined_area - area);
+		const auto descend_cost = [&](const int32_t child_index) {
+			const Node& child = nodes_[child_index];
+			const float enlarged_area = Aabb::Union(leaf_bounds, child.fat_bounds).SurfaceArea();
+			return child.IsLeaf() ? enlarged_area + inheritance_cost
+								  : enlarged_area - child.fat_bounds.SurfaceArea() + inheritance_cost;
+		};
+		const float cost1 = descend_cost(node.child1);
+		const float cost2 = descend_cost(node.child2);
+
+		if (cost < cost1 && cost < cost2) {
+			break;
+		}
+		index = cost1 < cost2 ? node.child1 : node.child2;
+	}
+
+	// Replace the sibling with a new parent holding both
+	const int32_t sibling = index;
+	const int32_t new_parent = AllocateNode();
+	const int32_t old_parent = nodes_[sibling].parent;
+
+	Node& parent_node = nodes_[new_parent];
+	parent_node.parent = old_parent;
+	parent_node.fat_bounds = Aabb::Union(leaf_bounds, nodes_[sibling].fat_bounds);
+	parent_node.height = nodes_[sibling].height + 1;
+	parent_node.layers = nodes_[leaf].layers | nodes_[sibling].layers;
+	parent_node.child1 = sibling;
+	parent_node.child2 = leaf;
+
+	if (old_parent != NULL_NODE) {
+		if (nodes_[old_parent].child1 == sibling) {
+			nodes_[old_parent].child1 = new_parent;
+		}
+		else {
+			nodes_[old_parent].child2 = new_parent;
+		}
+	}
+	else {
+		root_ = new_parent;
+	}
+	nodes_[sibling].parent = new_parent;
+	nodes_[leaf].parent = new_parent;
+
+	RefitAncestors(new_parent);
+}
+
+void DynamicAabbTree::RemoveLeaf(const int32_t leaf) {
+	if (leaf == root_) {
+		root_ = NULL_NODE;
+		return;
+	}
+
+	const int32_t parent = nodes_[leaf].parent;
+	const int32_t grand_parent = nodes_[parent].parent;
+	const int32_t sibling = nodes_[parent].child1 == leaf ? nodes_[parent].child2 : nodes_[parent].child1;
+
+	// The sibling takes the parent's place
+	if (grand_parent != NULL_NODE) {
+		if (nodes_[grand_parent].child1 == parent) {
+			nodes_[grand_parent].child1 = sibling;
+		}
+		else {
+			nodes_[grand_parent].child2 = sibling;
+		}
+		nodes_[sibling].parent = grand_parent;
+		FreeNode(parent);
+		RefitAncestors(grand_parent);
+	}
+	else {
+		root_ = sibling;
+		nodes_[sibling].parent = NULL_NODE;
+		FreeNode(parent);
+	}
+	nodes_[leaf].parent = NULL_NODE;
+}
+
+void DynamicAabbTree::RefitAncestors(int32_t index) {
+	while (index != NULL_NODE) {
+		index = Balance(index);
+
+		Node& node = nodes_[index];
+		const Node& child1 = nodes_[node.child1];
+		const Node& child2 = nodes_[node.child2];
+		node.height = 1 + std::max(child1.height, child2.height);
+		node.fat_bounds = Aabb::Union(child1.fat_bounds, child2.fat_bounds);
+		node.layers = child1.layers | child2.layers;
+
+		index = node.parent;
+	}
+}
+
+// Rotate the taller grandchild up when the subtree rooted at index is imbalanced. Returns the index
+// of the subtree's new root.
+int32_t DynamicAabbTree::Balance(const int32_t index) {
+	Node& a = nodes_[index];
+	if (a.IsLeaf() || a.height < 2) {
+		return index;
+	}
+
+	const int32_t index_b = a.child1;
+	const int32_t index_c = a.child2;
+	Node& b = nodes_[index_b];
+	Node& c = nodes_[index_c];
+	const int32_t balance = c.height - b.height;
+
+	// Returns the replacement for a under its parent (or as the root)
+	const auto promote = [this, index, &a](const int32_t promoted_index, Node& promoted) {
+		promoted.child1 = index;
+		promoted.parent = a.parent;
+		a.parent = promoted_index;
+		if (promoted.parent != NULL_NODE) {
+			Node& parent = nodes_[promoted.parent];
+			if (parent.child1 == index) {
+				parent.child1 = promoted_index;
+			}
+			else {
+				parent.child2 = promoted_index;
+			}
+		}
+		else {
+			root_ = promoted_index;
+		}
+	};
+
+	// Rotate c up
+	if (balance > 1) {
+		const int32_t index_f = c.child1;
+		const int32_t index_g = c.child2;
+		Node& f = nodes_[index_f];
+		Node& g = nodes_[index_g];
+		promote(index_c, c);
+
+		// c keeps its taller child; a adopts the shorter one
+		const bool keep_f = f.height > g.height;
+		const int32_t kept_index = keep_f ? index_f : index_g;
+		const int32_t moved_index = keep_f ? index_g : index_f;
+		Node& kept = nodes_[kept_index];
+		Node& moved = nodes_[moved_index];
+
+		c.child2 = kept_index;
+		a.child2 = moved_index;
+		moved.parent = index;
+		a.fat_bounds = Aabb::Union(b.fat_bounds, moved.fat_bounds);
+		c.fat_bounds = Aabb::Union(a.fat_bounds, kept.fat_bounds);
+		a.layers = b.layers | moved.layers;
+		c.layers = a.layers | kept.layers;
+		a.height = 1 + std::max(b.height, moved.height);
+		c.height = 1 + std::max(a.height, kept.height);
+		return index_c;
+	}
+
+	// Rotate b up
+	if (balance < -1) {
+		const int32_t index_d = b.child1;
+		const int32_t index_e = b.child2;
+		Node& d = nodes_[index_d];
+		Node& e = nodes_[index_e];
+		promote(index_b, b);
+
+		const bool keep_d = d.height > e.height;
+		const int32_t kept_index = keep_d ? index_d : index_e;
+		const int32_t moved_index = keep_d ? index_e : index_d;
+		Node& kept = nodes_[kept_index];
+		Node& moved = nodes_[moved_index];
+
+		b.child2 = kept_index;
+		a.child1 = moved_index;
+		moved.parent = index;
+		a.fat_bounds = Aabb::Union(c.fat_bounds, moved.fat_bounds);
+		b.fat_bounds = Aabb::Union(a.fat_bounds, kept.fat_bounds);
+		a.layers = c.layers | moved.layers;
+		b.layers = a.layers | kept.layers;
+		a.height = 1 + std::max(c.height, moved.height);
+		b.height = 1 + std::max(a.height, kept.height);
+		return index_b;
+	}
+
+	return index;
+}
+
+} // namespace engine::spatial
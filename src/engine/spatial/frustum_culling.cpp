@@ -0,0 +1,88 @@
+// Batched frustum culling
+module;
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define SPATIAL_CULL_SSE 1
+#include <xmmintrin.h>
+#endif
+
+module engine.spatial;
+
+import glm;
+
+namespace engine::spatial {
+
+namespace {
+// Coordinate arrays of the box corner furthest along one plane's normal. The normal's signs are the same for
+// every box, so the corner is picked once per plane instead of once per box and plane.
+struct PlaneCorners {
+	const float* x;
+	const float* y;
+	const float* z;
+};
+
+std::array<PlaneCorners, 6> PositiveCorners(const Frustum& frustum, const AabbBatch& boxes) {
+	std::array<PlaneCorners, 6> corners{};
+	for (size_t i = 0; i < corners.size(); ++i) {
+		const glm::vec4& plane = frustum.planes[i];
+		corners[i] = {
+			.x = plane.x >= 0.0F ? boxes.max_x.data() : boxes.min_x.data(),
+			.y = plane.y >= 0.0F ? boxes.max_y.data() : boxes.min_y.data(),
+			.z = plane.z >= 0.0F ? boxes.max_z.data() : boxes.min_z.data()
+		};
+	}
+	return corners;
+}
+} // namespace
+
+void CullAabbs(const Frustum& frustum, const AabbBatch& boxes, std::vector<uint32_t>& visible) {
+	const size_t count = boxes.Size();
+	const std::array<PlaneCorners, 6> corners = PositiveCorners(frustum, boxes);
+	size_t index = 0;
+
+#ifdef SPATIAL_CULL_SSE
+	constexpr size_t LANES = 4;
+	const __m128 zero = _mm_setzero_ps();
+	for (; index + LANES <= count; index += LANES) {
+		__m128 inside = _mm_cmpeq_ps(zero, zero);
+		for (size_t i = 0; i < corners.size(); ++i) {
+			const glm::vec4& plane = frustum.planes[i];
+			const __m128 dot = _mm_add_ps(
+				_mm_add_ps(
+					_mm_mul_ps(_mm_set1_ps(plane.x), _mm_loadu_ps(corners[i].x + index)),
+					_mm_mul_ps(_mm_set1_ps(plane.y), _mm_loadu_ps(corners[i].y + index))
+				),
+				_mm_mul_ps(_mm_set1_ps(plane.z), _mm_loadu_ps(corners[i].z + index))
+			);
+			inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(dot, _mm_set1_ps(plane.w)), zero));
+		}
+
+		// One bit per box, lowest lane first
+		const int mask = _mm_movemask_ps(inside);
+		for (size_t lane = 0; lane < LANES; ++lane) {
+			if ((mask & (1 << lane)) != 0) {
+				visible.push_back(static_cast<uint32_t>(index + lane));
+			}
+		}
+	}
+#endif
+
+	// Remainder (or every box without SSE); same plane test, one box at a time
+	for (; index < count; ++index) {
+		bool inside = true;
+		for (size_t i = 0; i < corners.size() && inside; ++i) {
+			const glm::vec4& plane = frustum.planes[i];
+			const glm::vec3 corner(corners[i].x[index], corners[i].y[index], corners[i].z[index]);
+			inside = glm::dot(glm::vec3(plane), corner) + plane.w >= 0.0F;
+		}
+		if (inside) {
+			visible.push_back(static_cast<uint32_t>(index));
+		}
+	}
+}
+
+} // namespace engine::spatial
@@ -0,0 +1,306 @@
+module;
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+export module engine.spatial;
+
+import glm;
+
+export namespace engine::spatial {
+
+// Layer mask matching every layer
+constexpr uint32_t ALL_LAYERS = 0xFFFFFFFF;
+
+// Ray for spatial queries. Direction is expected to be normalized so hit distances are in world units.
+struct Ray {
+	glm::vec3 origin{0.0F};
+	glm::vec3 direction{0.0F, 0.0F, -1.0F};
+	float max_distance = std::numeric_limits<float>::max();
+};
+
+// Axis-aligned bounding box
+struct Aabb {
+	glm::vec3 min{0.0F};
+	glm::vec3 max{0.0F};
+
+	static Aabb FromCenterExtents(const glm::vec3& center, const glm::vec3& extents) {
+		return {.min = center - extents, .max = center + extents};
+	}
+
+	static Aabb Union(const Aabb& a, const Aabb& b) {
+		return {.min = glm::min(a.min, b.min), .max = glm::max(a.max, b.max)};
+	}
+
+	[[nodiscard]] glm::vec3 Center() const { return (min + max) * 0.5F; }
+
+	[[nodiscard]] glm::vec3 Extents() const { return (max - min) * 0.5F; }
+
+	[[nodiscard]] float SurfaceArea() const {
+		const glm::vec3 size = max - min;
+		return 2.0F * (size.x * size.y + size.y * size.z + size.z * size.x);
+	}
+
+	[[nodiscard]] Aabb Expanded(const float margin) const { return {.min = min - margin, .max = max + margin}; }
+
+	[[nodiscard]] bool Contains(const glm::vec3& point) const {
+		return point.x >= min.x
+			   && point.x <= max.x
+			   && point.y >= min.y
+			   && point.y <= max.y
+			   && point.z >= min.z
+			   && point.z <= max.z;
+	}
+
+	[[nodiscard]] bool Contains(const Aabb& other) const {
+		return other.min.x >= min.x
+			   && other.max.x <= max.x
+			   && other.min.y >= min.y
+			   && other.max.y <= max.y
+			   && other.min.z >= min.z
+			   && other.max.z <= max.z;
+	}
+
+	[[nodiscard]] bool Intersects(const Aabb& other) const {
+		return min.x <= other.max.x
+			   && max.x >= other.min.x
+			   && min.y <= other.max.y
+			   && max.y >= other.min.y
+			   && min.z <= other.max.z
+			   && max.z >= other.min.z;
+	}
+
+	[[nodiscard]] bool IntersectsSphere(const glm::vec3& center, const float radius) const {
+		const glm::vec3 offset = glm::clamp(center, min, max) - center;
+		return glm::dot(offset, offset) <= radius * radius;
+	}
+
+	// Slab test against a ray given its precomputed reciprocal direction. On a hit, entry_distance is
+	// the distance to the box (0 when the origin is inside).
+	[[nodiscard]] bool IntersectsRay(
+		const glm::vec3& origin,
+		const glm::vec3& inverse_direction,
+		const float max_distance,
+		float& entry_distance
+	) const {
+		const glm::vec3 t0 = (min - origin) * inverse_direction;
+		const glm::vec3 t1 = (max - origin) * inverse_direction;
+		const glm::vec3 t_near = glm::min(t0, t1);
+		const glm::vec3 t_far = glm::max(t0, t1);
+		const float enter = glm::max(glm::max(t_near.x, t_near.y), glm::max(t_near.z, 0.0F));
+		const float exit = glm::min(glm::min(t_far.x, t_far.y), glm::min(t_far.z, max_distance));
+		if (enter > exit) {
+			return false;
+		}
+		entry_distance = enter;
+		return true;
+	}
+
+	// World-space box enclosing this box after an affine transform (Arvo's method)
+	[[nodiscard]] Aabb Transformed(const glm::mat4& matrix) const {
+		const glm::vec3 center = glm::vec3(matrix * glm::vec4(Center(), 1.0F));
+		const glm::vec3 extents = Extents();
+		const glm::mat3 abs_basis(
+			glm::abs(glm::vec3(matrix[0])),
+			glm::abs(glm::vec3(matrix[1])),
+			glm::abs(glm::vec3(matrix[2]))
+		);
+		return FromCenterExtents(center, abs_basis * extents);
+	}
+};
+
+// View frustum as six inward-facing planes (xyz = normal, w = distance); a point p is inside a plane
+// when dot(normal, p) + w >= 0
+struct Frustum {
+	enum Plane : uint8_t { Left, Right, Bottom, Top, Near, Far };
+
+	std::array<glm::vec4, 6> planes{};
+
+	// Extract planes from a view-projection matrix using OpenGL clip space (-w <= z <= w)
+	static Frustum FromMatrix(const glm::mat4& view_projection) {
+		// glm is column-major, so row i of the matrix is (m[0][i], m[1][i], m[2][i], m[3][i])
+		const auto row = [&view_projection](const int i) {
+			return glm::vec4(view_projection[0][i], view_projection[1][i], view_projection[2][i], view_projection[3][i]);
+		};
+		const glm::vec4 row_x = row(0);
+		const glm::vec4 row_y = row(1);
+		const glm::vec4 row_z = row(2);
+		const glm::vec4 row_w = row(3);
+
+		Frustum frustum;
+		frustum.planes[Left] = row_w + row_x;
+		frustum.planes[Right] = row_w - row_x;
+		frustum.planes[Bottom] = row_w + row_y;
+		frustum.planes[Top] = row_w - row_y;
+		frustum.planes[Near] = row_w + row_z;
+		frustum.planes[Far] = row_w - row_z;
+		for (auto& plane : frustum.planes) {
+			plane /= glm::length(glm::vec3(plane));
+		}
+		return frustum;
+	}
+
+	[[nodiscard]] bool Contains(const glm::vec3& point) const {
+		for (const auto& plane : planes) {
+			if (glm::dot(glm::vec3(plane), point) + plane.w < 0.0F) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	[[nodiscard]] bool IntersectsSphere(const glm::vec3& center, const float radius) const {
+		for (const auto& plane : planes) {
+			if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Conservative test: may report boxes near frustum corners as visible, never rejects a visible box
+	[[nodiscard]] bool Intersects(const Aabb& box) const {
+		for (const auto& plane : planes) {
+			// Test the box corner furthest along the plane normal
+			const glm::vec3 normal(plane);
+			const glm::vec3 positive(
+				normal.x >= 0.0F ? box.max.x : box.min.x,
+				normal.y >= 0.0F ? box.max.y : box.min.y,
+				normal.z >= 0.0F ? box.max.z : box.min.z
+			);
+			if (glm::dot(normal, positive) + plane.w < 0.0F) {
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+// Boxes stored one coordinate array per axis, so a culler can test several boxes per instruction
+struct AabbBatch {
+	std::vector<float> min_x;
+	std::vector<float> min_y;
+	std::vector<float> min_z;
+	std::vector<float> max_x;
+	std::vector<float> max_y;
+	std::vector<float> max_z;
+
+	void Push(const Aabb& box) {
+		min_x.push_back(box.min.x);
+		min_y.push_back(box.min.y);
+		min_z.push_back(box.min.z);
+		max_x.push_back(box.max.x);
+		max_y.push_back(box.max.y);
+		max_z.push_back(box.max.z);
+	}
+
+	void Clear() {
+		min_x.clear();
+		min_y.clear();
+		min_z.clear();
+		max_x.clear();
+		max_y.clear();
+		max_z.clear();
+	}
+
+	[[nodiscard]] size_t Size() const { return min_x.size(); }
+};
+
+// Append the index of every box in the batch that Frustum::Intersects would accept, in ascending order. Boxes
+// are tested four at a time with SSE where the target has it.
+void CullAabbs(const Frustum& frustum, const AabbBatch& boxes, std::vector<uint32_t>& visible);
+
+/**
+ * @brief Dynamic bounding volume hierarchy over axis-aligned boxes
+ *
+ * Leaves are stored with a "fat" box enlarged by FAT_MARGIN, so objects moving a little only refit
+ * their leaf; the tree is restructured only when an object leaves its fat box. Insertion uses the
+ * surface area heuristic and AVL-style rotations keep the tree balanced.
+ *
+ * Every node records the union of its subtree's layer bits, so layer-masked queries skip whole
+ * subtrees. Queries are const and safe to run concurrently from multiple threads as long as no
+ * thread is updating the tree.
+ */
+class DynamicAabbTree {
+public:
+	using Id = uint64_t;
+
+	struct RayHit {
+		Id id = 0;
+		float distance = 0.0F;
+	};
+
+	// Enlargement applied to leaf boxes
+	static constexpr float FAT_MARGIN = 0.1F;
+
+	// Insert an object or update its bounds/layer. Returns true if the tree was restructured.
+	bool Update(Id id, const Aabb& bounds, uint32_t layer = ALL_LAYERS);
+
+	// Remove an object. Returns false if it was not in the tree.
+	bool Remove(Id id);
+
+	void Clear();
+
+	[[nodiscard]] bool Contains(Id id) const { return leaves_.contains(id); }
+
+	[[nodiscard]] size_t Size() const { return leaves_.size(); }
+
+	// Height of the tree (0 when empty, 1 for a single leaf)
+	[[nodiscard]] int32_t Height() const;
+
+	// Tight bounds last given to Update(), or nullptr if the object is not in the tree
+	[[nodiscard]] const Aabb* GetBounds(Id id) const;
+
+	// === QUERIES ===
+	// Results are appended to out (callers can reuse the vector to avoid allocating per query)
+
+	void QueryPoint(const glm::vec3& point, uint32_t layer_mask, std::vector<Id>& out) const;
+
+	void QueryAabb(const Aabb& bounds, uint32_t layer_mask, std::vector<Id>& out) const;
+
+	// Objects whose bounds intersect the sphere
+	void QuerySphere(const glm::vec3& center, float radius, uint32_t layer_mask, std::vector<Id>& out) const;
+
+	// Objects whose bounds the ray enters within max_distance, nearest first
+	void QueryRay(const Ray& ray, uint32_t layer_mask, std::vector<RayHit>& out) const;
+
+	void QueryFrustum(const Frustum& frustum, uint32_t layer_mask, std::vector<Id>& out) const;
+
+private:
+	static constexpr int32_t NULL_NODE = -1;
+
+	struct Node {
+		Aabb fat_bounds;   // Leaves: enlarged bounds; internal nodes: union of children
+		Aabb tight_bounds; // Leaves only: exact bounds used for query results
+		Id id = 0;
+		int32_t parent = NULL_NODE; // Doubles as the next-free link for pooled nodes
+		int32_t child1 = NULL_NODE;
+		int32_t child2 = NULL_NODE;
+		int32_t height = 0; // Leaf = 0, free node = -1
+		uint32_t layers = 0;
+
+		[[nodiscard]] bool IsLeaf() const { return child1 == NULL_NODE; }
+	};
+
+	// Depth-first walk visiting leaves whose fat bounds pass node_test and whose layers match
+	template<typename NodeTest, typename LeafVisitor>
+	void Traverse(uint32_t layer_mask, NodeTest&& node_test, LeafVisitor&& visit_leaf) const;
+
+	int32_t AllocateNode();
+	void FreeNode(int32_t index);
+	void InsertLeaf(int32_t leaf);
+	void RemoveLeaf(int32_t leaf);
+	int32_t Balance(int32_t index);
+	void RefitAncestors(int32_t index);
+
+	std::vector<Node> nodes_;
+	int32_t root_ = NULL_NODE;
+	int32_t free_list_ = NULL_NODE;
+	std::unordered_map<Id, int32_t> leaves_;
+};
+
+} // namespace engine::spatial
@@ -1,11 +1,13 @@
 module;
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdint>
 #include <memory>
 #include <numbers>
 #include <optional>
+#include <span>
 #include <spdlog/spdlog.h>
 #include <string>
 #include <unordered_map>
@@ -28,6 +30,27 @@ constexpr float PI = std::numbers::pi_v<float>;
 constexpr float MIN_LINE_LENGTH = 0.001F; // Minimum line length to avoid degenerate geometry
 constexpr float MIN_CORNER_RADIUS = 0.1F; // Minimum corner radius for rounded rectangles
 
+namespace {
+// Point the VAO's vertex attributes at a flush's vertices, base bytes into the bound vertex buffer. Each flush's
+// indices start from its own first vertex, so the attributes move with the data instead of the indices.
+void SetVertexAttributes(const size_t base) {
+	const auto attribute = [base](const GLuint location, const GLint size, const size_t offset) {
+		glVertexAttribPointer(
+			location,
+			size,
+			GL_FLOAT,
+			GL_FALSE,
+			sizeof(Vertex),
+			reinterpret_cast<const void*>(base + offset)
+		);
+	};
+	attribute(0, 2, offsetof(Vertex, x));         // Position (x, y)
+	attribute(1, 2, offsetof(Vertex, u));         // TexCoord (u, v)
+	attribute(2, 4, offsetof(Vertex, r));         // Color (vec4)
+	attribute(3, 1, offsetof(Vertex, tex_index)); // TexIndex (float)
+}
+} // namespace
+
 struct BatchRenderer::BatchState {
 	// Current batch buffers
 	std::vector<Vertex> vertices;
@@ -38,6 +61,12 @@ struct BatchRenderer::BatchState {
 	std::vector<ScissorRect> scissor_stack;
 	ScissorRect current_scissor;
 
+	// Retained geometry being recorded, innermost last, and how much of the pending batch they already hold
+	std::vector<RetainedGeometry*> recordings;
+	size_t recorded_vertices = 0;
+	size_t recorded_indices = 0;
+	uint64_t retained_generation = 1;
+
 	// Stats
 	size_t draw_call_count = 0;
 	bool initialized = false;
@@ -49,8 +78,8 @@ struct BatchRenderer::BatchState {
 	// Rendering resources
 	rendering::ShaderId ui_shader = 0;
 	GLuint vao = 0;
-	GLuint vbo = 0;
-	GLuint ebo = 0;
+	rendering::StreamBuffer vertex_stream{rendering::StreamBufferTarget::Vertex};
+	rendering::StreamBuffer index_stream{rendering::StreamBufferTarget::Index};
 	glm::mat4 projection{};
 
 	// Screen dimensions
@@ -103,45 +132,25 @@ void BatchRenderer::Initialize() {
 			spdlog::info("[BatchRenderer] White texture created (ID: {})", state_->white_texture_id);
 		}
 
-		// Create OpenGL vertex array and buffers
-		glGenVertexArrays(1, &state_->vao);
-		glGenBuffers(1, &state_->vbo);
-		glGenBuffers(1, &state_->ebo);
-
-		glBindVertexArray(state_->vao);
-
-		// Allocate buffers
-		glBindBuffer(GL_ARRAY_BUFFER, state_->vbo);
-		glBufferData(GL_ARRAY_BUFFER, INITIAL_VERTEX_CAPACITY * sizeof(Vertex), nullptr, GL_DYNAMIC_DRAW);
-
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, state_->ebo);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, INITIAL_INDEX_CAPACITY * sizeof(uint32_t), nullptr, GL_DYNAMIC_DRAW);
-
-		// Setup vertex attributes
-		// Position (x, y)
-		glEnableVertexAttribArray(0);
-		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, x)));
-
-		// TexCoord (u, v)
-		glEnableVertexAttribArray(1);
-		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, u)));
+		// Headless runs still batch vertices (benchmarks, tests) but have no GL objects to create
+		if (rendering::IsHeadless()) {
+			state_->initialized = true;
+			return;
+		}
 
-		// Color (vec4)
-		glEnableVertexAttribArray(2);
-		glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, r)));
+		// Create the vertex array and its streaming buffers; each flush appends to the streams rather than
+		// overwriting data earlier draws in the frame may still be reading
+		glGenVertexArrays(1, &state_->vao);
+		rendering::GetGLStateCache().BindVertexArray(state_->vao);
+		state_->index_stream.Create(INITIAL_INDEX_CAPACITY * sizeof(uint32_t));
+		state_->vertex_stream.Create(INITIAL_VERTEX_CAPACITY * sizeof(Vertex));
 
-		// TexIndex (float)
-		glEnableVertexAttribArray(3);
-		glVertexAttribPointer(
-			3,
-			1,
-			GL_FLOAT,
-			GL_FALSE,
-			sizeof(Vertex),
-			reinterpret_cast<void*>(offsetof(Vertex, tex_index))
-		);
+		for (GLuint location = 0; location < 4; ++location) {
+			glEnableVertexAttribArray(location);
+		}
+		SetVertexAttributes(0);
 
-		glBindVertexArray(0);
+		rendering::GetGLStateCache().BindVertexArray(0);
 
 		// Check for GL errors during initialization
 		GLenum const err = glGetError();
@@ -158,13 +167,10 @@ void BatchRenderer::Shutdown() {
 		// Clean up OpenGL resources
 		if (state_->vao != 0) {
 			glDeleteVertexArrays(1, &state_->vao);
+			rendering::GetGLStateCache().Invalidate();
 		}
-		if (state_->vbo != 0) {
-			glDeleteBuffers(1, &state_->vbo);
-		}
-		if (state_->ebo != 0) {
-			glDeleteBuffers(1, &state_->ebo);
-		}
+		state_->vertex_stream.Destroy();
+		state_->index_stream.Destroy();
 
 		// Clean up texture
 		if (state_->white_texture_id != 0) {
@@ -186,8 +192,13 @@ void BatchRenderer::BeginFrame() {
 	state_->indices.clear();
 	state_->texture_slots.clear();
 	state_->scissor_stack.clear();
+	state_->recordings.clear();
+	state_->recorded_vertices = 0;
+	state_->recorded_indices = 0;
 	state_->draw_call_count = 0;
 	state_->in_frame = true;
+	text_renderer::FontManager::BeginFrame();
+	text_renderer::TextLayout::BeginFrame();
 
 	// Get current screen dimensions from renderer
 	auto& renderer = rendering::GetRenderer();
@@ -231,6 +242,11 @@ void BatchRenderer::PushScissor(const ScissorRect& scissor) {
 		return;
 	}
 
+	CaptureRetained();
+	for (RetainedGeometry* geometry : state_->recordings) {
+		geometry->ops.push_back({.kind = RetainedGeometry::Op::Kind::PushScissor, .scissor = scissor});
+	}
+
 	// Intersect with current scissor
 	ScissorRect const new_scissor = state_->current_scissor.Intersect(scissor);
 
@@ -248,6 +264,11 @@ void BatchRenderer::PopScissor() {
 		return;
 	}
 
+	CaptureRetained();
+	for (RetainedGeometry* geometry : state_->recordings) {
+		geometry->ops.push_back({.kind = RetainedGeometry::Op::Kind::PopScissor});
+	}
+
 	ScissorRect const previous = state_->scissor_stack.back();
 	state_->scissor_stack.pop_back();
 
@@ -270,7 +291,26 @@ void BatchRenderer::SubmitQuad(
 	const Rectangle& rect,
 	const Color& color,
 	const std::optional<Rectangle>& uv_coords,
-	uint32_t texture_id
+	const uint32_t texture_id
+) {
+	SubmitTexturedQuad(rect, color, uv_coords, texture_id, 0);
+}
+
+void BatchRenderer::SubmitSdfQuad(
+	const Rectangle& rect,
+	const Color& color,
+	const Rectangle& uv_coords,
+	const uint32_t texture_id
+) {
+	SubmitTexturedQuad(rect, color, uv_coords, texture_id, SDF_TEXTURE_INDEX_OFFSET);
+}
+
+void BatchRenderer::SubmitTexturedQuad(
+	const Rectangle& rect,
+	const Color& color,
+	const std::optional<Rectangle>& uv_coords,
+	uint32_t texture_id,
+	const int tex_index_offset
 ) {
 	if (!state_) {
 		return;
@@ -309,7 +349,7 @@ void BatchRenderer::SubmitQuad(
 	const float x1 = rect.x + rect.width;
 	const float y1 = rect.y;
 
-	const auto tex_slot_f = static_cast<float>(tex_slot);
+	const auto tex_slot_f = static_cast<float>(tex_slot + tex_index_offset);
 
 	// clang-format off
 	PushQuadVertices(
@@ -539,21 +579,25 @@ void BatchRenderer::SubmitText(
 	options.h_align = text_renderer::HorizontalAlign::Left;
 	options.v_align = text_renderer::VerticalAlign::Top;
 	options.max_width = 0.0F; // No wrapping
+	options.font_size = static_cast<float>(std::max(font_size, 0));
 
-	auto glyphs = text_renderer::TextLayout::Layout(text, *font, options);
+	const auto layout = text_renderer::TextLayout::LayoutCached(text, *font, options);
 
-	// Submit each glyph as a textured quad
-	uint32_t const texture_id = font->GetTextureId();
-
-	for (const auto& pg : glyphs) {
-		if (pg.metrics->size.x == 0 || pg.metrics->size.y == 0) {
+	// Submit each glyph as a textured quad from its atlas page
+	for (const auto& pg : layout->glyphs) {
+		if (pg.size.x == 0 || pg.size.y == 0) {
 			continue; // Skip empty glyphs (like space)
 		}
 
-		Rectangle const screen_rect(x + pg.position.x, y + pg.position.y, pg.metrics->size.x, pg.metrics->size.y);
+		Rectangle const screen_rect(x + pg.position.x, y + pg.position.y, pg.size.x, pg.size.y);
 
 		// Submit quad with glyph's UV coordinates
-		SubmitQuad(screen_rect, color, pg.metrics->atlas_rect, texture_id);
+		if (font->IsSdf()) {
+			SubmitSdfQuad(screen_rect, color, pg.metrics->atlas_rect, pg.metrics->texture_id);
+		}
+		else {
+			SubmitQuad(screen_rect, color, pg.metrics->atlas_rect, pg.metrics->texture_id);
+		}
 	}
 }
 
@@ -590,30 +634,118 @@ void BatchRenderer::SubmitTextRect(
 	options.h_align = text_renderer::HorizontalAlign::Left;
 	options.v_align = text_renderer::VerticalAlign::Top;
 	options.max_width = rect.width; // Enable wrapping
+	options.font_size = static_cast<float>(std::max(font_size, 0));
 
-	auto glyphs = text_renderer::TextLayout::Layout(text, *font, options);
+	const auto layout = text_renderer::TextLayout::LayoutCached(text, *font, options);
 
 	// Push scissor for clipping
 	PushScissor(ScissorRect(rect.x, rect.y, rect.width, rect.height));
 
-	// Submit each glyph as a textured quad
-	uint32_t const texture_id = font->GetTextureId();
-
-	for (const auto& pg : glyphs) {
-		if (pg.metrics->size.x == 0 || pg.metrics->size.y == 0) {
+	// Submit each glyph as a textured quad from its atlas page
+	for (const auto& pg : layout->glyphs) {
+		if (pg.size.x == 0 || pg.size.y == 0) {
 			continue; // Skip empty glyphs
 		}
 
-		Rectangle const screen_rect(rect.x + pg.position.x, rect.y + pg.position.y, pg.metrics->size.x, pg.metrics->size.y);
+		Rectangle const screen_rect(rect.x + pg.position.x, rect.y + pg.position.y, pg.size.x, pg.size.y);
 
 		// Submit quad with glyph's UV coordinates
-		SubmitQuad(screen_rect, color, pg.metrics->atlas_rect, texture_id);
+		if (font->IsSdf()) {
+			SubmitSdfQuad(screen_rect, color, pg.metrics->atlas_rect, pg.metrics->texture_id);
+		}
+		else {
+			SubmitQuad(screen_rect, color, pg.metrics->atlas_rect, pg.metrics->texture_id);
+		}
 	}
 
 	// Pop scissor
 	PopScissor();
 }
 
+void BatchRenderer::BeginRetained(RetainedGeometry& geometry, const float origin_x, const float origin_y) {
+	if (!state_) {
+		return;
+	}
+
+	// Enclosing recordings take everything submitted so far; the new one starts from here
+	CaptureRetained();
+	state_->recorded_vertices = state_->vertices.size();
+	state_->recorded_indices = state_->indices.size();
+
+	geometry.Clear();
+	geometry.origin_x = origin_x;
+	geometry.origin_y = origin_y;
+	state_->recordings.push_back(&geometry);
+}
+
+void BatchRenderer::EndRetained() {
+	if (!state_ || state_->recordings.empty()) {
+		return;
+	}
+
+	CaptureRetained();
+	RetainedGeometry* geometry = state_->recordings.back();
+	state_->recordings.pop_back();
+	geometry->generation = state_->retained_generation;
+	geometry->valid = true;
+}
+
+void BatchRenderer::SubmitRetained(const RetainedGeometry& geometry, const float origin_x, const float origin_y) {
+	if (!state_) {
+		return;
+	}
+
+	const float dx = origin_x - geometry.origin_x;
+	const float dy = origin_y - geometry.origin_y;
+	for (const RetainedGeometry::Op& op : geometry.ops) {
+		if (op.kind == RetainedGeometry::Op::Kind::PushScissor) {
+			PushScissor(ScissorRect(op.scissor.x + dx, op.scissor.y + dy, op.scissor.width, op.scissor.height));
+			continue;
+		}
+		if (op.kind == RetainedGeometry::Op::Kind::PopScissor) {
+			PopScissor();
+			continue;
+		}
+
+		// A run came from a single batch, so its textures always fit once the batch is flushed
+		const auto textures = std::span(geometry.textures).subspan(op.first_texture, op.texture_count);
+		const auto missing = std::ranges::count_if(textures, [](const uint32_t texture_id) {
+			return !state_->texture_slots.contains(texture_id);
+		});
+		if (state_->texture_slots.size() + static_cast<size_t>(missing) > MAX_TEXTURE_SLOTS) {
+			FlushBatch();
+		}
+		std::array<float, MAX_TEXTURE_SLOTS> slots{};
+		for (size_t i = 0; i < textures.size(); ++i) {
+			slots[i] = static_cast<float>(GetOrAddTextureSlot(textures[i]));
+		}
+
+		const auto base = static_cast<uint32_t>(state_->vertices.size());
+		for (uint32_t i = 0; i < op.vertex_count; ++i) {
+			Vertex vertex = geometry.vertices[op.first_vertex + i];
+			vertex.x += dx;
+			vertex.y += dy;
+			const auto tex_index = static_cast<int>(vertex.tex_index);
+			const int local = tex_index % MAX_TEXTURE_SLOTS;
+			vertex.tex_index = static_cast<float>(tex_index - local) + slots[static_cast<size_t>(local)];
+			state_->vertices.push_back(vertex);
+		}
+		for (uint32_t i = 0; i < op.index_count; ++i) {
+			state_->indices.push_back(base + geometry.indices[op.first_index + i]);
+		}
+	}
+}
+
+bool BatchRenderer::IsRetainedValid(const RetainedGeometry& geometry) {
+	return state_ && geometry.valid && geometry.generation == state_->retained_generation;
+}
+
+void BatchRenderer::InvalidateRetained() {
+	if (state_) {
+		++state_->retained_generation;
+	}
+}
+
 void BatchRenderer::Flush() {
 	if (!state_ || state_->vertices.empty()) {
 		return;
@@ -683,6 +815,16 @@ void BatchRenderer::FlushBatch() {
 	if (!state_ || state_->vertices.empty()) {
 		return;
 	}
+	CaptureRetained();
+
+	// Glyphs rasterized while building this batch have to reach their atlas pages before it draws
+	text_renderer::FontManager::FlushUploads();
+
+	if (rendering::IsHeadless()) {
+		state_->draw_call_count++;
+		StartNewBatch();
+		return;
+	}
 
 	// Get renderer
 	auto& renderer = rendering::GetRenderer();
@@ -699,6 +841,20 @@ void BatchRenderer::FlushBatch() {
 		}
 	}
 
+	// Append this batch to the streams; the index stream is VAO state, so the VAO is bound first
+	rendering::GetGLStateCache().BindVertexArray(state_->vao);
+	const size_t vertex_offset = state_->vertex_stream.Write(
+		state_->vertices.data(),
+		state_->vertices.size() * sizeof(Vertex),
+		sizeof(float)
+	);
+	SetVertexAttributes(vertex_offset);
+	const size_t index_offset = state_->index_stream.Write(
+		state_->indices.data(),
+		state_->indices.size() * sizeof(uint32_t),
+		sizeof(uint32_t)
+	);
+
 	// Apply scissor if active
 	const bool use_scissor = state_->current_scissor.IsValid();
 
@@ -707,12 +863,7 @@ void BatchRenderer::FlushBatch() {
 	command.shader = state_->ui_shader;
 	command.projection = state_->projection;
 	command.vao = state_->vao;
-	command.vbo = state_->vbo;
-	command.ebo = state_->ebo;
-	command.vertex_data = state_->vertices.data();
-	command.vertex_data_size = state_->vertices.size() * sizeof(Vertex);
-	command.index_data = state_->indices.data();
-	command.index_data_size = state_->indices.size() * sizeof(uint32_t);
+	command.index_offset = index_offset;
 	command.index_count = state_->indices.size();
 	command.texture_ids = texture_ids;
 	command.texture_count = state_->texture_slots.size();
@@ -741,5 +892,57 @@ void BatchRenderer::StartNewBatch() {
 	state_->vertices.clear();
 	state_->indices.clear();
 	state_->texture_slots.clear();
+	state_->recorded_vertices = 0;
+	state_->recorded_indices = 0;
+}
+
+void BatchRenderer::CaptureRetained() {
+	if (state_->recordings.empty()) {
+		return;
+	}
+	const size_t vertex_end = state_->vertices.size();
+	const size_t index_end = state_->indices.size();
+	if (vertex_end == state_->recorded_vertices && index_end == state_->recorded_indices) {
+		return;
+	}
+
+	std::array<uint32_t, MAX_TEXTURE_SLOTS> slot_textures{};
+	for (const auto& [texture_id, slot] : state_->texture_slots) {
+		slot_textures[slot] = texture_id;
+	}
+
+	for (RetainedGeometry* geometry : state_->recordings) {
+		RetainedGeometry::Op op{
+			.kind = RetainedGeometry::Op::Kind::Geometry,
+			.first_vertex = static_cast<uint32_t>(geometry->vertices.size()),
+			.vertex_count = static_cast<uint32_t>(vertex_end - state_->recorded_vertices),
+			.first_index = static_cast<uint32_t>(geometry->indices.size()),
+			.index_count = static_cast<uint32_t>(index_end - state_->recorded_indices),
+			.first_texture = static_cast<uint32_t>(geometry->textures.size())
+		};
+
+		// Store texture IDs rather than slots, since a replay lands in a batch with its own slot assignment
+		std::array<int, MAX_TEXTURE_SLOTS> local_texture{};
+		local_texture.fill(-1);
+		for (size_t i = state_->recorded_vertices; i < vertex_end; ++i) {
+			Vertex vertex = state_->vertices[i];
+			const auto tex_index = static_cast<int>(vertex.tex_index);
+			const int slot = tex_index % MAX_TEXTURE_SLOTS;
+			int& local = local_texture[static_cast<size_t>(slot)];
+			if (local < 0) {
+				local = static_cast<int>(op.texture_count++);
+				geometry->textures.push_back(slot_textures[static_cast<size_t>(slot)]);
+			}
+			vertex.tex_index = static_cast<float>(tex_index - slot + local); // Keeps the SDF offset
+			geometry->vertices.push_back(vertex);
+		}
+		for (size_t i = state_->recorded_indices; i < index_end; ++i) {
+			geometry->indices.push_back(state_->indices[i] - static_cast<uint32_t>(state_->recorded_vertices));
+		}
+		geometry->ops.push_back(op);
+	}
+
+	state_->recorded_vertices = vertex_end;
+	state_->recorded_indices = index_end;
 }
 } // namespace engine::ui::batch_renderer
@@ -34,6 +34,9 @@ public:
 	// Maximum texture slots supported (modern GL standard)
 	static constexpr int MAX_TEXTURE_SLOTS = 8;
 
+	// Added to a vertex's texture slot to make the shader treat the texture's alpha as a signed distance field
+	static constexpr int SDF_TEXTURE_INDEX_OFFSET = MAX_TEXTURE_SLOTS;
+
 	// Reserve capacity to avoid frequent reallocations
 	static constexpr size_t INITIAL_VERTEX_CAPACITY = 32768;
 	static constexpr size_t INITIAL_INDEX_CAPACITY = 98304;
@@ -114,6 +117,20 @@ public:
 		uint32_t texture_id = 0
 	);
 
+	/**
+	 * @brief Submit a quad sampling a signed distance field
+	 *
+	 * The texture's alpha is read as distance to an outline, 0.5 on the outline, and turned into coverage with
+	 * screen-space antialiasing, so the quad stays sharp at any scale. Used for SDF font atlases.
+	 *
+	 * @param rect Screen-space rectangle
+	 * @param color Fill color
+	 * @param uv_coords Texture coordinates of the field
+	 * @param texture_id Texture holding the field in its alpha channel
+	 */
+	static void
+	SubmitSdfQuad(const Rectangle& rect, const Color& color, const Rectangle& uv_coords, uint32_t texture_id);
+
 	/**
 	 * @brief Submit a line (tessellated as quad)
 	 *
@@ -160,7 +177,7 @@ public:
 	 * @param text UTF-8 encoded text string to render (supports newlines)
 	 * @param x X position in screen space (top-left of text)
 	 * @param y Y position in screen space (top-left of text)
-	 * @param font_size Font size in pixels (currently uses default font size; for variable sizes, pre-load fonts with FontManager::GetFont)
+	 * @param font_size Font size in pixels (0 = default font size); any size is sharp with SDF glyph caching
 	 * @param color Text color (RGBA, 0.0-1.0 range)
 	 *
 	 * @note Requires FontManager to be initialized with a default font.
@@ -190,7 +207,7 @@ public:
 	 *
 	 * @param rect Bounding rectangle for text (x, y, width, height)
 	 * @param text UTF-8 encoded text string to render
-	 * @param font_size Font size in pixels (currently uses default font size; for variable sizes, pre-load fonts with FontManager::GetFont)
+	 * @param font_size Font size in pixels (0 = default font size); any size is sharp with SDF glyph caching
 	 * @param color Text color (RGBA, 0.0-1.0 range)
 	 *
 	 * @note Requires FontManager to be initialized with a default font.
@@ -218,6 +235,43 @@ public:
 	 */
 	static void SubmitTextRect(const Rectangle& rect, const std::string& text, int font_size, const Color& color);
 
+	/**
+	 * @brief Start recording everything submitted until EndRetained() into geometry
+	 *
+	 * Submissions still go into the frame as usual. Recordings nest: an inner subtree's output (recorded or
+	 * replayed) is also captured by every enclosing recording.
+	 *
+	 * @param geometry Storage for the recording; cleared first
+	 * @param origin_x Screen X of the owner, used to translate later replays
+	 * @param origin_y Screen Y of the owner
+	 */
+	static void BeginRetained(RetainedGeometry& geometry, float origin_x, float origin_y);
+
+	/**
+	 * @brief Finish the innermost recording and mark it valid
+	 */
+	static void EndRetained();
+
+	/**
+	 * @brief Replay recorded geometry into the current frame
+	 *
+	 * Copies the vertices and indices, translated to the owner's current origin and remapped to this batch's
+	 * texture slots. Scissor changes are replayed through PushScissor()/PopScissor().
+	 */
+	static void SubmitRetained(const RetainedGeometry& geometry, float origin_x, float origin_y);
+
+	/**
+	 * @brief Check whether geometry holds a recording that is still safe to replay
+	 */
+	static bool IsRetainedValid(const RetainedGeometry& geometry);
+
+	/**
+	 * @brief Invalidate every recording made so far
+	 *
+	 * For changes outside any element, such as font atlases being rebuilt.
+	 */
+	static void InvalidateRetained();
+
 	/**
 	 * @brief Manually flush current batch
 	 *
@@ -255,6 +309,14 @@ private:
 	static std::unique_ptr<BatchState> state_;
 
 	// Internal helpers
+	static void SubmitTexturedQuad(
+		const Rectangle& rect,
+		const Color& color,
+		const std::optional<Rectangle>& uv_coords,
+		uint32_t texture_id,
+		int tex_index_offset
+	);
+
 	static void PushQuadVertices(const Vertex& v0, const Vertex& v1, const Vertex& v2, const Vertex& v3);
 
 	static void PushQuadIndices(uint32_t base_vertex);
@@ -266,5 +328,8 @@ private:
 	static void FlushBatch();
 
 	static void StartNewBatch();
+
+	// Append the pending batch's not yet recorded vertices and indices to every active recording
+	static void CaptureRetained();
 };
 } // namespace engine::ui::batch_renderer
@@ -3,6 +3,7 @@ module;
 #include <algorithm>
 #include <cstdint>
 #include <optional>
+#include <vector>
 
 export module engine.ui.batch_renderer:batch_types;
 
@@ -336,6 +337,46 @@ struct Rectangle {
 	Rectangle(const float x, const float y, const float w, const float h) : x(x), y(y), width(w), height(h) {}
 };
 
+/**
+ * @brief Tessellated output of a UI subtree, kept so an unchanged subtree can skip tessellation
+ *
+ * Recorded between BatchRenderer::BeginRetained() and EndRetained(), then submitted again with
+ * BatchRenderer::SubmitRetained(). Positions stay as they were recorded; a replay translates them by how far the
+ * owner's origin has moved since.
+ */
+struct RetainedGeometry {
+	// A run of geometry that went into one batch, or a scissor change between runs
+	struct Op {
+		enum class Kind : uint8_t { Geometry, PushScissor, PopScissor };
+
+		Kind kind = Kind::Geometry;
+		uint32_t first_vertex = 0;
+		uint32_t vertex_count = 0;
+		uint32_t first_index = 0;
+		uint32_t index_count = 0; // Relative to first_vertex
+		uint32_t first_texture = 0;
+		uint32_t texture_count = 0; // Vertex tex_index selects one of these, not a batch slot
+		ScissorRect scissor;        // PushScissor only, as it was passed in (not yet intersected)
+	};
+
+	std::vector<Vertex> vertices;
+	std::vector<uint32_t> indices;
+	std::vector<uint32_t> textures;
+	std::vector<Op> ops;
+	float origin_x = 0.0F;
+	float origin_y = 0.0F;
+	uint64_t generation = 0; // BatchRenderer retained generation at record time
+	bool valid = false;
+
+	void Clear() {
+		vertices.clear();
+		indices.clear();
+		textures.clear();
+		ops.clear();
+		valid = false;
+	}
+};
+
 /**
  * @brief Convert Color to packed RGBA uint32_t
  *
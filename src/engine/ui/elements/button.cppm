@@ -127,6 +127,7 @@ public:
 			text_element_->SetText(label_);
 			UpdateTextPosition();
 		}
+		MarkDirty();
 	}
 
 	/**
@@ -150,6 +151,7 @@ public:
 			text_element_->SetFontSize(font_size_);
 			UpdateTextPosition();
 		}
+		MarkDirty();
 	}
 
 	/**
@@ -164,25 +166,25 @@ public:
 	 * @brief Set normal (default) background color
 	 * @param color Normal state color
 	 */
-	void SetNormalColor(const batch_renderer::Color& color) { normal_color_ = color; }
+	void SetNormalColor(const batch_renderer::Color& color) { normal_color_ = color; MarkDirty(); }
 
 	/**
 	 * @brief Set hover background color
 	 * @param color Hover state color
 	 */
-	void SetHoverColor(const batch_renderer::Color& color) { hover_color_ = color; }
+	void SetHoverColor(const batch_renderer::Color& color) { hover_color_ = color; MarkDirty(); }
 
 	/**
 	 * @brief Set pressed background color
 	 * @param color Pressed state color
 	 */
-	void SetPressedColor(const batch_renderer::Color& color) { pressed_color_ = color; }
+	void SetPressedColor(const batch_renderer::Color& color) { pressed_color_ = color; MarkDirty(); }
 
 	/**
 	 * @brief Set disabled background color
 	 * @param color Disabled state color
 	 */
-	void SetDisabledColor(const batch_renderer::Color& color) { disabled_color_ = color; }
+	void SetDisabledColor(const batch_renderer::Color& color) { disabled_color_ = color; MarkDirty(); }
 
 	/**
 	 * @brief Set text color
@@ -193,19 +195,20 @@ public:
 		if (text_element_) {
 			text_element_->SetColor(color);
 		}
+		MarkDirty();
 	}
 
 	/**
 	 * @brief Set border color
 	 * @param color Border color
 	 */
-	void SetBorderColor(const batch_renderer::Color& color) { border_color_ = color; }
+	void SetBorderColor(const batch_renderer::Color& color) { border_color_ = color; MarkDirty(); }
 
 	/**
 	 * @brief Set border width
 	 * @param width Border width in pixels (0 = no border)
 	 */
-	void SetBorderWidth(const float width) { border_width_ = width >= 0.0F ? width : 0.0F; }
+	void SetBorderWidth(const float width) { border_width_ = width >= 0.0F ? width : 0.0F; MarkDirty(); }
 
 	// === State Management ===
 
@@ -227,6 +230,7 @@ public:
 			is_pressed_ = false;
 			is_hovered_ = false;
 		}
+		MarkDirty();
 	}
 
 	/**
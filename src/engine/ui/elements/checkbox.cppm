@@ -134,7 +134,7 @@ public:
 	 * checkbox->SetChecked(settings.sound_enabled);
 	 * @endcode
 	 */
-	void SetChecked(const bool checked) { is_checked_ = checked; }
+	void SetChecked(const bool checked) { is_checked_ = checked; MarkDirty(); }
 
 	/**
 	 * @brief Get checked state
@@ -199,6 +199,7 @@ public:
 			}
 			width_ = box_size_;
 		}
+		MarkDirty();
 	}
 
 	/**
@@ -213,13 +214,13 @@ public:
 	 * @brief Set box (outline) color
 	 * @param color Box color
 	 */
-	void SetBoxColor(const batch_renderer::Color& color) { box_color_ = color; }
+	void SetBoxColor(const batch_renderer::Color& color) { box_color_ = color; MarkDirty(); }
 
 	/**
 	 * @brief Set checkmark color
 	 * @param color Checkmark color
 	 */
-	void SetCheckmarkColor(const batch_renderer::Color& color) { checkmark_color_ = color; }
+	void SetCheckmarkColor(const batch_renderer::Color& color) { checkmark_color_ = color; MarkDirty(); }
 
 	/**
 	 * @brief Set label text color
@@ -230,13 +231,14 @@ public:
 		if (label_element_) {
 			label_element_->SetColor(color);
 		}
+		MarkDirty();
 	}
 
 	/**
 	 * @brief Set focus indicator color
 	 * @param color Focus color
 	 */
-	void SetFocusColor(const batch_renderer::Color& color) { focus_color_ = color; }
+	void SetFocusColor(const batch_renderer::Color& color) { focus_color_ = color; MarkDirty(); }
 
 	// === Event Callbacks ===
 
@@ -72,7 +72,7 @@ public:
 	 * @brief Set line color
 	 * @param color Divider line color
 	 */
-	void SetColor(const batch_renderer::Color& color) { color_ = color; }
+	void SetColor(const batch_renderer::Color& color) { color_ = color; MarkDirty(); }
 	[[nodiscard]] batch_renderer::Color GetColor() const { return color_; }
 
 	/**
@@ -88,6 +88,7 @@ public:
 		else {
 			width_ = thickness_;
 		}
+		MarkDirty();
 	}
 	[[nodiscard]] float GetThickness() const { return thickness_; }
 
@@ -106,6 +107,7 @@ public:
 			width_ = thickness_;
 			height_ = 0.0F; // Will be stretched by layout
 		}
+		MarkDirty();
 	}
 	[[nodiscard]] Orientation GetOrientation() const { return orientation_; }
 
@@ -69,7 +69,7 @@ public:
 	 * @brief Set the sprite to be rendered
 	 * @param sprite Shared pointer to sprite (can be shared across multiple Images)
 	 */
-	void SetSprite(const std::shared_ptr<Sprite>& sprite) { sprite_ = sprite; }
+	void SetSprite(const std::shared_ptr<Sprite>& sprite) { sprite_ = sprite; MarkDirty(); }
 
 	/**
 	 * @brief Clear the current sprite
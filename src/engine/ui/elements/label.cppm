@@ -133,6 +133,7 @@ public:
 			UpdateSize();
 			UpdateTextPosition();
 		}
+		MarkDirty();
 	}
 
 	/**
@@ -159,6 +160,7 @@ public:
 			UpdateSize();
 			UpdateTextPosition();
 		}
+		MarkDirty();
 	}
 
 	/**
@@ -182,6 +184,7 @@ public:
 		if (text_element_) {
 			text_element_->SetColor(color);
 		}
+		MarkDirty();
 	}
 
 	/**
@@ -209,6 +212,7 @@ public:
 	void SetAlignment(const Alignment alignment) {
 		alignment_ = alignment;
 		UpdateTextPosition();
+		MarkDirty();
 	}
 
 	/**
@@ -234,6 +238,7 @@ public:
 		max_width_ = max_width >= 0.0F ? max_width : 0.0F;
 		UpdateSize();
 		UpdateTextPosition();
+		MarkDirty();
 	}
 
 	/**
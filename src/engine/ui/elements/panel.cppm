@@ -97,7 +97,7 @@ public:
 	 * panel->SetBackgroundColor(Color{0.2f, 0.2f, 0.3f, 1.0f});
 	 * @endcode
 	 */
-	void SetBackgroundColor(const batch_renderer::Color& color) { background_color_ = color; }
+	void SetBackgroundColor(const batch_renderer::Color& color) { background_color_ = color; MarkDirty(); }
 
 	/**
 	 * @brief Get current background color
@@ -117,7 +117,7 @@ public:
 	 * panel->SetBorderWidth(2.0f);  // Make border visible
 	 * @endcode
 	 */
-	void SetBorderColor(const batch_renderer::Color& color) { border_color_ = color; }
+	void SetBorderColor(const batch_renderer::Color& color) { border_color_ = color; MarkDirty(); }
 
 	/**
 	 * @brief Get current border color
@@ -137,7 +137,7 @@ public:
 	 * panel->SetBorderWidth(0.0f);  // No border
 	 * @endcode
 	 */
-	void SetBorderWidth(const float width) { border_width_ = width >= 0.0F ? width : 0.0F; }
+	void SetBorderWidth(const float width) { border_width_ = width >= 0.0F ? width : 0.0F; MarkDirty(); }
 
 	/**
 	 * @brief Get current border width
@@ -162,7 +162,7 @@ public:
 	 * }
 	 * @endcode
 	 */
-	void SetOpacity(const float opacity) { opacity_ = std::clamp(opacity, 0.0F, 1.0F); }
+	void SetOpacity(const float opacity) { opacity_ = std::clamp(opacity, 0.0F, 1.0F); MarkDirty(); }
 
 	/**
 	 * @brief Get current opacity
@@ -196,7 +196,7 @@ public:
 	 * panel->AddChild(std::move(child));
 	 * @endcode
 	 */
-	void SetPadding(const float padding) { padding_ = padding >= 0.0F ? padding : 0.0F; }
+	void SetPadding(const float padding) { padding_ = padding >= 0.0F ? padding : 0.0F; MarkDirty(); }
 
 	/**
 	 * @brief Get current padding
@@ -228,7 +228,7 @@ public:
 	 * panel->SetClipChildren(false);  // Allow overflow
 	 * @endcode
 	 */
-	void SetClipChildren(const bool clip) { clip_children_ = clip; }
+	void SetClipChildren(const bool clip) { clip_children_ = clip; MarkDirty(); }
 
 	/**
 	 * @brief Check if scissor clipping is enabled
@@ -248,7 +248,8 @@ public:
 	 * 4. Render children (recursively) - padding is applied via GetAbsoluteBounds()
 	 * 5. Pop scissor
 	 *
-	 * Children are clipped to panel bounds via scissor test.
+	 * Children are clipped to panel bounds via scissor test. When retained (SetRetained()), all of this is
+	 * skipped while the subtree is unchanged and the cached geometry is replayed instead.
 	 *
 	 * @code
 	 * panel->Render();  // Renders panel and all children
@@ -262,6 +263,11 @@ public:
 			return;
 		}
 
+		// A retained panel whose subtree is unchanged replays its cached geometry
+		if (BeginRetainedRender()) {
+			return;
+		}
+
 		// Get actual panel bounds (element itself, not content area)
 		const Rectangle absolute_bounds = GetAbsoluteBounds();
 
@@ -303,6 +309,8 @@ public:
 		if (clip_children_) {
 			BatchRenderer::PopScissor();
 		}
+
+		EndRetainedRender();
 	}
 
 private:
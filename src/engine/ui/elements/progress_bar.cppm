@@ -112,6 +112,7 @@ public:
 	void SetProgress(const float progress) {
 		progress_ = std::clamp(progress, 0.0F, 1.0F);
 		UpdatePercentageDisplay();
+		MarkDirty();
 	}
 
 	/**
@@ -151,6 +152,7 @@ public:
 			UpdateLabelPosition();
 			UpdateBarWidth();
 		}
+		MarkDirty();
 	}
 
 	/**
@@ -181,6 +183,7 @@ public:
 			percentage_element_.reset();
 			UpdateBarWidth();
 		}
+		MarkDirty();
 	}
 
 	/**
@@ -195,7 +198,7 @@ public:
 	 * @brief Set track (background) color
 	 * @param color Track color
 	 */
-	void SetTrackColor(const batch_renderer::Color& color) { track_color_ = color; }
+	void SetTrackColor(const batch_renderer::Color& color) { track_color_ = color; MarkDirty(); }
 
 	/**
 	 * @brief Get track color
@@ -207,7 +210,7 @@ public:
 	 * @brief Set fill (progress) color
 	 * @param color Fill color
 	 */
-	void SetFillColor(const batch_renderer::Color& color) { fill_color_ = color; }
+	void SetFillColor(const batch_renderer::Color& color) { fill_color_ = color; MarkDirty(); }
 
 	/**
 	 * @brief Get fill color
@@ -219,13 +222,13 @@ public:
 	 * @brief Set border color
 	 * @param color Border color
 	 */
-	void SetBorderColor(const batch_renderer::Color& color) { border_color_ = color; }
+	void SetBorderColor(const batch_renderer::Color& color) { border_color_ = color; MarkDirty(); }
 
 	/**
 	 * @brief Set border width
 	 * @param width Border width in pixels (0 = no border)
 	 */
-	void SetBorderWidth(const float width) { border_width_ = width >= 0.0F ? width : 0.0F; }
+	void SetBorderWidth(const float width) { border_width_ = width >= 0.0F ? width : 0.0F; MarkDirty(); }
 
 	/**
 	 * @brief Set label and percentage text color
@@ -239,6 +242,7 @@ public:
 		if (percentage_element_) {
 			percentage_element_->SetColor(color);
 		}
+		MarkDirty();
 	}
 
 	// === Rendering ===
@@ -139,6 +139,7 @@ public:
 			current_value_ = new_value;
 			UpdateValueDisplay();
 		}
+		MarkDirty();
 	}
 
 	/**
@@ -154,6 +155,7 @@ public:
 	void SetMinValue(const float min_value) {
 		min_value_ = min_value;
 		current_value_ = std::clamp(current_value_, min_value_, max_value_);
+		MarkDirty();
 	}
 
 	/**
@@ -169,6 +171,7 @@ public:
 	void SetMaxValue(const float max_value) {
 		max_value_ = max_value;
 		current_value_ = std::clamp(current_value_, min_value_, max_value_);
+		MarkDirty();
 	}
 
 	/**
@@ -214,6 +217,7 @@ public:
 			UpdateLabelPosition();
 			UpdateTrackWidth();
 		}
+		MarkDirty();
 	}
 
 	/**
@@ -244,6 +248,7 @@ public:
 			value_element_.reset();
 			UpdateTrackWidth();
 		}
+		MarkDirty();
 	}
 
 	/**
@@ -258,19 +263,19 @@ public:
 	 * @brief Set track (background) color
 	 * @param color Track color
 	 */
-	void SetTrackColor(const batch_renderer::Color& color) { track_color_ = color; }
+	void SetTrackColor(const batch_renderer::Color& color) { track_color_ = color; MarkDirty(); }
 
 	/**
 	 * @brief Set fill (progress) color
 	 * @param color Fill color
 	 */
-	void SetFillColor(const batch_renderer::Color& color) { fill_color_ = color; }
+	void SetFillColor(const batch_renderer::Color& color) { fill_color_ = color; MarkDirty(); }
 
 	/**
 	 * @brief Set thumb (handle) color
 	 * @param color Thumb color
 	 */
-	void SetThumbColor(const batch_renderer::Color& color) { thumb_color_ = color; }
+	void SetThumbColor(const batch_renderer::Color& color) { thumb_color_ = color; MarkDirty(); }
 
 	// === Event Callbacks ===
 
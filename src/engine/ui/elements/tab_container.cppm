@@ -252,6 +252,7 @@ public:
 		if (tab_changed_callback_ && active_tab_index_ < tabs_.size()) {
 			tab_changed_callback_(active_tab_index_, tabs_[active_tab_index_].label);
 		}
+		MarkDirty();
 	}
 
 	/**
@@ -295,6 +296,7 @@ public:
 		content_panel_->SetRelativePosition(0, tab_bar_height_);
 		content_panel_->SetSize(width_, GetContentHeight());
 		RebuildTabButtons();
+		MarkDirty();
 	}
 
 	/**
@@ -306,6 +308,7 @@ public:
 		if (tab_bar_panel_) {
 			tab_bar_panel_->SetBackgroundColor(color);
 		}
+		MarkDirty();
 	}
 
 	/**
@@ -315,6 +318,7 @@ public:
 	void SetActiveTabColor(const batch_renderer::Color& color) {
 		active_tab_color_ = color;
 		UpdateTabButtonStyles();
+		MarkDirty();
 	}
 
 	/**
@@ -324,6 +328,7 @@ public:
 	void SetInactiveTabColor(const batch_renderer::Color& color) {
 		inactive_tab_color_ = color;
 		UpdateTabButtonStyles();
+		MarkDirty();
 	}
 
 	/**
@@ -333,6 +338,7 @@ public:
 	void SetTabTextColor(const batch_renderer::Color& color) {
 		tab_text_color_ = color;
 		UpdateTabButtonStyles();
+		MarkDirty();
 	}
 
 	/**
@@ -344,6 +350,7 @@ public:
 		if (content_panel_) {
 			content_panel_->SetBackgroundColor(color);
 		}
+		MarkDirty();
 	}
 
 	// === Rendering ===
@@ -122,6 +122,8 @@ public:
 	 * @brief Set font size (triggers glyph recomputation)
 	 *
 	 * Updates the font to a new size using FontManager. Recomputes glyphs.
+	 * With SDF glyph caching every size shares one atlas, so this only
+	 * re-runs layout and is cheap enough to animate.
 	 *
 	 * @param font_size New font size in pixels
 	 */
@@ -144,7 +146,7 @@ public:
 	 *
 	 * @param color New text color
 	 */
-	void SetColor(const batch_renderer::Color& color) { color_ = color; }
+	void SetColor(const batch_renderer::Color& color) { color_ = color; MarkDirty(); }
 
 	/**
 	 * @brief Get current text string
@@ -164,7 +166,8 @@ public:
 	 * Submits pre-computed glyph quads to BatchRenderer. This is extremely
 	 * efficient because glyph positioning was done in ComputeMesh(), not here.
 	 *
-	 * Per-frame cost: O(n) where n = number of glyphs (just vertex submission)
+	 * Per-frame cost: O(n) where n = number of glyphs (just vertex submission,
+	 * no glyph lookups unless the font atlas evicted pages since layout)
 	 *
 	 * @code
 	 * // Efficient rendering loop
@@ -186,6 +189,9 @@ private:
 	 * - Bounding box calculation
 	 * - Stores positioned glyphs for fast rendering
 	 *
+	 * Goes through TextLayout::LayoutCached(), so elements showing the same
+	 * string, such as recreated labels, share one layout.
+	 *
 	 * Called by: SetText(), SetFont(), constructor
 	 */
 	void ComputeMesh();
@@ -193,7 +199,8 @@ private:
 	std::string text_;                                   ///< Text content
 	batch_renderer::Color color_;                        ///< Text color
 	text_renderer::FontAtlas* font_{nullptr};            ///< Font atlas (non-owning)
-	std::vector<text_renderer::PositionedGlyph> glyphs_; ///< Pre-computed glyph positions
+	float font_size_{0.0F};                              ///< Layout size in pixels (0 = the font's own size)
+	std::shared_ptr<const text_renderer::TextLayoutResult> layout_; ///< Pre-computed glyph positions (shared cache)
 };
 
 // === Implementation ===
@@ -204,7 +211,7 @@ inline Text::Text(
 	std::string  text,
 	const float font_size,
 	const batch_renderer::Color& color
-) : UIElement(x, y, 0, 0), text_(std::move(text)), color_(color) {
+) : UIElement(x, y, 0, 0), text_(std::move(text)), color_(color), font_size_(font_size) {
 
 	// Get default font at requested size
 	font_ = text_renderer::FontManager::GetFont(
@@ -246,6 +253,7 @@ inline void Text::SetFont(text_renderer::FontAtlas* font) {
 }
 
 inline void Text::SetFontSize(const float font_size) {
+	font_size_ = font_size;
 	font_ = text_renderer::FontManager::GetFont(
 		text_renderer::FontManager::GetDefaultFontPath(),
 		static_cast<int>(font_size)
@@ -260,7 +268,8 @@ inline void Text::SetFontSize(const float font_size) {
 }
 
 inline void Text::ComputeMesh() {
-	glyphs_.clear();
+	layout_.reset();
+	MarkDirty();
 
 	// Validate font
 	if (!font_ || !font_->IsValid()) {
@@ -274,46 +283,53 @@ inline void Text::ComputeMesh() {
 	options.h_align = text_renderer::HorizontalAlign::Left;
 	options.v_align = text_renderer::VerticalAlign::Top;
 	options.max_width = 0.0F; // No wrapping
+	options.font_size = font_size_;
 
-	glyphs_ = text_renderer::TextLayout::Layout(text_, *font_, options);
-
-	// Use MeasureText to get proper bounds (respects newlines)
-	batch_renderer::Rectangle const bounds = text_renderer::TextLayout::MeasureText(
-		text_,
-		*font_,
-		0.0F // No wrapping
-	);
+	// The cached bounds come from MeasureText (respects newlines)
+	layout_ = text_renderer::TextLayout::LayoutCached(text_, *font_, options);
 
-	width_ = bounds.width;
-	height_ = bounds.height;
+	width_ = layout_->bounds.width;
+	height_ = layout_->bounds.height;
 }
 
 inline void Text::Render() const {
 	using namespace batch_renderer;
 
-	if (!is_visible_ || !font_ || !font_->IsValid() || glyphs_.empty()) {
+	if (!is_visible_ || !font_ || !font_->IsValid() || !layout_ || layout_->glyphs.empty()) {
 		return;
 	}
 
 	// Get absolute position for rendering
 	const Rectangle abs_bounds = GetAbsoluteBounds();
-	const uint32_t font_texture_id = font_->GetTextureId();
+
+	// Positions never change, but if the atlas has evicted pages since layout, glyphs may have been re-rasterized
+	// elsewhere and their metrics have to be looked up again
+	const bool metrics_current = layout_->atlas_generation == font_->GetEvictedPageCount();
+	if (metrics_current) {
+		for (const uint32_t texture_id : layout_->textures) {
+			font_->TouchTexture(texture_id);
+		}
+	}
 
 	// Submit pre-computed glyphs as quads
-	for (const auto& glyph : glyphs_) {
-		if (!glyph.metrics) continue;
+	for (const auto& glyph : layout_->glyphs) {
+		if (glyph.size.x == 0 || glyph.size.y == 0) continue;
+		const text_renderer::GlyphMetrics* metrics =
+			metrics_current ? glyph.metrics : font_->GetGlyph(glyph.codepoint);
+		if (!metrics) continue;
 
 		// Calculate glyph screen position
 		const float glyph_x = abs_bounds.x + glyph.position.x;
 		const float glyph_y = abs_bounds.y + glyph.position.y;
+		const Rectangle quad{glyph_x, glyph_y, glyph.size.x, glyph.size.y};
 
 		// Submit quad with glyph texture coordinates
-		BatchRenderer::SubmitQuad(
-			Rectangle{glyph_x, glyph_y, glyph.metrics->size.x, glyph.metrics->size.y},
-			color_,
-			glyph.metrics->atlas_rect,
-			font_texture_id
-		);
+		if (font_->IsSdf()) {
+			BatchRenderer::SubmitSdfQuad(quad, color_, metrics->atlas_rect, metrics->texture_id);
+		}
+		else {
+			BatchRenderer::SubmitQuad(quad, color_, metrics->atlas_rect, metrics->texture_id);
+		}
 	}
 }
 
@@ -1,7 +1,10 @@
 module;
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <functional>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
@@ -17,7 +20,14 @@ using namespace batch_renderer;
  * @brief Priority-based mouse event handler registration
  *
  * Allows flexible registration of UI components for mouse events with
- * explicit priorities. Handlers are sorted by priority (higher = first).
+ * explicit priorities. Handlers are called by priority (higher = first), with
+ * equal priorities called in registration order.
+ *
+ * Regions are bucketed into a screen-space uniform grid, so a dispatch only
+ * hit-tests the regions overlapping the cursor's cell instead of every
+ * registered region. Regions spanning more than MAX_CELLS_PER_REGION cells
+ * (full-screen modals, backgrounds) are kept in a separate list that is
+ * always tested.
  *
  * Inspired by towerforge's MouseEventManager architecture.
  *
@@ -99,6 +109,18 @@ public:
 	using RegionHandle = size_t;
 	static constexpr RegionHandle INVALID_HANDLE = static_cast<size_t>(-1);
 
+	static constexpr float DEFAULT_CELL_SIZE = 128.0F;   ///< Grid cell edge length in pixels
+	static constexpr int64_t MAX_CELLS_PER_REGION = 256; ///< Larger regions bypass the grid
+
+	/**
+	 * @brief Create a manager
+	 *
+	 * @param cell_size Edge length of a hit-test grid cell in pixels; roughly the size
+	 *                  of a typical region works well (non-positive values use the default)
+	 */
+	explicit MouseEventManager(const float cell_size = DEFAULT_CELL_SIZE) :
+			cell_size_(cell_size > 0.0F ? cell_size : DEFAULT_CELL_SIZE) {}
+
 	/**
 	 * @brief Register a mouse event region with priority
 	 *
@@ -113,14 +135,10 @@ public:
 		// Generate unique ID
 		RegionHandle const handle = next_id_++;
 
-		// Create region with stable ID
-		EventRegion region{handle, bounds, std::move(handler), priority, user_data};
-
-		// Store in map for stable access
-		regions_[handle] = std::move(region);
-
-		// Mark as needing resort
-		needs_sort_ = true;
+		// Store in map for stable access, then bucket into the grid
+		const CellRange cells = ComputeCellRange(bounds);
+		regions_[handle] = Entry{EventRegion{handle, bounds, std::move(handler), priority, user_data}, cells};
+		InsertIntoGrid(handle, cells);
 
 		return handle;
 	}
@@ -134,8 +152,8 @@ public:
 	bool UnregisterRegion(RegionHandle handle) {
 		auto it = regions_.find(handle);
 		if (it != regions_.end()) {
+			RemoveFromGrid(handle, it->second.cells);
 			regions_.erase(it);
-			needs_sort_ = true;
 			return true;
 		}
 		return false;
@@ -150,7 +168,8 @@ public:
 	size_t UnregisterByUserData(void* user_data) {
 		size_t count = 0;
 		for (auto it = regions_.begin(); it != regions_.end();) {
-			if (it->second.user_data == user_data) {
+			if (it->second.region.user_data == user_data) {
+				RemoveFromGrid(it->first, it->second.cells);
 				it = regions_.erase(it);
 				++count;
 			}
@@ -158,15 +177,14 @@ public:
 				++it;
 			}
 		}
-		if (count > 0) {
-			needs_sort_ = true;
-		}
 		return count;
 	}
 
 	/**
 	 * @brief Update region bounds (e.g., for animated/repositioned elements)
 	 *
+	 * Only touches the grid when the region moves into a different set of cells.
+	 *
 	 * @param handle Handle of region to update
 	 * @param new_bounds New bounds rectangle
 	 * @return true if region was found and updated
@@ -174,7 +192,13 @@ public:
 	bool UpdateRegionBounds(RegionHandle handle, const Rectangle& new_bounds) {
 		auto it = regions_.find(handle);
 		if (it != regions_.end()) {
-			it->second.bounds = new_bounds;
+			it->second.region.bounds = new_bounds;
+			const CellRange cells = ComputeCellRange(new_bounds);
+			if (cells != it->second.cells) {
+				RemoveFromGrid(handle, it->second.cells);
+				InsertIntoGrid(handle, cells);
+				it->second.cells = cells;
+			}
 			return true;
 		}
 		return false;
@@ -190,7 +214,7 @@ public:
 	bool SetRegionEnabled(RegionHandle handle, bool enabled) {
 		auto it = regions_.find(handle);
 		if (it != regions_.end()) {
-			it->second.enabled = enabled;
+			it->second.region.enabled = enabled;
 			return true;
 		}
 		return false;
@@ -200,39 +224,46 @@ public:
 	 * @brief Dispatch mouse event to registered regions
 	 *
 	 * Algorithm:
-	 * 1. Build sorted list of regions by priority (if needed)
-	 * 2. For each region (in priority order):
-	 *    - Check if event position is within bounds
-	 *    - If yes, call handler
-	 *    - If handler returns true, stop propagation
+	 * 1. Collect enabled regions containing the event position from the cursor's
+	 *    grid cell and the oversized list
+	 * 2. Sort the hits by priority (descending), then registration order
+	 * 3. For each hit, call its handler; if it returns true, stop propagation
+	 *
+	 * Handlers may register, unregister or move regions while the event is being
+	 * dispatched; each hit is re-checked just before its handler is called.
 	 *
 	 * @param event Mouse event to dispatch
 	 * @return true if any handler consumed the event
 	 */
 	bool DispatchEvent(const MouseEvent& event) {
-		// Build sorted list if needed
-		if (needs_sort_) {
-			BuildSortedList();
+		std::vector<RegionHandle> hits;
+		CollectHits(oversized_, event.x, event.y, hits);
+		if (const auto cell = PointCell(event.x, event.y)) {
+			if (const auto it = cells_.find(*cell); it != cells_.end()) {
+				CollectHits(it->second, event.x, event.y, hits);
+			}
 		}
 
+		std::ranges::sort(hits, [this](const RegionHandle a, const RegionHandle b) {
+			const int priority_a = regions_.at(a).region.priority;
+			const int priority_b = regions_.at(b).region.priority;
+			return priority_a != priority_b ? priority_a > priority_b : a < b;
+		});
+
 		// Dispatch to regions in priority order
-		for (size_t const handle : sorted_handles_) {
+		for (const RegionHandle handle : hits) {
 			auto it = regions_.find(handle);
 			if (it == regions_.end()) {
-				continue; // Region was removed
+				continue; // Region was removed by an earlier handler
 			}
 
-			const auto& region = it->second;
-			if (!region.enabled) {
+			const auto& region = it->second.region;
+			if (!region.enabled || !Contains(region.bounds, event.x, event.y)) {
 				continue;
 			}
 
-			// Hit test
-			if (Contains(region.bounds, event.x, event.y)) {
-				// Invoke handler
-				if (region.handler && region.handler(event)) {
-					return true; // Event consumed
-				}
+			if (region.handler && region.handler(event)) {
+				return true; // Event consumed
 			}
 		}
 
@@ -244,8 +275,8 @@ public:
 	 */
 	void Clear() {
 		regions_.clear();
-		sorted_handles_.clear();
-		needs_sort_ = false;
+		cells_.clear();
+		oversized_.clear();
 	}
 
 	/**
@@ -253,6 +284,11 @@ public:
 	 */
 	[[nodiscard]] size_t GetRegionCount() const { return regions_.size(); }
 
+	/**
+	 * @brief Get the hit-test grid cell size in pixels
+	 */
+	[[nodiscard]] float GetCellSize() const { return cell_size_; }
+
 	/**
 	 * @brief Get region by handle (for inspection/debugging)
 	 * @return Pointer to region, or nullptr if handle is invalid
@@ -260,32 +296,133 @@ public:
 	[[nodiscard]] const EventRegion* GetRegion(RegionHandle handle) const {
 		auto it = regions_.find(handle);
 		if (it != regions_.end()) {
-			return &it->second;
+			return &it->second.region;
 		}
 		return nullptr;
 	}
 
 private:
 	/**
-	 * @brief Build sorted list of region handles by priority
+	 * @brief Inclusive range of grid cells covered by a region
+	 *
+	 * An empty range (max < min) is never hit; oversized regions live outside the grid.
 	 */
-	void BuildSortedList() {
-		sorted_handles_.clear();
-		sorted_handles_.reserve(regions_.size());
+	struct CellRange {
+		int32_t min_x{0};
+		int32_t min_y{0};
+		int32_t max_x{-1};
+		int32_t max_y{-1};
+		bool oversized{false};
+
+		bool operator==(const CellRange&) const = default;
+	};
 
-		// Collect handles
-		for (const auto& pair : regions_) {
-			sorted_handles_.push_back(pair.first);
+	struct Entry {
+		EventRegion region;
+		CellRange cells;
+	};
+
+	// Keeps cell coordinates well inside int32_t; regions beyond it are treated as oversized
+	static constexpr float MAX_CELL_COORDINATE = static_cast<float>(1 << 30);
+
+	static uint64_t CellKey(const int32_t x, const int32_t y) {
+		return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+	}
+
+	/**
+	 * @brief Grid cell containing a point, or nullopt if it lies outside the grid
+	 */
+	[[nodiscard]] std::optional<uint64_t> PointCell(const float x, const float y) const {
+		const float cell_x = std::floor(x / cell_size_);
+		const float cell_y = std::floor(y / cell_size_);
+		// Written so that NaN also falls outside
+		if (!(std::abs(cell_x) <= MAX_CELL_COORDINATE && std::abs(cell_y) <= MAX_CELL_COORDINATE)) {
+			return std::nullopt;
 		}
+		return CellKey(static_cast<int32_t>(cell_x), static_cast<int32_t>(cell_y));
+	}
 
-		// Sort by priority (descending)
-		std::ranges::sort(sorted_handles_, [this](RegionHandle a, RegionHandle b) {
-			const auto& region_a = regions_.at(a);
-			const auto& region_b = regions_.at(b);
-			return region_a.priority > region_b.priority; // Descending
-		});
+	/**
+	 * @brief Cells overlapped by bounds, matching the inclusive edges of Contains()
+	 */
+	[[nodiscard]] CellRange ComputeCellRange(const Rectangle& bounds) const {
+		const float min_x = std::floor(bounds.x / cell_size_);
+		const float min_y = std::floor(bounds.y / cell_size_);
+		const float max_x = std::floor((bounds.x + bounds.width) / cell_size_);
+		const float max_y = std::floor((bounds.y + bounds.height) / cell_size_);
+		const auto representable = [](const float cell) { return std::abs(cell) <= MAX_CELL_COORDINATE; };
+		if (!representable(min_x) || !representable(min_y) || !representable(max_x) || !representable(max_y)) {
+			return CellRange{.oversized = true};
+		}
+
+		const CellRange range{
+			.min_x = static_cast<int32_t>(min_x),
+			.min_y = static_cast<int32_t>(min_y),
+			.max_x = static_cast<int32_t>(max_x),
+			.max_y = static_cast<int32_t>(max_y),
+			.oversized = false,
+		};
+		const int64_t columns = static_cast<int64_t>(range.max_x) - range.min_x + 1;
+		const int64_t rows = static_cast<int64_t>(range.max_y) - range.min_y + 1;
+		if (columns > 0 && rows > 0 && columns * rows > MAX_CELLS_PER_REGION) {
+			return CellRange{.oversized = true};
+		}
+		return range;
+	}
 
-		needs_sort_ = false;
+	void InsertIntoGrid(const RegionHandle handle, const CellRange& range) {
+		if (range.oversized) {
+			oversized_.push_back(handle);
+			return;
+		}
+		for (int32_t y = range.min_y; y <= range.max_y; ++y) {
+			for (int32_t x = range.min_x; x <= range.max_x; ++x) {
+				cells_[CellKey(x, y)].push_back(handle);
+			}
+		}
+	}
+
+	static void EraseHandle(std::vector<RegionHandle>& handles, const RegionHandle handle) {
+		if (const auto it = std::ranges::find(handles, handle); it != handles.end()) {
+			*it = handles.back();
+			handles.pop_back();
+		}
+	}
+
+	void RemoveFromGrid(const RegionHandle handle, const CellRange& range) {
+		if (range.oversized) {
+			EraseHandle(oversized_, handle);
+			return;
+		}
+		for (int32_t y = range.min_y; y <= range.max_y; ++y) {
+			for (int32_t x = range.min_x; x <= range.max_x; ++x) {
+				const auto it = cells_.find(CellKey(x, y));
+				if (it == cells_.end()) {
+					continue;
+				}
+				EraseHandle(it->second, handle);
+				if (it->second.empty()) {
+					cells_.erase(it);
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief Append the enabled regions among handles that contain the point
+	 */
+	void CollectHits(
+		const std::vector<RegionHandle>& handles,
+		const float x,
+		const float y,
+		std::vector<RegionHandle>& hits
+	) const {
+		for (const RegionHandle handle : handles) {
+			const auto& region = regions_.at(handle).region;
+			if (region.enabled && Contains(region.bounds, x, y)) {
+				hits.push_back(handle);
+			}
+		}
 	}
 
 	/**
@@ -295,9 +432,10 @@ private:
 		return x >= rect.x && x <= rect.x + rect.width && y >= rect.y && y <= rect.y + rect.height;
 	}
 
-	std::unordered_map<RegionHandle, EventRegion> regions_; ///< Map of stable ID to region
-	std::vector<RegionHandle> sorted_handles_;              ///< Cached sorted list of handles
-	RegionHandle next_id_{0};                               ///< Next unique ID to assign
-	bool needs_sort_{false};                                ///< Flag indicating sort is needed
+	std::unordered_map<RegionHandle, Entry> regions_;               ///< Map of stable ID to region
+	std::unordered_map<uint64_t, std::vector<RegionHandle>> cells_; ///< Grid cell key to overlapping regions
+	std::vector<RegionHandle> oversized_;                           ///< Regions too large for the grid
+	RegionHandle next_id_{0};                                       ///< Next unique ID to assign
+	float cell_size_{DEFAULT_CELL_SIZE};                            ///< Grid cell edge length in pixels
 };
 } // namespace engine::ui
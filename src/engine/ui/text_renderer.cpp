@@ -1,20 +1,22 @@
 module;
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <fstream>
+#include <functional>
 #include <memory>
 #include <optional>
+#include <ranges>
+#include <spdlog/spdlog.h>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
-// stb_rect_pack for improved packing (include before stb_truetype)
-#define STB_RECT_PACK_IMPLEMENTATION
-#include <stb_rect_pack.h>
-
 // stb_truetype for font loading
 #define STB_TRUETYPE_IMPLEMENTATION
 #include <stb_truetype.h>
@@ -29,14 +31,379 @@ import engine.assets;
 
 namespace engine::ui::text_renderer {
 
-// Helper to store stbtt_packedchar data
-struct PackedCharData {
-	stbtt_packedchar packed_chars[224]; // ASCII 32-255 (224 characters)
+namespace {
+// Glyphs are rasterized at twice their size in each direction and prefiltered, as the baked atlas did
+constexpr int GLYPH_OVERSAMPLE = 2;
+// Empty border around each glyph so linear filtering never picks up a neighbour
+constexpr int GLYPH_PADDING = 1;
+// Distance in generated pixels that an SDF glyph's field extends past its outline, and the value on the outline
+constexpr int SDF_SPREAD = 6;
+constexpr unsigned char SDF_ON_EDGE = 128;
+constexpr size_t NO_PAGE = SIZE_MAX;
+// Codepoints looked up through a flat array instead of the glyph map
+constexpr uint32_t ASCII_GLYPH_COUNT = 128;
+} // namespace
+
+// ShelfPacker implementation
+ShelfPacker::ShelfPacker(const int width, const int height) : width_(width), height_(height) {}
+
+std::optional<AtlasRegion> ShelfPacker::Allocate(const int width, const int height) {
+	if (width <= 0 || height <= 0 || width > width_ || height > height_) {
+		return std::nullopt;
+	}
+
+	// Shortest shelf with room, so short glyphs don't use up the tall shelves
+	Shelf* best = nullptr;
+	for (Shelf& shelf : shelves_) {
+		if (shelf.height >= height && shelf.used_width + width <= width_ && (!best || shelf.height < best->height)) {
+			best = &shelf;
+		}
+	}
+
+	// A shelf more than half as tall again wastes too much; open a new one while the page has room
+	const bool fits_new_shelf = next_shelf_y_ + height <= height_;
+	if (!best || (best->height * 2 > height * 3 && fits_new_shelf)) {
+		if (!fits_new_shelf) {
+			return std::nullopt;
+		}
+		shelves_.push_back({.y = next_shelf_y_, .height = height, .used_width = 0});
+		next_shelf_y_ += height;
+		best = &shelves_.back();
+	}
+
+	const AtlasRegion region{.x = best->used_width, .y = best->y};
+	best->used_width += width;
+	return region;
+}
+
+void ShelfPacker::Reset() {
+	shelves_.clear();
+	next_shelf_y_ = 0;
+}
+
+struct FontAtlas::Impl {
+	struct Page {
+		uint32_t texture_id = 0;
+		ShelfPacker packer;
+		std::vector<uint8_t> coverage;     // CPU copy of the page's alpha, the source of sub-image uploads
+		std::vector<uint32_t> codepoints;  // Glyphs on this page, dropped together on eviction
+		uint64_t last_used_frame = 0;
+		int dirty_x0 = 0;                  // Bounds of glyphs not uploaded yet; empty when x0 >= x1
+		int dirty_y0 = 0;
+		int dirty_x1 = 0;
+		int dirty_y1 = 0;
+	};
+
+	struct CachedGlyph {
+		GlyphMetrics metrics;
+		size_t page = NO_PAGE; // NO_PAGE for glyphs without a bitmap, such as space
+	};
+
+	using GlyphMap = std::unordered_map<uint32_t, CachedGlyph>;
+
+	std::vector<uint8_t> font_data; // stbtt_fontinfo points into this, so it must outlive font_info
+	stbtt_fontinfo font_info{};
+	float scale = 0.0F;
+	std::string texture_name;
+	GlyphCacheOptions options;
+
+	std::vector<Page> pages;
+	GlyphMap glyphs;
+	std::unordered_set<uint32_t> missing;
+	std::array<CachedGlyph*, ASCII_GLYPH_COUNT> ascii{};
+	uint64_t frame = 0;
+	size_t evicted_pages = 0;
+	uint32_t next_texture_serial = 0;
+
+	// Evicted glyphs and textures stay alive until the next frame, since pointers and quads from this one may still
+	// refer to them
+	std::vector<GlyphMap::node_type> retired_glyphs;
+	std::vector<uint32_t> retired_textures;
+
+	std::vector<uint8_t> scratch;
+
+	uint32_t CreatePageTexture() {
+		rendering::TextureCreateInfo tex_info{};
+		tex_info.width = static_cast<uint32_t>(options.page_size);
+		tex_info.height = static_cast<uint32_t>(options.page_size);
+		tex_info.format = rendering::TextureFormat::RGBA8;
+		tex_info.data = nullptr; // Only rasterized regions are ever sampled, and those are uploaded
+		tex_info.parameters = {
+			.min_filter = rendering::TextureFilter::Linear,
+			.mag_filter = rendering::TextureFilter::Linear,
+			.wrap_s = rendering::TextureWrap::ClampToEdge,
+			.wrap_t = rendering::TextureWrap::ClampToEdge,
+			.generate_mipmaps = false
+		};
+		auto& texture_mgr = rendering::GetRenderer().GetTextureManager();
+		return texture_mgr.CreateTexture(texture_name + "_" + std::to_string(next_texture_serial++), tex_info);
+	}
+
+	void AddPage() {
+		pages.push_back({
+			.texture_id = CreatePageTexture(),
+			.packer = ShelfPacker(options.page_size, options.page_size),
+			.coverage = std::vector<uint8_t>(static_cast<size_t>(options.page_size) * options.page_size, 0),
+			.codepoints = {},
+			.last_used_frame = frame
+		});
+	}
+
+	// Upload the page's glyphs that have not reached its texture yet
+	void UploadDirty(Page& page) {
+		if (page.dirty_x0 >= page.dirty_x1) {
+			return;
+		}
+
+		// Expand coverage to the atlas format: white RGB with coverage in alpha
+		const int width = page.dirty_x1 - page.dirty_x0;
+		const int height = page.dirty_y1 - page.dirty_y0;
+		scratch.resize(static_cast<size_t>(width) * height * 4);
+		size_t out = 0;
+		for (int y = page.dirty_y0; y < page.dirty_y1; ++y) {
+			const uint8_t* row = page.coverage.data() + static_cast<size_t>(y) * options.page_size;
+			for (int x = page.dirty_x0; x < page.dirty_x1; ++x) {
+				scratch[out++] = 255;
+				scratch[out++] = 255;
+				scratch[out++] = 255;
+				scratch[out++] = row[x];
+			}
+		}
+
+		rendering::TextureManager::UpdateTexture(
+			page.texture_id,
+			scratch.data(),
+			static_cast<uint32_t>(page.dirty_x0),
+			static_cast<uint32_t>(page.dirty_y0),
+			static_cast<uint32_t>(width),
+			static_cast<uint32_t>(height)
+		);
+		page.dirty_x0 = page.dirty_x1 = 0;
+	}
+
+	// Drop every glyph on the page and give it a fresh texture, keeping the old one until the frame is over. Quads
+	// from this frame may still sample glyphs rasterized since the last flush, so those reach the old texture first.
+	void EvictPage(const size_t index) {
+		Page& page = pages[index];
+		UploadDirty(page);
+		for (const uint32_t codepoint : page.codepoints) {
+			retired_glyphs.push_back(glyphs.extract(codepoint));
+			if (codepoint < ASCII_GLYPH_COUNT) {
+				ascii[codepoint] = nullptr;
+			}
+		}
+		page.codepoints.clear();
+		retired_textures.push_back(page.texture_id);
+		page.texture_id = CreatePageTexture();
+		page.packer.Reset();
+		std::ranges::fill(page.coverage, uint8_t{0});
+		page.last_used_frame = frame;
+		++evicted_pages;
+
+		// Retained UI geometry holds the evicted texture coordinates
+		batch_renderer::BatchRenderer::InvalidateRetained();
+		spdlog::debug("[FontAtlas] Evicted glyph page {} of {}", index, texture_name);
+	}
+
+	// Find room on an existing page, then a new page, then the least recently used page
+	std::optional<std::pair<size_t, AtlasRegion>> Allocate(const int width, const int height) {
+		for (size_t i = 0; i < pages.size(); ++i) {
+			if (auto region = pages[i].packer.Allocate(width, height)) {
+				return std::pair{i, *region};
+			}
+		}
+		if (pages.size() < options.max_pages) {
+			AddPage();
+		}
+		else {
+			const auto lru = std::ranges::min_element(pages, {}, &Page::last_used_frame);
+			EvictPage(static_cast<size_t>(lru - pages.begin()));
+		}
+		for (size_t i = pages.size(); i-- > 0;) {
+			if (pages[i].codepoints.empty()) {
+				if (auto region = pages[i].packer.Allocate(width, height)) {
+					return std::pair{i, *region};
+				}
+			}
+		}
+		return std::nullopt; // Larger than a whole page
+	}
+
+	const GlyphMetrics* Insert(const uint32_t codepoint, const CachedGlyph& cached) {
+		CachedGlyph& inserted = glyphs.emplace(codepoint, cached).first->second;
+		if (codepoint < ASCII_GLYPH_COUNT) {
+			ascii[codepoint] = &inserted;
+		}
+		return &inserted.metrics;
+	}
+
+	// Reserve a padded width x height rectangle for the glyph and grow its page's pending upload to cover it.
+	// Returns the page and the top-left of the glyph's own pixels.
+	std::optional<std::pair<size_t, AtlasRegion>> Place(const uint32_t codepoint, const int width, const int height) {
+		const auto placement = Allocate(width + GLYPH_PADDING * 2, height + GLYPH_PADDING * 2);
+		if (!placement) {
+			spdlog::warn("[FontAtlas] Glyph U+{:04X} does not fit in a {} px page", codepoint, options.page_size);
+			return std::nullopt;
+		}
+		const auto [page_index, region] = *placement;
+		Page& page = pages[page_index];
+		const int x1 = region.x + width + GLYPH_PADDING * 2;
+		const int y1 = region.y + height + GLYPH_PADDING * 2;
+		if (page.dirty_x0 >= page.dirty_x1) {
+			page.dirty_x0 = region.x;
+			page.dirty_y0 = region.y;
+			page.dirty_x1 = x1;
+			page.dirty_y1 = y1;
+		}
+		else {
+			page.dirty_x0 = std::min(page.dirty_x0, region.x);
+			page.dirty_y0 = std::min(page.dirty_y0, region.y);
+			page.dirty_x1 = std::max(page.dirty_x1, x1);
+			page.dirty_y1 = std::max(page.dirty_y1, y1);
+		}
+		page.codepoints.push_back(codepoint);
+		page.last_used_frame = frame;
+		return std::pair{page_index, AtlasRegion{.x = region.x + GLYPH_PADDING, .y = region.y + GLYPH_PADDING}};
+	}
+
+	const GlyphMetrics* Store(
+		const uint32_t codepoint,
+		CachedGlyph cached,
+		const size_t page_index,
+		const AtlasRegion& region,
+		const int width,
+		const int height
+	) {
+		const auto page_size = static_cast<float>(options.page_size);
+		cached.metrics.atlas_rect = batch_renderer::Rectangle(
+			static_cast<float>(region.x) / page_size,
+			static_cast<float>(region.y) / page_size,
+			static_cast<float>(width) / page_size,
+			static_cast<float>(height) / page_size
+		);
+		cached.metrics.texture_id = pages[page_index].texture_id;
+		cached.page = page_index;
+		return Insert(codepoint, cached);
+	}
+
+	const GlyphMetrics* RasterizeCoverage(const uint32_t codepoint, const int glyph, CachedGlyph cached) {
+		const float scale_x = scale * GLYPH_OVERSAMPLE;
+		const float scale_y = scale * GLYPH_OVERSAMPLE;
+		int x0 = 0;
+		int y0 = 0;
+		int x1 = 0;
+		int y1 = 0;
+		stbtt_GetGlyphBitmapBoxSubpixel(&font_info, glyph, scale_x, scale_y, 0.0F, 0.0F, &x0, &y0, &x1, &y1);
+		if (x1 <= x0 || y1 <= y0) {
+			return Insert(codepoint, cached);
+		}
+
+		// The prefilter needs oversample - 1 extra pixels to spread into
+		const int width = x1 - x0 + GLYPH_OVERSAMPLE - 1;
+		const int height = y1 - y0 + GLYPH_OVERSAMPLE - 1;
+		const auto placement = Place(codepoint, width, height);
+		if (!placement) {
+			return nullptr;
+		}
+		const auto [page_index, region] = *placement;
+
+		float sub_x = 0.0F;
+		float sub_y = 0.0F;
+		stbtt_MakeGlyphBitmapSubpixelPrefilter(
+			&font_info,
+			pages[page_index].coverage.data() + static_cast<size_t>(region.y) * options.page_size + region.x,
+			width,
+			height,
+			options.page_size,
+			scale_x,
+			scale_y,
+			0.0F,
+			0.0F,
+			GLYPH_OVERSAMPLE,
+			GLYPH_OVERSAMPLE,
+			&sub_x,
+			&sub_y,
+			glyph
+		);
+
+		constexpr float inverse_oversample = 1.0F / GLYPH_OVERSAMPLE;
+		cached.metrics.bearing = batch_renderer::Vector2(
+			static_cast<float>(x0) * inverse_oversample + sub_x,
+			static_cast<float>(y0) * inverse_oversample + sub_y
+		);
+		cached.metrics.size = batch_renderer::Vector2(
+			static_cast<float>(width) * inverse_oversample,
+			static_cast<float>(height) * inverse_oversample
+		);
+		return Store(codepoint, cached, page_index, region, width, height);
+	}
+
+	const GlyphMetrics* RasterizeSdf(const uint32_t codepoint, const int glyph, CachedGlyph cached) {
+		int width = 0;
+		int height = 0;
+		int x_offset = 0;
+		int y_offset = 0;
+		unsigned char* field = stbtt_GetGlyphSDF(
+			&font_info,
+			scale,
+			glyph,
+			SDF_SPREAD,
+			SDF_ON_EDGE,
+			static_cast<float>(SDF_ON_EDGE) / SDF_SPREAD,
+			&width,
+			&height,
+			&x_offset,
+			&y_offset
+		);
+		if (!field) {
+			return Insert(codepoint, cached); // No outline, such as space
+		}
+
+		const auto placement = Place(codepoint, width, height);
+		if (placement) {
+			const auto [page_index, region] = *placement;
+			uint8_t* destination =
+				pages[page_index].coverage.data() + static_cast<size_t>(region.y) * options.page_size + region.x;
+			for (int row = 0; row < height; ++row) {
+				std::memcpy(
+					destination + static_cast<size_t>(row) * options.page_size,
+					field + static_cast<size_t>(row) * width,
+					static_cast<size_t>(width)
+				);
+			}
+		}
+		stbtt_FreeSDF(field, nullptr);
+		if (!placement) {
+			return nullptr;
+		}
+
+		// The field includes the spread around the outline, so the quad does too
+		cached.metrics.bearing =
+			batch_renderer::Vector2(static_cast<float>(x_offset), static_cast<float>(y_offset));
+		cached.metrics.size = batch_renderer::Vector2(static_cast<float>(width), static_cast<float>(height));
+		return Store(codepoint, cached, placement->first, placement->second, width, height);
+	}
+
+	const GlyphMetrics* Rasterize(const uint32_t codepoint) {
+		const int glyph = stbtt_FindGlyphIndex(&font_info, static_cast<int>(codepoint));
+		if (glyph == 0) {
+			missing.insert(codepoint);
+			return nullptr;
+		}
+
+		int advance = 0;
+		int left_side_bearing = 0;
+		stbtt_GetGlyphHMetrics(&font_info, glyph, &advance, &left_side_bearing);
+
+		CachedGlyph cached;
+		cached.metrics.advance = static_cast<float>(advance) * scale;
+		return options.sdf ? RasterizeSdf(codepoint, glyph, cached) : RasterizeCoverage(codepoint, glyph, cached);
+	}
 };
 
 // FontAtlas implementation
-FontAtlas::FontAtlas(const std::string& font_path, int font_size_px) : font_size_(font_size_px) {
-
+FontAtlas::FontAtlas(const std::string& font_path, const int font_size_px, const GlyphCacheOptions& options) :
+		font_size_(font_size_px) {
 	// Load font file through asset manager
 	auto font_data_opt = assets::AssetManager::LoadBinaryFile(font_path);
 	if (!font_data_opt.has_value()) {
@@ -44,119 +411,120 @@ FontAtlas::FontAtlas(const std::string& font_path, int font_size_px) : font_size
 		return;
 	}
 
-	const std::vector<uint8_t>& file_data = font_data_opt.value();
+	auto impl = std::make_unique<Impl>();
+	impl->font_data = std::move(font_data_opt.value());
+	impl->options = options;
+	impl->options.max_pages = std::max<size_t>(options.max_pages, 1);
+	impl->texture_name = font_path + "_atlas_" + std::to_string(font_size_px);
 
 	// Initialize stb_truetype
-	stbtt_fontinfo font_info;
-	if (!stbtt_InitFont(&font_info, file_data.data(), 0)) {
+	if (!stbtt_InitFont(&impl->font_info, impl->font_data.data(), 0)) {
 		// Failed to parse font
 		return;
 	}
 
 	// Calculate scale for desired pixel size
-	const float scale = stbtt_ScaleForPixelHeight(&font_info, static_cast<float>(font_size_px));
+	impl->scale = stbtt_ScaleForPixelHeight(&impl->font_info, static_cast<float>(font_size_px));
 
 	// Get font vertical metrics
 	int ascent;
 	int descent;
 	int line_gap;
-	stbtt_GetFontVMetrics(&font_info, &ascent, &descent, &line_gap);
-	ascent_ = static_cast<float>(ascent) * scale;
-	descent_ = static_cast<float>(descent) * scale;
-	line_gap_ = static_cast<float>(line_gap) * scale;
-
-	atlas_width_ = 512;
-	atlas_height_ = 512;
-	std::vector<uint8_t> atlas_bitmap(static_cast<size_t>(atlas_width_ * atlas_height_), 0);
-
-	PackedCharData packed_data{};
-	stbtt_pack_context pack_context;
+	stbtt_GetFontVMetrics(&impl->font_info, &ascent, &descent, &line_gap);
+	ascent_ = static_cast<float>(ascent) * impl->scale;
+	descent_ = static_cast<float>(descent) * impl->scale;
+	line_gap_ = static_cast<float>(line_gap) * impl->scale;
 
-	if (!stbtt_PackBegin(&pack_context, atlas_bitmap.data(), atlas_width_, atlas_height_, 0, 1, nullptr)) {
+	impl->AddPage();
+	if (impl->pages.front().texture_id == 0) {
 		return;
 	}
+	pimpl_ = std::move(impl);
+}
 
-	stbtt_PackSetOversampling(&pack_context, 2, 2);
-
-	stbtt_pack_range range;
-	range.font_size = static_cast<float>(font_size_px);
-	range.first_unicode_codepoint_in_range = 32;
-	range.array_of_unicode_codepoints = nullptr;
-	range.num_chars = 224;
-	range.chardata_for_range = packed_data.packed_chars;
-
-	if (!stbtt_PackFontRanges(&pack_context, file_data.data(), 0, &range, 1)) {
-		// Packing failed, but continue with what we have
+FontAtlas::~FontAtlas() {
+	TextLayout::ClearCache();
+	if (!pimpl_) {
+		return;
 	}
+	auto& texture_mgr = rendering::GetRenderer().GetTextureManager();
+	for (const Impl::Page& page : pimpl_->pages) {
+		texture_mgr.DestroyTexture(page.texture_id);
+	}
+	for (const uint32_t texture_id : pimpl_->retired_textures) {
+		texture_mgr.DestroyTexture(texture_id);
+	}
+}
 
-	stbtt_PackEnd(&pack_context);
-
-	// stbtt_packedchar stores pixel coordinates in the atlas texture
-	for (int i = 0; i < 224; ++i) {
-		const uint32_t codepoint = 32 + i;
-		const stbtt_packedchar& pc = packed_data.packed_chars[i];
+const GlyphMetrics* FontAtlas::GetGlyph(const uint32_t codepoint) const {
+	if (!pimpl_) {
+		return nullptr;
+	}
+	Impl::CachedGlyph* cached = nullptr;
+	if (codepoint < ASCII_GLYPH_COUNT) {
+		cached = pimpl_->ascii[codepoint];
+	}
+	else if (const auto it = pimpl_->glyphs.find(codepoint); it != pimpl_->glyphs.end()) {
+		cached = &it->second;
+	}
+	if (cached) {
+		if (cached->page != NO_PAGE) {
+			pimpl_->pages[cached->page].last_used_frame = pimpl_->frame;
+		}
+		return &cached->metrics;
+	}
+	if (pimpl_->missing.contains(codepoint)) {
+		return nullptr;
+	}
+	return pimpl_->Rasterize(codepoint);
+}
 
-		// Normalize pixel coordinates to [0,1] range
-		float const uv_x = pc.x0 / static_cast<float>(atlas_width_);
-		float const uv_y = pc.y0 / static_cast<float>(atlas_height_);
-		float const uv_w = (pc.x1 - pc.x0) / static_cast<float>(atlas_width_);
-		float const uv_h = (pc.y1 - pc.y0) / static_cast<float>(atlas_height_);
+uint32_t FontAtlas::GetTextureId() const { return pimpl_ ? pimpl_->pages.front().texture_id : 0; }
 
-		GlyphMetrics metrics;
-		metrics.atlas_rect = batch_renderer::Rectangle(uv_x, uv_y, uv_w, uv_h);
-		metrics.bearing = batch_renderer::Vector2(pc.xoff, pc.yoff);
-		metrics.advance = pc.xadvance;
-		metrics.size = batch_renderer::Vector2(pc.xoff2 - pc.xoff, pc.yoff2 - pc.yoff);
-
-		glyphs_[codepoint] = metrics;
-	}
-
-	// Upload atlas texture to GPU
-	auto& renderer = rendering::GetRenderer();
-	auto& texture_mgr = renderer.GetTextureManager();
-
-	// Convert grayscale to RGBA (white RGB, grayscale in alpha channel)
-	std::vector<uint8_t> rgba_bitmap;
-	rgba_bitmap.reserve(atlas_bitmap.size() * 4);
-	for (uint8_t const gray : atlas_bitmap) {
-		rgba_bitmap.push_back(255);  // R
-		rgba_bitmap.push_back(255);  // G
-		rgba_bitmap.push_back(255);  // B
-		rgba_bitmap.push_back(gray); // A (coverage)
-	}
-
-	rendering::TextureCreateInfo tex_info{};
-	tex_info.width = static_cast<uint32_t>(atlas_width_);
-	tex_info.height = static_cast<uint32_t>(atlas_height_);
-	tex_info.format = rendering::TextureFormat::RGBA8;
-	tex_info.data = rgba_bitmap.data();
-	tex_info.parameters = {
-		.min_filter = rendering::TextureFilter::Linear,
-		.mag_filter = rendering::TextureFilter::Linear,
-		.wrap_s = rendering::TextureWrap::ClampToEdge,
-		.wrap_t = rendering::TextureWrap::ClampToEdge,
-		.generate_mipmaps = false
-	};
+bool FontAtlas::IsSdf() const { return pimpl_ && pimpl_->options.sdf; }
 
-	atlas_texture_id_ = texture_mgr.CreateTexture(font_path + "_atlas_" + std::to_string(font_size_px), tex_info);
+void FontAtlas::BeginFrame() {
+	if (!pimpl_) {
+		return;
+	}
+	++pimpl_->frame;
+	pimpl_->retired_glyphs.clear();
+	if (!pimpl_->retired_textures.empty()) {
+		auto& texture_mgr = rendering::GetRenderer().GetTextureManager();
+		for (const uint32_t texture_id : pimpl_->retired_textures) {
+			texture_mgr.DestroyTexture(texture_id);
+		}
+		pimpl_->retired_textures.clear();
+	}
 }
 
-FontAtlas::~FontAtlas() {
-	if (atlas_texture_id_ != 0) {
-		auto& renderer = rendering::GetRenderer();
-		auto& texture_mgr = renderer.GetTextureManager();
-		texture_mgr.DestroyTexture(atlas_texture_id_);
+void FontAtlas::FlushUploads() const {
+	if (!pimpl_) {
+		return;
+	}
+	for (Impl::Page& page : pimpl_->pages) {
+		pimpl_->UploadDirty(page);
 	}
 }
 
-const GlyphMetrics* FontAtlas::GetGlyph(uint32_t codepoint) const {
-	auto it = glyphs_.find(codepoint);
-	if (it != glyphs_.end()) {
-		return &it->second;
+void FontAtlas::TouchTexture(const uint32_t texture_id) const {
+	if (!pimpl_) {
+		return;
+	}
+	for (Impl::Page& page : pimpl_->pages) {
+		if (page.texture_id == texture_id) {
+			page.last_used_frame = pimpl_->frame;
+			return;
+		}
 	}
-	return nullptr;
 }
 
+size_t FontAtlas::GetPageCount() const { return pimpl_ ? pimpl_->pages.size() : 0; }
+
+size_t FontAtlas::GetCachedGlyphCount() const { return pimpl_ ? pimpl_->glyphs.size() : 0; }
+
+size_t FontAtlas::GetEvictedPageCount() const { return pimpl_ ? pimpl_->evicted_pages : 0; }
+
 // UTF-8 decoding implementation
 namespace utf8 {
 std::vector<uint32_t> Decode(const std::string& utf8_string) {
@@ -233,6 +601,13 @@ std::vector<uint32_t> Decode(const std::string& utf8_string) {
 } // namespace utf8
 
 // TextLayout implementation
+namespace {
+// Factor from the atlas's metrics to the requested size; 0 keeps the atlas's own size
+float LayoutScale(const FontAtlas& font, const float font_size) {
+	return font_size > 0.0F ? font_size / static_cast<float>(font.GetFontSize()) : 1.0F;
+}
+} // namespace
+
 std::vector<PositionedGlyph>
 TextLayout::Layout(const std::string& text, const FontAtlas& font, const LayoutOptions& options) {
 	std::vector<PositionedGlyph> result;
@@ -243,9 +618,11 @@ TextLayout::Layout(const std::string& text, const FontAtlas& font, const LayoutO
 
 	// Decode UTF-8
 	auto codepoints = utf8::Decode(text);
+	const float scale = LayoutScale(font, options.font_size);
+	const float line_advance = font.GetLineHeight() * scale * options.line_height;
 
 	float cursor_x = 0.0F;
-	float cursor_y = font.GetAscent(); // Start at baseline
+	float cursor_y = font.GetAscent() * scale; // Start at baseline
 	result.reserve(codepoints.size());
 
 	std::vector<PositionedGlyph> current_line;
@@ -271,18 +648,19 @@ TextLayout::Layout(const std::string& text, const FontAtlas& font, const LayoutO
 			current_line.clear();
 
 			cursor_x = 0.0F;
-			cursor_y += font.GetLineHeight() * options.line_height;
+			cursor_y += line_advance;
 			line_width = 0.0F;
 			continue;
 		}
 
 		const GlyphMetrics* glyph = font.GetGlyph(cp);
 		if (!glyph) {
-			continue; // Skip missing glyphs (replacement char U+FFFD not in atlas)
+			continue; // Skip glyphs the font does not have
 		}
 
 		// Check if line wrapping needed
-		if (options.max_width > 0.0F && cursor_x + glyph->advance > options.max_width && !current_line.empty()) {
+		const float advance = glyph->advance * scale;
+		if (options.max_width > 0.0F && cursor_x + advance > options.max_width && !current_line.empty()) {
 			// Apply alignment and flush current line
 			if (options.h_align != HorizontalAlign::Left) {
 				float offset = 0.0F;
@@ -300,18 +678,19 @@ TextLayout::Layout(const std::string& text, const FontAtlas& font, const LayoutO
 			current_line.clear();
 
 			cursor_x = 0.0F;
-			cursor_y += font.GetLineHeight() * options.line_height;
+			cursor_y += line_advance;
 			line_width = 0.0F;
 		}
 
 		// Position glyph
 		PositionedGlyph pg;
 		pg.codepoint = cp;
-		pg.position = batch_renderer::Vector2(cursor_x + glyph->bearing.x, cursor_y + glyph->bearing.y);
+		pg.position = batch_renderer::Vector2(cursor_x + glyph->bearing.x * scale, cursor_y + glyph->bearing.y * scale);
+		pg.size = batch_renderer::Vector2(glyph->size.x * scale, glyph->size.y * scale);
 		pg.metrics = glyph;
 
 		current_line.push_back(pg);
-		cursor_x += glyph->advance;
+		cursor_x += advance;
 		line_width = cursor_x;
 	}
 
@@ -334,7 +713,7 @@ TextLayout::Layout(const std::string& text, const FontAtlas& font, const LayoutO
 
 	// Apply vertical alignment (if needed)
 	if (options.v_align != VerticalAlign::Top) {
-		float const total_height = cursor_y + font.GetDescent();
+		float const total_height = cursor_y + font.GetDescent() * scale;
 		float offset_y = 0.0F;
 
 		// Note: This only makes sense when rendering into a bounded rect
@@ -354,13 +733,19 @@ TextLayout::Layout(const std::string& text, const FontAtlas& font, const LayoutO
 	return result;
 }
 
-batch_renderer::Rectangle TextLayout::MeasureText(const std::string& text, const FontAtlas& font, float max_width) {
+batch_renderer::Rectangle TextLayout::MeasureText(
+	const std::string& text,
+	const FontAtlas& font,
+	const float max_width,
+	const float font_size
+) {
 	if (text.empty() || !font.IsValid()) {
 		return batch_renderer::Rectangle(0, 0, 0, 0);
 	}
 
 	// Decode UTF-8
 	auto codepoints = utf8::Decode(text);
+	const float scale = LayoutScale(font, font_size);
 
 	float cursor_x = 0.0F;
 	float max_line_width = 0.0F;
@@ -383,29 +768,96 @@ batch_renderer::Rectangle TextLayout::MeasureText(const std::string& text, const
 		}
 
 		// Check wrapping (use same condition as Layout for consistency)
-		if (max_width > 0.0F && cursor_x + glyph->advance > max_width && has_content) {
+		const float advance = glyph->advance * scale;
+		if (max_width > 0.0F && cursor_x + advance > max_width && has_content) {
 			max_line_width = std::max(max_line_width, cursor_x);
 			cursor_x = 0.0F;
 			line_count++;
 			has_content = false;
 		}
 
-		cursor_x += glyph->advance;
+		cursor_x += advance;
 		has_content = true;
 	}
 
 	max_line_width = std::max(max_line_width, cursor_x);
 
-	const float total_height = static_cast<float>(line_count) * font.GetLineHeight();
+	const float total_height = static_cast<float>(line_count) * font.GetLineHeight() * scale;
 
 	return batch_renderer::Rectangle(0, 0, max_line_width, total_height);
 }
 
+// TextLayout cache. Defined ahead of the FontManager statics so it outlives the fonts, whose destructors clear it
+std::unordered_map<size_t, TextLayout::CacheEntry> TextLayout::cache_;
+uint64_t TextLayout::cache_frame_ = 0;
+
+namespace {
+size_t LayoutKeyHash(const std::string& text, const FontAtlas& font, const LayoutOptions& options) {
+	size_t hash = std::hash<std::string>()(text);
+	const auto combine = [&hash](const size_t value) { hash ^= value + 0x9E3779B9U + (hash << 6) + (hash >> 2); };
+	combine(std::hash<const FontAtlas*>()(&font));
+	combine(static_cast<size_t>(options.h_align));
+	combine(static_cast<size_t>(options.v_align));
+	combine(std::hash<float>()(options.max_width));
+	combine(std::hash<float>()(options.line_height));
+	combine(std::hash<float>()(options.font_size));
+	return hash;
+}
+} // namespace
+
+std::shared_ptr<const TextLayoutResult>
+TextLayout::LayoutCached(const std::string& text, const FontAtlas& font, const LayoutOptions& options) {
+	const size_t key = LayoutKeyHash(text, font, options);
+	const size_t atlas_generation = font.GetEvictedPageCount();
+
+	if (const auto it = cache_.find(key); it != cache_.end()) {
+		CacheEntry& entry = it->second;
+		if (entry.result->atlas_generation == atlas_generation && entry.font == &font && entry.options == options
+			&& entry.text == text) {
+			entry.last_used_frame = cache_frame_;
+			for (const uint32_t texture_id : entry.result->textures) {
+				font.TouchTexture(texture_id);
+			}
+			return entry.result;
+		}
+	}
+
+	// Stamped with the generation from before layout: if laying out evicts a page, the result is redone next time
+	auto result = std::make_shared<TextLayoutResult>();
+	result->glyphs = Layout(text, font, options);
+	result->bounds = MeasureText(text, font, options.max_width, options.font_size);
+	result->atlas_generation = atlas_generation;
+	for (const PositionedGlyph& glyph : result->glyphs) {
+		const uint32_t texture_id = glyph.metrics->texture_id;
+		if (texture_id != 0 && std::ranges::find(result->textures, texture_id) == result->textures.end()) {
+			result->textures.push_back(texture_id);
+		}
+	}
+
+	cache_.insert_or_assign(
+		key,
+		CacheEntry{.text = text, .font = &font, .options = options, .result = result, .last_used_frame = cache_frame_}
+	);
+	return result;
+}
+
+void TextLayout::BeginFrame() {
+	++cache_frame_;
+	std::erase_if(cache_, [](const auto& item) {
+		return cache_frame_ - item.second.last_used_frame > LAYOUT_CACHE_MAX_AGE;
+	});
+}
+
+void TextLayout::ClearCache() { cache_.clear(); }
+
+size_t TextLayout::GetCacheSize() { return cache_.size(); }
+
 // FontManager static members
 std::unordered_map<FontManager::FontKey, std::unique_ptr<FontAtlas>, FontManager::FontKeyHash> FontManager::fonts_;
 std::string FontManager::default_font_path_;
 int FontManager::default_font_size_ = 16;
 bool FontManager::initialized_ = false;
+GlyphCacheOptions FontManager::glyph_cache_options_;
 
 void FontManager::Initialize(const std::string& default_font_path, int default_font_size) {
 	if (initialized_) {
@@ -426,6 +878,18 @@ void FontManager::Shutdown() {
 	initialized_ = false;
 }
 
+void FontManager::BeginFrame() {
+	for (const auto& font : fonts_ | std::views::values) {
+		font->BeginFrame();
+	}
+}
+
+void FontManager::FlushUploads() {
+	for (const auto& font : fonts_ | std::views::values) {
+		font->FlushUploads();
+	}
+}
+
 FontAtlas* FontManager::GetDefaultFont() {
 	if (!initialized_) {
 		return nullptr;
@@ -434,7 +898,9 @@ FontAtlas* FontManager::GetDefaultFont() {
 }
 
 FontAtlas* FontManager::GetFont(const std::string& font_path, int font_size) {
-	FontKey const key{.path = font_path, .size = font_size};
+	// A distance field atlas serves every size, so all sizes share the entry for size 0
+	const bool sdf = glyph_cache_options_.sdf;
+	FontKey const key{.path = font_path, .size = sdf ? 0 : font_size};
 
 	auto it = fonts_.find(key);
 	if (it != fonts_.end()) {
@@ -442,7 +908,8 @@ FontAtlas* FontManager::GetFont(const std::string& font_path, int font_size) {
 	}
 
 	// Load font
-	auto font = std::make_unique<FontAtlas>(font_path, font_size);
+	const int atlas_size = sdf ? glyph_cache_options_.sdf_size : font_size;
+	auto font = std::make_unique<FontAtlas>(font_path, atlas_size, glyph_cache_options_);
 	if (!font->IsValid()) {
 		return nullptr;
 	}
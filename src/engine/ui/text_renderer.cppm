@@ -23,17 +23,90 @@ struct GlyphMetrics {
 	batch_renderer::Vector2 bearing;      ///< Offset from baseline to left/top of glyph
 	float advance{};                      ///< Horizontal advance to next glyph position
 	batch_renderer::Vector2 size;         ///< Glyph bitmap dimensions in pixels
+	uint32_t texture_id{};                ///< Atlas page texture holding the glyph (0 if it has no bitmap)
 };
 
 /**
- * @brief Font atlas containing pre-rasterized glyphs.
+ * @brief Position of a packed rectangle inside an atlas page, in pixels.
+ */
+struct AtlasRegion {
+	int x{};
+	int y{};
+};
+
+/**
+ * @brief Shelf packer for a single atlas page.
+ *
+ * Rectangles are placed left to right on horizontal shelves. A rectangle goes on the shortest existing shelf it
+ * fits, unless that shelf is much taller than the rectangle and there is still room to open a new one. Glyphs of
+ * one font size have similar heights, so shelves fill densely without the cost of a general rectangle packer.
  *
- * A FontAtlas loads a TrueType font and rasterizes all supported glyphs
- * into a single texture atlas. Currently supports ASCII and Latin-1 character
- * sets (codepoints 32-255).
+ * Space is only reclaimed by Reset(); FontAtlas evicts whole pages rather than individual glyphs.
+ */
+class ShelfPacker {
+public:
+	ShelfPacker(int width, int height);
+
+	/**
+	 * @brief Reserve a width x height rectangle.
+	 * @return Top-left corner of the rectangle, or std::nullopt if the page has no room for it
+	 */
+	[[nodiscard]] std::optional<AtlasRegion> Allocate(int width, int height);
+
+	/// Forget every allocation, making the whole page available again
+	void Reset();
+
+	[[nodiscard]] int GetWidth() const { return width_; }
+
+	[[nodiscard]] int GetHeight() const { return height_; }
+
+	/// Height from the top of the page down to the bottom of the last opened shelf
+	[[nodiscard]] int GetUsedHeight() const { return next_shelf_y_; }
+
+private:
+	struct Shelf {
+		int y;
+		int height;
+		int used_width;
+	};
+
+	std::vector<Shelf> shelves_;
+	int width_;
+	int height_;
+	int next_shelf_y_ = 0;
+};
+
+/**
+ * @brief Budget and glyph format for a font's glyph cache.
  *
- * The atlas uses a 512x512 grayscale (R8) texture with shelf-based packing.
- * Each font size requires a separate atlas (~256 KB of GPU memory).
+ * Each page is a page_size x page_size RGBA texture (1 MB at the default 512) plus a quarter of that in CPU-side
+ * coverage, so a font never holds more than max_pages of either.
+ *
+ * With sdf set, pages hold signed distance fields instead of coverage. A distance field stays sharp when scaled,
+ * so FontManager loads one atlas per font, generated at sdf_size, and lays it out at any requested size.
+ */
+struct GlyphCacheOptions {
+	int page_size = 512;   ///< Width and height of each atlas page in pixels
+	size_t max_pages = 4;  ///< Pages to fill before the least recently used one is evicted
+	bool sdf = false;      ///< Store signed distance fields, drawn with BatchRenderer::SubmitSdfQuad
+	int sdf_size = 48;     ///< Pixel size SDF glyphs are generated at when FontManager loads them
+};
+
+/**
+ * @brief Font atlas that rasterizes glyphs on first use.
+ *
+ * A FontAtlas loads a TrueType font and rasterizes glyphs into shelf-packed
+ * atlas pages the first time they are requested, so any codepoint the font
+ * covers (Cyrillic, CJK, ...) can be drawn without baking a huge range up front.
+ *
+ * Pages are created as needed up to GlyphCacheOptions::max_pages. When the
+ * budget is reached the least recently used page is evicted: its glyphs are
+ * dropped and rasterized again if they are requested later. Eviction also
+ * invalidates retained UI geometry, which holds the old texture coordinates.
+ *
+ * New glyphs are written to a CPU copy of their page and uploaded as one
+ * dirty rectangle per page by FlushUploads(), which BatchRenderer calls
+ * before it draws. Each font size requires a separate atlas.
  *
  * @note FontAtlas objects are typically managed by FontManager, not created directly.
  *
@@ -53,20 +126,21 @@ struct GlyphMetrics {
 class FontAtlas {
 public:
 	/**
-	 * @brief Load a TrueType font and generate atlas texture.
+	 * @brief Load a TrueType font and create its first atlas page.
 	 *
-	 * Loads a .ttf font file, rasterizes glyphs for ASCII + Latin-1 characters,
-	 * packs them into a texture atlas, and uploads to GPU.
+	 * Loads a .ttf font file and reads its metrics. No glyphs are rasterized
+	 * until they are requested through GetGlyph().
 	 *
 	 * @param font_path Path to TrueType (.ttf) font file
-	 * @param font_size_px Font size in pixels (recommended: 12-48)
+	 * @param font_size_px Font size in pixels (recommended: 12-48); for SDF atlases, the size glyphs are generated at
+	 * @param options Page size, page budget and glyph format for the glyph cache
 	 *
 	 * @note Check IsValid() after construction to verify successful loading.
-	 * @note Loading is CPU-intensive; use FontManager for caching.
+	 * @note Use FontManager for caching.
 	 *
 	 * @warning File must be accessible and contain valid TrueType data.
 	 */
-	FontAtlas(const std::string& font_path, int font_size_px);
+	FontAtlas(const std::string& font_path, int font_size_px, const GlyphCacheOptions& options = {});
 
 	~FontAtlas();
 
@@ -77,39 +151,70 @@ public:
 	/**
 	 * @brief Get glyph metrics for a Unicode codepoint.
 	 *
-	 * Retrieves pre-computed metrics for rendering a specific character.
-	 * Returns nullptr if the codepoint is not in the atlas (unsupported character).
+	 * Returns the cached metrics, rasterizing the glyph into an atlas page on
+	 * first use. Returns nullptr if the font has no glyph for the codepoint.
+	 * The cache is not observable through the metrics, so this stays const.
 	 *
 	 * @param codepoint Unicode codepoint value (e.g., 'A' = 65, 'é' = 0xE9)
-	 * @return Pointer to glyph metrics, or nullptr if codepoint not found
+	 * @return Pointer to glyph metrics, or nullptr if the font lacks the glyph
 	 *
-	 * @note Currently supports ASCII (32-126) and Latin-1 (128-255) only.
-	 * @note Returned pointer is valid for the lifetime of the FontAtlas.
+	 * @note Returned pointer stays valid until the next BeginFrame() after its
+	 *       page is evicted. Keep the codepoint, not the pointer, across frames.
 	 *
 	 * @code
 	 * auto* glyph = font->GetGlyph('A');
 	 * if (glyph) {
 	 *     float char_width = glyph->advance;
-	 *     // Render using glyph->atlas_rect for UV coordinates
+	 *     // Render using glyph->atlas_rect and glyph->texture_id
 	 * }
 	 * @endcode
 	 */
 	[[nodiscard]] const GlyphMetrics* GetGlyph(uint32_t codepoint) const;
 
 	/**
-	 * @brief Get atlas texture ID for rendering.
+	 * @brief Get the texture ID of the first atlas page.
 	 *
-	 * Returns the OpenGL texture ID of the font atlas texture.
-	 * Use this with BatchRenderer to render glyphs.
+	 * Glyphs can live on any page, so render with GlyphMetrics::texture_id.
 	 *
-	 * @return OpenGL texture ID (0 if atlas failed to load)
+	 * @return Texture ID (0 if the font failed to load)
+	 */
+	[[nodiscard]] uint32_t GetTextureId() const;
+
+	/**
+	 * @brief Start a new frame for LRU tracking.
 	 *
-	 * @code
-	 * uint32_t texId = font->GetTextureId();
-	 * BatchRenderer::SubmitQuad(rect, color, uv_coords, texId);
-	 * @endcode
+	 * Releases the textures and metrics of pages evicted during the previous
+	 * frame, which earlier draws may still have referenced.
 	 */
-	[[nodiscard]] uint32_t GetTextureId() const { return atlas_texture_id_; }
+	void BeginFrame();
+
+	/**
+	 * @brief Upload glyphs rasterized since the last call.
+	 *
+	 * Each page with new glyphs is uploaded with a single sub-image update
+	 * covering all of them.
+	 */
+	void FlushUploads() const;
+
+	/**
+	 * @brief Mark the page with this texture as used this frame.
+	 *
+	 * For glyphs drawn from a cached layout without going through GetGlyph(),
+	 * so their page is not mistaken for a cold one.
+	 *
+	 * @param texture_id Page texture, as in GlyphMetrics::texture_id
+	 */
+	void TouchTexture(uint32_t texture_id) const;
+
+	/// Number of atlas pages currently allocated
+	[[nodiscard]] size_t GetPageCount() const;
+
+	/// Number of glyphs currently rasterized into the atlas
+	[[nodiscard]] size_t GetCachedGlyphCount() const;
+
+	/// Number of pages evicted since the font was loaded. GlyphMetrics pointers obtained while this is unchanged
+	/// are still current.
+	[[nodiscard]] size_t GetEvictedPageCount() const;
 
 	/**
 	 * @brief Get font ascent (baseline to top).
@@ -141,23 +246,27 @@ public:
 	 */
 	[[nodiscard]] int GetFontSize() const { return font_size_; }
 
+	/**
+	 * @brief Check if the atlas stores signed distance fields.
+	 * @return true if glyphs must be drawn with BatchRenderer::SubmitSdfQuad
+	 */
+	[[nodiscard]] bool IsSdf() const;
+
 	/**
 	 * @brief Check if the atlas was successfully loaded.
 	 * @return true if atlas loaded successfully, false otherwise
 	 *
 	 * @note Always check this after constructing or accessing a font.
 	 */
-	[[nodiscard]] bool IsValid() const { return atlas_texture_id_ != 0; }
+	[[nodiscard]] bool IsValid() const { return pimpl_ != nullptr; }
 
 private:
-	std::unordered_map<uint32_t, GlyphMetrics> glyphs_;
-	uint32_t atlas_texture_id_ = 0;
+	struct Impl;
+	std::unique_ptr<Impl> pimpl_;
 	float ascent_ = 0.0F;
 	float descent_ = 0.0F;
 	float line_gap_ = 0.0F;
 	int font_size_ = 0;
-	int atlas_width_ = 0;
-	int atlas_height_ = 0;
 };
 
 /**
@@ -188,6 +297,9 @@ struct LayoutOptions {
 	VerticalAlign v_align = VerticalAlign::Top;      ///< Vertical alignment
 	float max_width = 0.0F;                          ///< Maximum width before wrapping (0 = no wrapping)
 	float line_height = 1.0F;                        ///< Line height multiplier (1.0 = default spacing)
+	float font_size = 0.0F;                          ///< Size to lay out at in pixels (0 = the atlas's own size)
+
+	bool operator==(const LayoutOptions&) const = default;
 };
 
 /**
@@ -199,7 +311,21 @@ struct LayoutOptions {
 struct PositionedGlyph {
 	uint32_t codepoint{};             ///< Unicode codepoint of this glyph
 	batch_renderer::Vector2 position; ///< Screen-space position (top-left)
-	const GlyphMetrics* metrics{};    ///< Pointer to glyph metrics (non-owning)
+	batch_renderer::Vector2 size;     ///< Screen-space quad size (metrics size scaled to the layout's font size)
+	const GlyphMetrics* metrics{};    ///< Pointer to glyph metrics (non-owning, see FontAtlas::GetGlyph)
+};
+
+/**
+ * @brief A cached layout: positioned glyphs with their bounds and atlas pages.
+ *
+ * Produced by TextLayout::LayoutCached(). The glyphs' metrics pointers are
+ * current while the font's GetEvictedPageCount() equals atlas_generation.
+ */
+struct TextLayoutResult {
+	std::vector<PositionedGlyph> glyphs;  ///< Same as TextLayout::Layout()
+	batch_renderer::Rectangle bounds;     ///< Same as TextLayout::MeasureText()
+	std::vector<uint32_t> textures;       ///< Atlas page textures the glyphs are drawn from
+	size_t atlas_generation{};            ///< FontAtlas::GetEvictedPageCount() when laid out
 };
 
 /**
@@ -246,6 +372,7 @@ public:
 	 * @return Vector of positioned glyphs in screen space
 	 *
 	 * @note Positions are relative to (0, 0). Offset by desired screen position when rendering.
+	 * @note options.font_size scales the layout; only SDF atlases stay sharp at sizes other than their own.
 	 * @note Empty string returns empty vector.
 	 * @note Missing glyphs are skipped (no rendering).
 	 *
@@ -261,9 +388,8 @@ public:
 	 * float offsetX = 100.0f, offsetY = 50.0f;
 	 * for (const auto& g : glyphs) {
 	 *     BatchRenderer::SubmitQuad(
-	 *         {offsetX + g.position.x, offsetY + g.position.y,
-	 *          g.metrics->size.x, g.metrics->size.y},
-	 *         color, g.metrics->atlas_rect, font->GetTextureId()
+	 *         {offsetX + g.position.x, offsetY + g.position.y, g.size.x, g.size.y},
+	 *         color, g.metrics->atlas_rect, g.metrics->texture_id
 	 *     );
 	 * }
 	 * @endcode
@@ -280,6 +406,7 @@ public:
 	 * @param text UTF-8 encoded text string
 	 * @param font Font atlas to use for measurements
 	 * @param max_width Maximum width before wrapping (0 = single line, no limit)
+	 * @param font_size Size to measure at in pixels (0 = the atlas's own size)
 	 * @return Bounding rectangle with width and height (x=0, y=0)
 	 *
 	 * @note Faster than Layout() for dimension queries only.
@@ -300,7 +427,64 @@ public:
 	 * @endcode
 	 */
 	static batch_renderer::Rectangle
-	MeasureText(const std::string& text, const FontAtlas& font, float max_width = 0.0F);
+	MeasureText(const std::string& text, const FontAtlas& font, float max_width = 0.0F, float font_size = 0.0F);
+
+	/// Frames a cached layout survives without being requested
+	static constexpr uint64_t LAYOUT_CACHE_MAX_AGE = 120;
+
+	/**
+	 * @brief Layout text through the layout cache.
+	 *
+	 * Returns the cached result for this (text, font, options) if there is a
+	 * current one, at the cost of hashing the text once. Otherwise lays the
+	 * text out, measures it and caches the result. A cached result is redone
+	 * when the font has evicted glyph pages since it was laid out.
+	 *
+	 * @param text UTF-8 encoded text string
+	 * @param font Font atlas containing the glyphs
+	 * @param options Layout configuration, including font_size
+	 * @return Shared layout; holding it keeps it alive after the cache drops it
+	 *
+	 * @code
+	 * // Each frame: a hash lookup, no decoding or glyph lookups
+	 * auto layout = TextLayout::LayoutCached("Score: 100", *font, opts);
+	 * for (const auto& g : layout->glyphs) {
+	 *     // Submit g as in Layout()
+	 * }
+	 * @endcode
+	 */
+	static std::shared_ptr<const TextLayoutResult>
+	LayoutCached(const std::string& text, const FontAtlas& font, const LayoutOptions& options);
+
+	/**
+	 * @brief Advance the cache generation and drop layouts unused for LAYOUT_CACHE_MAX_AGE frames.
+	 *
+	 * Called by BatchRenderer::BeginFrame().
+	 */
+	static void BeginFrame();
+
+	/**
+	 * @brief Drop every cached layout.
+	 *
+	 * Called when a font is destroyed, since entries are keyed by font address.
+	 */
+	static void ClearCache();
+
+	/// Number of layouts currently cached
+	[[nodiscard]] static size_t GetCacheSize();
+
+private:
+	struct CacheEntry {
+		std::string text;
+		const FontAtlas* font;
+		LayoutOptions options;
+		std::shared_ptr<const TextLayoutResult> result;
+		uint64_t last_used_frame;
+	};
+
+	// Keyed by a hash of the text, font and options; the entry holds them in full to rule out collisions
+	static std::unordered_map<size_t, CacheEntry> cache_;
+	static uint64_t cache_frame_;
 };
 
 /**
@@ -345,7 +529,9 @@ std::vector<uint32_t> Decode(const std::string& utf8_string);
  *
  * The manager maintains a default font for convenient text rendering without
  * explicit font management. Each font size requires a separate atlas, so multiple
- * sizes of the same font create independent FontAtlas instances.
+ * sizes of the same font create independent FontAtlas instances, unless
+ * GlyphCacheOptions::sdf is set, in which case one distance field atlas per font
+ * serves every size.
  *
  * **Lifecycle:**
  * 1. Initialize() - Set default font (call once at startup)
@@ -449,8 +635,10 @@ public:
 	 * @return Pointer to font atlas, or nullptr if loading failed
 	 *
 	 * @note First call for a (path, size) loads the font; subsequent calls return cached atlas.
+	 * @note With SDF glyph caching every size of a path shares one atlas, so lay text out with
+	 *       LayoutOptions::font_size set to the size you asked for.
 	 * @note Pointer is valid until Shutdown() is called.
-	 * @note Each font size requires ~256 KB GPU memory.
+	 * @note Each font size has its own glyph cache, bounded by SetGlyphCacheOptions().
 	 *
 	 * @code
 	 * // Load or get cached 24px title font
@@ -471,6 +659,32 @@ public:
 
 	static std::string GetDefaultFontPath() { return default_font_path_; }
 
+	/**
+	 * @brief Set the glyph cache budget for fonts loaded after this call.
+	 *
+	 * @param options Page size and page budget per font
+	 */
+	static void SetGlyphCacheOptions(const GlyphCacheOptions& options) { glyph_cache_options_ = options; }
+
+	/**
+	 * @brief Start a new frame on every loaded font.
+	 *
+	 * Called by BatchRenderer::BeginFrame().
+	 *
+	 * @see FontAtlas::BeginFrame
+	 */
+	static void BeginFrame();
+
+	/**
+	 * @brief Upload newly rasterized glyphs of every loaded font.
+	 *
+	 * Called by BatchRenderer before each draw, so glyphs requested while
+	 * building the batch are on the GPU when it renders.
+	 *
+	 * @see FontAtlas::FlushUploads
+	 */
+	static void FlushUploads();
+
 private:
 	struct FontKey {
 		std::string path;
@@ -489,5 +703,6 @@ private:
 	static std::string default_font_path_;
 	static int default_font_size_;
 	static bool initialized_;
+	static GlyphCacheOptions glyph_cache_options_;
 };
 } // namespace engine::ui::text_renderer
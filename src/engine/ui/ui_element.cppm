@@ -383,8 +383,14 @@ public:
 	 * @param y Y coordinate relative to parent
 	 */
 	void SetRelativePosition(const float x, const float y) {
-		relative_x_ = x;
-		relative_y_ = y;
+		if (x != relative_x_ || y != relative_y_) {
+			relative_x_ = x;
+			relative_y_ = y;
+			// Retained geometry replays translated to the new position, so only the ancestors' caches are stale
+			if (parent_ != nullptr) {
+				parent_->MarkDirty();
+			}
+		}
 	}
 
 	/**
@@ -393,21 +399,24 @@ public:
 	 * @param height Element height in pixels
 	 */
 	void SetSize(const float width, const float height) {
-		width_ = width;
-		height_ = height;
+		if (width != width_ || height != height_) {
+			width_ = width;
+			height_ = height;
+			MarkDirty();
+		}
 	}
 
 	/**
 	 * @brief Set element width
 	 * @param width Element width in pixels
 	 */
-	void SetWidth(const float width) { width_ = width; }
+	void SetWidth(const float width) { SetSize(width, height_); }
 
 	/**
 	 * @brief Set element height
 	 * @param height Element height in pixels
 	 */
-	void SetHeight(const float height) { height_ = height; }
+	void SetHeight(const float height) { SetSize(width_, height); }
 
 	/**
 	 * @brief Get element width
@@ -437,13 +446,13 @@ public:
 	 * @brief Set relative X position
 	 * @param x X coordinate relative to parent
 	 */
-	void SetRelativeX(const float x) { relative_x_ = x; }
+	void SetRelativeX(const float x) { SetRelativePosition(x, relative_y_); }
 
 	/**
 	 * @brief Set relative Y position
 	 * @param y Y coordinate relative to parent
 	 */
-	void SetRelativeY(const float y) { relative_y_ = y; }
+	void SetRelativeY(const float y) { SetRelativePosition(relative_x_, y); }
 
 	// === Hit Testing ===
 
@@ -470,7 +479,7 @@ public:
 	 * @brief Set focused state
 	 * @param focused True to focus, false to unfocus
 	 */
-	void SetFocused(const bool focused) { is_focused_ = focused; }
+	void SetFocused(const bool focused) { SetStateFlag(is_focused_, focused); }
 
 	/**
 	 * @brief Check if element is focused
@@ -482,7 +491,7 @@ public:
 	 * @brief Set hovered state
 	 * @param hovered True if mouse is over element
 	 */
-	void SetHovered(const bool hovered) { is_hovered_ = hovered; }
+	void SetHovered(const bool hovered) { SetStateFlag(is_hovered_, hovered); }
 
 	/**
 	 * @brief Check if element is hovered
@@ -494,7 +503,7 @@ public:
 	 * @brief Set visibility
 	 * @param visible True to show, false to hide
 	 */
-	void SetVisible(const bool visible) { is_visible_ = visible; }
+	void SetVisible(const bool visible) { SetStateFlag(is_visible_, visible); }
 
 	/**
 	 * @brief Check if element is visible
@@ -502,6 +511,31 @@ public:
 	 */
 	[[nodiscard]] bool IsVisible() const { return is_visible_; }
 
+	// === Retained Geometry ===
+
+	/**
+	 * @brief Keep this subtree's tessellated geometry between frames
+	 *
+	 * While nothing below it changes, Render() copies the cached vertices instead of tessellating again. Only
+	 * elements that act as a cache boundary honour it (Panel, and so Container). The setters and mouse handling
+	 * call MarkDirty() on change; state changed any other way (such as through ScrollState directly) needs an
+	 * explicit MarkDirty().
+	 */
+	void SetRetained(bool retained);
+
+	[[nodiscard]] bool IsRetained() const { return retained_geometry_ != nullptr; }
+
+	/**
+	 * @brief Drop the cached geometry of this element and of every ancestor that contains it
+	 */
+	void MarkDirty() {
+		for (UIElement* element = this; element != nullptr; element = element->parent_) {
+			if (element->retained_geometry_) {
+				element->retained_geometry_->valid = false;
+			}
+		}
+	}
+
 	// === Event Callbacks (Observer Pattern) ===
 
 	/**
@@ -621,6 +655,7 @@ public:
 
 		// Let components handle first
 		if (components_.ProcessMouseEvent(event)) {
+			MarkDirty();
 			return true;
 		}
 
@@ -634,57 +669,19 @@ public:
 		// No child consumed event, check if it's within our bounds
 		if (!Contains(event.x, event.y)) {
 			// Not hovering anymore
-			if (is_hovered_) {
-				is_hovered_ = false;
-			}
+			SetHovered(false);
 			return false;
 		}
 
 		// Update hover state
-		is_hovered_ = true;
+		SetHovered(true);
 
-		// Try event handlers in order of specificity
-		// Callbacks are checked first, then virtual methods
-		if (event.left_pressed || event.right_pressed || event.middle_pressed) {
-			// Try callback first
-			if (click_callback_ && click_callback_(event)) {
-				return true;
-			}
-			// Then virtual method
-			if (OnClick(event)) {
-				return true;
-			}
-		}
-
-		if (event.scroll_delta_x != 0.0F || event.scroll_delta_y != 0.0F) {
-			// Try callback first
-			if (scroll_callback_ && scroll_callback_(event)) {
-				return true;
-			}
-			// Then virtual method
-			if (OnScroll(event)) {
-				return true;
-			}
-		}
-
-		if (event.left_down || event.right_down || event.middle_down) {
-			// Try callback first
-			if (drag_callback_ && drag_callback_(event)) {
-				return true;
-			}
-			// Then virtual method
-			if (OnDrag(event)) {
-				return true;
-			}
-		}
-
-		// Always call hover last
-		// Try callback first
-		if (hover_callback_ && hover_callback_(event)) {
+		// Handlers change how the element looks (pressed, dragged, scrolled), so anything they consume is redrawn
+		if (DispatchMouseHandlers(event)) {
+			MarkDirty();
 			return true;
 		}
-		// Then virtual method
-		return OnHover(event);
+		return false;
 	}
 
 	/**
@@ -870,6 +867,16 @@ protected:
 	 */
 	[[nodiscard]] batch_renderer::Rectangle GetAbsoluteParentBounds() const;
 
+	/**
+	 * @brief Start of Render() for elements that can cache their subtree
+	 *
+	 * @return true if the cached geometry was replayed and Render() is done; false if the subtree must be
+	 *         submitted as usual, followed by EndRetainedRender()
+	 */
+	bool BeginRetainedRender() const;
+
+	void EndRetainedRender() const;
+
 	// Position relative to parent
 	float relative_x_ = 0.0F;
 	float relative_y_ = 0.0F;
@@ -883,6 +890,9 @@ protected:
 	bool is_hovered_ = false;
 	bool is_visible_ = true;
 
+	// Cached subtree geometry; only allocated once SetRetained(true) is called
+	std::unique_ptr<batch_renderer::RetainedGeometry> retained_geometry_;
+
 	// Event callbacks (optional, for composition-based event handling)
 	ClickCallback click_callback_;
 	HoverCallback hover_callback_;
@@ -895,6 +905,60 @@ protected:
 
 	// Component system
 	ComponentContainer components_;
+
+private:
+	void SetStateFlag(bool& flag, const bool value) {
+		if (flag != value) {
+			flag = value;
+			MarkDirty();
+		}
+	}
+
+	// The handler chain of ProcessMouseEvent(), once the event is known to be inside this element
+	bool DispatchMouseHandlers(const MouseEvent& event) {
+		// Try event handlers in order of specificity
+		// Callbacks are checked first, then virtual methods
+		if (event.left_pressed || event.right_pressed || event.middle_pressed) {
+			// Try callback first
+			if (click_callback_ && click_callback_(event)) {
+				return true;
+			}
+			// Then virtual method
+			if (OnClick(event)) {
+				return true;
+			}
+		}
+
+		if (event.scroll_delta_x != 0.0F || event.scroll_delta_y != 0.0F) {
+			// Try callback first
+			if (scroll_callback_ && scroll_callback_(event)) {
+				return true;
+			}
+			// Then virtual method
+			if (OnScroll(event)) {
+				return true;
+			}
+		}
+
+		if (event.left_down || event.right_down || event.middle_down) {
+			// Try callback first
+			if (drag_callback_ && drag_callback_(event)) {
+				return true;
+			}
+			// Then virtual method
+			if (OnDrag(event)) {
+				return true;
+			}
+		}
+
+		// Always call hover last
+		// Try callback first
+		if (hover_callback_ && hover_callback_(event)) {
+			return true;
+		}
+		// Then virtual method
+		return OnHover(event);
+	}
 };
 
 // === Implementation ===
@@ -903,14 +967,48 @@ inline void UIElement::AddChild(std::unique_ptr<UIElement> child) {
 	if (child) {
 		child->SetParent(this);
 		children_.push_back(std::move(child));
+		MarkDirty();
 	}
 }
 
 inline void UIElement::RemoveChild(UIElement* child) {
 	std::erase_if(children_, [child](const std::unique_ptr<UIElement>& elem) { return elem.get() == child; });
+	MarkDirty();
+}
+
+inline void UIElement::ClearChildren() {
+	children_.clear();
+	MarkDirty();
+}
+
+inline void UIElement::SetRetained(const bool retained) {
+	if (!retained) {
+		retained_geometry_.reset();
+	}
+	else if (!retained_geometry_) {
+		retained_geometry_ = std::make_unique<batch_renderer::RetainedGeometry>();
+	}
 }
 
-inline void UIElement::ClearChildren() { children_.clear(); }
+inline bool UIElement::BeginRetainedRender() const {
+	if (!retained_geometry_) {
+		return false;
+	}
+	using batch_renderer::BatchRenderer;
+	const batch_renderer::Rectangle bounds = GetAbsoluteBounds();
+	if (BatchRenderer::IsRetainedValid(*retained_geometry_)) {
+		BatchRenderer::SubmitRetained(*retained_geometry_, bounds.x, bounds.y);
+		return true;
+	}
+	BatchRenderer::BeginRetained(*retained_geometry_, bounds.x, bounds.y);
+	return false;
+}
+
+inline void UIElement::EndRetainedRender() const {
+	if (retained_geometry_) {
+		batch_renderer::BatchRenderer::EndRetained();
+	}
+}
 
 inline batch_renderer::Rectangle UIElement::GetAbsoluteBounds() const {
 	const batch_renderer::Rectangle bounds = GetRelativeBounds();
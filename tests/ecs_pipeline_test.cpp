@@ -0,0 +1,105 @@
+#include <flecs.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+import engine.ecs;
+import engine.components;
+import glm;
+
+using namespace engine::ecs;
+using namespace engine::components;
+
+namespace {
+struct Placement {
+	glm::vec3 position;
+	glm::quat rotation;
+};
+
+// Movers (some spinning, some parented to another mover) stepped for a few frames; returns every
+// entity's final world placement in creation order
+std::vector<Placement> SimulateMovers(ECSWorld& ecs, const uint32_t threads) {
+	ecs.SetThreads(threads);
+
+	std::vector<flecs::entity> movers;
+	for (size_t i = 0; i < 10000; ++i) {
+		auto entity = ecs.CreateEntity();
+		if (i % 4 == 3) {
+			ECSWorld::SetParent(entity, movers[i - 1]);
+		}
+		entity.set<Velocity>({
+			.linear = {1.0F, static_cast<float>(i % 3), 0.0F},
+			.angular = {0.0F, static_cast<float>(i % 5) * 0.5F, 0.0F},
+		});
+		if (i % 7 == 0) {
+			entity.add<Rotating>();
+		}
+		movers.push_back(entity);
+	}
+	for (int frame = 0; frame < 10; ++frame) {
+		ecs.ProgressAll(0.1F);
+	}
+
+	std::vector<Placement> placements;
+	placements.reserve(movers.size());
+	for (const auto mover : movers) {
+		const auto& world_transform = mover.get<WorldTransform>();
+		placements.push_back({world_transform.position, world_transform.rotation});
+	}
+	return placements;
+}
+} // namespace
+
+class EcsPipelineTest : public ::testing::Test {
+protected:
+	ECSWorld ecs_;
+
+	std::vector<flecs::entity> CreateMovers(const size_t count) {
+		std::vector<flecs::entity> movers;
+		for (size_t i = 0; i < count; ++i) {
+			auto entity = ecs_.CreateEntity();
+			entity.set<Velocity>({.linear = {1.0F, static_cast<float>(i % 3), 0.0F}});
+			movers.push_back(entity);
+		}
+		return movers;
+	}
+};
+
+TEST_F(EcsPipelineTest, multi_threaded_systems_match_single_threaded_results) {
+	ECSWorld single_threaded;
+	const auto expected = SimulateMovers(single_threaded, 1);
+	const auto actual = SimulateMovers(ecs_, 4);
+	EXPECT_EQ(ecs_.GetThreads(), 4U);
+
+	ASSERT_EQ(actual.size(), expected.size());
+	for (size_t i = 0; i < actual.size(); ++i) {
+		// Every entity is computed by the same code either way, so results match exactly
+		ASSERT_EQ(actual[i].position, expected[i].position) << "entity " << i;
+		ASSERT_EQ(actual[i].rotation, expected[i].rotation) << "entity " << i;
+	}
+
+	// Sanity check that the scene actually moved: an unparented mover travels 1 unit along X
+	EXPECT_NEAR(expected[0].position.x, 1.0F, 1e-4F);
+}
+
+TEST_F(EcsPipelineTest, zero_threads_falls_back_to_main_thread) {
+	ecs_.SetThreads(0);
+	EXPECT_EQ(ecs_.GetThreads(), 1U);
+}
+
+TEST_F(EcsPipelineTest, single_phase_progress_runs_only_that_phase) {
+	const auto mover = CreateMovers(1).front();
+
+	// Simulation moves the local transform but does not propagate it
+	ecs_.ProgressSimulation(1.0F);
+	EXPECT_FLOAT_EQ(mover.get<Transform>().position.x, 1.0F);
+	EXPECT_FLOAT_EQ(mover.get<WorldTransform>().position.x, 0.0F);
+
+	ecs_.ProgressPostSimulation(1.0F);
+	EXPECT_FLOAT_EQ(mover.get<Transform>().position.x, 1.0F);
+	EXPECT_FLOAT_EQ(mover.get<WorldTransform>().position.x, 1.0F);
+
+	// Single-phase progress works in edit mode too, where the main pipeline skips Simulation
+	ecs_.ProgressEditMode(1.0F);
+	ecs_.ProgressSimulation(1.0F);
+	EXPECT_FLOAT_EQ(mover.get<Transform>().position.x, 2.0F);
+}
@@ -0,0 +1,132 @@
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+import engine.rendering;
+
+using namespace engine::rendering;
+
+namespace {
+// GL enum values the cache forwards; the mock only needs them to be distinct
+constexpr uint32_t GL_DEPTH_TEST_VALUE = 0x0B71;
+constexpr uint32_t GL_BLEND_VALUE = 0x0BE2;
+constexpr uint32_t GL_TEXTURE0_VALUE = 0x84C0;
+
+// Every call the cache lets through, in order
+std::vector<std::string> g_calls;
+
+GLFunctions MockGLFunctions() {
+	return {
+		.enable = [](const uint32_t capability) { g_calls.push_back("enable " + std::to_string(capability)); },
+		.disable = [](const uint32_t capability) { g_calls.push_back("disable " + std::to_string(capability)); },
+		.depth_mask = [](const bool enabled) { g_calls.push_back(enabled ? "depth_mask on" : "depth_mask off"); },
+		.polygon_mode = [](uint32_t, const uint32_t mode) { g_calls.push_back("polygon " + std::to_string(mode)); },
+		.blend_func = [](uint32_t, uint32_t) { g_calls.push_back("blend_func"); },
+		.use_program = [](const uint32_t program) { g_calls.push_back("program " + std::to_string(program)); },
+		.bind_vertex_array = [](const uint32_t vao) { g_calls.push_back("vao " + std::to_string(vao)); },
+		.active_texture = [](const uint32_t unit) { g_calls.push_back("unit " + std::to_string(unit)); },
+		.bind_texture = [](uint32_t, const uint32_t texture) { g_calls.push_back("tex " + std::to_string(texture)); }
+	};
+}
+
+class GLStateCacheTest : public ::testing::Test {
+protected:
+	void SetUp() override { g_calls.clear(); }
+
+	GLStateCache cache{MockGLFunctions()};
+};
+} // namespace
+
+TEST_F(GLStateCacheTest, first_call_is_always_issued) {
+	cache.SetFlag(RenderFlag::DepthTest, false);
+	cache.UseProgram(0);
+
+	EXPECT_EQ(
+		g_calls,
+		(std::vector<std::string>{"disable " + std::to_string(GL_DEPTH_TEST_VALUE), "program 0"})
+	);
+	EXPECT_EQ(cache.GetStats().calls_issued, 2U);
+	EXPECT_EQ(cache.GetStats().calls_eliminated, 0U);
+}
+
+TEST_F(GLStateCacheTest, repeated_state_is_eliminated) {
+	for (int draw = 0; draw < 3; ++draw) {
+		cache.UseProgram(7);
+		cache.BindVertexArray(3);
+		cache.SetFlag(RenderFlag::Blend, true);
+		cache.SetBlendFunc(1, 2);
+		cache.SetFlag(RenderFlag::DepthMask, true);
+	}
+
+	EXPECT_EQ(g_calls.size(), 5U);
+	EXPECT_EQ(cache.GetStats().calls_issued, 5U);
+	EXPECT_EQ(cache.GetStats().calls_eliminated, 10U);
+}
+
+TEST_F(GLStateCacheTest, changes_are_forwarded) {
+	cache.SetFlag(RenderFlag::Blend, true);
+	cache.SetFlag(RenderFlag::Blend, false);
+	cache.SetBlendFunc(1, 2);
+	cache.SetBlendFunc(1, 3);
+	cache.SetFlag(RenderFlag::Wireframe, true);
+	cache.SetFlag(RenderFlag::Wireframe, false);
+
+	ASSERT_EQ(g_calls.size(), 6U);
+	EXPECT_EQ(g_calls[0], "enable " + std::to_string(GL_BLEND_VALUE));
+	EXPECT_EQ(g_calls[1], "disable " + std::to_string(GL_BLEND_VALUE));
+	EXPECT_EQ(g_calls[4].substr(0, 8), "polygon ");
+	EXPECT_NE(g_calls[4], g_calls[5]);
+	EXPECT_EQ(cache.GetStats().calls_eliminated, 0U);
+}
+
+TEST_F(GLStateCacheTest, texture_bindings_are_tracked_per_unit) {
+	cache.BindTexture(0, 10);
+	cache.BindTexture(1, 11);
+	cache.BindTexture(0, 10); // Still bound on unit 0; no unit switch needed either
+	cache.BindTexture(1, 11);
+	cache.BindTexture(0, 12); // Unit 1 is active, so this switches back to 0
+
+	EXPECT_EQ(
+		g_calls,
+		(std::vector<std::string>{
+			"unit " + std::to_string(GL_TEXTURE0_VALUE),
+			"tex 10",
+			"unit " + std::to_string(GL_TEXTURE0_VALUE + 1),
+			"tex 11",
+			"unit " + std::to_string(GL_TEXTURE0_VALUE),
+			"tex 12"
+		})
+	);
+}
+
+TEST_F(GLStateCacheTest, invalidate_forgets_shadowed_state) {
+	cache.UseProgram(4);
+	cache.SetFlag(RenderFlag::CullFace, true);
+	cache.Invalidate();
+	cache.UseProgram(4);
+	cache.SetFlag(RenderFlag::CullFace, true);
+
+	EXPECT_EQ(g_calls.size(), 4U);
+	EXPECT_EQ(cache.GetStats().calls_eliminated, 0U);
+}
+
+TEST_F(GLStateCacheTest, wireframe_is_ignored_without_polygon_mode) {
+	GLFunctions functions = MockGLFunctions();
+	functions.polygon_mode = nullptr; // As on GLES/WebGL
+	GLStateCache gles_cache(functions);
+
+	gles_cache.SetFlag(RenderFlag::Wireframe, true);
+
+	EXPECT_TRUE(g_calls.empty());
+	EXPECT_EQ(gles_cache.GetStats().calls_issued, 0U);
+}
+
+TEST_F(GLStateCacheTest, reset_stats_keeps_shadowed_state) {
+	cache.BindVertexArray(2);
+	cache.ResetStats();
+	cache.BindVertexArray(2);
+
+	EXPECT_EQ(cache.GetStats().calls_issued, 0U);
+	EXPECT_EQ(cache.GetStats().calls_eliminated, 1U);
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+import engine;
+import glm;
+
+using namespace engine;
+using namespace engine::components;
+
+// Headless mode is process-wide, so put back whatever the rest of the binary expects
+class HeadlessEngineTest : public ::testing::Test {
+protected:
+	void SetUp() override { was_headless_ = rendering::IsHeadless(); }
+
+	void TearDown() override { rendering::SetHeadless(was_headless_); }
+
+	bool was_headless_ = false;
+};
+
+TEST_F(HeadlessEngineTest, runs_simulation_without_window_or_renderer) {
+	Engine engine;
+	ASSERT_TRUE(engine.InitHeadless());
+	EXPECT_TRUE(engine.IsHeadless());
+	EXPECT_EQ(engine.window, nullptr);
+	EXPECT_EQ(engine.renderer, nullptr);
+
+	auto entity = engine.ecs.CreateEntity();
+	entity.set<Velocity>({.linear = {1.0F, 0.0F, 0.0F}});
+
+	const double seconds = engine.RunHeadless(60, 1.0F / 60.0F);
+	EXPECT_GE(seconds, 0.0);
+	EXPECT_NEAR(entity.get<Transform>().position.x, 1.0F, 1e-4F);
+	EXPECT_NEAR(entity.get<WorldTransform>().position.x, 1.0F, 1e-4F);
+
+	engine.Shutdown();
+}
+
+TEST_F(HeadlessEngineTest, rendering_resources_are_tracked_without_gl) {
+	rendering::SetHeadless(true);
+	auto& renderer = rendering::GetRenderer();
+
+	const auto mesh = renderer.GetMeshManager().CreateCube(1.0F);
+	EXPECT_TRUE(renderer.GetMeshManager().IsValid(mesh));
+	EXPECT_EQ(renderer.GetMeshManager().GetIndexCount(mesh), 36U);
+
+	const auto white = renderer.GetTextureManager().GetWhiteTexture();
+	EXPECT_TRUE(renderer.GetTextureManager().IsValid(white));
+	EXPECT_EQ(renderer.GetTextureManager().GetWidth(white), 1U);
+}
@@ -0,0 +1,117 @@
+#include <flecs.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+import engine.ecs;
+import engine.components;
+
+using namespace engine::ecs;
+using namespace engine::components;
+
+class HierarchyIndexTest : public ::testing::Test {
+protected:
+	ECSWorld ecs_;
+
+	flecs::entity Create(const char* name, const flecs::entity parent = {}) {
+		auto entity = ecs_.CreateEntity();
+		entity.set<SceneEntity>({.name = name});
+		if (parent.is_valid()) {
+			ECSWorld::SetParent(entity, parent);
+		}
+		return entity;
+	}
+};
+
+TEST_F(HierarchyIndexTest, find_by_name_tracks_renames_and_removal) {
+	auto entity = Create("Player");
+	EXPECT_EQ(ecs_.FindEntityByName("Player"), entity);
+	EXPECT_FALSE(ecs_.FindEntityByName("Enemy").is_valid());
+
+	entity.set<SceneEntity>({.name = "Hero"});
+	EXPECT_FALSE(ecs_.FindEntityByName("Player").is_valid());
+	EXPECT_EQ(ecs_.FindEntityByName("Hero"), entity);
+
+	// Changing other SceneEntity fields keeps the entry
+	entity.set<SceneEntity>({.name = "Hero", .visible = false});
+	EXPECT_EQ(ecs_.FindEntityByName("Hero"), entity);
+
+	entity.destruct();
+	EXPECT_FALSE(ecs_.FindEntityByName("Hero").is_valid());
+}
+
+TEST_F(HierarchyIndexTest, find_by_name_respects_root) {
+	auto scene_a = Create("SceneA");
+	auto scene_b = Create("SceneB");
+	auto door_a = Create("Door", scene_a);
+	auto door_b = Create("Door", scene_b);
+
+	EXPECT_EQ(ecs_.FindEntityByName("Door", scene_a), door_a);
+	EXPECT_EQ(ecs_.FindEntityByName("Door", scene_b), door_b);
+	EXPECT_TRUE(ecs_.FindEntityByName("Door").is_valid());
+
+	door_a.destruct();
+	EXPECT_FALSE(ecs_.FindEntityByName("Door", scene_a).is_valid());
+	EXPECT_EQ(ecs_.FindEntityByName("Door"), door_b);
+}
+
+TEST_F(HierarchyIndexTest, find_by_path) {
+	auto root = Create("Root");
+	auto player = Create("Player", root);
+	auto weapon = Create("Weapon", player);
+	auto muzzle = Create("Muzzle", weapon);
+	auto enemy = Create("Enemy", root);
+	Create("Muzzle", Create("Weapon", enemy));
+
+	EXPECT_EQ(ecs_.FindEntityByPath("Player/Weapon/Muzzle", root), muzzle);
+	EXPECT_EQ(ecs_.FindEntityByPath("/Player/Weapon/", root), weapon);
+	EXPECT_EQ(ecs_.FindEntityByPath("Root/Player"), player);
+	EXPECT_FALSE(ecs_.FindEntityByPath("Weapon/Muzzle", root).is_valid());
+	EXPECT_FALSE(ecs_.FindEntityByPath("Player/Muzzle", root).is_valid());
+	EXPECT_FALSE(ecs_.FindEntityByPath("", root).is_valid());
+}
+
+TEST_F(HierarchyIndexTest, descendants_view_is_preorder_and_invalidated_on_reparent) {
+	auto root = Create("Root");
+	auto a = Create("A", root);
+	auto a_child = Create("AChild", a);
+	auto b = Create("B", root);
+
+	const std::vector<flecs::entity> expected{a, a_child, b};
+	const auto view = ecs_.GetDescendantsView(root);
+	EXPECT_EQ(std::vector<flecs::entity>(view.begin(), view.end()), expected);
+	EXPECT_EQ(ECSWorld::GetDescendants(root), expected);
+
+	// Repeated calls reuse the cached list
+	EXPECT_EQ(ecs_.GetDescendantsView(root).data(), view.data());
+
+	ECSWorld::RemoveParent(a);
+	EXPECT_EQ(ECSWorld::GetDescendants(root), std::vector<flecs::entity>{b});
+
+	b.destruct();
+	EXPECT_TRUE(ecs_.GetDescendantsView(root).empty());
+	EXPECT_EQ(ECSWorld::GetDescendants(a), std::vector<flecs::entity>{a_child});
+}
+
+TEST_F(HierarchyIndexTest, descendants_view_survives_queries_on_other_roots) {
+	auto root = Create("Root");
+	Create("Child", root);
+	const auto view = ecs_.GetDescendantsView(root);
+
+	// Filling the cache with other roots evicts one list at a time, least recently queried first
+	std::vector<flecs::entity> others;
+	for (int i = 0; i < 63; ++i) {
+		others.push_back(Create("Other"));
+		Create("OtherChild", others.back());
+	}
+	for (const auto other : others) {
+		static_cast<void>(ecs_.GetDescendantsView(other));
+	}
+	ASSERT_EQ(view.size(), 1U);
+	EXPECT_EQ(ecs_.GetDescendantsView(root).data(), view.data());
+
+	// Root is now the most recently used, so the next new root evicts the first of the others instead
+	auto extra = Create("Extra");
+	Create("ExtraChild", extra);
+	static_cast<void>(ecs_.GetDescendantsView(extra));
+	EXPECT_EQ(ecs_.GetDescendantsView(root).data(), view.data());
+}
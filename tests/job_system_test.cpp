@@ -0,0 +1,134 @@
+#include <atomic>
+#include <gtest/gtest.h>
+#include <vector>
+
+import engine.platform;
+
+using namespace engine::platform::threading;
+
+class JobSystemTest : public ::testing::Test {
+protected:
+	JobSystem jobs_{4};
+};
+
+TEST_F(JobSystemTest, creates_requested_worker_count) {
+	EXPECT_EQ(jobs_.WorkerCount(), 4U);
+	EXPECT_EQ(jobs_.MaxConcurrency(), 5U);
+	EXPECT_FALSE(jobs_.IsWorkerThread());
+}
+
+TEST_F(JobSystemTest, wait_runs_all_submitted_jobs) {
+	std::atomic<int> executed{0};
+	JobCounter counter;
+
+	for (int i = 0; i < 1000; ++i) {
+		jobs_.Submit([&executed]() { executed.fetch_add(1); }, &counter);
+	}
+	jobs_.Wait(counter);
+
+	EXPECT_EQ(executed.load(), 1000);
+	EXPECT_TRUE(counter.IsDone());
+}
+
+TEST_F(JobSystemTest, dependent_job_runs_after_dependency) {
+	std::atomic<int> stage{0};
+	std::atomic<bool> ordered{true};
+	JobCounter first;
+	JobCounter second;
+
+	for (int i = 0; i < 16; ++i) {
+		jobs_.Submit([&stage]() { stage.fetch_add(1); }, &first);
+	}
+	jobs_.Submit([&stage, &ordered]() { ordered = stage.load() == 16; }, &second, first);
+
+	jobs_.Wait(second);
+	EXPECT_TRUE(ordered.load());
+	EXPECT_TRUE(first.IsDone());
+}
+
+TEST_F(JobSystemTest, dependency_already_done_runs_immediately) {
+	JobCounter done;
+	JobCounter counter;
+	bool ran = false;
+
+	jobs_.Submit([&ran]() { ran = true; }, &counter, done);
+	jobs_.Wait(counter);
+	EXPECT_TRUE(ran);
+}
+
+TEST_F(JobSystemTest, parallel_for_covers_range_exactly_once) {
+	std::vector<int> hits(10007, 0);
+
+	jobs_.ParallelFor(0, hits.size(), 64, [&hits](const size_t begin, const size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			hits[i]++;
+		}
+	});
+
+	for (const int hit : hits) {
+		ASSERT_EQ(hit, 1);
+	}
+}
+
+TEST_F(JobSystemTest, parallel_for_with_auto_grain_and_empty_range) {
+	std::atomic<size_t> sum{0};
+	jobs_.ParallelFor(0, 1000, 0, [&sum](const size_t begin, const size_t end) {
+		size_t local = 0;
+		for (size_t i = begin; i < end; ++i) {
+			local += i;
+		}
+		sum.fetch_add(local);
+	});
+	EXPECT_EQ(sum.load(), 999U * 1000U / 2U);
+
+	bool called = false;
+	jobs_.ParallelFor(5, 5, 0, [&called](size_t, size_t) { called = true; });
+	EXPECT_FALSE(called);
+}
+
+TEST_F(JobSystemTest, nested_wait_inside_job_does_not_deadlock) {
+	JobCounter outer;
+	std::atomic<int> inner_total{0};
+
+	// More outer jobs than workers, each waiting on inner work: only completes if waiters help
+	for (int i = 0; i < 8; ++i) {
+		jobs_.Submit(
+			[this, &inner_total]() {
+				JobCounter inner;
+				for (int j = 0; j < 8; ++j) {
+					jobs_.Submit([&inner_total]() { inner_total.fetch_add(1); }, &inner);
+				}
+				jobs_.Wait(inner);
+			},
+			&outer
+		);
+	}
+	jobs_.Wait(outer);
+	EXPECT_EQ(inner_total.load(), 64);
+}
+
+TEST(ThreadingPrimitivesTest, mutex_and_atomic_basics) {
+	EXPECT_GE(HardwareConcurrency(), 1U);
+
+	Mutex mutex;
+	EXPECT_TRUE(mutex.TryLock());
+	mutex.Unlock();
+	{
+		LockGuard guard(mutex);
+	}
+	EXPECT_TRUE(mutex.TryLock());
+	mutex.Unlock();
+
+	AtomicInt32 value(5);
+	EXPECT_EQ(value.FetchAdd(3), 5);
+	EXPECT_EQ(value.FetchSub(1), 8);
+	EXPECT_EQ(value.Load(), 7);
+	int expected = 7;
+	EXPECT_TRUE(value.CompareExchange(expected, 10));
+	EXPECT_EQ(value.Exchange(1), 10);
+}
+
+TEST(ThreadingPrimitivesTest, global_job_system_is_shared) {
+	EXPECT_EQ(&GetJobSystem(), &GetJobSystem());
+	EXPECT_GE(GetJobSystem().WorkerCount(), 1U);
+}
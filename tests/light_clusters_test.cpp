@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+
+import engine.rendering;
+import glm;
+
+using namespace engine::rendering;
+
+namespace {
+constexpr float NEAR_PLANE = 0.1f;
+constexpr float FAR_PLANE = 1000.0f;
+
+LightClusters MakeClusters() {
+	LightClusters clusters;
+	const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, NEAR_PLANE, FAR_PLANE);
+	clusters.SetProjection(projection, NEAR_PLANE, FAR_PLANE);
+	return clusters;
+}
+
+std::vector<uint32_t> LightsIn(const LightClusters& clusters, const uint32_t cluster) {
+	const LightClusterRange range = clusters.GetClusters()[cluster];
+	const auto indices = clusters.GetLightIndices().subspan(range.offset, range.count);
+	return {indices.begin(), indices.end()};
+}
+} // namespace
+
+TEST(LightClustersTest, light_lands_only_in_clusters_around_it) {
+	LightClusters clusters = MakeClusters();
+	// Camera at the origin looking down -z; one light straight ahead
+	const std::vector<ClusterLight> lights{{.position = {0.0f, 0.0f, -10.0f}, .range = 1.0f, .index = 7}};
+	clusters.Assign(lights, glm::mat4(1.0f));
+
+	const uint32_t slice = clusters.SliceOf(10.0f);
+	const uint32_t center = LightClusters::ClusterIndex(LIGHT_CLUSTER_GRID_X / 2, LIGHT_CLUSTER_GRID_Y / 2, slice);
+	EXPECT_EQ(LightsIn(clusters, center), std::vector<uint32_t>{7});
+	EXPECT_TRUE(LightsIn(clusters, LightClusters::ClusterIndex(0, 0, slice)).empty());
+	EXPECT_TRUE(LightsIn(clusters, LightClusters::ClusterIndex(LIGHT_CLUSTER_GRID_X / 2, 4, 0)).empty());
+
+	uint32_t referenced = 0;
+	for (const auto& range : clusters.GetClusters()) {
+		referenced += range.count;
+	}
+	EXPECT_EQ(referenced, clusters.GetLightIndices().size());
+	EXPECT_LT(referenced, 50U);
+}
+
+TEST(LightClustersTest, lights_outside_the_frustum_depth_are_skipped) {
+	LightClusters clusters = MakeClusters();
+	const std::vector<ClusterLight> lights{
+		{.position = {0.0f, 0.0f, 5.0f}, .range = 1.0f, .index = 0},      // Behind the camera
+		{.position = {0.0f, 0.0f, -2000.0f}, .range = 10.0f, .index = 1}, // Past the far plane
+		{.position = {0.0f, 0.0f, -10.0f}, .range = 0.0f, .index = 2}     // No range
+	};
+	clusters.Assign(lights, glm::mat4(1.0f));
+	EXPECT_TRUE(clusters.GetLightIndices().empty());
+}
+
+TEST(LightClustersTest, view_transform_moves_lights_into_view) {
+	LightClusters clusters = MakeClusters();
+	// Light behind the origin, seen by a camera that turned around to face +z
+	const std::vector<ClusterLight> lights{{.position = {0.0f, 0.0f, 10.0f}, .range = 1.0f, .index = 3}};
+	const glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	clusters.Assign(lights, view);
+
+	const uint32_t slice = clusters.SliceOf(10.0f);
+	const uint32_t center = LightClusters::ClusterIndex(LIGHT_CLUSTER_GRID_X / 2, LIGHT_CLUSTER_GRID_Y / 2, slice);
+	EXPECT_EQ(LightsIn(clusters, center), std::vector<uint32_t>{3});
+}
+
+TEST(LightClustersTest, many_lights_keep_input_order_and_cluster_cap) {
+	LightClusters clusters = MakeClusters();
+	// Enough overlapping lights to take the job system path and overflow the clusters around them
+	std::vector<ClusterLight> lights;
+	for (uint32_t i = 0; i < 300; ++i) {
+		lights.push_back({
+			.position = {static_cast<float>(i % 10) - 5.0f, static_cast<float>(i / 10 % 5) - 2.0f, -20.0f},
+			.range = 3.0f,
+			.index = i
+		});
+	}
+	clusters.Assign(lights, glm::mat4(1.0f));
+
+	const uint32_t slice = clusters.SliceOf(20.0f);
+	const uint32_t center = LightClusters::ClusterIndex(LIGHT_CLUSTER_GRID_X / 2, LIGHT_CLUSTER_GRID_Y / 2, slice);
+	const auto crowded = LightsIn(clusters, center);
+	EXPECT_EQ(crowded.size(), MAX_LIGHTS_PER_CLUSTER);
+	EXPECT_TRUE(std::ranges::is_sorted(crowded));
+
+	uint32_t expected_offset = 0;
+	for (const auto& range : clusters.GetClusters()) {
+		EXPECT_EQ(range.offset, expected_offset);
+		EXPECT_LE(range.count, MAX_LIGHTS_PER_CLUSTER);
+		expected_offset += range.count;
+	}
+	EXPECT_EQ(expected_offset, clusters.GetLightIndices().size());
+
+	// Reassigning with no lights clears every cluster
+	clusters.Assign({}, glm::mat4(1.0f));
+	EXPECT_TRUE(clusters.GetLightIndices().empty());
+	EXPECT_TRUE(std::ranges::all_of(clusters.GetClusters(), [](const auto& range) { return range.count == 0; }));
+}
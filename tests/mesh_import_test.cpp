@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+import engine.rendering;
+
+using namespace engine::rendering;
+
+namespace {
+constexpr uint32_t GRID_SIZE = 40;
+
+// Triangle soup of a GRID_SIZE x GRID_SIZE grid in shuffled order: every corner is repeated and the order has no
+// locality, like a naive exporter's output
+MeshCreateInfo ShuffledGridSoup() {
+	std::vector<std::array<uint32_t, 3>> triangles;
+	const auto corner = [](const uint32_t x, const uint32_t y) { return y * (GRID_SIZE + 1) + x; };
+	for (uint32_t y = 0; y < GRID_SIZE; ++y) {
+		for (uint32_t x = 0; x < GRID_SIZE; ++x) {
+			triangles.push_back({corner(x, y), corner(x + 1, y), corner(x + 1, y + 1)});
+			triangles.push_back({corner(x, y), corner(x + 1, y + 1), corner(x, y + 1)});
+		}
+	}
+	std::ranges::shuffle(triangles, std::mt19937(7));
+
+	MeshCreateInfo mesh;
+	for (const auto& triangle : triangles) {
+		for (const uint32_t point : triangle) {
+			Vertex vertex{};
+			vertex.position = {
+				static_cast<float>(point % (GRID_SIZE + 1)),
+				static_cast<float>(point / (GRID_SIZE + 1)),
+				0.0f
+			};
+			mesh.vertices.push_back(vertex);
+		}
+	}
+	return mesh;
+}
+
+// Triangles as sorted position triples, so meshes can be compared regardless of vertex and triangle order
+std::vector<std::array<float, 6>> TrianglePositions(const MeshCreateInfo& mesh) {
+	std::vector<std::array<float, 6>> triangles;
+	for (size_t i = 0; i < mesh.indices.size(); i += 3) {
+		std::array<std::array<float, 2>, 3> corners{};
+		for (size_t c = 0; c < 3; ++c) {
+			const Vec3& position = mesh.vertices[mesh.indices[i + c]].position;
+			corners[c] = {position.x, position.y};
+		}
+		std::ranges::rotate(corners, std::ranges::min_element(corners));
+		triangles.push_back({corners[0][0], corners[0][1], corners[1][0], corners[1][1], corners[2][0], corners[2][1]});
+	}
+	std::ranges::sort(triangles);
+	return triangles;
+}
+} // namespace
+
+TEST(MeshImportTest, deduplicate_merges_identical_vertices) {
+	MeshCreateInfo mesh = ShuffledGridSoup();
+	const size_t soup_vertices = mesh.vertices.size();
+
+	const size_t removed = DeduplicateVertices(mesh);
+	EXPECT_EQ(mesh.vertices.size(), (GRID_SIZE + 1) * (GRID_SIZE + 1));
+	EXPECT_EQ(removed, soup_vertices - mesh.vertices.size());
+	EXPECT_EQ(mesh.indices.size(), soup_vertices);
+}
+
+TEST(MeshImportTest, optimize_reorders_for_the_vertex_cache_and_keeps_every_triangle) {
+	MeshCreateInfo mesh = ShuffledGridSoup();
+	DeduplicateVertices(mesh);
+	const auto triangles = TrianglePositions(mesh);
+	const float shuffled_acmr = ComputeACMR(mesh.indices);
+
+	OptimizeMesh(mesh);
+	EXPECT_EQ(TrianglePositions(mesh), triangles);
+	EXPECT_GT(shuffled_acmr, 2.5f);
+	EXPECT_LT(ComputeACMR(mesh.indices), 0.8f);
+
+	// Vertex fetch order: each index is at most one past the highest seen so far
+	uint32_t next_new = 0;
+	for (const uint32_t index : mesh.indices) {
+		ASSERT_LE(index, next_new);
+		next_new = std::max(next_new, index + 1);
+	}
+	EXPECT_EQ(next_new, mesh.vertices.size());
+}
+
+TEST(MeshImportTest, binary_round_trip_uses_16_bit_indices_when_they_fit) {
+	MeshCreateInfo mesh = ShuffledGridSoup();
+	OptimizeMesh(mesh);
+
+	const std::vector<uint8_t> blob = WriteMeshBinary(mesh);
+	MeshBinaryHeader header;
+	std::memcpy(&header, blob.data(), sizeof(header));
+	EXPECT_EQ(header.magic, MESH_BINARY_MAGIC);
+	EXPECT_EQ(header.index_size, sizeof(uint16_t));
+	EXPECT_LT(blob.size(), sizeof(header) + mesh.vertices.size() * sizeof(Vertex) + mesh.indices.size() * 3);
+
+	const auto loaded = ReadMeshBinary(blob);
+	ASSERT_TRUE(loaded.has_value());
+	EXPECT_EQ(loaded->indices, mesh.indices);
+	ASSERT_EQ(loaded->vertices.size(), mesh.vertices.size());
+	EXPECT_EQ(std::memcmp(loaded->vertices.data(), mesh.vertices.data(), mesh.vertices.size() * sizeof(Vertex)), 0);
+}
+
+TEST(MeshImportTest, binary_reader_rejects_bad_blobs) {
+	MeshCreateInfo mesh;
+	mesh.vertices.resize(3);
+	mesh.indices = {0, 1, 2};
+	const std::vector<uint8_t> blob = WriteMeshBinary(mesh);
+	ASSERT_TRUE(ReadMeshBinary(blob).has_value());
+
+	auto wrong_version = blob;
+	wrong_version[offsetof(MeshBinaryHeader, version)] = MESH_BINARY_VERSION + 1;
+	EXPECT_FALSE(ReadMeshBinary(wrong_version).has_value());
+
+	const std::vector truncated(blob.begin(), blob.end() - 4);
+	EXPECT_FALSE(ReadMeshBinary(truncated).has_value());
+
+	MeshCreateInfo out_of_range = mesh;
+	out_of_range.indices = {0, 1, 3};
+	EXPECT_FALSE(ReadMeshBinary(WriteMeshBinary(out_of_range)).has_value());
+
+	EXPECT_FALSE(ReadMeshBinary({}).has_value());
+}
+
+TEST(MeshImportTest, large_meshes_keep_32_bit_indices) {
+	MeshCreateInfo mesh;
+	mesh.vertices.resize(MAX_16BIT_INDEXED_VERTICES + 1);
+	mesh.indices = {0, 1, static_cast<uint32_t>(MAX_16BIT_INDEXED_VERTICES)};
+
+	const std::vector<uint8_t> blob = WriteMeshBinary(mesh);
+	MeshBinaryHeader header;
+	std::memcpy(&header, blob.data(), sizeof(header));
+	EXPECT_EQ(header.index_size, sizeof(uint32_t));
+	const auto loaded = ReadMeshBinary(blob);
+	ASSERT_TRUE(loaded.has_value());
+	EXPECT_EQ(loaded->indices, mesh.indices);
+}
+
+TEST(MeshImportTest, small_meshes_upload_16_bit_indices) {
+	if (!InstallNullDevice()) {
+		GTEST_SKIP() << "GL is not loaded through glad on this platform";
+	}
+	SetHeadless(false);
+	Renderer renderer;
+	ResetNullDeviceStats();
+
+	const MeshId cube = renderer.GetMeshManager().CreateCube();
+	const uint32_t vertex_count = renderer.GetMeshManager().GetVertexCount(cube);
+	const uint32_t index_count = renderer.GetMeshManager().GetIndexCount(cube);
+	EXPECT_EQ(
+		GetNullDeviceStats().buffer_upload_bytes,
+		vertex_count * sizeof(Vertex) + index_count * sizeof(uint16_t)
+	);
+	ResetNullDeviceStats();
+}
@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+
+import engine.rendering;
+import glm;
+
+using namespace engine::rendering;
+
+namespace {
+constexpr auto VERTEX_SOURCE = R"(#version 300 es
+layout(location = 0) in vec3 a_Position;
+uniform mat4 u_MVP;
+void main() { gl_Position = u_MVP * vec4(a_Position, 1.0); }
+)";
+
+constexpr auto FRAGMENT_SOURCE = R"(#version 300 es
+precision mediump float;
+out vec4 FragColor;
+void main() { FragColor = vec4(1.0); }
+)";
+} // namespace
+
+class NullDeviceTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		if (!InstallNullDevice()) {
+			GTEST_SKIP() << "GL is not loaded through glad on this platform";
+		}
+		SetHeadless(false); // The null device stands in for the context, so take the real GL paths
+		shader_ = renderer_.GetShaderManager().LoadShaderFromString("null_device_test", VERTEX_SOURCE, FRAGMENT_SOURCE);
+		mesh_ = renderer_.GetMeshManager().CreateCube();
+		ResetNullDeviceStats();
+	}
+
+	void TearDown() override {
+		SetNullDeviceRecording(false);
+		ResetNullDeviceStats();
+	}
+
+	void SubmitCubes(const uint32_t count) const {
+		for (uint32_t i = 0; i < count; ++i) {
+			renderer_.SubmitRenderCommand({
+				.mesh = mesh_,
+				.shader = shader_,
+				.material = INVALID_MATERIAL,
+				.transform = glm::translate(glm::mat4(1.0f), glm::vec3(static_cast<float>(i), 0.0f, 0.0f)),
+				.camera_view = glm::mat4(1.0f)
+			});
+		}
+	}
+
+	Renderer renderer_;
+	ShaderId shader_ = INVALID_SHADER;
+	MeshId mesh_ = INVALID_MESH;
+};
+
+TEST_F(NullDeviceTest, draws_reach_the_device) {
+	ASSERT_NE(shader_, INVALID_SHADER);
+	ASSERT_NE(mesh_, INVALID_MESH);
+	renderer_.BeginFrame();
+	ResetNullDeviceStats();
+	SubmitCubes(10);
+
+	const NullDeviceStats& stats = GetNullDeviceStats();
+	EXPECT_EQ(stats.draw_calls, 10U);
+	EXPECT_EQ(stats.draw_calls, renderer_.GetStats().draw_calls);
+	EXPECT_EQ(stats.vertices_submitted, static_cast<uint64_t>(renderer_.GetStats().triangles) * 3);
+}
+
+TEST_F(NullDeviceTest, repeated_draws_add_no_state_changes) {
+	renderer_.BeginFrame();
+	ResetNullDeviceStats();
+	SubmitCubes(1);
+	const uint64_t first_draw_changes = GetNullDeviceStats().state_changes;
+	EXPECT_GT(first_draw_changes, 0U);
+
+	// Same shader, mesh and render state, so the state cache drops every state call
+	SubmitCubes(20);
+	EXPECT_EQ(GetNullDeviceStats().state_changes, first_draw_changes);
+	EXPECT_GT(GetNullDeviceStats().uniform_uploads, 20U);
+}
+
+TEST_F(NullDeviceTest, uploads_are_measured) {
+	const std::array<uint8_t, 4 * 4 * 4> pixels{};
+	const TextureId texture = renderer_.GetTextureManager().CreateTexture(
+		"null_device_texture",
+		{.width = 4, .height = 4, .format = TextureFormat::RGBA8, .data = pixels.data()}
+	);
+	ASSERT_NE(texture, INVALID_TEXTURE);
+	EXPECT_EQ(GetNullDeviceStats().texture_upload_bytes, pixels.size());
+
+	// Vertex and index data both go up when the mesh is created
+	EXPECT_EQ(GetNullDeviceStats().buffer_upload_bytes, 0U);
+	const uint64_t created_before = GetNullDeviceStats().objects_created;
+	static_cast<void>(renderer_.GetMeshManager().CreateCube(2.0f));
+	EXPECT_GT(GetNullDeviceStats().buffer_upload_bytes, 0U);
+	EXPECT_GT(GetNullDeviceStats().objects_created, created_before);
+}
+
+TEST_F(NullDeviceTest, recording_logs_call_names) {
+	SubmitCubes(1);
+	EXPECT_TRUE(GetNullDeviceCalls().empty());
+
+	SetNullDeviceRecording(true);
+	SubmitCubes(1);
+	const auto calls = GetNullDeviceCalls();
+	ASSERT_FALSE(calls.empty());
+	EXPECT_EQ(calls.back(), "glDrawElements");
+	EXPECT_NE(std::ranges::find(calls, "glUniformMatrix4fv"), calls.end());
+
+	ResetNullDeviceStats();
+	EXPECT_TRUE(GetNullDeviceCalls().empty());
+	EXPECT_EQ(GetNullDeviceStats().draw_calls, 0U);
+}
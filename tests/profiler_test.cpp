@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <flecs.h>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "platform/profiler.h"
+
+import engine.platform;
+import engine.ecs;
+
+using namespace engine::platform;
+
+class ProfilerTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		profiling::Clear();
+		profiling::SetEnabled(true);
+	}
+
+	void TearDown() override {
+		profiling::SetEnabled(false);
+		profiling::Clear();
+	}
+
+	static const profiling::ZoneEvent* Find(const std::vector<profiling::ZoneEvent>& events, const char* name) {
+		const auto it = std::ranges::find_if(events, [name](const profiling::ZoneEvent& event) {
+			return event.name && std::strcmp(event.name, name) == 0;
+		});
+		return it == events.end() ? nullptr : &*it;
+	}
+};
+
+TEST_F(ProfilerTest, nested_zones_record_depth_and_containment) {
+	{
+		PROFILE_ZONE("Outer");
+		{
+			PROFILE_ZONE("Inner");
+		}
+	}
+
+	const auto events = profiling::Capture();
+	const auto* outer = Find(events, "Outer");
+	const auto* inner = Find(events, "Inner");
+	ASSERT_NE(outer, nullptr);
+	ASSERT_NE(inner, nullptr);
+	EXPECT_EQ(outer->depth, 0U);
+	EXPECT_EQ(inner->depth, 1U);
+	EXPECT_EQ(inner->thread_id, outer->thread_id);
+	EXPECT_GE(inner->start_ns, outer->start_ns);
+	EXPECT_LE(inner->start_ns + inner->duration_ns, outer->start_ns + outer->duration_ns);
+}
+
+TEST_F(ProfilerTest, disabled_zones_are_not_recorded) {
+	profiling::SetEnabled(false);
+	{
+		PROFILE_ZONE("Disabled");
+	}
+	EXPECT_EQ(Find(profiling::Capture(), "Disabled"), nullptr);
+}
+
+TEST_F(ProfilerTest, threads_get_their_own_ids_and_names) {
+	{
+		PROFILE_ZONE("MainThreadZone");
+	}
+	std::thread worker([] {
+		threading::SetCurrentThreadName("Profiled Worker");
+		PROFILE_ZONE("WorkerZone");
+	});
+	worker.join();
+
+	const auto events = profiling::Capture();
+	const auto* main_zone = Find(events, "MainThreadZone");
+	const auto* worker_zone = Find(events, "WorkerZone");
+	ASSERT_NE(main_zone, nullptr);
+	ASSERT_NE(worker_zone, nullptr);
+	EXPECT_NE(main_zone->thread_id, worker_zone->thread_id);
+
+	const auto trace = nlohmann::json::parse(profiling::ToChromeTraceJson());
+	bool found_name = false;
+	for (const auto& event : trace["traceEvents"]) {
+		if (event["ph"] == "M" && event["args"]["name"] == "Profiled Worker") {
+			found_name = event["tid"] == worker_zone->thread_id;
+		}
+	}
+	EXPECT_TRUE(found_name);
+}
+
+TEST_F(ProfilerTest, ring_buffer_keeps_newest_events) {
+	const char* name = profiling::Intern("Flood");
+	for (size_t i = 0; i < profiling::EVENTS_PER_THREAD + 10; ++i) {
+		profiling::RecordZone(name, static_cast<int64_t>(i), 1);
+	}
+
+	const auto events = profiling::Capture();
+	const auto flood = std::ranges::count_if(events, [name](const auto& event) { return event.name == name; });
+	EXPECT_EQ(static_cast<size_t>(flood), profiling::EVENTS_PER_THREAD);
+
+	profiling::Clear();
+	EXPECT_TRUE(profiling::Capture().empty());
+}
+
+TEST_F(ProfilerTest, chrome_trace_contains_complete_events) {
+	profiling::RecordZone(profiling::Intern("Quote\"Zone"), 1500, 2250);
+
+	const auto trace = nlohmann::json::parse(profiling::ToChromeTraceJson());
+	ASSERT_TRUE(trace.contains("traceEvents"));
+	bool found = false;
+	for (const auto& event : trace["traceEvents"]) {
+		if (event["name"] == "Quote\"Zone") {
+			found = true;
+			EXPECT_EQ(event["ph"], "X");
+			EXPECT_DOUBLE_EQ(event["ts"].get<double>(), 1.5);
+			EXPECT_DOUBLE_EQ(event["dur"].get<double>(), 2.25);
+		}
+	}
+	EXPECT_TRUE(found);
+}
+
+TEST_F(ProfilerTest, flecs_systems_get_zones_automatically) {
+	engine::ecs::ECSWorld ecs;
+	ecs.GetWorld().system("ProfiledTestSystem").kind(flecs::OnUpdate).run([](flecs::iter&) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	});
+
+	ecs.ProgressAll(1.0f / 60.0f);
+
+	const auto events = profiling::Capture();
+	const auto* system_zone = Find(events, "ProfiledTestSystem");
+	const auto* progress_zone = Find(events, "ECS Progress");
+	ASSERT_NE(system_zone, nullptr);
+	ASSERT_NE(progress_zone, nullptr);
+	EXPECT_GE(system_zone->duration_ns, 500'000);
+	EXPECT_EQ(system_zone->depth, progress_zone->depth + 1);
+}
@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+import engine.rendering;
+
+using namespace engine::rendering;
+
+namespace {
+std::vector<uint32_t> SortedIndices(RenderQueue& queue) {
+	queue.Sort();
+	std::vector<uint32_t> indices;
+	for (const auto& item : queue.Items()) {
+		indices.push_back(item.index);
+	}
+	return indices;
+}
+} // namespace
+
+TEST(RenderQueueTest, layer_outranks_everything) {
+	RenderQueue queue;
+	queue.Push(RenderQueue::MakeKey({.layer = 1, .shader = 1}), 0);
+	queue.Push(RenderQueue::MakeKey({.layer = 0, .transparent = true, .shader = 9, .view_depth = 100.0f}), 1);
+	queue.Push(RenderQueue::MakeKey({.layer = 0, .shader = 9}), 2);
+
+	EXPECT_EQ(SortedIndices(queue), (std::vector<uint32_t>{2, 1, 0}));
+}
+
+TEST(RenderQueueTest, opaque_groups_by_shader_then_material_then_mesh) {
+	RenderQueue queue;
+	queue.Push(RenderQueue::MakeKey({.shader = 2, .material = 1, .mesh = 1}), 0);
+	queue.Push(RenderQueue::MakeKey({.shader = 1, .material = 2, .mesh = 1}), 1);
+	queue.Push(RenderQueue::MakeKey({.shader = 2, .material = 1, .mesh = 3, .view_depth = 1.0f}), 2);
+	queue.Push(RenderQueue::MakeKey({.shader = 1, .material = 1, .mesh = 5, .view_depth = 50.0f}), 3);
+	queue.Push(RenderQueue::MakeKey({.shader = 2, .material = 1, .mesh = 1, .view_depth = 0.5f}), 4);
+
+	EXPECT_EQ(SortedIndices(queue), (std::vector<uint32_t>{3, 1, 0, 4, 2}));
+}
+
+TEST(RenderQueueTest, opaque_is_front_to_back_and_transparent_back_to_front) {
+	RenderQueue queue;
+	for (const float depth : {5.0f, 0.25f, 40.0f}) {
+		queue.Push(RenderQueue::MakeKey({.shader = 1, .view_depth = depth}), static_cast<uint32_t>(queue.Size()));
+	}
+	for (const float depth : {5.0f, 0.25f, 40.0f}) {
+		queue.Push(
+			RenderQueue::MakeKey({.transparent = true, .shader = 1, .view_depth = depth}),
+			static_cast<uint32_t>(queue.Size())
+		);
+	}
+
+	EXPECT_EQ(SortedIndices(queue), (std::vector<uint32_t>{1, 0, 2, 5, 3, 4}));
+}
+
+TEST(RenderQueueTest, behind_camera_sorts_as_nearest) {
+	EXPECT_EQ(RenderQueue::MakeKey({.view_depth = -3.0f}), RenderQueue::MakeKey({.view_depth = 0.0f}));
+}
+
+TEST(RenderQueueTest, radix_sort_matches_stable_sort) {
+	std::mt19937_64 rng(1234);
+	RenderQueue queue;
+	std::vector<RenderQueue::Item> expected;
+	for (uint32_t i = 0; i < 5000; ++i) {
+		// Few distinct keys so stability is exercised, with random high and low digits
+		const uint64_t key = (rng() % 37) << 56 | (rng() % 3) << 20 | (rng() % 5);
+		queue.Push(key, i);
+		expected.push_back({.key = key, .index = i});
+	}
+	std::ranges::stable_sort(expected, {}, &RenderQueue::Item::key);
+
+	queue.Sort();
+	ASSERT_EQ(queue.Size(), expected.size());
+	for (size_t i = 0; i < expected.size(); ++i) {
+		EXPECT_EQ(queue.Items()[i].key, expected[i].key);
+		EXPECT_EQ(queue.Items()[i].index, expected[i].index);
+	}
+}
+
+TEST(RenderQueueTest, clear_empties_the_queue) {
+	RenderQueue queue;
+	queue.Push(1, 0);
+	queue.Clear();
+	EXPECT_TRUE(queue.Empty());
+	queue.Sort();
+	EXPECT_TRUE(queue.Items().empty());
+}
@@ -1,6 +1,13 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <gtest/gtest.h>
+#include <string_view>
+#include <vector>
 
 import engine.components;
+import engine.ecs;
+import engine.rendering;
 import glm;
 
 class RendererTest : public ::testing::Test {
@@ -47,3 +54,121 @@ TEST_F(RendererTest, default_camera_has_sane_values) {
 	EXPECT_FALSE(glm::isnan(default_camera.projection_matrix[0][0]));
 	EXPECT_FALSE(glm::isinf(default_camera.projection_matrix[0][0]));
 }
+
+// Instanced runs are only formed from draws whose render state stacks compare equal
+TEST_F(RendererTest, render_state_stacks_compare_by_value) {
+	using engine::rendering::RenderFlag;
+	using engine::rendering::RenderFlagStackEntry;
+	const std::vector<RenderFlagStackEntry> wireframe{{.enable_flags = {RenderFlag::Wireframe}}};
+	const std::vector<RenderFlagStackEntry> same_wireframe{{.enable_flags = {RenderFlag::Wireframe}}};
+	const std::vector<RenderFlagStackEntry> no_depth{{.disable_flags = {RenderFlag::DepthTest}}};
+
+	EXPECT_EQ(wireframe, same_wireframe);
+	EXPECT_NE(wireframe, no_depth);
+	EXPECT_NE(wireframe, std::vector<RenderFlagStackEntry>{});
+}
+
+// The instance buffer is read as eight vec4 attributes per instance, so the struct must be tightly packed
+TEST_F(RendererTest, instance_data_is_two_packed_matrices) {
+	EXPECT_EQ(sizeof(engine::rendering::InstanceData), 2 * sizeof(glm::mat4));
+	EXPECT_EQ(offsetof(engine::rendering::InstanceData, normal_matrix), sizeof(glm::mat4));
+}
+
+// ============================================================================
+// Instanced Run Tests (null GL device)
+// ============================================================================
+
+namespace {
+constexpr auto INSTANCED_VERTEX_SOURCE = R"(#version 300 es
+layout(location = 0) in vec3 a_Position;
+layout(location = 4) in mat4 a_InstanceModel;
+uniform mat4 u_MVP;
+uniform mat4 u_ViewProjection;
+uniform int u_Instanced;
+void main() {
+    gl_Position = u_Instanced == 1 ? u_ViewProjection * a_InstanceModel * vec4(a_Position, 1.0)
+                                   : u_MVP * vec4(a_Position, 1.0);
+}
+)";
+
+constexpr auto INSTANCED_FRAGMENT_SOURCE = R"(#version 300 es
+precision mediump float;
+out vec4 FragColor;
+void main() { FragColor = vec4(1.0); }
+)";
+} // namespace
+
+class InstancedRunTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		using namespace engine::rendering;
+		if (!InstallNullDevice()) {
+			GTEST_SKIP() << "GL is not loaded through glad on this platform";
+		}
+		SetHeadless(false);
+		shader_ = renderer_.GetShaderManager().LoadShaderFromString(
+			"instanced_run_test",
+			INSTANCED_VERTEX_SOURCE,
+			INSTANCED_FRAGMENT_SOURCE
+		);
+		ASSERT_NE(shader_, INVALID_SHADER);
+	}
+
+	void TearDown() override {
+		engine::rendering::SetNullDeviceRecording(false);
+		engine::rendering::ResetNullDeviceStats();
+	}
+
+	void AddRenderables(const engine::rendering::MeshId mesh, const int count) {
+		for (int i = 0; i < count; ++i) {
+			auto entity = ecs_.CreateEntity();
+			entity.set<engine::components::Transform>({.position = {static_cast<float>(i), 0.0f, 0.0f}});
+			entity.set<engine::rendering::Renderable>({.mesh = mesh, .shader = shader_});
+		}
+	}
+
+	// Render one frame and count the instanced and plain draw calls that reached the device
+	void RenderFrame(size_t& instanced_draws, size_t& plain_draws) {
+		ecs_.ProgressEditMode(1.0f / 60.0f);
+		renderer_.BeginFrame();
+		engine::rendering::ResetNullDeviceStats();
+		engine::rendering::SetNullDeviceRecording(true);
+		ecs_.SubmitRenderCommands(renderer_);
+		engine::rendering::SetNullDeviceRecording(false);
+
+		const auto calls = engine::rendering::GetNullDeviceCalls();
+		instanced_draws = static_cast<size_t>(std::ranges::count(calls, std::string_view("glDrawElementsInstanced")));
+		plain_draws = static_cast<size_t>(std::ranges::count(calls, std::string_view("glDrawElements")));
+	}
+
+	engine::rendering::Renderer renderer_;
+	engine::ecs::ECSWorld ecs_;
+	engine::rendering::ShaderId shader_ = engine::rendering::INVALID_SHADER;
+};
+
+TEST_F(InstancedRunTest, identical_meshes_draw_as_one_instanced_call) {
+	AddRenderables(renderer_.GetMeshManager().CreateCube(), 10);
+
+	size_t instanced_draws = 0;
+	size_t plain_draws = 0;
+	RenderFrame(instanced_draws, plain_draws);
+	EXPECT_EQ(instanced_draws, 1U);
+	EXPECT_EQ(plain_draws, 0U);
+	EXPECT_EQ(engine::rendering::GetNullDeviceStats().draw_calls, 1U);
+	EXPECT_EQ(renderer_.GetStats().instances, 10U);
+}
+
+TEST_F(InstancedRunTest, mixed_meshes_split_into_runs_and_singles_draw_plainly) {
+	AddRenderables(renderer_.GetMeshManager().CreateCube(), 4);
+	AddRenderables(renderer_.GetMeshManager().CreateCube(2.0f), 3);
+	// A lone draw is below the shortest run worth instancing
+	AddRenderables(renderer_.GetMeshManager().CreateCube(3.0f), 1);
+
+	size_t instanced_draws = 0;
+	size_t plain_draws = 0;
+	RenderFrame(instanced_draws, plain_draws);
+	EXPECT_EQ(instanced_draws, 2U);
+	EXPECT_EQ(plain_draws, 1U);
+	EXPECT_EQ(engine::rendering::GetNullDeviceStats().draw_calls, 3U);
+	EXPECT_EQ(renderer_.GetStats().instances, 7U);
+}
@@ -77,7 +77,7 @@ TEST_F(SceneSerializationTest, SaveAndLoad_EntityWithTransform_PreservesValues)
 	// Set transform values
 	auto& transform = entity.get_mut<Transform>();
 	transform.position = glm::vec3(10.0f, 20.0f, 30.0f);
-	transform.rotation = glm::vec3(0.1f, 0.2f, 0.3f);
+	transform.SetEulerAngles(glm::vec3(0.1f, 0.2f, 0.3f));
 	transform.scale = glm::vec3(2.0f, 3.0f, 4.0f);
 
 	// Save the scene
@@ -104,9 +104,10 @@ TEST_F(SceneSerializationTest, SaveAndLoad_EntityWithTransform_PreservesValues)
 	EXPECT_FLOAT_EQ(loaded_transform.position.y, 20.0f);
 	EXPECT_FLOAT_EQ(loaded_transform.position.z, 30.0f);
 
-	EXPECT_FLOAT_EQ(loaded_transform.rotation.x, 0.1f);
-	EXPECT_FLOAT_EQ(loaded_transform.rotation.y, 0.2f);
-	EXPECT_FLOAT_EQ(loaded_transform.rotation.z, 0.3f);
+	const glm::vec3 loaded_euler = loaded_transform.GetEulerAngles();
+	EXPECT_NEAR(loaded_euler.x, 0.1f, 1e-5f);
+	EXPECT_NEAR(loaded_euler.y, 0.2f, 1e-5f);
+	EXPECT_NEAR(loaded_euler.z, 0.3f, 1e-5f);
 
 	EXPECT_FLOAT_EQ(loaded_transform.scale.x, 2.0f);
 	EXPECT_FLOAT_EQ(loaded_transform.scale.y, 3.0f);
@@ -342,6 +343,27 @@ TEST_F(SceneSerializationTest, Load_NonexistentFile_ReturnsInvalidScene) {
 	EXPECT_EQ(loaded_id, INVALID_SCENE);
 }
 
+TEST_F(SceneSerializationTest, LegacyEntityJson_EulerRotation_UpgradesToQuaternion) {
+	const std::string legacy_json = R"({"name":"Legacy","components":{"engine.components.Transform":{)"
+									R"("position":{"x":1,"y":2,"z":3},"rotation":{"x":0,"y":1.5,"z":0},)"
+									R"("scale":{"x":1,"y":1,"z":1}}}})";
+
+	const std::string upgraded = SceneSerializer::UpgradeLegacyEntityJson(legacy_json);
+	EXPECT_NE(upgraded.find("\"w\""), std::string::npos);
+
+	// Already-upgraded data passes through untouched
+	EXPECT_EQ(SceneSerializer::UpgradeLegacyEntityJson(upgraded), upgraded);
+
+	const auto entity = ecs_world_->CreateEntity();
+	entity.from_json(upgraded.c_str());
+
+	const auto& transform = entity.get<Transform>();
+	EXPECT_FLOAT_EQ(transform.position.y, 2.0f);
+	const glm::quat expected(glm::vec3(0.0f, 1.5f, 0.0f));
+	EXPECT_NEAR(transform.rotation.w, expected.w, 1e-5f);
+	EXPECT_NEAR(transform.rotation.y, expected.y, 1e-5f);
+}
+
 TEST_F(SceneSerializationTest, SavedFile_ContainsValidJson) {
 	SceneId scene_id = scene_manager_->CreateScene("JsonTestScene");
 	ASSERT_NE(scene_id, INVALID_SCENE);
@@ -0,0 +1,249 @@
+#include <algorithm>
+#include <cstdint>
+#include <flecs.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+import engine.ecs;
+import engine.components;
+import engine.spatial;
+import glm;
+
+using namespace engine::ecs;
+using namespace engine::components;
+using namespace engine::spatial;
+
+namespace {
+Aabb UnitBoxAt(const glm::vec3& center) { return Aabb::FromCenterExtents(center, glm::vec3(0.5F)); }
+
+bool ContainsId(const std::vector<DynamicAabbTree::Id>& ids, const DynamicAabbTree::Id id) {
+	return std::ranges::find(ids, id) != ids.end();
+}
+} // namespace
+
+// === DYNAMIC AABB TREE ===
+
+TEST(DynamicAabbTreeTest, insert_update_and_remove) {
+	DynamicAabbTree tree;
+	EXPECT_EQ(tree.Height(), 0);
+
+	EXPECT_TRUE(tree.Update(1, UnitBoxAt({0.0F, 0.0F, 0.0F})));
+	EXPECT_TRUE(tree.Update(2, UnitBoxAt({5.0F, 0.0F, 0.0F})));
+	EXPECT_EQ(tree.Size(), 2U);
+	EXPECT_TRUE(tree.Contains(1));
+
+	// Moving within the fat margin keeps the tree structure
+	EXPECT_FALSE(tree.Update(1, UnitBoxAt({0.05F, 0.0F, 0.0F})));
+	EXPECT_FLOAT_EQ(tree.GetBounds(1)->min.x, -0.45F);
+
+	// Moving far away reinserts
+	EXPECT_TRUE(tree.Update(1, UnitBoxAt({20.0F, 0.0F, 0.0F})));
+	std::vector<DynamicAabbTree::Id> ids;
+	tree.QueryPoint({0.0F, 0.0F, 0.0F}, ALL_LAYERS, ids);
+	EXPECT_TRUE(ids.empty());
+	tree.QueryPoint({20.0F, 0.0F, 0.0F}, ALL_LAYERS, ids);
+	EXPECT_EQ(ids, std::vector<DynamicAabbTree::Id>{1});
+
+	EXPECT_TRUE(tree.Remove(1));
+	EXPECT_FALSE(tree.Remove(1));
+	EXPECT_EQ(tree.GetBounds(1), nullptr);
+	EXPECT_EQ(tree.Size(), 1U);
+}
+
+TEST(DynamicAabbTreeTest, stays_balanced_and_matches_brute_force) {
+	DynamicAabbTree tree;
+	std::vector<Aabb> boxes;
+
+	// A line of boxes is the worst case for an unbalanced tree
+	constexpr uint64_t COUNT = 1024;
+	for (uint64_t i = 0; i < COUNT; ++i) {
+		const auto x = static_cast<float>(i);
+		boxes.push_back(UnitBoxAt({x, static_cast<float>(i % 7), 0.0F}));
+		tree.Update(i, boxes.back());
+	}
+	EXPECT_LE(tree.Height(), 32);
+
+	const Aabb region{.min = {100.0F, 0.0F, -1.0F}, .max = {140.0F, 3.0F, 1.0F}};
+	std::vector<DynamicAabbTree::Id> ids;
+	tree.QueryAabb(region, ALL_LAYERS, ids);
+	for (uint64_t i = 0; i < COUNT; ++i) {
+		EXPECT_EQ(ContainsId(ids, i), boxes[i].Intersects(region)) << "id " << i;
+	}
+
+	// Remove every other box and check again
+	for (uint64_t i = 0; i < COUNT; i += 2) {
+		tree.Remove(i);
+	}
+	ids.clear();
+	tree.QueryAabb(region, ALL_LAYERS, ids);
+	for (uint64_t i = 0; i < COUNT; ++i) {
+		EXPECT_EQ(ContainsId(ids, i), i % 2 == 1 && boxes[i].Intersects(region)) << "id " << i;
+	}
+}
+
+TEST(DynamicAabbTreeTest, layer_mask_filters_results) {
+	DynamicAabbTree tree;
+	tree.Update(1, UnitBoxAt({0.0F, 0.0F, 0.0F}), 0b01);
+	tree.Update(2, UnitBoxAt({0.0F, 0.0F, 0.0F}), 0b10);
+
+	std::vector<DynamicAabbTree::Id> ids;
+	tree.QuerySphere({0.0F, 0.0F, 0.0F}, 1.0F, 0b10, ids);
+	EXPECT_EQ(ids, std::vector<DynamicAabbTree::Id>{2});
+
+	// Changing only the layer is picked up without moving the box
+	tree.Update(1, UnitBoxAt({0.0F, 0.0F, 0.0F}), 0b10);
+	ids.clear();
+	tree.QuerySphere({0.0F, 0.0F, 0.0F}, 1.0F, 0b10, ids);
+	EXPECT_EQ(ids.size(), 2U);
+}
+
+TEST(DynamicAabbTreeTest, ray_hits_are_sorted_nearest_first) {
+	DynamicAabbTree tree;
+	tree.Update(1, UnitBoxAt({0.0F, 0.0F, -10.0F}));
+	tree.Update(2, UnitBoxAt({0.0F, 0.0F, -3.0F}));
+	tree.Update(3, UnitBoxAt({5.0F, 0.0F, -3.0F})); // Off the ray
+
+	std::vector<DynamicAabbTree::RayHit> hits;
+	tree.QueryRay({.origin = {0.0F, 0.0F, 0.0F}, .direction = {0.0F, 0.0F, -1.0F}}, ALL_LAYERS, hits);
+	ASSERT_EQ(hits.size(), 2U);
+	EXPECT_EQ(hits[0].id, 2U);
+	EXPECT_FLOAT_EQ(hits[0].distance, 2.5F);
+	EXPECT_EQ(hits[1].id, 1U);
+
+	hits.clear();
+	tree.QueryRay({.direction = {0.0F, 0.0F, -1.0F}, .max_distance = 5.0F}, ALL_LAYERS, hits);
+	ASSERT_EQ(hits.size(), 1U);
+	EXPECT_EQ(hits[0].id, 2U);
+}
+
+TEST(DynamicAabbTreeTest, frustum_query_culls_boxes_outside) {
+	DynamicAabbTree tree;
+	tree.Update(1, UnitBoxAt({0.0F, 0.0F, -10.0F})); // In front of the camera
+	tree.Update(2, UnitBoxAt({0.0F, 0.0F, 10.0F}));  // Behind
+	tree.Update(3, UnitBoxAt({0.0F, 0.0F, -500.0F})); // Beyond the far plane
+
+	const glm::mat4 projection = glm::perspective(glm::radians(60.0F), 1.0F, 0.1F, 100.0F);
+	const glm::mat4 view = glm::lookAt(glm::vec3(0.0F), glm::vec3(0.0F, 0.0F, -1.0F), glm::vec3(0.0F, 1.0F, 0.0F));
+	const Frustum frustum = Frustum::FromMatrix(projection * view);
+
+	std::vector<DynamicAabbTree::Id> ids;
+	tree.QueryFrustum(frustum, ALL_LAYERS, ids);
+	EXPECT_EQ(ids, std::vector<DynamicAabbTree::Id>{1});
+}
+
+TEST(FrustumCullingTest, batch_matches_per_box_test) {
+	const glm::mat4 projection = glm::perspective(glm::radians(60.0F), 1.5F, 0.1F, 50.0F);
+	const glm::mat4 view = glm::lookAt(glm::vec3(3.0F, 2.0F, 5.0F), glm::vec3(0.0F), glm::vec3(0.0F, 1.0F, 0.0F));
+	const Frustum frustum = Frustum::FromMatrix(projection * view);
+
+	// A grid straddling every plane; 11^3 boxes is not a multiple of the SIMD width, so the tail is covered too
+	AabbBatch batch;
+	std::vector<uint32_t> expected;
+	for (int x = -5; x <= 5; ++x) {
+		for (int y = -5; y <= 5; ++y) {
+			for (int z = -5; z <= 5; ++z) {
+				const Aabb box = Aabb::FromCenterExtents(glm::vec3(x, y, z) * 12.0F, glm::vec3(1.0F, 2.0F, 0.5F));
+				if (frustum.Intersects(box)) {
+					expected.push_back(static_cast<uint32_t>(batch.Size()));
+				}
+				batch.Push(box);
+			}
+		}
+	}
+	ASSERT_FALSE(expected.empty());
+	ASSERT_LT(expected.size(), batch.Size());
+
+	std::vector<uint32_t> visible;
+	CullAabbs(frustum, batch, visible);
+	EXPECT_EQ(visible, expected);
+}
+
+TEST(FrustumCullingTest, results_are_appended) {
+	const glm::mat4 projection = glm::perspective(glm::radians(60.0F), 1.0F, 0.1F, 100.0F);
+	const glm::mat4 view = glm::lookAt(glm::vec3(0.0F), glm::vec3(0.0F, 0.0F, -1.0F), glm::vec3(0.0F, 1.0F, 0.0F));
+	const Frustum frustum = Frustum::FromMatrix(projection * view);
+
+	AabbBatch batch;
+	batch.Push(UnitBoxAt({0.0F, 0.0F, 10.0F})); // Behind
+	batch.Push(UnitBoxAt({0.0F, 0.0F, -10.0F}));
+
+	std::vector<uint32_t> visible{99};
+	CullAabbs(frustum, batch, visible);
+	EXPECT_EQ(visible, (std::vector<uint32_t>{99, 1}));
+
+	batch.Clear();
+	EXPECT_EQ(batch.Size(), 0U);
+}
+
+TEST(AabbTest, transformed_encloses_rotated_box) {
+	const Aabb box{.min = glm::vec3(-1.0F), .max = glm::vec3(1.0F)};
+	const glm::mat4 matrix = glm::translate(glm::mat4(1.0F), glm::vec3(10.0F, 0.0F, 0.0F))
+							 * glm::mat4_cast(glm::angleAxis(glm::quarter_pi<float>(), glm::vec3(0, 0, 1)));
+	const Aabb world = box.Transformed(matrix);
+
+	EXPECT_NEAR(world.max.x, 10.0F + glm::sqrt(2.0F), 1e-5F);
+	EXPECT_NEAR(world.min.y, -glm::sqrt(2.0F), 1e-5F);
+	EXPECT_NEAR(world.max.z, 1.0F, 1e-5F);
+}
+
+// === ECS WORLD QUERIES ===
+
+class SpatialIndexWorldTest : public ::testing::Test {
+protected:
+	ECSWorld ecs_;
+
+	flecs::entity CreateAt(const glm::vec3& position, const uint32_t layer = 1, const flecs::entity parent = {}) {
+		auto entity = ecs_.CreateEntity();
+		if (parent.is_valid()) {
+			ECSWorld::SetParent(entity, parent);
+		}
+		entity.set<Transform>({.position = position});
+		entity.set<Spatial>({.spatial_layer = layer});
+		return entity;
+	}
+
+	void Step() { ecs_.ProgressEditMode(1.0F / 60.0F); }
+};
+
+TEST_F(SpatialIndexWorldTest, queries_use_world_space_bounds) {
+	auto entity = CreateAt({10.0F, 0.0F, 0.0F});
+	Step();
+
+	EXPECT_EQ(ecs_.QueryPoint({10.2F, 0.0F, 0.0F}), std::vector<flecs::entity>{entity});
+	EXPECT_TRUE(ecs_.QueryPoint({0.0F, 0.0F, 0.0F}).empty());
+	EXPECT_EQ(ecs_.QuerySphere({12.0F, 0.0F, 0.0F}, 1.6F).size(), 1U);
+	EXPECT_EQ(ecs_.QueryAabb({.min = {9.0F, -1.0F, -1.0F}, .max = {9.6F, 1.0F, 1.0F}}).size(), 1U);
+
+	const auto hits = ecs_.QueryRay({.origin = {0.0F, 0.0F, 0.0F}, .direction = {1.0F, 0.0F, 0.0F}});
+	ASSERT_EQ(hits.size(), 1U);
+	EXPECT_EQ(hits[0].entity, entity);
+	EXPECT_FLOAT_EQ(hits[0].distance, 9.5F);
+}
+
+TEST_F(SpatialIndexWorldTest, moving_parent_refits_children) {
+	auto parent = CreateAt({0.0F, 0.0F, 0.0F});
+	auto child = CreateAt({0.0F, 5.0F, 0.0F}, 1, parent);
+	Step();
+	EXPECT_EQ(ecs_.QueryPoint({0.0F, 5.0F, 0.0F}), std::vector<flecs::entity>{child});
+
+	parent.set<Transform>({.position = {100.0F, 0.0F, 0.0F}});
+	Step();
+	EXPECT_TRUE(ecs_.QueryPoint({0.0F, 5.0F, 0.0F}).empty());
+	EXPECT_EQ(ecs_.QueryPoint({100.0F, 5.0F, 0.0F}), std::vector<flecs::entity>{child});
+}
+
+TEST_F(SpatialIndexWorldTest, layer_mask_and_removal) {
+	auto a = CreateAt({0.0F, 0.0F, 0.0F}, 0b01);
+	auto b = CreateAt({0.0F, 0.0F, 0.0F}, 0b10);
+	Step();
+
+	EXPECT_EQ(ecs_.QueryPoint({0.0F, 0.0F, 0.0F}).size(), 2U);
+	EXPECT_EQ(ecs_.QueryPoint({0.0F, 0.0F, 0.0F}, 0b10), std::vector<flecs::entity>{b});
+
+	b.destruct();
+	EXPECT_EQ(ecs_.QueryPoint({0.0F, 0.0F, 0.0F}), std::vector<flecs::entity>{a});
+
+	a.remove<Spatial>();
+	EXPECT_TRUE(ecs_.QueryPoint({0.0F, 0.0F, 0.0F}).empty());
+	EXPECT_EQ(ecs_.GetSpatialIndex().Size(), 0U);
+}
@@ -0,0 +1,134 @@
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+
+import engine.rendering;
+import glm;
+
+using namespace engine::rendering;
+
+namespace {
+SpriteRenderCommand SpriteWith(const TextureId texture, const int layer = 0) {
+	return {.texture = texture, .position = {0.0f, 0.0f}, .size = {1.0f, 1.0f}, .layer = layer};
+}
+
+// Texture id of each quad, read back through its draw's slot table
+std::vector<TextureId> QuadTextures(const SpriteBatch& batch) {
+	std::vector<TextureId> textures;
+	for (const auto& draw : batch.GetDraws()) {
+		for (uint32_t quad = draw.first_quad; quad < draw.first_quad + draw.quad_count; ++quad) {
+			const SpriteVertex& first_vertex = batch.GetVertices()[quad * SpriteBatch::VERTICES_PER_QUAD];
+			const auto slot = static_cast<uint32_t>(first_vertex.texture_slot);
+			EXPECT_LT(slot, draw.texture_count);
+			textures.push_back(draw.textures[slot]);
+		}
+	}
+	return textures;
+}
+
+void ExpectVec2Near(const glm::vec2& actual, const glm::vec2& expected) {
+	EXPECT_NEAR(actual.x, expected.x, 1e-4f);
+	EXPECT_NEAR(actual.y, expected.y, 1e-4f);
+}
+} // namespace
+
+TEST(SpriteBatchTest, sprites_without_texture_are_dropped) {
+	SpriteBatch batch;
+	batch.Add(SpriteWith(INVALID_TEXTURE));
+	batch.Add(SpriteWith(3));
+	batch.Build();
+
+	EXPECT_EQ(batch.Size(), 1U);
+	EXPECT_EQ(batch.GetVertices().size(), SpriteBatch::VERTICES_PER_QUAD);
+}
+
+TEST(SpriteBatchTest, layers_sort_stably) {
+	SpriteBatch batch;
+	batch.Add(SpriteWith(1, 2));
+	batch.Add(SpriteWith(2, 0));
+	batch.Add(SpriteWith(3, 2));
+	batch.Add(SpriteWith(4, 0));
+	batch.Build();
+
+	EXPECT_EQ(QuadTextures(batch), (std::vector<TextureId>{2, 4, 1, 3}));
+	ASSERT_EQ(batch.GetDraws().size(), 1U);
+}
+
+TEST(SpriteBatchTest, draws_split_only_when_texture_slots_run_out) {
+	SpriteBatch batch;
+	std::vector<TextureId> expected;
+	for (int repeat = 0; repeat < 3; ++repeat) {
+		for (TextureId texture = 1; texture <= SPRITE_BATCH_MAX_TEXTURE_SLOTS; ++texture) {
+			batch.Add(SpriteWith(texture));
+			expected.push_back(texture);
+		}
+	}
+	batch.Add(SpriteWith(100)); // A ninth texture
+	batch.Add(SpriteWith(1));   // No longer in the new draw's table
+	expected.push_back(100);
+	expected.push_back(1);
+	batch.Build();
+
+	const auto draws = batch.GetDraws();
+	ASSERT_EQ(draws.size(), 2U);
+	EXPECT_EQ(draws[0].first_quad, 0U);
+	EXPECT_EQ(draws[0].quad_count, 3 * SPRITE_BATCH_MAX_TEXTURE_SLOTS);
+	EXPECT_EQ(draws[0].texture_count, SPRITE_BATCH_MAX_TEXTURE_SLOTS);
+	EXPECT_EQ(draws[1].first_quad, 3 * SPRITE_BATCH_MAX_TEXTURE_SLOTS);
+	EXPECT_EQ(draws[1].quad_count, 2U);
+	EXPECT_EQ(draws[1].texture_count, 2U);
+	EXPECT_EQ(QuadTextures(batch), expected);
+}
+
+TEST(SpriteBatchTest, quads_apply_pivot_rotation_and_texture_transform) {
+	SpriteBatch batch;
+	batch.Add({
+		.texture = 1,
+		.position = {10.0f, 20.0f},
+		.size = {4.0f, 2.0f},
+		.rotation = glm::half_pi<float>(),
+		.color = {1.0f, 0.0f, 0.0f, 1.0f},
+		.texture_offset = {0.5f, 0.0f},
+		.texture_scale = {0.5f, 1.0f},
+		.pivot = {0.0f, 0.0f},
+		.flip_x = true
+	});
+	batch.Build();
+
+	const auto vertices = batch.GetVertices();
+	ASSERT_EQ(vertices.size(), 4U);
+	// Bottom-left sits on the position; a quarter turn maps +x to +y
+	ExpectVec2Near(vertices[0].position, {10.0f, 20.0f});
+	ExpectVec2Near(vertices[1].position, {10.0f, 24.0f});
+	ExpectVec2Near(vertices[2].position, {8.0f, 24.0f});
+	// Flipped horizontally, then scaled into the right half of the texture
+	ExpectVec2Near(vertices[0].tex_coords, {1.0f, 0.0f});
+	ExpectVec2Near(vertices[1].tex_coords, {0.5f, 0.0f});
+	ExpectVec2Near(vertices[2].tex_coords, {0.5f, 1.0f});
+	EXPECT_EQ(vertices[3].color, glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+}
+
+TEST(SpriteBatchTest, large_batches_match_serial_layout) {
+	// Enough sprites to take the job system path
+	constexpr uint32_t count = 10000;
+	SpriteBatch batch;
+	for (uint32_t i = 0; i < count; ++i) {
+		SpriteRenderCommand sprite = SpriteWith(1 + i % 4, static_cast<int>(i % 2));
+		sprite.position = {static_cast<float>(i), 0.0f};
+		batch.Add(sprite);
+	}
+	batch.Build();
+
+	const auto vertices = batch.GetVertices();
+	ASSERT_EQ(vertices.size(), count * SpriteBatch::VERTICES_PER_QUAD);
+	ASSERT_EQ(batch.GetDraws().size(), 1U);
+	// Layer 0 (even positions) first, each layer in submission order
+	for (uint32_t quad = 0; quad < count; ++quad) {
+		const uint32_t sprite = quad < count / 2 ? quad * 2 : (quad - count / 2) * 2 + 1;
+		ExpectVec2Near(vertices[quad * SpriteBatch::VERTICES_PER_QUAD].position, {sprite - 0.5f, -0.5f});
+	}
+
+	batch.Clear();
+	EXPECT_EQ(batch.Size(), 0U);
+	EXPECT_TRUE(batch.GetVertices().empty());
+}
@@ -0,0 +1,108 @@
+#include <flecs.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+import engine.ecs;
+import engine.components;
+import glm;
+
+using namespace engine::ecs;
+using namespace engine::components;
+
+class StaticEntityTest : public ::testing::Test {
+protected:
+	ECSWorld ecs_;
+
+	flecs::entity CreateAt(const glm::vec3& position, const bool is_static, const flecs::entity parent = {}) {
+		auto entity = ecs_.CreateEntity();
+		if (parent.is_valid()) {
+			ECSWorld::SetParent(entity, parent);
+		}
+		entity.set<SceneEntity>({.static_entity = is_static});
+		entity.set<Transform>({.position = position});
+		entity.set<Spatial>({.spatial_layer = 1});
+		return entity;
+	}
+
+	void Step() { ecs_.ProgressEditMode(1.0F / 60.0F); }
+};
+
+TEST_F(StaticEntityTest, tag_follows_scene_entity_flag) {
+	auto entity = CreateAt({0.0F, 0.0F, 0.0F}, true);
+	EXPECT_TRUE(entity.has<StaticEntity>());
+
+	entity.set<SceneEntity>({.static_entity = false});
+	EXPECT_FALSE(entity.has<StaticEntity>());
+}
+
+TEST_F(StaticEntityTest, computed_once_and_indexed) {
+	auto entity = CreateAt({10.0F, 0.0F, 0.0F}, true);
+	Step();
+
+	EXPECT_FLOAT_EQ(entity.get<WorldTransform>().position.x, 10.0F);
+	EXPECT_EQ(ecs_.QueryPoint({10.0F, 0.0F, 0.0F}), std::vector<flecs::entity>{entity});
+
+	// Writing the static entity's own Transform is an explicit change and refreshes it
+	entity.set<Transform>({.position = {20.0F, 0.0F, 0.0F}});
+	Step();
+	EXPECT_FLOAT_EQ(entity.get<WorldTransform>().position.x, 20.0F);
+	EXPECT_TRUE(ecs_.QueryPoint({10.0F, 0.0F, 0.0F}).empty());
+	EXPECT_EQ(ecs_.QueryPoint({20.0F, 0.0F, 0.0F}), std::vector<flecs::entity>{entity});
+}
+
+TEST_F(StaticEntityTest, moving_parent_skips_static_children_until_invalidated) {
+	auto parent = CreateAt({0.0F, 0.0F, 0.0F}, false);
+	auto static_child = CreateAt({0.0F, 5.0F, 0.0F}, true, parent);
+	auto dynamic_child = CreateAt({0.0F, -5.0F, 0.0F}, false, parent);
+	Step();
+
+	parent.set<Transform>({.position = {100.0F, 0.0F, 0.0F}});
+	Step();
+	EXPECT_FLOAT_EQ(dynamic_child.get<WorldTransform>().position.x, 100.0F);
+	EXPECT_FLOAT_EQ(static_child.get<WorldTransform>().position.x, 0.0F);
+	EXPECT_EQ(ecs_.QueryPoint({0.0F, 5.0F, 0.0F}), std::vector<flecs::entity>{static_child});
+
+	ECSWorld::InvalidateStatic(static_child);
+	Step();
+	EXPECT_FLOAT_EQ(static_child.get<WorldTransform>().position.x, 100.0F);
+	EXPECT_TRUE(ecs_.QueryPoint({0.0F, 5.0F, 0.0F}).empty());
+	EXPECT_EQ(ecs_.QueryPoint({100.0F, 5.0F, 0.0F}), std::vector<flecs::entity>{static_child});
+}
+
+TEST_F(StaticEntityTest, dirty_grandchild_below_pruned_static_child_still_updates) {
+	auto parent = CreateAt({0.0F, 0.0F, 0.0F}, false);
+	auto static_child = CreateAt({0.0F, 5.0F, 0.0F}, true, parent);
+	auto grandchild = CreateAt({1.0F, 0.0F, 0.0F}, false, static_child);
+	Step();
+	EXPECT_FLOAT_EQ(grandchild.get<WorldTransform>().position.x, 1.0F);
+
+	// The moving parent is pruned at the static child, so the grandchild's own change must still be applied
+	// against the static child's cached transform
+	parent.set<Transform>({.position = {100.0F, 0.0F, 0.0F}});
+	grandchild.set<Transform>({.position = {2.0F, 0.0F, 0.0F}});
+	Step();
+	EXPECT_FLOAT_EQ(static_child.get<WorldTransform>().position.x, 0.0F);
+	EXPECT_FLOAT_EQ(grandchild.get<WorldTransform>().position.x, 2.0F);
+	EXPECT_FLOAT_EQ(grandchild.get<WorldTransform>().position.y, 5.0F);
+}
+
+TEST_F(StaticEntityTest, invalidating_static_root_refreshes_static_descendants) {
+	auto root = CreateAt({0.0F, 0.0F, 0.0F}, true);
+	auto child = CreateAt({1.0F, 0.0F, 0.0F}, true, root);
+	Step();
+	EXPECT_FLOAT_EQ(child.get<WorldTransform>().position.x, 1.0F);
+
+	root.set<Transform>({.position = {0.0F, 3.0F, 0.0F}});
+	Step();
+	EXPECT_FLOAT_EQ(child.get<WorldTransform>().position.y, 3.0F);
+}
+
+TEST_F(StaticEntityTest, removal_leaves_spatial_index) {
+	auto entity = CreateAt({0.0F, 0.0F, 0.0F}, true);
+	Step();
+	EXPECT_EQ(ecs_.GetSpatialIndex().Size(), 1U);
+
+	entity.destruct();
+	EXPECT_EQ(ecs_.GetSpatialIndex().Size(), 0U);
+	Step();
+}
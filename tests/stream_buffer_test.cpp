@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+
+import engine.rendering;
+
+using namespace engine::rendering;
+
+// Runs the real GL path against the null device, whose fences have always signalled
+class StreamBufferTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		if (!InstallNullDevice()) {
+			GTEST_SKIP() << "GL is not loaded through glad on this platform";
+		}
+		SetHeadless(false);
+		ResetNullDeviceStats();
+	}
+
+	void TearDown() override {
+		SetNullDeviceRecording(false);
+		ResetNullDeviceStats();
+	}
+
+	std::array<uint8_t, 4096> data_{};
+};
+
+TEST_F(StreamBufferTest, writes_append_within_a_region) {
+	StreamBuffer buffer(StreamBufferTarget::Vertex);
+	ASSERT_TRUE(buffer.Create(1024));
+
+	EXPECT_EQ(buffer.Write(data_.data(), 100, 4), 0U);
+	EXPECT_EQ(buffer.Write(data_.data(), 100, 4), 100U);
+	// Rounded up to the next whole 28 byte vertex
+	EXPECT_EQ(buffer.Write(data_.data(), 28, 28), 224U);
+
+	// Three sub-data uploads and no respecification beyond Create()
+	EXPECT_EQ(GetNullDeviceStats().buffer_upload_bytes, 228U);
+	EXPECT_EQ(buffer.GetOrphanCount(), 0U);
+}
+
+TEST_F(StreamBufferTest, full_regions_rotate_and_are_reused_once_fenced) {
+	StreamBuffer buffer(StreamBufferTarget::Index);
+	ASSERT_TRUE(buffer.Create(256));
+
+	EXPECT_EQ(buffer.Write(data_.data(), 200, 4), 0U);
+	EXPECT_EQ(buffer.Write(data_.data(), 200, 4), 256U);
+	EXPECT_EQ(buffer.Write(data_.data(), 200, 4), 512U);
+	// Back to the first region; its fence has signalled, so the storage is kept
+	EXPECT_EQ(buffer.Write(data_.data(), 200, 4), 0U);
+	EXPECT_EQ(buffer.GetOrphanCount(), 0U);
+	EXPECT_EQ(buffer.GetRegionSize(), 256U);
+}
+
+TEST_F(StreamBufferTest, oversized_writes_grow_the_regions) {
+	StreamBuffer buffer(StreamBufferTarget::Vertex);
+	ASSERT_TRUE(buffer.Create(256));
+	static_cast<void>(buffer.Write(data_.data(), 100, 4));
+
+	EXPECT_EQ(buffer.Write(data_.data(), 1000, 4), 0U);
+	EXPECT_EQ(buffer.GetRegionSize(), 1024U);
+	EXPECT_EQ(buffer.GetOrphanCount(), 1U);
+	EXPECT_EQ(buffer.Write(data_.data(), 24, 4), 1000U);
+}
+
+TEST_F(StreamBufferTest, writes_map_the_range_instead_of_sub_data) {
+	StreamBuffer buffer(StreamBufferTarget::Vertex);
+	ASSERT_TRUE(buffer.Create(256));
+
+	SetNullDeviceRecording(true);
+	static_cast<void>(buffer.Write(data_.data(), 100, 4));
+	const auto calls = GetNullDeviceCalls();
+	EXPECT_NE(std::ranges::find(calls, "glMapBufferRange"), calls.end());
+	EXPECT_NE(std::ranges::find(calls, "glUnmapBuffer"), calls.end());
+	EXPECT_EQ(std::ranges::find(calls, "glBufferSubData"), calls.end());
+}
+
+TEST_F(StreamBufferTest, growing_creates_no_fence) {
+	StreamBuffer buffer(StreamBufferTarget::Vertex);
+	ASSERT_TRUE(buffer.Create(256));
+	static_cast<void>(buffer.Write(data_.data(), 100, 4));
+
+	// The grown storage is fresh, so there is nothing for a fence to guard
+	SetNullDeviceRecording(true);
+	static_cast<void>(buffer.Write(data_.data(), 1000, 4));
+	const auto calls = GetNullDeviceCalls();
+	EXPECT_EQ(std::ranges::find(calls, "glFenceSync"), calls.end());
+	EXPECT_NE(std::ranges::find(calls, "glBufferData"), calls.end());
+}
+
+TEST_F(StreamBufferTest, headless_buffer_is_never_created) {
+	SetHeadless(true);
+	StreamBuffer buffer(StreamBufferTarget::Vertex);
+	EXPECT_FALSE(buffer.Create(1024));
+	EXPECT_FALSE(buffer.IsValid());
+	EXPECT_EQ(buffer.Write(data_.data(), 100, 4), 0U);
+	EXPECT_EQ(GetNullDeviceStats().buffer_upload_bytes, 0U);
+	SetHeadless(false);
+}
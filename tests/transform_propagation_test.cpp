@@ -0,0 +1,139 @@
+#include <flecs.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+import engine.ecs;
+import engine.components;
+import glm;
+
+using namespace engine::ecs;
+using namespace engine::components;
+
+class TransformPropagationTest : public ::testing::Test {
+protected:
+	ECSWorld ecs_;
+
+	flecs::entity CreateAt(const glm::vec3& position, const flecs::entity parent = {}) {
+		auto entity = ecs_.CreateEntity();
+		if (parent.is_valid()) {
+			ECSWorld::SetParent(entity, parent);
+		}
+		entity.set<Transform>({.position = position});
+		return entity;
+	}
+
+	void Step() { ecs_.ProgressEditMode(1.0F / 60.0F); }
+};
+
+TEST_F(TransformPropagationTest, world_transform_updates_after_progress) {
+	auto entity = CreateAt({1.0F, 2.0F, 3.0F});
+	Step();
+
+	const auto& wt = entity.get<WorldTransform>();
+	EXPECT_FLOAT_EQ(wt.position.x, 1.0F);
+	EXPECT_FLOAT_EQ(wt.position.y, 2.0F);
+	EXPECT_FLOAT_EQ(wt.position.z, 3.0F);
+}
+
+TEST_F(TransformPropagationTest, child_inherits_parent_translation) {
+	auto parent = CreateAt({10.0F, 0.0F, 0.0F});
+	auto child = CreateAt({0.0F, 5.0F, 0.0F}, parent);
+	Step();
+
+	const auto& wt = child.get<WorldTransform>();
+	EXPECT_FLOAT_EQ(wt.position.x, 10.0F);
+	EXPECT_FLOAT_EQ(wt.position.y, 5.0F);
+}
+
+TEST_F(TransformPropagationTest, rotated_parent_composes_quaternions) {
+	auto parent = CreateAt({0.0F, 0.0F, 0.0F});
+	auto child = CreateAt({1.0F, 0.0F, 0.0F}, parent);
+	parent.set<Transform>({.rotation = glm::angleAxis(glm::half_pi<float>(), glm::vec3(0, 1, 0))});
+	child.set<Transform>({.position = {1.0F, 0.0F, 0.0F}, .scale = glm::vec3(2.0F)});
+	Step();
+
+	// +90 degrees about Y maps +X to -Z
+	const auto& wt = child.get<WorldTransform>();
+	EXPECT_NEAR(wt.position.x, 0.0F, 1e-5F);
+	EXPECT_NEAR(wt.position.z, -1.0F, 1e-5F);
+	EXPECT_NEAR(glm::abs(glm::dot(wt.rotation, parent.get<Transform>().rotation)), 1.0F, 1e-5F);
+	EXPECT_FLOAT_EQ(wt.scale.x, 2.0F);
+
+	// Matrix and TRS fields describe the same transform
+	const glm::mat4 expected = ComposeTransformMatrix(wt.position, wt.rotation, wt.scale);
+	for (int column = 0; column < 4; ++column) {
+		for (int row = 0; row < 4; ++row) {
+			EXPECT_NEAR(wt.matrix[column][row], expected[column][row], 1e-5F);
+		}
+	}
+}
+
+TEST_F(TransformPropagationTest, moving_parent_repropagates_subtree) {
+	auto parent = CreateAt({0.0F, 0.0F, 0.0F});
+	auto child = CreateAt({1.0F, 0.0F, 0.0F}, parent);
+	auto grandchild = CreateAt({1.0F, 0.0F, 0.0F}, child);
+	Step();
+
+	// Moving the parent twice in one frame still yields the latest placement
+	parent.set<Transform>({.position = {5.0F, 0.0F, 0.0F}});
+	parent.set<Transform>({.position = {7.0F, 0.0F, 0.0F}});
+	Step();
+
+	EXPECT_FLOAT_EQ(child.get<WorldTransform>().position.x, 8.0F);
+	EXPECT_FLOAT_EQ(grandchild.get<WorldTransform>().position.x, 9.0F);
+}
+
+TEST_F(TransformPropagationTest, dirty_descendant_below_transformless_intermediate_is_recomputed) {
+	auto root = CreateAt({10.0F, 0.0F, 0.0F});
+	auto group = ecs_.GetWorld().entity(); // Grouping node with no Transform or WorldTransform
+	ECSWorld::SetParent(group, root);
+	auto leaf = CreateAt({1.0F, 0.0F, 0.0F}, group);
+	Step();
+	EXPECT_FLOAT_EQ(leaf.get<WorldTransform>().position.x, 11.0F);
+
+	// Both ends dirty in the same frame: the leaf is only reachable from the root through the group
+	root.set<Transform>({.position = {20.0F, 0.0F, 0.0F}});
+	leaf.set<Transform>({.position = {2.0F, 0.0F, 0.0F}});
+	Step();
+	EXPECT_FLOAT_EQ(leaf.get<WorldTransform>().position.x, 22.0F);
+
+	// Moving only the root still reaches the leaf
+	root.set<Transform>({.position = {30.0F, 0.0F, 0.0F}});
+	Step();
+	EXPECT_FLOAT_EQ(leaf.get<WorldTransform>().position.x, 32.0F);
+}
+
+TEST_F(TransformPropagationTest, reparenting_updates_world_transform) {
+	auto first = CreateAt({100.0F, 0.0F, 0.0F});
+	auto second = CreateAt({-100.0F, 0.0F, 0.0F});
+	auto child = CreateAt({1.0F, 0.0F, 0.0F}, first);
+	Step();
+	EXPECT_FLOAT_EQ(child.get<WorldTransform>().position.x, 101.0F);
+
+	ECSWorld::SetParent(child, second);
+	Step();
+	EXPECT_FLOAT_EQ(child.get<WorldTransform>().position.x, -99.0F);
+}
+
+TEST_F(TransformPropagationTest, wide_deep_hierarchy_propagates_in_parallel) {
+	// Wide enough that every depth is split across job system workers
+	constexpr int root_count = 1024;
+	constexpr int depth = 10;
+
+	std::vector<flecs::entity> leaves;
+	leaves.reserve(root_count);
+	for (int r = 0; r < root_count; ++r) {
+		auto node = CreateAt({static_cast<float>(r), 0.0F, 0.0F});
+		for (int d = 1; d < depth; ++d) {
+			node = CreateAt({0.0F, 1.0F, 0.0F}, node);
+		}
+		leaves.push_back(node);
+	}
+	Step();
+
+	for (int r = 0; r < root_count; ++r) {
+		const auto& wt = leaves[r].get<WorldTransform>();
+		ASSERT_FLOAT_EQ(wt.position.x, static_cast<float>(r));
+		ASSERT_FLOAT_EQ(wt.position.y, static_cast<float>(depth - 1));
+	}
+}
@@ -0,0 +1,243 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+
+import engine.rendering;
+import engine.ui;
+
+using namespace engine::ui::text_renderer;
+
+namespace {
+// Read straight from the source tree, so the tests don't depend on the working directory
+constexpr auto FONT_PATH = CITRUS_TEST_ASSETS_DIR "/fonts/Kenney Future.ttf";
+} // namespace
+
+// ============================================================================
+// Shelf Packer Tests
+// ============================================================================
+
+TEST(ShelfPackerTest, SimilarHeights_ShareAShelf) {
+	ShelfPacker packer(64, 64);
+
+	const auto first = packer.Allocate(10, 20);
+	const auto second = packer.Allocate(10, 18);
+	ASSERT_TRUE(first.has_value());
+	ASSERT_TRUE(second.has_value());
+	EXPECT_EQ(first->x, 0);
+	EXPECT_EQ(second->x, 10);
+	EXPECT_EQ(second->y, first->y);
+	EXPECT_EQ(packer.GetUsedHeight(), 20);
+}
+
+TEST(ShelfPackerTest, MuchShorterRect_OpensItsOwnShelf) {
+	ShelfPacker packer(64, 64);
+	static_cast<void>(packer.Allocate(10, 20));
+
+	const auto short_rect = packer.Allocate(10, 8);
+	ASSERT_TRUE(short_rect.has_value());
+	EXPECT_EQ(short_rect->y, 20);
+	EXPECT_EQ(packer.GetUsedHeight(), 28);
+}
+
+TEST(ShelfPackerTest, FullPage_RejectsUntilReset) {
+	ShelfPacker packer(32, 32);
+	int allocated = 0;
+	while (packer.Allocate(8, 8)) {
+		++allocated;
+	}
+	EXPECT_EQ(allocated, 16);
+	EXPECT_FALSE(packer.Allocate(33, 1).has_value());
+
+	packer.Reset();
+	EXPECT_EQ(packer.GetUsedHeight(), 0);
+	EXPECT_TRUE(packer.Allocate(32, 32).has_value());
+}
+
+// ============================================================================
+// Glyph Cache Tests
+// ============================================================================
+
+class GlyphAtlasTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		engine::rendering::SetHeadless(true);
+		// A single small page, so the alphabet alone forces evictions
+		const GlyphCacheOptions options{.page_size = 64, .max_pages = 1};
+		font = std::make_unique<FontAtlas>(FONT_PATH, 16, options);
+		ASSERT_TRUE(font->IsValid()) << "Could not load " << FONT_PATH;
+	}
+
+	void TearDown() override { font.reset(); }
+
+	std::unique_ptr<FontAtlas> font;
+};
+
+TEST_F(GlyphAtlasTest, Glyphs_AreRasterizedOnFirstUse) {
+	EXPECT_EQ(font->GetCachedGlyphCount(), 0U);
+
+	const GlyphMetrics* glyph = font->GetGlyph('A');
+	ASSERT_NE(glyph, nullptr);
+	EXPECT_EQ(glyph->texture_id, font->GetTextureId());
+	EXPECT_EQ(font->GetGlyph('A'), glyph);
+	EXPECT_EQ(font->GetCachedGlyphCount(), 1U);
+}
+
+TEST_F(GlyphAtlasTest, CodepointMissingFromFont_ReturnsNull) {
+	EXPECT_EQ(font->GetGlyph(0x4E2D), nullptr); // CJK, which this font does not cover
+	EXPECT_EQ(font->GetCachedGlyphCount(), 0U);
+}
+
+TEST_F(GlyphAtlasTest, PageBudget_EvictsAndReRasterizes) {
+	const GlyphMetrics* first = font->GetGlyph('W');
+	ASSERT_NE(first, nullptr);
+	const float advance = first->advance;
+	const uint32_t first_texture = first->texture_id;
+
+	for (uint32_t codepoint = 'A'; codepoint <= 'Z'; ++codepoint) {
+		static_cast<void>(font->GetGlyph(codepoint));
+	}
+	EXPECT_EQ(font->GetPageCount(), 1U);
+	EXPECT_GT(font->GetEvictedPageCount(), 0U);
+
+	// The evicted metrics stay readable for the rest of the frame
+	EXPECT_EQ(first->advance, advance);
+	font->BeginFrame();
+
+	const GlyphMetrics* again = font->GetGlyph('W');
+	ASSERT_NE(again, nullptr);
+	EXPECT_EQ(again->advance, advance);
+	EXPECT_NE(again->texture_id, first_texture);
+}
+
+// Runs the real texture paths on the null device, so uploads can be measured
+class GlyphAtlasUploadTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		if (!engine::rendering::InstallNullDevice()) {
+			GTEST_SKIP() << "GL is not loaded through glad on this platform";
+		}
+		engine::rendering::SetHeadless(false);
+		const GlyphCacheOptions options{.page_size = 64, .max_pages = 1};
+		font = std::make_unique<FontAtlas>(FONT_PATH, 16, options);
+		engine::rendering::ResetNullDeviceStats();
+	}
+
+	void TearDown() override {
+		font.reset();
+		engine::rendering::ResetNullDeviceStats();
+		engine::rendering::SetHeadless(true);
+	}
+
+	std::unique_ptr<FontAtlas> font;
+};
+
+TEST_F(GlyphAtlasUploadTest, GlyphsEvictedWithinTheFrame_StillReachTheirTexture) {
+	ASSERT_TRUE(font->IsValid()) << "Could not load " << FONT_PATH;
+
+	// Nothing is flushed, so only the evictions themselves can upload the glyphs quads from this frame still use
+	ASSERT_NE(font->GetGlyph('W'), nullptr);
+	for (uint32_t codepoint = 'A'; codepoint <= 'Z' && font->GetEvictedPageCount() == 0; ++codepoint) {
+		static_cast<void>(font->GetGlyph(codepoint));
+	}
+	ASSERT_GT(font->GetEvictedPageCount(), 0U);
+	EXPECT_GT(engine::rendering::GetNullDeviceStats().texture_upload_bytes, 0U);
+}
+
+// ============================================================================
+// Signed Distance Field Tests
+// ============================================================================
+
+class SdfAtlasTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		engine::rendering::SetHeadless(true);
+		font = std::make_unique<FontAtlas>(FONT_PATH, 48, GlyphCacheOptions{.sdf = true});
+		ASSERT_TRUE(font->IsValid()) << "Could not load " << FONT_PATH;
+	}
+
+	void TearDown() override { font.reset(); }
+
+	std::unique_ptr<FontAtlas> font;
+};
+
+TEST_F(SdfAtlasTest, OneAtlas_LaysOutAtAnySize) {
+	EXPECT_TRUE(font->IsSdf());
+
+	const auto native = TextLayout::MeasureText("Hello", *font);
+	const auto half = TextLayout::MeasureText("Hello", *font, 0.0f, 24.0f);
+	EXPECT_FLOAT_EQ(half.width, native.width * 0.5f);
+	EXPECT_FLOAT_EQ(half.height, native.height * 0.5f);
+
+	LayoutOptions options;
+	options.font_size = 96.0f;
+	const auto glyphs = TextLayout::Layout("H", *font, options);
+	ASSERT_EQ(glyphs.size(), 1U);
+	EXPECT_FLOAT_EQ(glyphs[0].size.x, glyphs[0].metrics->size.x * 2.0f);
+	EXPECT_EQ(font->GetCachedGlyphCount(), 4U); // 'H', 'e', 'l', 'o', rasterized once for every size
+}
+
+TEST_F(SdfAtlasTest, FontManager_SharesOneAtlasAcrossSizes) {
+	FontManager::SetGlyphCacheOptions({.sdf = true});
+	FontManager::Initialize(FONT_PATH, 16);
+
+	FontAtlas* small = FontManager::GetFont(FONT_PATH, 16);
+	FontAtlas* large = FontManager::GetFont(FONT_PATH, 64);
+	ASSERT_NE(small, nullptr);
+	EXPECT_EQ(small, large);
+	EXPECT_TRUE(small->IsSdf());
+
+	FontManager::Shutdown();
+	FontManager::SetGlyphCacheOptions({});
+}
+
+// ============================================================================
+// Layout Cache Tests
+// ============================================================================
+
+class LayoutCacheTest : public GlyphAtlasTest {
+protected:
+	void TearDown() override {
+		TextLayout::ClearCache();
+		GlyphAtlasTest::TearDown();
+	}
+};
+
+TEST_F(LayoutCacheTest, RepeatedText_ReturnsTheSameLayout) {
+	const LayoutOptions options;
+	const auto first = TextLayout::LayoutCached("Hello", *font, options);
+	const auto second = TextLayout::LayoutCached("Hello", *font, options);
+	EXPECT_EQ(first, second);
+	EXPECT_EQ(first->glyphs.size(), 5U);
+	EXPECT_FLOAT_EQ(first->bounds.width, TextLayout::MeasureText("Hello", *font).width);
+	EXPECT_EQ(TextLayout::GetCacheSize(), 1U);
+}
+
+TEST_F(LayoutCacheTest, DifferentTextOrOptions_AreSeparateEntries) {
+	LayoutOptions options;
+	const auto hello = TextLayout::LayoutCached("Hello", *font, options);
+	EXPECT_NE(TextLayout::LayoutCached("World", *font, options), hello);
+
+	options.max_width = 10.0f;
+	EXPECT_NE(TextLayout::LayoutCached("Hello", *font, options), hello);
+	EXPECT_EQ(TextLayout::GetCacheSize(), 3U);
+}
+
+TEST_F(LayoutCacheTest, UnusedEntries_AgeOut) {
+	static_cast<void>(TextLayout::LayoutCached("Hello", *font, {}));
+	for (uint64_t frame = 0; frame <= TextLayout::LAYOUT_CACHE_MAX_AGE; ++frame) {
+		TextLayout::BeginFrame();
+	}
+	EXPECT_EQ(TextLayout::GetCacheSize(), 0U);
+}
+
+TEST_F(LayoutCacheTest, AtlasEviction_ForcesRelayout) {
+	const auto before = TextLayout::LayoutCached("Hello", *font, {});
+	for (uint32_t codepoint = 'A'; codepoint <= 'Z'; ++codepoint) {
+		static_cast<void>(font->GetGlyph(codepoint));
+	}
+	ASSERT_GT(font->GetEvictedPageCount(), 0U);
+
+	const auto after = TextLayout::LayoutCached("Hello", *font, {});
+	EXPECT_NE(after, before);
+	EXPECT_EQ(after->atlas_generation, font->GetEvictedPageCount());
+}
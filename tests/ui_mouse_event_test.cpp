@@ -456,6 +456,93 @@ TEST_F(UIMouseEventTest, MouseEventManagerEnableDisable) {
 	EXPECT_TRUE(handler_called);
 }
 
+TEST_F(UIMouseEventTest, MouseEventManagerEqualPriority_RegistrationOrder) {
+	MouseEventManager manager;
+	std::vector<int> call_order;
+
+	for (int i = 0; i < 4; ++i) {
+		manager.RegisterRegion(Rectangle{0.0f, 0.0f, 50.0f, 50.0f}, [&call_order, i](const MouseEvent&) {
+			call_order.push_back(i);
+			return false;
+		});
+	}
+
+	manager.DispatchEvent(MouseEvent{25.0f, 25.0f});
+	EXPECT_EQ(call_order, (std::vector<int>{0, 1, 2, 3}));
+}
+
+TEST_F(UIMouseEventTest, MouseEventManagerGrid_BoundsAcrossCells) {
+	MouseEventManager manager(32.0f);
+	int hits = 0;
+
+	// Spans several cells, including negative ones; edges are inclusive
+	auto handle = manager.RegisterRegion(Rectangle{-40.0f, -40.0f, 104.0f, 104.0f}, [&hits](const MouseEvent&) {
+		++hits;
+		return false;
+	});
+
+	manager.DispatchEvent(MouseEvent{-40.0f, -40.0f});
+	manager.DispatchEvent(MouseEvent{64.0f, 64.0f});
+	manager.DispatchEvent(MouseEvent{0.0f, 30.0f});
+	manager.DispatchEvent(MouseEvent{65.0f, 0.0f});
+	EXPECT_EQ(hits, 3);
+
+	// Moving into different cells must stop hits in the old ones
+	hits = 0;
+	manager.UpdateRegionBounds(handle, Rectangle{500.0f, 500.0f, 10.0f, 10.0f});
+	manager.DispatchEvent(MouseEvent{0.0f, 30.0f});
+	manager.DispatchEvent(MouseEvent{505.0f, 505.0f});
+	EXPECT_EQ(hits, 1);
+}
+
+TEST_F(UIMouseEventTest, MouseEventManagerGrid_OversizedRegionRespectsPriority) {
+	MouseEventManager manager(16.0f);
+	std::vector<int> call_order;
+
+	// Far more than MAX_CELLS_PER_REGION cells, so it lives outside the grid
+	manager.RegisterRegion(
+		Rectangle{0.0f, 0.0f, 4096.0f, 4096.0f},
+		[&call_order](const MouseEvent&) {
+			call_order.push_back(1);
+			return false;
+		},
+		100
+	);
+	manager.RegisterRegion(
+		Rectangle{2000.0f, 2000.0f, 10.0f, 10.0f},
+		[&call_order](const MouseEvent&) {
+			call_order.push_back(2);
+			return false;
+		},
+		10
+	);
+
+	manager.DispatchEvent(MouseEvent{2005.0f, 2005.0f});
+	EXPECT_EQ(call_order, (std::vector<int>{1, 2}));
+}
+
+TEST_F(UIMouseEventTest, MouseEventManagerHandlerUnregistersDuringDispatch) {
+	MouseEventManager manager;
+	bool lower_called = false;
+
+	auto lower = manager.RegisterRegion(Rectangle{0.0f, 0.0f, 100.0f, 100.0f}, [&lower_called](const MouseEvent&) {
+		lower_called = true;
+		return false;
+	});
+	manager.RegisterRegion(
+		Rectangle{0.0f, 0.0f, 100.0f, 100.0f},
+		[&manager, lower](const MouseEvent&) {
+			manager.UnregisterRegion(lower);
+			return false;
+		},
+		10
+	);
+
+	EXPECT_FALSE(manager.DispatchEvent(MouseEvent{50.0f, 50.0f}));
+	EXPECT_FALSE(lower_called);
+	EXPECT_EQ(manager.GetRegionCount(), 1);
+}
+
 // ============================================================================
 // Integration Test: UIElement + MouseEventManager
 // ============================================================================
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <memory>
+
+import engine.rendering;
+import engine.ui;
+
+using namespace engine::ui;
+using namespace engine::ui::elements;
+using namespace engine::ui::batch_renderer;
+
+// ============================================================================
+// Retained Geometry Tests
+// ============================================================================
+
+namespace {
+// Submits one quad and counts how often it was actually tessellated
+class CountingQuad : public UIElement {
+public:
+	CountingQuad(const float x, const float y, const float width, const float height) :
+			UIElement(x, y, width, height) {}
+
+	void Render() const override {
+		if (!IsVisible()) {
+			return;
+		}
+		++render_count;
+		BatchRenderer::SubmitQuad(GetAbsoluteBounds(), Colors::WHITE);
+	}
+
+	mutable int render_count = 0;
+};
+} // namespace
+
+class RetainedGeometryTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		engine::rendering::SetHeadless(true);
+		panel = std::make_unique<Panel>(100, 100, 300, 200);
+		panel->SetRetained(true);
+		auto child = std::make_unique<CountingQuad>(10, 10, 50, 20);
+		quad = child.get();
+		panel->AddChild(std::move(child));
+	}
+
+	void TearDown() override { panel.reset(); }
+
+	// Render one frame and return how many vertices it submitted
+	[[nodiscard]] size_t RenderFrame() const {
+		BatchRenderer::BeginFrame();
+		panel->Render();
+		const size_t vertices = BatchRenderer::GetPendingVertexCount();
+		BatchRenderer::EndFrame();
+		return vertices;
+	}
+
+	std::unique_ptr<Panel> panel;
+	CountingQuad* quad = nullptr;
+};
+
+TEST_F(RetainedGeometryTest, UnchangedSubtree_IsReplayedWithoutTessellating) {
+	const size_t first = RenderFrame();
+	EXPECT_EQ(quad->render_count, 1);
+
+	EXPECT_EQ(RenderFrame(), first);
+	EXPECT_EQ(RenderFrame(), first);
+	EXPECT_EQ(quad->render_count, 1);
+}
+
+TEST_F(RetainedGeometryTest, ChildSetter_InvalidatesAncestorCache) {
+	const size_t first = RenderFrame();
+
+	quad->SetSize(60, 20);
+	EXPECT_EQ(RenderFrame(), first);
+	EXPECT_EQ(quad->render_count, 2);
+
+	// Setting the same value again is not a change
+	quad->SetSize(60, 20);
+	static_cast<void>(RenderFrame());
+	EXPECT_EQ(quad->render_count, 2);
+
+	quad->SetVisible(false);
+	EXPECT_LT(RenderFrame(), first);
+}
+
+TEST_F(RetainedGeometryTest, MovingRetainedPanel_ReplaysTranslated) {
+	const size_t first = RenderFrame();
+
+	panel->SetRelativePosition(400, 300);
+	EXPECT_EQ(RenderFrame(), first);
+	EXPECT_EQ(quad->render_count, 1);
+}
+
+TEST_F(RetainedGeometryTest, NestedRetainedPanel_ReplaysIntoRebuiltParent) {
+	auto inner = std::make_unique<Panel>(100, 50, 100, 100);
+	inner->SetRetained(true);
+	auto inner_child = std::make_unique<CountingQuad>(5, 5, 10, 10);
+	CountingQuad* inner_quad = inner_child.get();
+	inner->AddChild(std::move(inner_child));
+	panel->AddChild(std::move(inner));
+
+	const size_t first = RenderFrame();
+	EXPECT_EQ(inner_quad->render_count, 1);
+
+	// Only the outer panel's own child changed, so the inner panel is copied into the new outer recording
+	quad->SetRelativePosition(20, 10);
+	EXPECT_EQ(RenderFrame(), first);
+	EXPECT_EQ(quad->render_count, 2);
+	EXPECT_EQ(inner_quad->render_count, 1);
+
+	EXPECT_EQ(RenderFrame(), first);
+	EXPECT_EQ(quad->render_count, 2);
+}
+
+TEST_F(RetainedGeometryTest, ClippedPanel_ReplaysScissorChanges) {
+	panel->SetClipChildren(true);
+
+	// Background, then the clipped children; each scissor change splits the batch
+	static_cast<void>(RenderFrame());
+	const size_t draw_calls = BatchRenderer::GetDrawCallCount();
+	EXPECT_EQ(draw_calls, 2U);
+
+	static_cast<void>(RenderFrame());
+	EXPECT_EQ(BatchRenderer::GetDrawCallCount(), draw_calls);
+	EXPECT_EQ(quad->render_count, 1);
+}
+
+TEST_F(RetainedGeometryTest, InvalidateRetained_ForcesRebuild) {
+	static_cast<void>(RenderFrame());
+	BatchRenderer::InvalidateRetained();
+	static_cast<void>(RenderFrame());
+	EXPECT_EQ(quad->render_count, 2);
+}
+
+TEST_F(RetainedGeometryTest, NotRetained_TessellatesEveryFrame) {
+	panel->SetRetained(false);
+	const size_t first = RenderFrame();
+	EXPECT_EQ(RenderFrame(), first);
+	EXPECT_EQ(quad->render_count, 2);
+}
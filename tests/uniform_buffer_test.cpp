@@ -0,0 +1,56 @@
+#include <cstddef>
+#include <gtest/gtest.h>
+
+import engine.rendering;
+import glm;
+
+using namespace engine::rendering;
+
+// The C++ struct is uploaded byte for byte, so its offsets must be the std140 offsets of the GLSL block
+TEST(UniformBufferTest, scene_uniforms_match_std140_offsets) {
+	EXPECT_EQ(offsetof(SceneUniforms, camera_position), 0U);
+	EXPECT_EQ(offsetof(SceneUniforms, ambient), 16U);
+	EXPECT_EQ(offsetof(SceneUniforms, light_count), 32U);
+	EXPECT_EQ(offsetof(SceneUniforms, light_positions), 48U);
+	EXPECT_EQ(offsetof(SceneUniforms, light_colors), 48U + 16U * MAX_SCENE_LIGHTS);
+	EXPECT_EQ(offsetof(SceneUniforms, light_params), 48U + 32U * MAX_SCENE_LIGHTS);
+	EXPECT_EQ(offsetof(SceneUniforms, cluster_depth), 48U + 48U * MAX_SCENE_LIGHTS);
+	EXPECT_EQ(offsetof(SceneUniforms, cluster_screen), 64U + 48U * MAX_SCENE_LIGHTS);
+	EXPECT_EQ(sizeof(SceneUniforms), 80U + 48U * MAX_SCENE_LIGHTS);
+	// GL_MAX_UNIFORM_BLOCK_SIZE is only guaranteed to be 16 KiB
+	EXPECT_LE(sizeof(SceneUniforms), 16384U);
+}
+
+TEST(UniformBufferTest, scene_uniform_defaults) {
+	const SceneUniforms uniforms;
+	EXPECT_EQ(uniforms.light_count[0], 0);
+	EXPECT_EQ(uniforms.ambient, glm::vec4(1.0f, 1.0f, 1.0f, 0.5f));
+}
+
+TEST(UniformBufferTest, headless_buffer_is_never_created) {
+	SetHeadless(true);
+	UniformBuffer buffer;
+	EXPECT_FALSE(buffer.Create(sizeof(SceneUniforms)));
+	EXPECT_FALSE(buffer.IsValid());
+
+	// No buffer, so these must not touch GL
+	const SceneUniforms uniforms;
+	buffer.Update(&uniforms, sizeof(uniforms));
+	buffer.BindBase(SCENE_UNIFORM_BINDING);
+	SetHeadless(false);
+}
+
+TEST(UniformBufferTest, headless_shader_has_no_uniform_handles) {
+	SetHeadless(true);
+	Shader shader;
+	ASSERT_TRUE(shader.Compile({.vertex_source = "void main() {}", .fragment_source = "void main() {}"}));
+
+	const UniformHandle handle = shader.GetUniformHandle("u_Model");
+	EXPECT_FALSE(handle.IsValid());
+	EXPECT_FALSE(shader.GetStandardUniforms().mvp.IsValid());
+	EXPECT_FALSE(shader.BindUniformBlock(SCENE_UNIFORM_BLOCK, SCENE_UNIFORM_BINDING));
+
+	// Invalid handles are ignored rather than forwarded to GL
+	shader.SetUniform(handle, glm::mat4(1.0f));
+	SetHeadless(false);
+}